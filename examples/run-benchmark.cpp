@@ -0,0 +1,293 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the processing cost of synthetic echo scenarios. The signals are
+// generated, so the figures are reproducible on any machine without test data.
+
+#include "api/scoped_refptr.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <webrtc/common_audio/vad/include/batch_vad.h>
+#include <webrtc/common_audio/vad/include/webrtc_vad.h>
+#include <webrtc/modules/audio_processing/include/audio_processing.h>
+#include <webrtc/modules/audio_processing/aec3/aec3_common.h>
+#include <webrtc/modules/audio_processing/aec3/echo_canceller3.h>
+
+#define RATE 48000
+#define BLOCK_MS 10
+#define FRAME_LENGTH (RATE * BLOCK_MS / 1000)
+#define WARMUP_FRAMES 100
+#define MEASURED_FRAMES 1000
+#define VAD_BATCH_FRAMES 100
+
+// Creates AEC3 with the default configuration and the given number of capture
+// worker threads.
+class EchoCanceller3Factory : public webrtc::EchoControlFactory {
+  public:
+    explicit EchoCanceller3Factory(int num_capture_worker_threads) {
+	config_.multi_channel.num_capture_worker_threads = num_capture_worker_threads;
+    }
+
+    std::unique_ptr<webrtc::EchoControl> Create(int sample_rate_hz,
+						int num_render_channels,
+						int num_capture_channels) override {
+	return std::make_unique<webrtc::EchoCanceller3>(config_, std::nullopt,
+							sample_rate_hz, num_render_channels,
+							num_capture_channels);
+    }
+
+  private:
+    webrtc::EchoCanceller3Config config_;
+};
+
+// Generates a mono render signal and a capture signal where each channel holds
+// the render signal attenuated and delayed by a channel-specific amount, plus
+// some noise.
+class EchoScenario {
+  public:
+    explicit EchoScenario(int num_capture_channels)
+	: render_(FRAME_LENGTH),
+	  capture_(num_capture_channels, std::vector<float>(FRAME_LENGTH)),
+	  render_channels_{render_.data()},
+	  history_(kMaxDelay + FRAME_LENGTH, 0.f) {
+	for (auto &channel : capture_)
+	    capture_channels_.push_back(channel.data());
+    }
+
+    // Produces the next 10 ms of render and capture audio.
+    void NextFrame() {
+	std::memmove(history_.data(), history_.data() + FRAME_LENGTH,
+		     kMaxDelay * sizeof(float));
+	for (int i = 0; i < FRAME_LENGTH; i++) {
+	    render_[i] = Noise(8000.f);
+	    history_[kMaxDelay + i] = render_[i];
+	}
+	for (size_t ch = 0; ch < capture_.size(); ch++) {
+	    const int delay = kMaxDelay - 48 * static_cast<int>(ch % 8);
+	    for (int i = 0; i < FRAME_LENGTH; i++)
+		capture_[ch][i] = 0.3f * history_[kMaxDelay - delay + i] + Noise(30.f);
+	}
+    }
+
+    const float *const *render() { return render_channels_; }
+    float *const *capture() { return capture_channels_.data(); }
+
+  private:
+    static constexpr int kMaxDelay = 4800;
+
+    // Returns uniform noise in [-amplitude, amplitude).
+    float Noise(float amplitude) {
+	seed_ = seed_ * 1664525u + 1013904223u;
+	return amplitude * (static_cast<float>(seed_ >> 8) / (1 << 23) - 1.f);
+    }
+
+    std::vector<float> render_;
+    std::vector<std::vector<float>> capture_;
+    float *render_channels_[1];
+    std::vector<float *> capture_channels_;
+    std::vector<float> history_;
+    uint32_t seed_ = 1;
+};
+
+// Average cost in microseconds of processing 10 ms of render and capture audio.
+struct ProcessingCost {
+    double render_us;
+    double capture_us;
+};
+
+// Measures the cost of processing the generated echo scenario with `apm`.
+static ProcessingCost TimeProcessing(webrtc::AudioProcessing &apm, int num_capture_channels) {
+    webrtc::StreamConfig render_config(RATE, 1);
+    webrtc::StreamConfig capture_config(RATE, num_capture_channels);
+    EchoScenario scenario(num_capture_channels);
+
+    std::chrono::duration<double, std::micro> render_time(0), capture_time(0);
+    for (int n = 0; n < WARMUP_FRAMES + MEASURED_FRAMES; n++) {
+	scenario.NextFrame();
+	const auto render_start = std::chrono::steady_clock::now();
+	apm.AnalyzeReverseStream(scenario.render(), render_config);
+	const auto capture_start = std::chrono::steady_clock::now();
+	apm.set_stream_delay_ms(0);
+	apm.ProcessStream(scenario.capture(), capture_config, capture_config,
+			  scenario.capture());
+	const auto capture_end = std::chrono::steady_clock::now();
+	if (n >= WARMUP_FRAMES) {
+	    render_time += capture_start - render_start;
+	    capture_time += capture_end - capture_start;
+	}
+    }
+    return {render_time.count() / MEASURED_FRAMES, capture_time.count() / MEASURED_FRAMES};
+}
+
+// Measures the cost of processing with AEC3 only.
+static ProcessingCost TimeAec3(int num_capture_channels, int num_capture_worker_threads) {
+    webrtc::AudioProcessing::Config config;
+    config.pipeline.multi_channel_capture = true;
+    config.echo_canceller.enabled = true;
+
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm = webrtc::AudioProcessingBuilder()
+	.SetConfig(config)
+	.SetEchoControlFactory(std::make_unique<EchoCanceller3Factory>(num_capture_worker_threads))
+	.Create();
+    return TimeProcessing(*apm, num_capture_channels);
+}
+
+// Measures the cost of processing mono audio with a typical voice call
+// configuration, with the capture output either used or muted.
+static ProcessingCost TimeCallProcessing(bool muted) {
+    webrtc::AudioProcessing::Config config;
+    config.high_pass_filter.enabled = true;
+    config.echo_canceller.enabled = true;
+    config.noise_suppression.enabled = true;
+    config.gain_controller1.enabled = true;
+    config.gain_controller1.mode = webrtc::AudioProcessing::Config::GainController1::kAdaptiveDigital;
+    config.gain_controller2.enabled = true;
+
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm =
+	webrtc::AudioProcessingBuilder().SetConfig(config).Create();
+    apm->set_output_will_be_muted(muted);
+    return TimeProcessing(*apm, 1);
+}
+
+// Average cost in nanoseconds of classifying 10 ms of one stream with one
+// WebRtcVad instance per stream and with a BatchVad for all streams.
+struct VadCost {
+    double per_frame_ns;
+    double batch_ns;
+};
+
+// Measures the VAD cost for `num_streams` streams of noise bursts at `rate`.
+static VadCost TimeVad(int rate, size_t num_streams) {
+    const size_t frame_length = rate / 100;
+    std::vector<int16_t> audio(num_streams * VAD_BATCH_FRAMES * frame_length);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < audio.size(); i++) {
+	seed = seed * 1664525u + 1013904223u;
+	const int shift = (i / (rate / 4)) % 2 ? 2 : 8;
+	audio[i] = static_cast<int16_t>(seed >> 16) >> shift;
+    }
+    std::vector<uint8_t> decisions(num_streams * VAD_BATCH_FRAMES);
+    const int num_runs = MEASURED_FRAMES / VAD_BATCH_FRAMES;
+
+    std::vector<VadInst *> instances(num_streams);
+    for (VadInst *&instance : instances) {
+	instance = WebRtcVad_Create();
+	WebRtcVad_Init(instance);
+	WebRtcVad_set_mode(instance, 2);
+    }
+    const auto per_frame_start = std::chrono::steady_clock::now();
+    for (int run = 0; run < num_runs; run++) {
+	for (size_t s = 0; s < num_streams; s++) {
+	    for (size_t k = 0; k < VAD_BATCH_FRAMES; k++) {
+		const size_t frame = s * VAD_BATCH_FRAMES + k;
+		decisions[frame] = WebRtcVad_Process(instances[s], rate,
+						     &audio[frame * frame_length], frame_length);
+	    }
+	}
+    }
+    const auto per_frame_end = std::chrono::steady_clock::now();
+    for (VadInst *instance : instances)
+	WebRtcVad_Free(instance);
+
+    std::unique_ptr<webrtc::BatchVad> batch_vad =
+	webrtc::CreateBatchVad(num_streams, webrtc::Vad::kVadAggressive, rate, frame_length);
+    const auto batch_start = std::chrono::steady_clock::now();
+    for (int run = 0; run < num_runs; run++)
+	batch_vad->Process(audio, VAD_BATCH_FRAMES, decisions);
+    const auto batch_end = std::chrono::steady_clock::now();
+
+    const double num_frames = static_cast<double>(num_runs) * num_streams * VAD_BATCH_FRAMES;
+    const std::chrono::duration<double, std::nano> per_frame_time = per_frame_end - per_frame_start;
+    const std::chrono::duration<double, std::nano> batch_time = batch_end - batch_start;
+    return {per_frame_time.count() / num_frames, batch_time.count() / num_frames};
+}
+
+static void Usage(const char *name) {
+    std::cerr << "Usage: " << name << " aec3 [<capture_channels> [<worker_threads>]]" << std::endl;
+    std::cerr << "       " << name << " aec3-scaling [<worker_threads>]" << std::endl;
+    std::cerr << "       " << name << " muted" << std::endl;
+    std::cerr << "       " << name << " vad [<streams>]" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+	Usage(argv[0]);
+	return EXIT_FAILURE;
+    }
+
+    if (strcmp(argv[1], "aec3") == 0 && argc <= 4) {
+	const int num_capture_channels = argc > 2 ? atoi(argv[2]) : 1;
+	const int num_capture_worker_threads = argc > 3 ? atoi(argv[3]) : 0;
+	if (num_capture_channels < 1 || num_capture_worker_threads < 0) {
+	    Usage(argv[0]);
+	    return EXIT_FAILURE;
+	}
+	const ProcessingCost cost = TimeAec3(num_capture_channels, num_capture_worker_threads);
+	std::cout << "AEC3 with " << webrtc::kBlockSize << " sample blocks, "
+		  << num_capture_channels << " capture channels, "
+		  << num_capture_worker_threads << " worker threads: render "
+		  << cost.render_us << " us, capture " << cost.capture_us
+		  << " us per 10 ms" << std::endl;
+	return EXIT_SUCCESS;
+    }
+
+    if (strcmp(argv[1], "aec3-scaling") == 0 && argc <= 3) {
+	const int num_capture_worker_threads = argc > 2 ? atoi(argv[2]) : 3;
+	if (num_capture_worker_threads < 1) {
+	    Usage(argv[0]);
+	    return EXIT_FAILURE;
+	}
+	std::cout << "AEC3 with " << webrtc::kBlockSize << " sample blocks, capture us per 10 ms" << std::endl;
+	std::cout << "channels\tserial\t" << num_capture_worker_threads << " workers" << std::endl;
+	for (int num_capture_channels = 1; num_capture_channels <= 16; num_capture_channels *= 2) {
+	    const ProcessingCost serial = TimeAec3(num_capture_channels, 0);
+	    const ProcessingCost parallel = TimeAec3(num_capture_channels, num_capture_worker_threads);
+	    std::cout << num_capture_channels << "\t\t" << serial.capture_us << "\t"
+		      << parallel.capture_us << std::endl;
+	}
+	return EXIT_SUCCESS;
+    }
+
+    if (strcmp(argv[1], "muted") == 0 && argc == 2) {
+	const ProcessingCost used = TimeCallProcessing(false);
+	const ProcessingCost muted = TimeCallProcessing(true);
+	std::cout << "HPF, AEC3, NS, AGC1 and AGC2, us per 10 ms" << std::endl;
+	std::cout << "output used: render " << used.render_us << ", capture "
+		  << used.capture_us << std::endl;
+	std::cout << "output muted: render " << muted.render_us << ", capture "
+		  << muted.capture_us << std::endl;
+	return EXIT_SUCCESS;
+    }
+
+    if (strcmp(argv[1], "vad") == 0 && argc <= 3) {
+	const int num_streams = argc > 2 ? atoi(argv[2]) : 64;
+	if (num_streams < 1) {
+	    Usage(argv[0]);
+	    return EXIT_FAILURE;
+	}
+	std::cout << "VAD of " << num_streams << " streams, ns per 10 ms of one stream" << std::endl;
+	std::cout << "rate\tper frame\tbatch\tspeedup" << std::endl;
+	for (int rate : {8000, 16000, 32000, 48000}) {
+	    const VadCost cost = TimeVad(rate, num_streams);
+	    std::cout << rate << "\t" << cost.per_frame_ns << "\t\t" << cost.batch_ns << "\t"
+		      << cost.per_frame_ns / cost.batch_ns << std::endl;
+	}
+	return EXIT_SUCCESS;
+    }
+
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+}
@@ -10,19 +10,126 @@
  */
 
 #include "api/scoped_refptr.h"
+#include <array>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 #include <webrtc/modules/audio_processing/include/audio_processing.h>
+#include <webrtc/modules/audio_processing/aec3/echo_canceller3.h>
+#include <webrtc/common_audio/resampler/push_sinc_resampler.h>
 
 #define DEFAULT_BLOCK_MS 10
 #define DEFAULT_RATE 32000
 #define DEFAULT_CHANNELS 1
 
+#define LINEAR_RATE 16000
+
+// Creates AEC3 with the default configuration and the linear output exported,
+// optionally storing the linear filters with half precision.
+class EchoCanceller3Factory : public webrtc::EchoControlFactory {
+  public:
+    explicit EchoCanceller3Factory(bool half_precision_storage) {
+	config_.filter.export_linear_aec_output = true;
+	config_.filter.half_precision_storage = half_precision_storage;
+    }
+
+    std::unique_ptr<webrtc::EchoControl> Create(int sample_rate_hz,
+						int num_render_channels,
+						int num_capture_channels) override {
+	return std::make_unique<webrtc::EchoCanceller3>(config_, std::nullopt,
+							sample_rate_hz, num_render_channels,
+							num_capture_channels);
+    }
+
+  private:
+    webrtc::EchoCanceller3Config config_;
+};
+
+// Runs only the echo canceller over the files and prints the linear ERLE
+// (capture vs. linear filter output, both at 16 kHz) and the total ERLE
+// (capture vs. processed output). The figures are only meaningful for
+// recordings that contain echo and no near-end speech.
+static void ReportErle(const char *play_path, const char *rec_path, bool half_precision_storage) {
+    std::ifstream play_file(play_path, std::ios::binary);
+    std::ifstream rec_file(rec_path, std::ios::binary);
+
+    webrtc::AudioProcessing::Config config;
+    config.echo_canceller.enabled = true;
+    config.echo_canceller.mobile_mode = false;
+    config.echo_canceller.export_linear_aec_output = true;
+
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm = webrtc::AudioProcessingBuilder()
+	.SetConfig(config)
+	.SetEchoControlFactory(std::make_unique<EchoCanceller3Factory>(half_precision_storage))
+	.Create();
+
+    webrtc::StreamConfig stream_config(DEFAULT_RATE, DEFAULT_CHANNELS);
+    webrtc::PushSincResampler resampler(DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000,
+					LINEAR_RATE * DEFAULT_BLOCK_MS / 1000);
+
+    double rec_energy = 0.0, out_energy = 0.0;
+    double rec_linear_energy = 0.0, linear_energy = 0.0;
+
+    while (!play_file.eof() && !rec_file.eof()) {
+	int16_t play_frame[DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000 * DEFAULT_CHANNELS];
+	int16_t rec_frame[DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000 * DEFAULT_CHANNELS];
+	int16_t out_frame[DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000 * DEFAULT_CHANNELS];
+	float rec_mono[DEFAULT_RATE * DEFAULT_BLOCK_MS / 1000];
+	float rec_linear_rate[LINEAR_RATE * DEFAULT_BLOCK_MS / 1000];
+	std::array<float, LINEAR_RATE * DEFAULT_BLOCK_MS / 1000> linear_output;
+
+	play_file.read(reinterpret_cast<char *>(play_frame), sizeof(play_frame));
+	rec_file.read(reinterpret_cast<char *>(rec_frame), sizeof(rec_frame));
+	if (play_file.gcount() != sizeof(play_frame) || rec_file.gcount() != sizeof(rec_frame))
+	    break;
+
+	apm->ProcessReverseStream(play_frame, stream_config, stream_config, play_frame);
+	apm->ProcessStream(rec_frame, stream_config, stream_config, out_frame);
+
+	for (size_t i = 0; i < sizeof(rec_frame) / sizeof(rec_frame[0]); i++) {
+	    rec_energy += static_cast<double>(rec_frame[i]) * rec_frame[i];
+	    out_energy += static_cast<double>(out_frame[i]) * out_frame[i];
+	}
+
+	// The linear output is a mono downmix of the lower band in [-1, 1], so
+	// compare it against the capture mixed, scaled and resampled the same way.
+	for (size_t i = 0; i < sizeof(rec_mono) / sizeof(rec_mono[0]); i++) {
+	    float sum = 0.f;
+	    for (size_t ch = 0; ch < DEFAULT_CHANNELS; ch++)
+		sum += rec_frame[i * DEFAULT_CHANNELS + ch];
+	    rec_mono[i] = sum / DEFAULT_CHANNELS / 32768.f;
+	}
+	resampler.Resample(rec_mono, sizeof(rec_mono) / sizeof(rec_mono[0]), rec_linear_rate,
+			   sizeof(rec_linear_rate) / sizeof(rec_linear_rate[0]));
+
+	if (!apm->GetLinearAecOutput(rtc::ArrayView<std::array<float, 160>>(&linear_output, 1)))
+	    continue;
+	for (size_t i = 0; i < linear_output.size(); i++) {
+	    rec_linear_energy += static_cast<double>(rec_linear_rate[i]) * rec_linear_rate[i];
+	    linear_energy += static_cast<double>(linear_output[i]) * linear_output[i];
+	}
+    }
+
+    std::cout << (half_precision_storage ? "fp16" : "fp32")
+	      << ": linear ERLE " << 10.0 * std::log10((rec_linear_energy + 1e-10) / (linear_energy + 1e-10))
+	      << " dB, total ERLE " << 10.0 * std::log10((rec_energy + 1.0) / (out_energy + 1.0))
+	      << " dB" << std::endl;
+}
+
 int main(int argc, char **argv) {
+    if (argc == 4 && strcmp(argv[1], "--compare-half-precision") == 0) {
+	ReportErle(argv[2], argv[3], false);
+	ReportErle(argv[2], argv[3], true);
+	return EXIT_SUCCESS;
+    }
+
     if (argc != 4) {
 	std::cerr << "Usage: " << argv[0] << " <play_file> <rec_file> <out_file>" << std::endl;
+	std::cerr << "       " << argv[0] << " --compare-half-precision <play_file> <rec_file>" << std::endl;
 	return EXIT_FAILURE;
     }
 
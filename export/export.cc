@@ -1,5 +1,7 @@
 #include "export.h"
+#include <algorithm>
 #include <iostream>
+#include <webrtc/common_audio/vad/include/batch_vad.h>
 
 AudioProcessingHandle::AudioProcessingHandle()
     : apm_(webrtc::AudioProcessingBuilder().Create()) {}
@@ -25,6 +27,14 @@ void AudioProcessingHandle::SetStreamDelayMs(int delay_ms) {
     apm_->set_stream_delay_ms(delay_ms);
 }
 
+std::vector<uint8_t> AudioProcessingHandle::GetEchoCancellerState() {
+    return apm_->GetEchoCancellerWarmStartState();
+}
+
+bool AudioProcessingHandle::SetEchoCancellerState(const uint8_t* const src, size_t size) {
+    return apm_->SetEchoCancellerWarmStartState(rtc::ArrayView<const uint8_t>(src, size));
+}
+
 // -------------------- Export functions ------------------ //
 
 AudioProcessingHandle* WebRTC_APM_Create() {
@@ -65,4 +75,52 @@ int WebRTC_APM_ProcessStream(AudioProcessingHandle* handle, const int16_t* const
 void WebRTC_APM_SetStreamDelayMs(AudioProcessingHandle* handle, int delay_ms) {
     if (!handle) return;
     handle->SetStreamDelayMs(delay_ms);
+}
+
+size_t WebRTC_APM_GetEchoCancellerState(AudioProcessingHandle* handle, uint8_t* const dest,
+    size_t capacity) {
+    if (!handle) return 0;
+    const std::vector<uint8_t> state = handle->GetEchoCancellerState();
+    if (dest && capacity >= state.size()) {
+        std::copy(state.begin(), state.end(), dest);
+    }
+    return state.size();
+}
+
+int WebRTC_APM_SetEchoCancellerState(AudioProcessingHandle* handle, const uint8_t* const src,
+    size_t size) {
+    if (!handle || !src) return -1;
+    return handle->SetEchoCancellerState(src, size) ? 0 : -1;
+}
+
+webrtc::BatchVad* WebRTC_VAD_Create(size_t num_streams, int mode, int sample_rate,
+    size_t frame_length) {
+    if (mode < webrtc::Vad::kVadNormal || mode > webrtc::Vad::kVadVeryAggressive) return nullptr;
+    return webrtc::CreateBatchVad(num_streams, static_cast<webrtc::Vad::Aggressiveness>(mode),
+        sample_rate, frame_length).release();
+}
+
+void WebRTC_VAD_Destroy(webrtc::BatchVad* handle) {
+    if (!handle) return;
+    delete handle;
+}
+
+int WebRTC_VAD_Process(webrtc::BatchVad* handle, const int16_t* const audio,
+    size_t num_frames, uint8_t* const decisions) {
+    if (!handle || !audio || !decisions) return -1;
+    const size_t num_decisions = handle->num_streams() * num_frames;
+    const bool ok = handle->Process(
+        rtc::ArrayView<const int16_t>(audio, num_decisions * handle->frame_length()),
+        num_frames, rtc::ArrayView<uint8_t>(decisions, num_decisions));
+    return ok ? 0 : -1;
+}
+
+void WebRTC_VAD_Reset(webrtc::BatchVad* handle) {
+    if (!handle) return;
+    handle->Reset();
+}
+
+void WebRTC_VAD_ResetStream(webrtc::BatchVad* handle, size_t stream) {
+    if (!handle || stream >= handle->num_streams()) return;
+    handle->Reset(stream);
 }
\ No newline at end of file
@@ -2,11 +2,16 @@
 #define WEBRTC_EXPORT_H
 
 #include <memory>
+#include <vector>
 #include <stdint.h>
 #include <stddef.h>
 #include <webrtc/rtc_base/system/rtc_export.h>
 #include <webrtc/modules/audio_processing/include/audio_processing.h>
 
+namespace webrtc {
+class BatchVad;
+}  // namespace webrtc
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,6 +25,8 @@ class AudioProcessingHandle {
     int ProcessStream(const int16_t* const src, const webrtc::StreamConfig* input_config,
       const webrtc::StreamConfig* output_config, int16_t* const dest);
     void SetStreamDelayMs(int delay_ms);
+    std::vector<uint8_t> GetEchoCancellerState();
+    bool SetEchoCancellerState(const uint8_t* const src, size_t size);
     webrtc::StreamConfig CreateStreamConfig(int sample_rate, size_t num_channels);
   private:
     rtc::scoped_refptr<webrtc::AudioProcessing> apm_;
@@ -44,6 +51,33 @@ RTC_EXPORT int WebRTC_APM_ProcessStream(AudioProcessingHandle* handle, const int
 
 RTC_EXPORT void WebRTC_APM_SetStreamDelayMs(AudioProcessingHandle* handle, int delay_ms);
 
+// Copies the serialized state of the converged echo canceller into `dest` when it holds at least
+// `capacity` bytes. Returns the size of the state, or 0 if none is available. Pass a NULL `dest` to
+// query the size.
+RTC_EXPORT size_t WebRTC_APM_GetEchoCancellerState(AudioProcessingHandle* handle, uint8_t* const dest,
+  size_t capacity);
+
+// Initializes the echo canceller from a state returned by WebRTC_APM_GetEchoCancellerState(), once
+// the first stream has been processed. Returns 0 on success, -1 if the state cannot be used.
+RTC_EXPORT int WebRTC_APM_SetEchoCancellerState(AudioProcessingHandle* handle, const uint8_t* const src,
+  size_t size);
+
+// Voice activity detection over `num_streams` streams at once. `mode` is the
+// aggressiveness (0-3). Returns NULL for invalid rate/frame length pairs.
+RTC_EXPORT webrtc::BatchVad* WebRTC_VAD_Create(size_t num_streams, int mode, int sample_rate,
+  size_t frame_length);
+
+RTC_EXPORT void WebRTC_VAD_Destroy(webrtc::BatchVad* handle);
+
+// Classifies `num_frames` frames of every stream. `audio` holds the frames of one stream after the
+// other, `decisions` receives num_streams * num_frames values (1 active, 0 passive).
+RTC_EXPORT int WebRTC_VAD_Process(webrtc::BatchVad* handle, const int16_t* const audio,
+  size_t num_frames, uint8_t* const decisions);
+
+RTC_EXPORT void WebRTC_VAD_Reset(webrtc::BatchVad* handle);
+
+RTC_EXPORT void WebRTC_VAD_ResetStream(webrtc::BatchVad* handle, size_t stream);
+
 #ifdef __cplusplus
 }
 #endif
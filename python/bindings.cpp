@@ -3,10 +3,13 @@
 #include <pybind11/stl.h>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
 #include "webrtc/api/audio/audio_frame.h"
 #include "webrtc/api/audio/echo_canceller3_config.h"
+#include "webrtc/common_audio/vad/include/batch_vad.h"
 
 namespace py = pybind11;
 
@@ -183,11 +186,102 @@ public:
         
         return result;
     }
+    
+    py::bytes get_echo_canceller_state() {
+        const std::vector<uint8_t> state = apm_->GetEchoCancellerWarmStartState();
+        return py::bytes(reinterpret_cast<const char*>(state.data()), state.size());
+    }
+    
+    bool set_echo_canceller_state(const py::bytes& state) {
+        const std::string data = state;
+        return apm_->SetEchoCancellerWarmStartState(rtc::ArrayView<const uint8_t>(
+            reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+    }
 
 private:
     rtc::scoped_refptr<webrtc::AudioProcessing> apm_;
 };
 
+class PyVoiceActivityDetector {
+public:
+    PyVoiceActivityDetector(int num_streams = 1,
+                            int mode = 0,
+                            int sample_rate = 16000,
+                            int frame_ms = 10) {
+        if (num_streams < 1) {
+            throw std::runtime_error("Number of streams must be at least 1");
+        }
+        if (mode < 0 || mode > 3) {
+            throw std::runtime_error("VAD mode must be between 0 and 3");
+        }
+        if (frame_ms != 10 && frame_ms != 20 && frame_ms != 30) {
+            throw std::runtime_error("Frame length must be 10, 20, or 30 ms");
+        }
+        vad_ = webrtc::CreateBatchVad(
+            num_streams, static_cast<webrtc::Vad::Aggressiveness>(mode),
+            sample_rate, static_cast<size_t>(sample_rate / 1000 * frame_ms));
+        if (!vad_) {
+            throw std::runtime_error("Sample rate must be 8000, 16000, 32000, or 48000 Hz");
+        }
+    }
+    
+    py::array_t<uint8_t> process(py::array_t<int16_t, py::array::c_style | py::array::forcecast> input) {
+        auto buf = input.request();
+        const size_t num_streams = vad_->num_streams();
+        const size_t frame_length = vad_->frame_length();
+        
+        // A single stream may be passed as a 1-dimensional array, several
+        // streams as a (num_streams, num_samples) array.
+        size_t samples;
+        if (buf.ndim == 1 && num_streams == 1) {
+            samples = buf.shape[0];
+        } else if (buf.ndim == 2 && static_cast<size_t>(buf.shape[0]) == num_streams) {
+            samples = buf.shape[1];
+        } else {
+            throw std::runtime_error("Input array must have shape (num_streams, num_samples)");
+        }
+        if (samples == 0 || samples % frame_length != 0) {
+            throw std::runtime_error("Number of samples must be a non-zero multiple of the frame length");
+        }
+        
+        const size_t num_frames = samples / frame_length;
+        auto output = buf.ndim == 1
+            ? py::array_t<uint8_t>(num_frames)
+            : py::array_t<uint8_t>({num_streams, num_frames});
+        auto output_buf = output.request();
+        
+        rtc::ArrayView<const int16_t> audio(static_cast<const int16_t*>(buf.ptr),
+                                            num_streams * samples);
+        rtc::ArrayView<uint8_t> decisions(static_cast<uint8_t*>(output_buf.ptr),
+                                          num_streams * num_frames);
+        
+        // The whole batch runs without the GIL so that other Python threads,
+        // e.g. other detectors, can run in parallel.
+        {
+            py::gil_scoped_release release;
+            vad_->Process(audio, num_frames, decisions);
+        }
+        
+        return output;
+    }
+    
+    void reset() { vad_->Reset(); }
+    
+    void reset_stream(int stream) {
+        if (stream < 0 || static_cast<size_t>(stream) >= vad_->num_streams()) {
+            throw std::runtime_error("Stream index out of range");
+        }
+        vad_->Reset(stream);
+    }
+    
+    int num_streams() const { return static_cast<int>(vad_->num_streams()); }
+    
+    int frame_length() const { return static_cast<int>(vad_->frame_length()); }
+
+private:
+    std::unique_ptr<webrtc::BatchVad> vad_;
+};
+
 PYBIND11_MODULE(webrtc_audio_processing, m) {
     m.doc() = "WebRTC Audio Processing Python bindings";
     
@@ -245,10 +339,70 @@ PYBIND11_MODULE(webrtc_audio_processing, m) {
         .def("stream_has_echo", &PyAudioProcessing::stream_has_echo,
              "Check if echo is detected in the stream")
         .def("get_statistics", &PyAudioProcessing::get_statistics,
-             "Get audio processing statistics");
+             "Get audio processing statistics")
+        .def("get_echo_canceller_state", &PyAudioProcessing::get_echo_canceller_state,
+             R"pbdoc(
+             Get a snapshot of the converged echo canceller state.
+             
+             Returns:
+                 Serialized state as bytes, empty if echo cancellation is disabled
+             )pbdoc")
+        .def("set_echo_canceller_state", &PyAudioProcessing::set_echo_canceller_state,
+             py::arg("state"),
+             R"pbdoc(
+             Initialize the echo canceller from a state returned by
+             get_echo_canceller_state(). Call it after the first process_stream()
+             call, with the same channel configuration as the source instance.
+             
+             Args:
+                 state: Serialized state as bytes
+                 
+             Returns:
+                 True if the state was accepted
+             )pbdoc");
+    
+    py::class_<PyVoiceActivityDetector>(m, "VoiceActivityDetector")
+        .def(py::init<int, int, int, int>(),
+             py::arg("num_streams") = 1, py::arg("mode") = 0,
+             py::arg("sample_rate") = 16000, py::arg("frame_ms") = 10,
+             R"pbdoc(
+             Create a voice activity detector for one or more streams.
+             
+             Args:
+                 num_streams: Number of independent streams classified per call
+                 mode: Aggressiveness (0 = quality ... 3 = very aggressive)
+                 sample_rate: Sample rate in Hz (8000, 16000, 32000, or 48000)
+                 frame_ms: Frame length in ms (10, 20, or 30)
+             )pbdoc")
+        .def("process", &PyVoiceActivityDetector::process,
+             py::arg("input"),
+             R"pbdoc(
+             Classify all frames of all streams in one call.
+             
+             Args:
+                 input: int16 numpy array of shape (num_samples,) for a single
+                        stream or (num_streams, num_samples). num_samples must
+                        be a multiple of the frame length.
+                 
+             Returns:
+                 uint8 numpy array with one decision per frame (1 = voice),
+                 of shape (num_frames,) or (num_streams, num_frames)
+             )pbdoc")
+        .def("reset", &PyVoiceActivityDetector::reset,
+             "Reset the state of all streams")
+        .def("reset_stream", &PyVoiceActivityDetector::reset_stream,
+             py::arg("stream"),
+             "Reset the state of a single stream")
+        .def_property_readonly("num_streams", &PyVoiceActivityDetector::num_streams)
+        .def_property_readonly("frame_length", &PyVoiceActivityDetector::frame_length,
+             "Frame length in samples");
              
     // Module-level constants
-    m.attr("__version__") = "2.1.0";
+#ifdef VERSION_INFO
+    m.attr("__version__") = VERSION_INFO;
+#else
+    m.attr("__version__") = "dev";
+#endif
     m.attr("SAMPLE_RATE_8KHZ") = 8000;
     m.attr("SAMPLE_RATE_16KHZ") = 16000;
     m.attr("SAMPLE_RATE_32KHZ") = 32000;
@@ -181,6 +181,93 @@ def test_error_handling():
         traceback.print_exc()
         return False
 
+def test_voice_activity_detector():
+    """Test batch voice activity detection."""
+    print("\nTesting voice activity detection...")
+    
+    try:
+        import webrtc_audio_processing as wapm
+        
+        # Four streams, one second each at 16kHz, classified in 10ms frames.
+        vad = wapm.VoiceActivityDetector(num_streams=4, mode=2, sample_rate=16000, frame_ms=10)
+        assert vad.frame_length == 160, "Unexpected frame length"
+        
+        audio = np.zeros((4, 16000), dtype=np.int16)
+        audio[1] = np.random.randint(-8000, 8000, 16000, dtype=np.int16)
+        decisions = vad.process(audio)
+        
+        assert decisions.shape == (4, 100), "Decision shape mismatch"
+        assert not decisions[0].any(), "Silence classified as voice"
+        print(f"✓ Classified {decisions.size} frames, {int(decisions.sum())} active")
+        
+        # Streams are independent: a single-stream detector gives the same
+        # decisions for the same audio.
+        single = wapm.VoiceActivityDetector(mode=2, sample_rate=16000, frame_ms=10)
+        assert (single.process(audio[1]) == decisions[1]).all(), "Batch and single stream differ"
+        print("✓ Batch decisions match single stream decisions")
+        
+        vad.reset_stream(1)
+        vad.reset()
+        
+        # Input that is not a whole number of frames is rejected.
+        try:
+            vad.process(audio[:, :100])
+            print("✗ Should have raised error for partial frame")
+            return False
+        except RuntimeError:
+            print("✓ Correctly caught partial frame error")
+        
+        return True
+        
+    except Exception as e:
+        print(f"✗ Voice activity detection test failed: {e}")
+        traceback.print_exc()
+        return False
+
+def test_echo_canceller_state():
+    """Test exporting and importing the echo canceller state."""
+    print("\nTesting echo canceller warm start...")
+    
+    try:
+        import webrtc_audio_processing as wapm
+        
+        def process_echo(apm, render):
+            # The capture signal holds the render signal delayed by 20ms.
+            capture = np.concatenate([np.zeros(320, dtype=np.int16), render[:-320] // 2])
+            for start in range(0, len(render), 160):
+                apm.process_reverse_stream(render[start:start + 160])
+                apm.process_stream(capture[start:start + 160])
+        
+        render = np.random.randint(-8000, 8000, 32000, dtype=np.int16)  # 2s at 16kHz
+        source = wapm.AudioProcessing()
+        source.apply_config(echo_cancellation=True, noise_suppression=False,
+                            gain_control=False, high_pass_filter=False)
+        process_echo(source, render)
+        state = source.get_echo_canceller_state()
+        assert isinstance(state, bytes) and len(state) > 0, "No echo canceller state"
+        print(f"✓ Exported {len(state)} bytes of echo canceller state")
+        
+        target = wapm.AudioProcessing()
+        target.apply_config(echo_cancellation=True, noise_suppression=False,
+                            gain_control=False, high_pass_filter=False)
+        process_echo(target, render[:160])
+        assert target.set_echo_canceller_state(state), "State rejected"
+        assert not target.set_echo_canceller_state(state[:-1]), "Truncated state accepted"
+        assert not target.set_echo_canceller_state(b""), "Empty state accepted"
+        print("✓ State imported, malformed states rejected")
+        
+        # The imported state is applied while processing continues.
+        process_echo(target, render)
+        assert len(target.get_echo_canceller_state()) == len(state), "State size changed"
+        print("✓ Imported state round trip successful")
+        
+        return True
+        
+    except Exception as e:
+        print(f"✗ Echo canceller warm start test failed: {e}")
+        traceback.print_exc()
+        return False
+
 def main():
     """Run all tests."""
     print("WebRTC Audio Processing Python Bindings Test Suite")
@@ -192,6 +279,8 @@ def main():
         test_gain_control,
         test_statistics,
         test_error_handling,
+        test_voice_activity_detector,
+        test_echo_canceller_state,
     ]
     
     passed = 0
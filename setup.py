@@ -204,7 +204,7 @@ ext_modules = [
         cxx_std=20,
         extra_compile_args=extra_compile_args,
         extra_link_args=extra_link_args,
-        define_macros=[("VERSION_INFO", '"2.1.0"')],
+        define_macros=[("VERSION_INFO", '"2.2.0"')],
     ),
 ]
 
@@ -213,7 +213,7 @@ with open("README.md", "r", encoding="utf-8") as fh:
 
 setup(
     name="webrtc-audio-processing",
-    version="2.1.0",
+    version="2.2.0",
     author="WebRTC Audio Processing Team",
     author_email="",
     description="Python bindings for WebRTC Audio Processing library",
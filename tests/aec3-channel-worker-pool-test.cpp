@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies that the Subtractor produces bit-identical outputs and filters
+// when its capture channels are processed on a ChannelWorkerPool, for 1 to 16
+// channels and pools of several sizes, and that ParallelFor() calls each
+// channel exactly once and allows the pool to be destroyed right after it.
+// The pool is passed to the Subtractor directly, as EchoRemover does not
+// create one on single-core machines.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <webrtc/api/audio/echo_canceller3_config.h>
+#include <webrtc/modules/audio_processing/aec3/aec3_common.h>
+#include <webrtc/modules/audio_processing/aec3/aec_state.h>
+#include <webrtc/modules/audio_processing/aec3/block.h>
+#include <webrtc/modules/audio_processing/aec3/channel_worker_pool.h>
+#include <webrtc/modules/audio_processing/aec3/render_delay_buffer.h>
+#include <webrtc/modules/audio_processing/aec3/render_signal_analyzer.h>
+#include <webrtc/modules/audio_processing/aec3/subtractor.h>
+#include <webrtc/modules/audio_processing/aec3/subtractor_output.h>
+#include <webrtc/modules/audio_processing/logging/apm_data_dumper.h>
+
+#define RATE 16000
+#define MAX_CHANNELS 16
+#define NUM_BLOCKS 300
+// The render buffer is read the default delay of 5 blocks behind, which puts
+// the echo 2 blocks into the filters.
+#define ECHO_DELAY_BLOCKS 7
+#define NUM_DESTRUCTIONS 500
+
+static const int kNumWorkerThreads[] = {1, 4, MAX_CHANNELS - 1};
+
+// Returns a uniformly distributed value in [-1, 1).
+static float Random(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return static_cast<float>(*seed >> 8) / (1 << 23) - 1.f;
+}
+
+// Runs a Subtractor on `pool`, or serially if it is null, over render noise
+// and capture channels holding its delayed echo at different levels, and
+// appends the outputs of all blocks followed by the final filters to
+// `result`.
+static void Run(size_t num_channels, webrtc::ChannelWorkerPool *pool, std::vector<float> *result) {
+    webrtc::EchoCanceller3Config config;
+    webrtc::ApmDataDumper data_dumper(0);
+    const webrtc::Aec3Optimization optimization = webrtc::DetectOptimization();
+    std::unique_ptr<webrtc::RenderDelayBuffer> render_delay_buffer(
+	webrtc::RenderDelayBuffer::Create(config, RATE, 1));
+    webrtc::RenderSignalAnalyzer render_signal_analyzer(config);
+    webrtc::AecState aec_state(config, num_channels);
+    webrtc::Subtractor subtractor(config, 1, num_channels, &data_dumper, optimization, pool);
+
+    webrtc::Block render(webrtc::NumBandsForRate(RATE), 1);
+    webrtc::Block capture(webrtc::NumBandsForRate(RATE), num_channels);
+    std::vector<std::array<float, webrtc::kBlockSize>> history(ECHO_DELAY_BLOCKS + 1);
+    std::vector<webrtc::SubtractorOutput> outputs(num_channels);
+    uint32_t seed = 1;
+
+    for (int n = 0; n < NUM_BLOCKS; n++) {
+	std::copy(history.begin() + 1, history.end(), history.begin());
+	for (float &x : history.back())
+	    x = 8000.f * Random(&seed);
+	std::copy(history.back().begin(), history.back().end(), render.begin(0, 0));
+	for (size_t ch = 0; ch < num_channels; ch++) {
+	    const float gain = 0.2f + 0.05f * static_cast<float>(ch);
+	    auto y = capture.View(/*band=*/0, ch);
+	    for (size_t k = 0; k < webrtc::kBlockSize; k++)
+		y[k] = gain * history.front()[k] + 30.f * Random(&seed);
+	}
+
+	render_delay_buffer->Insert(render);
+	render_delay_buffer->PrepareCaptureProcessing();
+	const webrtc::RenderBuffer &render_buffer = *render_delay_buffer->GetRenderBuffer();
+	render_signal_analyzer.Update(render_buffer, std::nullopt);
+	subtractor.Process(render_buffer, capture, render_signal_analyzer, aec_state, outputs);
+
+	for (const webrtc::SubtractorOutput &output : outputs) {
+	    result->insert(result->end(), output.e_refined.begin(), output.e_refined.end());
+	    result->insert(result->end(), output.e_coarse.begin(), output.e_coarse.end());
+	    result->insert(result->end(), output.E2_refined.begin(), output.E2_refined.end());
+	    result->insert(result->end(), output.E2_coarse.begin(), output.E2_coarse.end());
+	}
+    }
+
+    std::vector<std::vector<std::vector<webrtc::FftData>>> filters;
+    subtractor.GetFilters(&filters);
+    for (const auto &channel_filters : filters) {
+	for (const auto &partition : channel_filters) {
+	    for (const webrtc::FftData &H : partition) {
+		result->insert(result->end(), H.re.begin(), H.re.end());
+		result->insert(result->end(), H.im.begin(), H.im.end());
+	    }
+	}
+    }
+}
+
+static bool TestSubtractor() {
+    for (size_t num_channels = 1; num_channels <= MAX_CHANNELS; num_channels++) {
+	std::vector<float> serial;
+	Run(num_channels, nullptr, &serial);
+	for (int num_worker_threads : kNumWorkerThreads) {
+	    webrtc::ChannelWorkerPool pool(num_worker_threads);
+	    std::vector<float> parallel;
+	    Run(num_channels, &pool, &parallel);
+	    if (parallel != serial) {
+		std::cerr << num_channels << " channels on " << num_worker_threads
+			  << " worker threads differ from the serial processing" << std::endl;
+		return false;
+	    }
+	}
+    }
+    return true;
+}
+
+// Destroys each pool right after its only ParallelFor(), while the workers
+// may still be on their way back to waiting for work.
+static bool TestDestruction() {
+    for (int n = 0; n < NUM_DESTRUCTIONS; n++) {
+	const size_t num_channels = n % (MAX_CHANNELS + 1);
+	std::vector<std::atomic<int>> calls(num_channels);
+	{
+	    webrtc::ChannelWorkerPool pool(n % MAX_CHANNELS);
+	    pool.ParallelFor(num_channels, [&](size_t ch) { calls[ch]++; });
+	}
+	for (size_t ch = 0; ch < num_channels; ch++) {
+	    if (calls[ch] != 1) {
+		std::cerr << "Channel " << ch << " of " << num_channels << " processed "
+			  << calls[ch] << " times" << std::endl;
+		return false;
+	    }
+	}
+    }
+    return true;
+}
+
+int main() {
+    if (!TestSubtractor() || !TestDestruction())
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies that the render FFT history covers every filter partition, also
+// when the initial filters are longer than the final ones.
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include <webrtc/api/audio/echo_canceller3_config.h>
+#include <webrtc/modules/audio_processing/aec3/aec3_common.h>
+#include <webrtc/modules/audio_processing/aec3/block.h>
+#include <webrtc/modules/audio_processing/aec3/render_buffer.h>
+#include <webrtc/modules/audio_processing/aec3/render_delay_buffer.h>
+
+#define RATE 48000
+#define NUM_BLOCKS 200
+
+// Checks that the FFT of each partition read by a filter of `num_partitions`
+// partitions matches the spectrum stored for the same block.
+static bool CheckPartitions(const webrtc::RenderBuffer &render_buffer, size_t num_partitions) {
+    const auto ffts = render_buffer.GetFftBuffer();
+    if (ffts.size() < num_partitions) {
+	std::cerr << "FFT buffer holds " << ffts.size() << " partitions, "
+		  << num_partitions << " are needed" << std::endl;
+	return false;
+    }
+
+    const webrtc::Aec3Optimization optimization = webrtc::DetectOptimization();
+    std::array<float, webrtc::kFftLengthBy2Plus1> X2;
+    for (size_t k = 0; k < num_partitions; k++) {
+	const auto &X = ffts[(render_buffer.Position() + k) % ffts.size()][0];
+	X.Spectrum(optimization, X2);
+	if (X2 != render_buffer.Spectrum(k)[0]) {
+	    std::cerr << "FFT of partition " << k << " does not match its block" << std::endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+int main() {
+    webrtc::EchoCanceller3Config config;
+    config.filter.refined_initial.length_blocks = 20;
+    config.filter.coarse_initial.length_blocks = 18;
+    const size_t num_partitions = config.filter.refined_initial.length_blocks;
+
+    std::unique_ptr<webrtc::RenderDelayBuffer> render_delay_buffer(
+	webrtc::RenderDelayBuffer::Create(config, RATE, 1));
+    webrtc::Block block(webrtc::NumBandsForRate(RATE), 1);
+    uint32_t seed = 1;
+
+    for (int n = 0; n < NUM_BLOCKS; n++) {
+	for (int band = 0; band < block.NumBands(); band++) {
+	    for (float &x : block.View(band, 0)) {
+		seed = seed * 1664525u + 1013904223u;
+		x = 8000.f * (static_cast<float>(seed >> 8) / (1 << 23) - 1.f);
+	    }
+	}
+	render_delay_buffer->Insert(block);
+	render_delay_buffer->PrepareCaptureProcessing();
+	if (n >= static_cast<int>(num_partitions) &&
+	    !CheckPartitions(*render_delay_buffer->GetRenderBuffer(), num_partitions))
+	    return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
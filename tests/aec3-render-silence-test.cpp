@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies the render silence fast path: RenderDelayBuffer flags the render
+// buffer as silent once all of it is below the silence limit and clears the
+// flag with the first active block, the Subtractor leaves its filters
+// untouched while the flag is set, and the echo is removed again right after
+// the render signal returns.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <webrtc/api/audio/echo_canceller3_config.h>
+#include <webrtc/modules/audio_processing/aec3/aec3_common.h>
+#include <webrtc/modules/audio_processing/aec3/aec_state.h>
+#include <webrtc/modules/audio_processing/aec3/block.h>
+#include <webrtc/modules/audio_processing/aec3/render_delay_buffer.h>
+#include <webrtc/modules/audio_processing/aec3/render_signal_analyzer.h>
+#include <webrtc/modules/audio_processing/aec3/subtractor.h>
+#include <webrtc/modules/audio_processing/aec3/subtractor_output.h>
+#include <webrtc/modules/audio_processing/logging/apm_data_dumper.h>
+
+#define RATE 16000
+// The render buffer is read the default delay of 5 blocks behind, which puts
+// the echo 2 blocks into the filters.
+#define ECHO_DELAY_BLOCKS 7
+#define ACTIVE_BLOCKS 1000
+#define SILENT_BLOCKS 500
+#define RESUMED_BLOCKS 20
+// Echo return loss enhancement required right after the render signal
+// returns, in dB.
+#define MIN_ERLE_DB 20.0
+
+typedef std::vector<std::vector<std::vector<webrtc::FftData>>> Filters;
+
+// Returns a uniformly distributed value in [-1, 1).
+static float Random(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return static_cast<float>(*seed >> 8) / (1 << 23) - 1.f;
+}
+
+static bool SameFilters(const Filters &a, const Filters &b) {
+    for (size_t ch = 0; ch < a.size(); ch++) {
+	for (size_t p = 0; p < a[ch].size(); p++) {
+	    for (size_t k = 0; k < a[ch][p].size(); k++) {
+		if (a[ch][p][k].re != b[ch][p][k].re || a[ch][p][k].im != b[ch][p][k].im)
+		    return false;
+	    }
+	}
+    }
+    return a.size() == b.size();
+}
+
+// Feeds render blocks of the given amplitude and capture blocks that hold
+// their echo plus nearend noise through the render buffer and the Subtractor,
+// the same way as EchoRemover does with the fast path enabled.
+class EchoPath {
+  public:
+    EchoPath()
+	: config_(Config()),
+	  data_dumper_(0),
+	  render_delay_buffer_(webrtc::RenderDelayBuffer::Create(config_, RATE, 1)),
+	  render_signal_analyzer_(config_),
+	  aec_state_(config_, 1),
+	  subtractor_(config_, 1, 1, &data_dumper_, webrtc::DetectOptimization(), nullptr),
+	  render_(webrtc::NumBandsForRate(RATE), 1),
+	  capture_(webrtc::NumBandsForRate(RATE), 1),
+	  history_(ECHO_DELAY_BLOCKS + 1),
+	  outputs_(1) {}
+
+    // Processes one block and returns whether the render buffer was flagged
+    // as silent. `capture_energy` and `error_energy` are increased by the
+    // energies of the capture signal and the refined filter error.
+    bool ProcessBlock(float render_amplitude, float nearend_amplitude, double *capture_energy,
+		      double *error_energy) {
+	std::copy(history_.begin() + 1, history_.end(), history_.begin());
+	for (float &x : history_.back())
+	    x = render_amplitude * Random(&seed_);
+	std::copy(history_.back().begin(), history_.back().end(), render_.begin(0, 0));
+	auto y = capture_.View(/*band=*/0, 0);
+	for (size_t k = 0; k < webrtc::kBlockSize; k++)
+	    y[k] = 0.5f * history_.front()[k] + nearend_amplitude * Random(&seed_);
+
+	render_delay_buffer_->Insert(render_);
+	render_delay_buffer_->PrepareCaptureProcessing();
+	const webrtc::RenderBuffer &render_buffer = *render_delay_buffer_->GetRenderBuffer();
+	render_signal_analyzer_.Update(render_buffer, std::nullopt);
+	const bool silence = render_buffer.GetRenderSilence();
+	if (silence) {
+	    subtractor_.ProcessRenderSilence(capture_, outputs_);
+	    for (size_t k = 0; k < webrtc::kBlockSize; k++) {
+		if (outputs_[0].s_refined[k] != 0.f || outputs_[0].e_refined[k] != y[k])
+		    silence_output_mismatch_ = true;
+	    }
+	} else {
+	    subtractor_.Process(render_buffer, capture_, render_signal_analyzer_, aec_state_,
+				outputs_);
+	}
+
+	for (size_t k = 0; k < webrtc::kBlockSize; k++) {
+	    *capture_energy += static_cast<double>(y[k]) * y[k];
+	    *error_energy += static_cast<double>(outputs_[0].e_refined[k]) * outputs_[0].e_refined[k];
+	}
+	return silence;
+    }
+
+    Filters GetFilters() const {
+	Filters filters;
+	subtractor_.GetFilters(&filters);
+	return filters;
+    }
+
+    // Returns true if the outputs formed during render silence were not the
+    // capture signal with a zero echo estimate.
+    bool silence_output_mismatch() const { return silence_output_mismatch_; }
+
+    static webrtc::EchoCanceller3Config Config() {
+	webrtc::EchoCanceller3Config config;
+	config.echo_removal_control.skip_linear_processing_during_render_silence = true;
+	return config;
+    }
+
+  private:
+
+    const webrtc::EchoCanceller3Config config_;
+    webrtc::ApmDataDumper data_dumper_;
+    std::unique_ptr<webrtc::RenderDelayBuffer> render_delay_buffer_;
+    webrtc::RenderSignalAnalyzer render_signal_analyzer_;
+    webrtc::AecState aec_state_;
+    webrtc::Subtractor subtractor_;
+    webrtc::Block render_;
+    webrtc::Block capture_;
+    std::vector<std::array<float, webrtc::kBlockSize>> history_;
+    std::vector<webrtc::SubtractorOutput> outputs_;
+    uint32_t seed_ = 1;
+    bool silence_output_mismatch_ = false;
+};
+
+int main() {
+    EchoPath echo_path;
+    double capture_energy = 0.0, error_energy = 0.0;
+    for (int n = 0; n < ACTIVE_BLOCKS; n++) {
+	if (echo_path.ProcessBlock(8000.f, 10.f, &capture_energy, &error_energy)) {
+	    std::cerr << "Active render block " << n << " flagged as silent" << std::endl;
+	    return EXIT_FAILURE;
+	}
+    }
+
+    // Render below the silence limit of 1, with nearend noise that the
+    // adaptation would react to. The flag is only set once the silent blocks
+    // fill the render buffer, and the filters may adapt until then.
+    Filters silence_filters;
+    int first_silent_block = -1;
+    int num_silent_blocks = 0;
+    bool silence_cleared = false;
+    for (int n = 0; n < SILENT_BLOCKS; n++) {
+	const bool silence = echo_path.ProcessBlock(0.9f, 100.f, &capture_energy, &error_energy);
+	silence_cleared = silence_cleared || (num_silent_blocks > 0 && !silence);
+	if (silence && num_silent_blocks++ == 0) {
+	    first_silent_block = n;
+	    silence_filters = echo_path.GetFilters();
+	}
+    }
+    const int buffer_size = static_cast<int>(webrtc::GetRenderDelayBufferSize(
+	EchoPath::Config().delay.down_sampling_factor, EchoPath::Config().delay.num_filters,
+	EchoPath::Config().filter.refined.length_blocks));
+    if (first_silent_block != buffer_size - 1 || silence_cleared) {
+	std::cerr << "Render silence flagged from silent block " << first_silent_block
+		  << " instead of " << buffer_size - 1
+		  << (silence_cleared ? ", and cleared while silent" : "") << std::endl;
+	return EXIT_FAILURE;
+    }
+    if (echo_path.silence_output_mismatch()) {
+	std::cerr << "Outputs during render silence are not the capture signal" << std::endl;
+	return EXIT_FAILURE;
+    }
+    if (!SameFilters(echo_path.GetFilters(), silence_filters)) {
+	std::cerr << "Filters changed during " << num_silent_blocks << " blocks of render silence"
+		  << std::endl;
+	return EXIT_FAILURE;
+    }
+
+    capture_energy = error_energy = 0.0;
+    for (int n = 0; n < RESUMED_BLOCKS; n++) {
+	if (echo_path.ProcessBlock(8000.f, 10.f, &capture_energy, &error_energy)) {
+	    std::cerr << "Render silence not cleared by active block " << n << std::endl;
+	    return EXIT_FAILURE;
+	}
+    }
+    const double erle_db = 10.0 * std::log10(capture_energy / error_energy);
+    std::cout << "ERLE after the render silence: " << erle_db << " dB" << std::endl;
+    if (!(erle_db >= MIN_ERLE_DB))
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runs SuppressionGain and ComfortNoiseGenerator with each SIMD optimization
+// that the CPU supports next to instances using Aec3Optimization::kNone, on
+// identical input, and requires the suppression gains, the noise spectra and
+// the comfort noise to be bit-exact.
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <webrtc/api/audio/echo_canceller3_config.h>
+#include <webrtc/modules/audio_processing/aec3/aec3_common.h>
+#include <webrtc/modules/audio_processing/aec3/aec_state.h>
+#include <webrtc/modules/audio_processing/aec3/block.h>
+#include <webrtc/modules/audio_processing/aec3/comfort_noise_generator.h>
+#include <webrtc/modules/audio_processing/aec3/fft_data.h>
+#include <webrtc/modules/audio_processing/aec3/render_signal_analyzer.h>
+#include <webrtc/modules/audio_processing/aec3/suppression_gain.h>
+
+#define RATE 48000
+#define NUM_CHANNELS 2
+#define NUM_BLOCKS 1000
+#define SEGMENT_BLOCKS 100
+
+typedef std::array<float, webrtc::kFftLengthBy2Plus1> Spectrum;
+
+static const char *Name(webrtc::Aec3Optimization optimization) {
+    switch (optimization) {
+    case webrtc::Aec3Optimization::kSse2:
+	return "SSE2";
+    case webrtc::Aec3Optimization::kAvx2:
+	return "AVX2";
+    case webrtc::Aec3Optimization::kNeon:
+	return "Neon";
+    default:
+	return "none";
+    }
+}
+
+// Returns a uniformly distributed value in [0, 1).
+static float Random(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return static_cast<float>(*seed >> 8) / (1 << 24);
+}
+
+// Fills `spectrum` with a power spectrum around `level` that varies over the
+// bins.
+static void FillSpectrum(float level, uint32_t *seed, Spectrum *spectrum) {
+    for (float &x : *spectrum)
+	x = level * (0.1f + 2.f * Random(seed));
+}
+
+// Returns the index of the first element that differs, or -1.
+template <typename T>
+static int FirstMismatch(const T &a, const T &b) {
+    for (size_t k = 0; k < a.size(); k++) {
+	if (a[k] != b[k])
+	    return static_cast<int>(k);
+    }
+    return -1;
+}
+
+static bool Compare(webrtc::Aec3Optimization optimization) {
+    webrtc::EchoCanceller3Config config;
+    webrtc::AecState aec_state(config, NUM_CHANNELS);
+    webrtc::RenderSignalAnalyzer render_signal_analyzer(config);
+    webrtc::SuppressionGain scalar_gain(config, webrtc::Aec3Optimization::kNone, RATE,
+					NUM_CHANNELS);
+    webrtc::SuppressionGain gain(config, optimization, RATE, NUM_CHANNELS);
+    webrtc::ComfortNoiseGenerator scalar_noise(config, webrtc::Aec3Optimization::kNone,
+					       NUM_CHANNELS);
+    webrtc::ComfortNoiseGenerator noise(config, optimization, NUM_CHANNELS);
+
+    webrtc::Block render(webrtc::NumBandsForRate(RATE), NUM_CHANNELS);
+    std::vector<Spectrum> nearend(NUM_CHANNELS), echo(NUM_CHANNELS);
+    std::vector<Spectrum> residual_echo(NUM_CHANNELS), capture(NUM_CHANNELS);
+    std::vector<webrtc::FftData> scalar_lower(NUM_CHANNELS), scalar_upper(NUM_CHANNELS);
+    std::vector<webrtc::FftData> lower(NUM_CHANNELS), upper(NUM_CHANNELS);
+    uint32_t seed = 1;
+
+    for (int n = 0; n < NUM_BLOCKS; n++) {
+	// The segments move between echo only, nearend only, double talk and
+	// silence, and the render signal between loud and quiet.
+	const int segment = n / SEGMENT_BLOCKS;
+	const float nearend_level = segment % 4 == 1 || segment % 4 == 2 ? 1e7f : 1e3f;
+	const float echo_level = segment % 4 == 0 || segment % 4 == 2 ? 1e7f : 1e2f;
+	const float render_level = segment % 2 ? 30.f : 8000.f;
+	for (int band = 0; band < render.NumBands(); band++) {
+	    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+		for (float &x : render.View(band, ch))
+		    x = render_level * (2.f * Random(&seed) - 1.f);
+	    }
+	}
+	for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+	    FillSpectrum(nearend_level, &seed, &nearend[ch]);
+	    FillSpectrum(echo_level, &seed, &echo[ch]);
+	    FillSpectrum(echo_level * 0.1f, &seed, &residual_echo[ch]);
+	    for (size_t k = 0; k < capture[ch].size(); k++)
+		capture[ch][k] = nearend[ch][k] + echo[ch][k];
+	}
+
+	const bool saturated_capture = n % 97 == 0;
+	scalar_noise.Compute(saturated_capture, capture, scalar_lower, scalar_upper);
+	noise.Compute(saturated_capture, capture, lower, upper);
+	for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+	    int k = FirstMismatch(noise.NoiseSpectrum()[ch], scalar_noise.NoiseSpectrum()[ch]);
+	    if (k < 0) {
+		k = FirstMismatch(lower[ch].re, scalar_lower[ch].re);
+		k = k < 0 ? FirstMismatch(lower[ch].im, scalar_lower[ch].im) : k;
+		k = k < 0 ? FirstMismatch(upper[ch].re, scalar_upper[ch].re) : k;
+		k = k < 0 ? FirstMismatch(upper[ch].im, scalar_upper[ch].im) : k;
+	    }
+	    if (k >= 0) {
+		std::cerr << Name(optimization) << ": comfort noise of channel " << ch
+			  << " differs in block " << n << ", bin " << k << std::endl;
+		return false;
+	    }
+	}
+
+	// The gains are computed from the scalar noise spectrum, so that they
+	// only differ if the gain computation does.
+	const bool clock_drift = segment % 3 == 2;
+	float scalar_high_bands_gain, high_bands_gain;
+	Spectrum scalar_low_band_gain, low_band_gain;
+	scalar_gain.GetGain(nearend, echo, residual_echo, residual_echo,
+			    scalar_noise.NoiseSpectrum(), render_signal_analyzer, aec_state,
+			    render, clock_drift, &scalar_high_bands_gain, &scalar_low_band_gain);
+	gain.GetGain(nearend, echo, residual_echo, residual_echo, scalar_noise.NoiseSpectrum(),
+		     render_signal_analyzer, aec_state, render, clock_drift, &high_bands_gain,
+		     &low_band_gain);
+	const int k = FirstMismatch(low_band_gain, scalar_low_band_gain);
+	if (k >= 0 || high_bands_gain != scalar_high_bands_gain) {
+	    std::cerr << Name(optimization) << ": suppression gain differs in block " << n;
+	    if (k >= 0)
+		std::cerr << ", bin " << k << ": " << low_band_gain[k] << " instead of "
+			  << scalar_low_band_gain[k];
+	    std::cerr << std::endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+int main() {
+    const webrtc::Aec3Optimization detected = webrtc::DetectOptimization();
+    std::vector<webrtc::Aec3Optimization> optimizations;
+    if (detected == webrtc::Aec3Optimization::kSse2 ||
+	detected == webrtc::Aec3Optimization::kAvx2)
+	optimizations.push_back(webrtc::Aec3Optimization::kSse2);
+    if (detected != webrtc::Aec3Optimization::kSse2)
+	optimizations.push_back(detected);
+
+    for (webrtc::Aec3Optimization optimization : optimizations) {
+	if (optimization != webrtc::Aec3Optimization::kNone && !Compare(optimization))
+	    return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
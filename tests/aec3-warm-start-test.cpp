@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies that the echo canceller state exported through AudioProcessing
+// survives serialization and speeds up the convergence of a new instance.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <webrtc/modules/audio_processing/include/audio_processing.h>
+#include <webrtc/modules/audio_processing/aec3/echo_canceller3.h>
+#include <webrtc/modules/audio_processing/aec3/warm_start_state.h>
+
+#define RATE 16000
+#define FRAME_LENGTH (RATE / 100)
+#define ECHO_DELAY 320
+#define CONVERGENCE_FRAMES 500
+#define MEASURED_FRAMES 50
+
+// Creates AEC3 instances that export their linear filter output.
+class EchoCanceller3Factory : public webrtc::EchoControlFactory {
+  public:
+    EchoCanceller3Factory() {
+	config_.filter.export_linear_aec_output = true;
+    }
+
+    std::unique_ptr<webrtc::EchoControl> Create(int sample_rate_hz,
+						int num_render_channels,
+						int num_capture_channels) override {
+	return std::make_unique<webrtc::EchoCanceller3>(config_, std::nullopt,
+							sample_rate_hz, num_render_channels,
+							num_capture_channels);
+    }
+
+  private:
+    webrtc::EchoCanceller3Config config_;
+};
+
+// Feeds noise to the render side and its delayed echo to the capture side.
+class EchoPath {
+  public:
+    EchoPath() : history_(ECHO_DELAY + FRAME_LENGTH, 0) {}
+
+    // Processes the next 10 ms and returns the energy of the linear echo
+    // canceller output, which is not masked by the initial echo suppression.
+    double ProcessFrame(webrtc::AudioProcessing &apm) {
+	const webrtc::StreamConfig config(RATE, 1);
+	std::copy(history_.begin() + FRAME_LENGTH, history_.end(), history_.begin());
+	int16_t render[FRAME_LENGTH];
+	int16_t capture[FRAME_LENGTH];
+	for (int i = 0; i < FRAME_LENGTH; i++) {
+	    seed_ = seed_ * 1664525u + 1013904223u;
+	    render[i] = static_cast<int16_t>(seed_ >> 16) / 4;
+	    history_[ECHO_DELAY + i] = render[i];
+	    capture[i] = history_[i] / 2;
+	}
+	apm.ProcessReverseStream(render, config, config, render);
+	apm.set_stream_delay_ms(0);
+	apm.ProcessStream(capture, config, config, capture);
+
+	std::array<float, 160> linear_output;
+	apm.GetLinearAecOutput(rtc::ArrayView<std::array<float, 160>>(&linear_output, 1));
+	double energy = 0.0;
+	for (float x : linear_output)
+	    energy += static_cast<double>(x) * x;
+	return energy;
+    }
+
+  private:
+    std::vector<int16_t> history_;
+    uint32_t seed_ = 1;
+};
+
+static rtc::scoped_refptr<webrtc::AudioProcessing> CreateEchoCanceller() {
+    webrtc::AudioProcessing::Config config;
+    config.echo_canceller.enabled = true;
+    config.echo_canceller.export_linear_aec_output = true;
+    return webrtc::AudioProcessingBuilder()
+	.SetConfig(config)
+	.SetEchoControlFactory(std::make_unique<EchoCanceller3Factory>())
+	.Create();
+}
+
+// Returns the echo energy left by a new instance over its first frames, after
+// importing `state` if it is non-empty.
+static double InitialEchoEnergy(const std::vector<uint8_t> &state) {
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm = CreateEchoCanceller();
+    EchoPath echo_path;
+    echo_path.ProcessFrame(*apm);
+    if (!state.empty() && !apm->SetEchoCancellerWarmStartState(state)) {
+	std::cerr << "State rejected" << std::endl;
+	return -1.0;
+    }
+    double energy = 0.0;
+    for (int n = 0; n < MEASURED_FRAMES; n++)
+	energy += echo_path.ProcessFrame(*apm);
+    return energy;
+}
+
+int main() {
+    rtc::scoped_refptr<webrtc::AudioProcessing> source = CreateEchoCanceller();
+    EchoPath echo_path;
+    for (int n = 0; n < CONVERGENCE_FRAMES; n++)
+	echo_path.ProcessFrame(*source);
+    const std::vector<uint8_t> state = source->GetEchoCancellerWarmStartState();
+    if (state.empty()) {
+	std::cerr << "No echo canceller state" << std::endl;
+	return EXIT_FAILURE;
+    }
+
+    const std::optional<webrtc::Aec3WarmStartState> parsed =
+	webrtc::DeserializeWarmStartState(state);
+    if (!parsed || webrtc::SerializeWarmStartState(*parsed) != state) {
+	std::cerr << "State does not survive a serialization round trip" << std::endl;
+	return EXIT_FAILURE;
+    }
+
+    rtc::scoped_refptr<webrtc::AudioProcessing> target = CreateEchoCanceller();
+    EchoPath target_echo_path;
+    target_echo_path.ProcessFrame(*target);
+    const std::vector<uint8_t> truncated(state.begin(), state.end() - 1);
+    if (target->SetEchoCancellerWarmStartState(truncated) ||
+	target->SetEchoCancellerWarmStartState({})) {
+	std::cerr << "Malformed state accepted" << std::endl;
+	return EXIT_FAILURE;
+    }
+
+    // States that parse but hold values the echo canceller cannot use.
+    std::vector<webrtc::Aec3WarmStartState> invalid_states(5, *parsed);
+    invalid_states[0].erl[0] = std::numeric_limits<float>::quiet_NaN();
+    invalid_states[1].filters[0][0][0].re[1] = std::numeric_limits<float>::infinity();
+    invalid_states[2].reverb_decay = -std::numeric_limits<float>::infinity();
+    invalid_states[3].filters[0].resize(1000, invalid_states[3].filters[0][0]);
+    invalid_states[4].delay_blocks = 1000000;
+    for (const webrtc::Aec3WarmStartState &invalid_state : invalid_states) {
+	if (target->SetEchoCancellerWarmStartState(
+		webrtc::SerializeWarmStartState(invalid_state))) {
+	    std::cerr << "Out of range state accepted" << std::endl;
+	    return EXIT_FAILURE;
+	}
+    }
+
+    const double cold_energy = InitialEchoEnergy({});
+    const double warm_energy = InitialEchoEnergy(state);
+    std::cout << "Initial echo energy: cold " << cold_energy << ", warm " << warm_energy
+	      << std::endl;
+    // The imported filters should remove at least 6 dB more echo.
+    if (warm_energy < 0.0 || 4.0 * warm_energy >= cold_energy)
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
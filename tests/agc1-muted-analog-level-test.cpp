@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies that AGC1 in the adaptive analog mode keeps recommending input
+// volumes while the capture output is muted, the same as while it is used.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <webrtc/modules/audio_processing/include/audio_processing.h>
+
+#define RATE 48000
+#define FRAME_LENGTH (RATE / 100)
+#define NUM_FRAMES 1000
+#define SEGMENT_FRAMES 200
+#define INITIAL_LEVEL 128
+
+static rtc::scoped_refptr<webrtc::AudioProcessing> CreateApm(bool muted) {
+    webrtc::AudioProcessing::Config config;
+    // The high-pass filter is bypassed while muted, so it would change what
+    // AGC1 analyzes.
+    config.high_pass_filter.enabled = false;
+    config.gain_controller1.enabled = true;
+    config.gain_controller1.mode = webrtc::AudioProcessing::Config::GainController1::kAdaptiveAnalog;
+    config.gain_controller1.analog_gain_controller.enabled = false;
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm =
+	webrtc::AudioProcessingBuilder().SetConfig(config).Create();
+    apm->set_output_will_be_muted(muted);
+    return apm;
+}
+
+// Fills `frame` with noise that alternates between loud and quiet segments,
+// which makes AGC1 move the input volume both ways.
+static void FillFrame(int index, uint32_t *seed, std::vector<int16_t> *frame) {
+    const int shift = (index / SEGMENT_FRAMES) % 2 ? 9 : 1;
+    for (int16_t &sample : *frame) {
+	*seed = *seed * 1664525u + 1013904223u;
+	sample = static_cast<int16_t>(static_cast<int32_t>(*seed) >> 16) >> shift;
+    }
+}
+
+int main() {
+    rtc::scoped_refptr<webrtc::AudioProcessing> used = CreateApm(false);
+    rtc::scoped_refptr<webrtc::AudioProcessing> muted = CreateApm(true);
+    const webrtc::StreamConfig stream_config(RATE, 1);
+
+    uint32_t seed = 1;
+    std::vector<int16_t> frame(FRAME_LENGTH);
+    int used_level = INITIAL_LEVEL;
+    int muted_level = INITIAL_LEVEL;
+    int num_level_changes = 0;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+	FillFrame(i, &seed, &frame);
+	std::vector<int16_t> used_frame = frame;
+	std::vector<int16_t> muted_frame = frame;
+
+	used->set_stream_analog_level(used_level);
+	muted->set_stream_analog_level(muted_level);
+	if (used->ProcessStream(used_frame.data(), stream_config, stream_config,
+				used_frame.data()) != webrtc::AudioProcessing::kNoError ||
+	    muted->ProcessStream(muted_frame.data(), stream_config, stream_config,
+				 muted_frame.data()) != webrtc::AudioProcessing::kNoError) {
+	    std::cerr << "ProcessStream failed in frame " << i << std::endl;
+	    return EXIT_FAILURE;
+	}
+
+	const int new_level = muted->recommended_stream_analog_level();
+	if (new_level != used->recommended_stream_analog_level()) {
+	    std::cerr << "Frame " << i << ": muted level " << new_level << " instead of "
+		      << used->recommended_stream_analog_level() << std::endl;
+	    return EXIT_FAILURE;
+	}
+	num_level_changes += new_level != muted_level;
+	used_level = muted_level = new_level;
+    }
+
+    if (num_level_changes == 0) {
+	std::cerr << "The recommended level never changed" << std::endl;
+	return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares AudioConverter with a mix matrix against remixing followed by
+// mono resampling, for downmixes that resample after the remix and upmixes
+// that resample before it. With --bad-matrix, creates a converter with a mix
+// matrix of the wrong size, which is expected to crash.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <webrtc/common_audio/audio_converter.h>
+
+#define NUM_CHUNKS 20
+
+typedef std::vector<std::vector<float>> Channels;
+
+// Returns pseudo-random samples in [-1, 1).
+static std::vector<float> Noise(size_t length, uint32_t *seed) {
+    std::vector<float> values(length);
+    for (float &value : values) {
+	*seed = *seed * 1664525u + 1013904223u;
+	value = static_cast<int32_t>(*seed) / 2147483648.f;
+    }
+    return values;
+}
+
+static std::vector<float *> Pointers(Channels &channels) {
+    std::vector<float *> pointers;
+    for (std::vector<float> &channel : channels)
+	pointers.push_back(channel.data());
+    return pointers;
+}
+
+static std::vector<float> MixMatrix(size_t src_channels, size_t dst_channels) {
+    std::vector<float> matrix(src_channels * dst_channels);
+    for (size_t k = 0; k < matrix.size(); k++)
+	matrix[k] = static_cast<float>((k * 7) % 11) / 10.f - 0.3f;
+    return matrix;
+}
+
+static bool TestMixMatrix(size_t src_channels, size_t src_frames, size_t dst_channels,
+			  size_t dst_frames) {
+    const std::vector<float> matrix = MixMatrix(src_channels, dst_channels);
+    std::unique_ptr<webrtc::AudioConverter> converter = webrtc::AudioConverter::Create(
+	src_channels, src_frames, dst_channels, dst_frames, matrix);
+    // The reference resamples each remixed channel on its own.
+    std::vector<std::unique_ptr<webrtc::AudioConverter>> resamplers;
+    for (size_t ch = 0; ch < dst_channels; ch++)
+	resamplers.push_back(webrtc::AudioConverter::Create(1, src_frames, 1, dst_frames));
+
+    uint32_t seed = 1;
+    float max_error = 0.f;
+    for (int chunk = 0; chunk < NUM_CHUNKS; chunk++) {
+	Channels src(src_channels);
+	for (std::vector<float> &channel : src)
+	    channel = Noise(src_frames, &seed);
+	Channels dst(dst_channels, std::vector<float>(dst_frames));
+	std::vector<float *> src_pointers = Pointers(src);
+	std::vector<float *> dst_pointers = Pointers(dst);
+	converter->Convert(src_pointers.data(), src_channels * src_frames, dst_pointers.data(),
+			   dst_channels * dst_frames);
+
+	for (size_t i = 0; i < dst_channels; i++) {
+	    std::vector<float> mixed(src_frames);
+	    for (size_t n = 0; n < src_frames; n++) {
+		double sum = 0.0;
+		for (size_t j = 0; j < src_channels; j++)
+		    sum += static_cast<double>(matrix[i * src_channels + j]) * src[j][n];
+		mixed[n] = static_cast<float>(sum);
+	    }
+	    std::vector<float> expected(dst_frames);
+	    const float *mixed_pointer = mixed.data();
+	    float *expected_pointer = expected.data();
+	    resamplers[i]->Convert(&mixed_pointer, src_frames, &expected_pointer, dst_frames);
+	    for (size_t n = 0; n < dst_frames; n++)
+		max_error = std::max(max_error, std::fabs(dst[i][n] - expected[n]));
+	}
+    }
+
+    if (max_error > 1e-5f) {
+	std::cerr << src_channels << "x" << src_frames << " -> " << dst_channels << "x"
+		  << dst_frames << ": error " << max_error << std::endl;
+	return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--bad-matrix") == 0) {
+	const std::vector<float> matrix = MixMatrix(8, 2);
+	webrtc::AudioConverter::Create(8, 480, 2, 160,
+				       rtc::ArrayView<const float>(matrix.data(), matrix.size() - 1));
+	return EXIT_SUCCESS;
+    }
+
+    // Downmixes resample after the remix, upmixes before it.
+    if (!TestMixMatrix(8, 480, 2, 160) || !TestMixMatrix(8, 160, 2, 480) ||
+	!TestMixMatrix(8, 480, 2, 480) || !TestMixMatrix(6, 441, 1, 160) ||
+	!TestMixMatrix(6, 160, 1, 441) || !TestMixMatrix(2, 480, 6, 160) ||
+	!TestMixMatrix(1, 160, 6, 960))
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies that the view-based ProcessAudioFrame() and
+// ProcessReverseAudioFrame() overloads process caller-owned frames in place,
+// and that the float overloads reject more than kMaxConcurrentChannels
+// channels.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <webrtc/api/audio/audio_processing.h>
+#include <webrtc/api/audio/audio_view.h>
+#include <webrtc/api/audio/channel_layout.h>
+#include <webrtc/modules/audio_processing/audio_buffer.h>
+#include <webrtc/modules/audio_processing/include/audio_frame_proxies.h>
+
+#define RATE 48000
+#define FRAME_LENGTH (RATE / 100)
+#define NUM_CHANNELS 2
+
+// Doubles every sample, which makes the processing visible in the output.
+class Doubler : public webrtc::CustomProcessing {
+  public:
+    void Initialize(int sample_rate_hz, int num_channels) override {}
+
+    void Process(webrtc::AudioBuffer *audio) override {
+	for (size_t ch = 0; ch < audio->num_channels(); ch++) {
+	    float *channel = audio->channels()[ch];
+	    for (size_t i = 0; i < audio->num_frames(); i++)
+		channel[i] *= 2.f;
+	}
+    }
+
+    std::string ToString() const override { return "Doubler"; }
+};
+
+static rtc::scoped_refptr<webrtc::AudioProcessing> CreateDoublingApm() {
+    return webrtc::AudioProcessingBuilder()
+	.SetCapturePostProcessing(std::make_unique<Doubler>())
+	.SetRenderPreProcessing(std::make_unique<Doubler>())
+	.Create();
+}
+
+static bool CheckResult(int result, int expected_result, const char *description) {
+    if (result != expected_result) {
+	std::cerr << description << " returned " << result << " instead of " << expected_result
+		  << std::endl;
+	return false;
+    }
+    return true;
+}
+
+static bool TestInt16(bool reverse) {
+    const char *description = reverse ? "int16 ProcessReverseAudioFrame" : "int16 ProcessAudioFrame";
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm = CreateDoublingApm();
+    std::vector<int16_t> samples(FRAME_LENGTH * NUM_CHANNELS);
+    for (size_t i = 0; i < samples.size(); i++)
+	samples[i] = static_cast<int16_t>(i % 2000) - 1000;
+    const std::vector<int16_t> input = samples;
+
+    webrtc::InterleavedView<int16_t> frame(samples.data(), FRAME_LENGTH, NUM_CHANNELS);
+    const int result = reverse ? webrtc::ProcessReverseAudioFrame(apm.get(), frame)
+			       : webrtc::ProcessAudioFrame(apm.get(), frame);
+    if (!CheckResult(result, webrtc::AudioProcessing::kNoError, description))
+	return false;
+    for (size_t i = 0; i < samples.size(); i++) {
+	if (std::abs(samples[i] - 2 * input[i]) > 1) {
+	    std::cerr << description << ": sample " << i << " is " << samples[i]
+		      << " instead of " << 2 * input[i] << std::endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+static bool TestFloat(bool reverse) {
+    const char *description = reverse ? "float ProcessReverseAudioFrame" : "float ProcessAudioFrame";
+    rtc::scoped_refptr<webrtc::AudioProcessing> apm = CreateDoublingApm();
+    std::vector<float> samples(FRAME_LENGTH * NUM_CHANNELS);
+    for (size_t i = 0; i < samples.size(); i++)
+	samples[i] = static_cast<float>(i % 200) / 400.f - 0.25f;
+    const std::vector<float> input = samples;
+
+    webrtc::DeinterleavedView<float> frame(samples.data(), FRAME_LENGTH, NUM_CHANNELS);
+    int result = reverse ? webrtc::ProcessReverseAudioFrame(apm.get(), frame)
+			 : webrtc::ProcessAudioFrame(apm.get(), frame);
+    if (!CheckResult(result, webrtc::AudioProcessing::kNoError, description))
+	return false;
+    for (size_t i = 0; i < samples.size(); i++) {
+	if (std::fabs(samples[i] - 2.f * input[i]) > 1e-4f) {
+	    std::cerr << description << ": sample " << i << " is " << samples[i]
+		      << " instead of " << 2.f * input[i] << std::endl;
+	    return false;
+	}
+    }
+
+    const size_t num_channels = webrtc::kMaxConcurrentChannels + 1;
+    std::vector<float> too_many_channels(FRAME_LENGTH * num_channels);
+    webrtc::DeinterleavedView<float> large_frame(too_many_channels.data(), FRAME_LENGTH,
+						 num_channels);
+    result = reverse ? webrtc::ProcessReverseAudioFrame(apm.get(), large_frame)
+		     : webrtc::ProcessAudioFrame(apm.get(), large_frame);
+    return CheckResult(result, webrtc::AudioProcessing::kBadNumberChannelsError, description);
+}
+
+int main() {
+    if (!TestInt16(false) || !TestInt16(true) || !TestFloat(false) || !TestFloat(true))
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
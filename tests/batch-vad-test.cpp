@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the decisions of BatchVad frame by frame with one WebRtcVad
+// instance per stream, for all modes, sample rates and frame lengths, stream
+// counts below, at and above one SIMD vector, and stream resets.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <webrtc/common_audio/vad/include/batch_vad.h>
+#include <webrtc/common_audio/vad/include/webrtc_vad.h>
+
+#define NUM_FRAMES 120
+#define SEGMENT_MS 400
+#define RESET_FRAME 70
+
+static const double kPi = 3.14159265358979323846;
+
+static const int kSampleRates[] = {8000, 16000, 32000, 48000};
+static const int kFrameDurationsMs[] = {10, 20, 30};
+static const size_t kNumStreams[] = {1, 5, 8, 11};
+
+// Returns `length` samples that alternate between a modulated harmonic
+// signal, noise and near silence, at a level that differs between streams.
+static std::vector<int16_t> Signal(size_t length, int sample_rate_hz, size_t stream) {
+    std::vector<int16_t> samples(length);
+    uint32_t seed = static_cast<uint32_t>(stream) * 7919u + 1u;
+    const double gain = 0.3 + 0.15 * static_cast<double>(stream % 5);
+    for (size_t n = 0; n < length; n++) {
+	seed = seed * 1664525u + 1013904223u;
+	const double noise = static_cast<int32_t>(seed) / 2147483648.0;
+	const double t = static_cast<double>(n) / sample_rate_hz;
+	double value;
+	switch ((n / (sample_rate_hz / 1000 * SEGMENT_MS) + stream) % 3) {
+	case 0:
+	    value = 0.5 * (1.0 + std::sin(2.0 * kPi * 4.0 * t)) *
+		    (std::sin(2.0 * kPi * 180.0 * t) + 0.5 * std::sin(2.0 * kPi * 540.0 * t) +
+		     0.25 * std::sin(2.0 * kPi * 1260.0 * t));
+	    value += 0.05 * noise;
+	    break;
+	case 1:
+	    value = 0.4 * noise;
+	    break;
+	default:
+	    value = 0.002 * noise;
+	    break;
+	}
+	samples[n] = static_cast<int16_t>(std::lround(gain * 16000.0 * value));
+    }
+    return samples;
+}
+
+// Returns the number of mismatching decisions, or -1 on errors.
+static int Compare(webrtc::Vad::Aggressiveness mode, int sample_rate_hz, size_t frame_length,
+		   size_t num_streams, size_t *num_active) {
+    std::unique_ptr<webrtc::BatchVad> batch_vad =
+	webrtc::CreateBatchVad(num_streams, mode, sample_rate_hz, frame_length);
+    if (!batch_vad)
+	return -1;
+
+    std::vector<std::vector<int16_t>> signals;
+    std::vector<VadInst *> instances;
+    for (size_t s = 0; s < num_streams; s++) {
+	signals.push_back(Signal(NUM_FRAMES * frame_length, sample_rate_hz, s));
+	VadInst *instance = WebRtcVad_Create();
+	if (WebRtcVad_Init(instance) != 0 || WebRtcVad_set_mode(instance, mode) != 0)
+	    return -1;
+	instances.push_back(instance);
+    }
+
+    int mismatches = 0;
+    // Feeds the frames in batches of varying size.
+    size_t frame = 0;
+    for (size_t batch_frames = 1; frame < NUM_FRAMES; batch_frames = batch_frames % 9 + 1) {
+	if (frame + batch_frames > NUM_FRAMES)
+	    batch_frames = NUM_FRAMES - frame;
+	// Every third stream starts over at a fixed frame.
+	if (frame < RESET_FRAME && RESET_FRAME < frame + batch_frames)
+	    batch_frames = RESET_FRAME - frame;
+	if (frame == RESET_FRAME) {
+	    for (size_t s = 0; s < num_streams; s += 3) {
+		batch_vad->Reset(s);
+		WebRtcVad_Init(instances[s]);
+		WebRtcVad_set_mode(instances[s], mode);
+	    }
+	}
+
+	std::vector<int16_t> audio;
+	for (size_t s = 0; s < num_streams; s++) {
+	    audio.insert(audio.end(), signals[s].begin() + frame * frame_length,
+			 signals[s].begin() + (frame + batch_frames) * frame_length);
+	}
+	std::vector<uint8_t> decisions(num_streams * batch_frames);
+	if (!batch_vad->Process(audio, batch_frames, decisions))
+	    return -1;
+
+	for (size_t s = 0; s < num_streams; s++) {
+	    for (size_t k = 0; k < batch_frames; k++) {
+		const int expected =
+		    WebRtcVad_Process(instances[s], sample_rate_hz,
+				      &signals[s][(frame + k) * frame_length], frame_length);
+		if (expected < 0)
+		    return -1;
+		const int decision = decisions[s * batch_frames + k];
+		*num_active += decision;
+		if (decision != expected) {
+		    if (mismatches == 0) {
+			std::cerr << "Mode " << mode << ", " << sample_rate_hz << " Hz, "
+				  << frame_length << " samples, " << num_streams
+				  << " streams: stream " << s << " frame " << frame + k
+				  << " is " << decision << " instead of " << expected
+				  << std::endl;
+		    }
+		    mismatches++;
+		}
+	    }
+	}
+	frame += batch_frames;
+    }
+
+    for (VadInst *instance : instances)
+	WebRtcVad_Free(instance);
+    return mismatches;
+}
+
+int main() {
+    const webrtc::Vad::Aggressiveness modes[] = {
+	webrtc::Vad::kVadNormal, webrtc::Vad::kVadLowBitrate, webrtc::Vad::kVadAggressive,
+	webrtc::Vad::kVadVeryAggressive};
+    size_t num_decisions = 0;
+    size_t num_active = 0;
+    int mismatches = 0;
+    for (webrtc::Vad::Aggressiveness mode : modes) {
+	for (int sample_rate_hz : kSampleRates) {
+	    for (int duration_ms : kFrameDurationsMs) {
+		const size_t frame_length = sample_rate_hz / 1000 * duration_ms;
+		for (size_t num_streams : kNumStreams) {
+		    const int result = Compare(mode, sample_rate_hz, frame_length, num_streams,
+					       &num_active);
+		    if (result < 0) {
+			std::cerr << "Mode " << mode << ", " << sample_rate_hz << " Hz, "
+				  << frame_length << " samples: processing failed"
+				  << std::endl;
+			return EXIT_FAILURE;
+		    }
+		    mismatches += result;
+		    num_decisions += num_streams * NUM_FRAMES;
+		}
+	    }
+	}
+    }
+
+    std::cout << mismatches << " of " << num_decisions << " decisions differ, "
+	      << num_active << " are active" << std::endl;
+    // Both decisions have to occur for the comparison to mean anything.
+    if (mismatches != 0 || num_active == 0 || num_active == num_decisions)
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
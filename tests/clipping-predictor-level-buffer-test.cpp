@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Checks the windows tracked by ClippingPredictorLevelBuffer against
+// ComputePartialMetrics() for random capacities, windows, levels and resets.
+// The maxima have to be identical and the averages equal up to a relative
+// error of TOLERANCE.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include <webrtc/modules/audio_processing/agc2/clipping_predictor_level_buffer.h>
+
+#define NUM_BUFFERS 300
+#define MAX_WINDOWS 6
+#define MAX_PUSHES 2000
+#define TOLERANCE 1e-5
+
+typedef webrtc::ClippingPredictorLevelBuffer LevelBuffer;
+
+static uint32_t Random(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+// Returns a level in [0, 1) that is often zero or repeats the previous maximum,
+// which exercises equal maxima in the candidate queue.
+static LevelBuffer::Level RandomLevel(uint32_t *seed, float previous_max) {
+    const float a = static_cast<float>(Random(seed)) / (1 << 24);
+    const float b = static_cast<float>(Random(seed)) / (1 << 24);
+    switch (Random(seed) % 5) {
+    case 0:
+	return {0.f, 0.f};
+    case 1:
+	return {std::min(a, previous_max), previous_max};
+    case 2:
+	return {1e-6f * a, 1e-6f * std::max(a, b)};
+    default:
+	return {std::min(a, b), std::max(a, b)};
+    }
+}
+
+static bool Check(const LevelBuffer &buffer, int window, int delay, int num_items,
+		  int64_t *num_checks) {
+    const std::optional<LevelBuffer::Level> tracked = buffer.GetWindowMetrics(window);
+    const std::optional<LevelBuffer::Level> expected =
+	buffer.ComputePartialMetrics(delay, num_items);
+    ++*num_checks;
+    if (tracked.has_value() != expected.has_value()) {
+	std::cerr << "Window " << delay << "+" << num_items << " at size " << buffer.Size()
+		  << (tracked ? " has metrics" : " has no metrics") << std::endl;
+	return false;
+    }
+    if (!tracked)
+	return true;
+    const double error = std::fabs(static_cast<double>(tracked->average) - expected->average);
+    if (tracked->max != expected->max ||
+	!(error <= TOLERANCE * std::max(static_cast<double>(expected->average), 1e-6))) {
+	std::cerr << "Window " << delay << "+" << num_items << " at size " << buffer.Size()
+		  << ": average " << tracked->average << ", max " << tracked->max
+		  << " instead of " << expected->average << ", " << expected->max << std::endl;
+	return false;
+    }
+    return true;
+}
+
+int main() {
+    uint32_t seed = 1;
+    int64_t num_checks = 0;
+    for (int n = 0; n < NUM_BUFFERS; n++) {
+	const int capacity = 1 + static_cast<int>(Random(&seed) % LevelBuffer::kMaxCapacity);
+	LevelBuffer buffer(capacity);
+	const int num_windows = 1 + static_cast<int>(Random(&seed) % MAX_WINDOWS);
+	std::vector<int> delays, lengths, windows;
+	for (int w = 0; w < num_windows; w++) {
+	    const int num_items = 1 + static_cast<int>(Random(&seed) % capacity);
+	    const int delay = static_cast<int>(Random(&seed) % (capacity - num_items + 1));
+	    windows.push_back(buffer.AddWindow(delay, num_items));
+	    delays.push_back(delay);
+	    lengths.push_back(num_items);
+	}
+
+	const int num_pushes = static_cast<int>(Random(&seed) % MAX_PUSHES);
+	float previous_max = 0.f;
+	for (int p = 0; p < num_pushes; p++) {
+	    if (Random(&seed) % 500 == 0)
+		buffer.Reset();
+	    const LevelBuffer::Level level = RandomLevel(&seed, previous_max);
+	    previous_max = level.max;
+	    buffer.Push(level);
+	    for (int w = 0; w < num_windows; w++) {
+		if (!Check(buffer, windows[w], delays[w], lengths[w], &num_checks)) {
+		    std::cerr << "Capacity " << capacity << ", push " << p << std::endl;
+		    return EXIT_FAILURE;
+		}
+	    }
+	}
+    }
+    std::cout << num_checks << " checks passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the partitioned FFT FIR filter with a direct-form convolution, for
+// single and multiple channels, input chunks of varying length and in-place
+// filtering.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <webrtc/common_audio/fir_filter.h>
+#include <webrtc/common_audio/fir_filter_factory.h>
+#include <webrtc/common_audio/fir_filter_fft.h>
+
+#define NUM_SAMPLES 5000
+#define MAX_CHUNK_LENGTH 480
+#define NUM_CHANNELS 3
+
+// Returns uniformly distributed pseudo-random values in [-1, 1).
+static std::vector<float> Noise(size_t length, uint32_t seed) {
+    std::vector<float> values(length);
+    for (float &value : values) {
+	seed = seed * 1664525u + 1013904223u;
+	value = static_cast<int32_t>(seed) / 2147483648.f;
+    }
+    return values;
+}
+
+// Convolves `in` with `coefficients` in double precision.
+static std::vector<float> DirectForm(const std::vector<float> &coefficients,
+				     const std::vector<float> &in) {
+    std::vector<float> out(in.size());
+    for (size_t n = 0; n < in.size(); n++) {
+	double sum = 0.0;
+	for (size_t k = 0; k < coefficients.size() && k <= n; k++)
+	    sum += static_cast<double>(coefficients[k]) * in[n - k];
+	out[n] = static_cast<float>(sum);
+    }
+    return out;
+}
+
+// Returns the lengths of the consecutive chunks the input is fed in, which
+// include empty chunks and chunks crossing several filter blocks.
+static std::vector<size_t> ChunkLengths() {
+    std::vector<size_t> lengths;
+    size_t total = 0;
+    for (size_t k = 0; total < NUM_SAMPLES; k++) {
+	const size_t length =
+	    std::min<size_t>((k * 97) % (MAX_CHUNK_LENGTH + 1), NUM_SAMPLES - total);
+	lengths.push_back(length);
+	total += length;
+    }
+    return lengths;
+}
+
+// Checks that `out` matches `expected` within the float rounding of a sum of
+// `coefficients.size()` products.
+static bool Matches(const std::vector<float> &coefficients,
+		    const std::vector<float> &expected, const std::vector<float> &out,
+		    const char *description) {
+    float coefficients_norm = 0.f;
+    for (float c : coefficients)
+	coefficients_norm += std::fabs(c);
+    const float tolerance = 1e-5f * coefficients_norm;
+    for (size_t n = 0; n < expected.size(); n++) {
+	if (!(std::fabs(out[n] - expected[n]) <= tolerance)) {
+	    std::cerr << description << " with " << coefficients.size()
+		      << " coefficients: sample " << n << " is " << out[n] << " instead of "
+		      << expected[n] << std::endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+static bool TestSingleChannel(const std::vector<float> &coefficients) {
+    const std::vector<float> in = Noise(NUM_SAMPLES, 1);
+    const std::vector<float> expected = DirectForm(coefficients, in);
+
+    std::unique_ptr<webrtc::FIRFilter> filter(
+	webrtc::CreateFirFilter(coefficients.data(), coefficients.size(), MAX_CHUNK_LENGTH));
+    std::vector<float> out(NUM_SAMPLES);
+    size_t position = 0;
+    for (size_t length : ChunkLengths()) {
+	filter->Filter(&in[position], length, &out[position]);
+	position += length;
+    }
+    if (!Matches(coefficients, expected, out, "CreateFirFilter"))
+	return false;
+
+    // The same, with the output written over the input.
+    filter.reset(
+	webrtc::CreateFirFilter(coefficients.data(), coefficients.size(), MAX_CHUNK_LENGTH));
+    std::vector<float> in_place = in;
+    position = 0;
+    for (size_t length : ChunkLengths()) {
+	filter->Filter(&in_place[position], length, &in_place[position]);
+	position += length;
+    }
+    return Matches(coefficients, expected, in_place, "In-place filtering");
+}
+
+static bool TestMultiChannel(const std::vector<float> &coefficients) {
+    std::vector<std::vector<float>> in(NUM_CHANNELS);
+    std::vector<std::vector<float>> out(NUM_CHANNELS, std::vector<float>(NUM_SAMPLES));
+    for (size_t ch = 0; ch < NUM_CHANNELS; ch++)
+	in[ch] = Noise(NUM_SAMPLES, static_cast<uint32_t>(ch + 2));
+
+    // The first channel is filtered in place.
+    out[0] = in[0];
+    webrtc::FIRFilterFFT filter(coefficients.data(), coefficients.size(), MAX_CHUNK_LENGTH,
+				NUM_CHANNELS);
+    size_t position = 0;
+    for (size_t length : ChunkLengths()) {
+	const float *in_pointers[NUM_CHANNELS];
+	float *out_pointers[NUM_CHANNELS];
+	for (size_t ch = 0; ch < NUM_CHANNELS; ch++) {
+	    in_pointers[ch] = ch == 0 ? &out[0][position] : &in[ch][position];
+	    out_pointers[ch] = &out[ch][position];
+	}
+	filter.Filter(in_pointers, length, out_pointers);
+	position += length;
+    }
+
+    for (size_t ch = 0; ch < NUM_CHANNELS; ch++) {
+	if (!Matches(coefficients, DirectForm(coefficients, in[ch]), out[ch],
+		     "Multichannel filtering"))
+	    return false;
+    }
+    return true;
+}
+
+int main() {
+    // Lengths around the block size, the threshold of CreateFirFilter() and
+    // long filters with a partial last partition.
+    const size_t lengths[] = {129, 255, 256, 257, 1000, 4096};
+    for (size_t length : lengths) {
+	std::vector<float> coefficients = Noise(length, static_cast<uint32_t>(length));
+	// Make the coefficients decay like a room response.
+	for (size_t k = 0; k < length; k++)
+	    coefficients[k] *= std::exp(-3.f * k / length);
+	if (!TestSingleChannel(coefficients) || !TestMultiChannel(coefficients))
+	    return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the SSE2/Neon iSAC pitch analysis used by the pitch-based VAD with
+// the scalar code, built next to it with the names from isac-scalar-names.h.
+// It covers the split filterbank, the weighting filter with its all-pole
+// filters, the autocorrelation and the pitch analysis with its pitch filters.
+// The vector code keeps the scalar order of accumulation, so the outputs are
+// expected to match exactly; the test allows a relative error of
+// TOLERANCE.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+#include <webrtc/modules/audio_coding/codecs/isac/main/source/filter_functions.h>
+#include <webrtc/modules/audio_coding/codecs/isac/main/source/isac_vad.h>
+#include <webrtc/modules/audio_coding/codecs/isac/main/source/pitch_estimator.h>
+#include <webrtc/modules/audio_coding/codecs/isac/main/source/structs.h>
+
+void WebRtcIsacScalar_AutoCorr(double *r, const double *x, size_t N, size_t order);
+void WebRtcIsacScalar_InitPitchAnalysis(PitchAnalysisStruct *State);
+void WebRtcIsacScalar_InitPreFilterbank(PreFiltBankstr *prefiltdata);
+void WebRtcIsacScalar_PitchAnalysis(const double *in, double *out, PitchAnalysisStruct *State,
+				    double *lags, double *gains);
+void WebRtcIsacScalar_SplitAndFilterFloat(float *in, float *LP, float *HP, double *LP_la,
+					  double *HP_la, PreFiltBankstr *prefiltdata);
+void WebRtcIsacScalar_WeightingFilter(const double *in, double *weiout, double *whiout,
+				      WeightFiltstr *wfdata);
+}
+
+#define RATE 16000
+#define NUM_FRAMES 150
+#define TOLERANCE 1e-12
+
+static const double kPi = 3.14159265358979323846;
+
+// Tracks the largest relative difference between the optimized and the
+// scalar outputs.
+class Comparison {
+  public:
+    template <typename T>
+    void Add(const T *optimized, const T *scalar, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+	    const double difference = std::fabs(static_cast<double>(optimized[i]) - scalar[i]);
+	    const double error = difference / std::max(1.0, std::fabs(static_cast<double>(scalar[i])));
+	    // NaN counts as a mismatch.
+	    max_error_ = !(error <= max_error_) ? error : max_error_;
+	}
+    }
+
+    bool Check(const char *description) const {
+	if (!(max_error_ <= TOLERANCE)) {
+	    std::cerr << description << ": relative error " << max_error_ << std::endl;
+	    return false;
+	}
+	return true;
+    }
+
+  private:
+    double max_error_ = 0.0;
+};
+
+// Returns a voiced signal with a gliding pitch, interrupted by noise and near
+// silence, at 16 kHz.
+static std::vector<float> Signal(size_t length) {
+    std::vector<float> samples(length);
+    uint32_t seed = 1;
+    double phase = 0.0;
+    for (size_t n = 0; n < length; n++) {
+	seed = seed * 1664525u + 1013904223u;
+	const double noise = static_cast<int32_t>(seed) / 2147483648.0;
+	const double t = static_cast<double>(n) / RATE;
+	const double pitch_hz = 110.0 + 90.0 * std::sin(2.0 * kPi * 0.7 * t);
+	phase += 2.0 * kPi * pitch_hz / RATE;
+	double value = 0.0;
+	switch ((n / (RATE / 2)) % 3) {
+	case 0:
+	case 1:
+	    for (int harmonic = 1; harmonic <= 8; harmonic++)
+		value += std::sin(harmonic * phase) / harmonic;
+	    value = 0.4 * value + 0.02 * noise;
+	    break;
+	default:
+	    value = (n / (RATE / 4)) % 2 ? 0.3 * noise : 1e-4 * noise;
+	    break;
+	}
+	samples[n] = static_cast<float>(10000.0 * value);
+    }
+    return samples;
+}
+
+// Runs the split filterbank and the pitch analysis like VadAudioProc does.
+static bool TestPitchAnalysis(const std::vector<float> &signal) {
+    PreFiltBankstr filterbank, scalar_filterbank;
+    PitchAnalysisStruct pitch, scalar_pitch;
+    WebRtcIsac_InitPreFilterbank(&filterbank);
+    WebRtcIsacScalar_InitPreFilterbank(&scalar_filterbank);
+    WebRtcIsac_InitPitchAnalysis(&pitch);
+    WebRtcIsacScalar_InitPitchAnalysis(&scalar_pitch);
+
+    Comparison split, analysis;
+    for (size_t frame = 0; frame < NUM_FRAMES; frame++) {
+	std::vector<float> in(signal.begin() + frame * FRAMESAMPLES,
+			      signal.begin() + (frame + 1) * FRAMESAMPLES);
+	std::vector<float> scalar_in = in;
+	float lower[FRAMESAMPLES_HALF], upper[FRAMESAMPLES_HALF];
+	float scalar_lower[FRAMESAMPLES_HALF], scalar_upper[FRAMESAMPLES_HALF];
+	double lower_la[FRAMESAMPLES_HALF], upper_la[FRAMESAMPLES_HALF];
+	double scalar_lower_la[FRAMESAMPLES_HALF], scalar_upper_la[FRAMESAMPLES_HALF];
+	WebRtcIsac_SplitAndFilterFloat(in.data(), lower, upper, lower_la, upper_la, &filterbank);
+	WebRtcIsacScalar_SplitAndFilterFloat(scalar_in.data(), scalar_lower, scalar_upper,
+					     scalar_lower_la, scalar_upper_la, &scalar_filterbank);
+	split.Add(lower, scalar_lower, FRAMESAMPLES_HALF);
+	split.Add(upper, scalar_upper, FRAMESAMPLES_HALF);
+	split.Add(lower_la, scalar_lower_la, FRAMESAMPLES_HALF);
+	split.Add(upper_la, scalar_upper_la, FRAMESAMPLES_HALF);
+
+	// Both analyses get the scalar lower band, so that a difference in the
+	// filterbank does not hide or cause one here.
+	double out[PITCH_FRAME_LEN + QLOOKAHEAD], scalar_out[PITCH_FRAME_LEN + QLOOKAHEAD];
+	double lags[PITCH_SUBFRAMES], gains[PITCH_SUBFRAMES];
+	double scalar_lags[PITCH_SUBFRAMES], scalar_gains[PITCH_SUBFRAMES];
+	WebRtcIsac_PitchAnalysis(scalar_lower_la, out, &pitch, lags, gains);
+	WebRtcIsacScalar_PitchAnalysis(scalar_lower_la, scalar_out, &scalar_pitch, scalar_lags,
+				       scalar_gains);
+	analysis.Add(out, scalar_out, PITCH_FRAME_LEN + QLOOKAHEAD);
+	analysis.Add(lags, scalar_lags, PITCH_SUBFRAMES);
+	analysis.Add(gains, scalar_gains, PITCH_SUBFRAMES);
+    }
+    return split.Check("WebRtcIsac_SplitAndFilterFloat") &&
+	   analysis.Check("WebRtcIsac_PitchAnalysis");
+}
+
+// WebRtcIsac_WeightingFilter() runs the autocorrelation and the all-pole
+// filters over each frame.
+static bool TestWeightingFilter(const std::vector<float> &signal) {
+    PitchAnalysisStruct pitch, scalar_pitch;
+    WebRtcIsac_InitPitchAnalysis(&pitch);
+    WebRtcIsacScalar_InitPitchAnalysis(&scalar_pitch);
+
+    Comparison comparison;
+    for (size_t frame = 0; frame < NUM_FRAMES; frame++) {
+	double in[PITCH_FRAME_LEN];
+	std::copy(signal.begin() + frame * PITCH_FRAME_LEN,
+		  signal.begin() + (frame + 1) * PITCH_FRAME_LEN, in);
+	double weighted[PITCH_FRAME_LEN], whitened[PITCH_FRAME_LEN];
+	double scalar_weighted[PITCH_FRAME_LEN], scalar_whitened[PITCH_FRAME_LEN];
+	WebRtcIsac_WeightingFilter(in, weighted, whitened, &pitch.Wghtstr);
+	WebRtcIsacScalar_WeightingFilter(in, scalar_weighted, scalar_whitened,
+					 &scalar_pitch.Wghtstr);
+	comparison.Add(weighted, scalar_weighted, PITCH_FRAME_LEN);
+	comparison.Add(whitened, scalar_whitened, PITCH_FRAME_LEN);
+    }
+    return comparison.Check("WebRtcIsac_WeightingFilter");
+}
+
+// Covers orders and lengths around the groups of eight lags, where the
+// vector code leaves lags or samples to the scalar loops.
+static bool TestAutoCorr(const std::vector<float> &signal) {
+    Comparison comparison;
+    for (size_t length = 1; length <= 40; length++) {
+	const std::vector<double> x(signal.begin() + length * 100,
+				    signal.begin() + length * 100 + length);
+	for (size_t order = 0; order < length && order <= 20; order++) {
+	    std::vector<double> r(order + 1), scalar_r(order + 1);
+	    WebRtcIsac_AutoCorr(r.data(), x.data(), length, order);
+	    WebRtcIsacScalar_AutoCorr(scalar_r.data(), x.data(), length, order);
+	    comparison.Add(r.data(), scalar_r.data(), order + 1);
+	}
+    }
+    return comparison.Check("WebRtcIsac_AutoCorr");
+}
+
+int main() {
+    const std::vector<float> signal = Signal(NUM_FRAMES * FRAMESAMPLES);
+    if (!TestPitchAnalysis(signal) || !TestWeightingFilter(signal) || !TestAutoCorr(signal))
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Force-included when building the scalar reference of the iSAC pitch
+// analysis for isac-pitch-test. It disables the SSE2 and Neon kernels and
+// renames the exported functions, so that the reference can be linked next
+// to the optimized code.
+
+#ifndef TESTS_ISAC_SCALAR_NAMES_H_
+#define TESTS_ISAC_SCALAR_NAMES_H_
+
+#ifndef WAP_DISABLE_INLINE_SSE
+#define WAP_DISABLE_INLINE_SSE
+#endif
+#undef WEBRTC_HAS_NEON
+
+#define WebRtcIsac_AllPassFilter2Float WebRtcIsacScalar_AllPassFilter2Float
+#define WebRtcIsac_AutoCorr WebRtcIsacScalar_AutoCorr
+#define WebRtcIsac_InitPitchAnalysis WebRtcIsacScalar_InitPitchAnalysis
+#define WebRtcIsac_InitPitchFilter WebRtcIsacScalar_InitPitchFilter
+#define WebRtcIsac_InitPreFilterbank WebRtcIsacScalar_InitPreFilterbank
+#define WebRtcIsac_LevDurb WebRtcIsacScalar_LevDurb
+#define WebRtcIsac_PitchAnalysis WebRtcIsacScalar_PitchAnalysis
+#define WebRtcIsac_PitchfilterPost WebRtcIsacScalar_PitchfilterPost
+#define WebRtcIsac_PitchfilterPre WebRtcIsacScalar_PitchfilterPre
+#define WebRtcIsac_PitchfilterPre_gains WebRtcIsacScalar_PitchfilterPre_gains
+#define WebRtcIsac_PitchfilterPre_la WebRtcIsacScalar_PitchfilterPre_la
+#define WebRtcIsac_SplitAndFilterFloat WebRtcIsacScalar_SplitAndFilterFloat
+#define WebRtcIsac_WeightingFilter WebRtcIsacScalar_WeightingFilter
+#define WebRtcIsac_kLowerApFactorsFloat WebRtcIsacScalar_kLowerApFactorsFloat
+#define WebRtcIsac_kUpperApFactorsFloat WebRtcIsacScalar_kUpperApFactorsFloat
+
+#endif  // TESTS_ISAC_SCALAR_NAMES_H_
@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the SSE2 versions of the signal processing library functions with
+// the C versions, for all lengths around the vector widths, unaligned inputs,
+// and inputs that are full of or end in INT16_MIN and INT32_MIN.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+extern "C" {
+#include <webrtc/common_audio/signal_processing/include/signal_processing_library.h>
+}
+
+#define MAX_LENGTH 67
+#define NUM_PATTERNS 6
+
+static uint32_t Random(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed;
+}
+
+// Fills `vector` with one of the patterns: random values, random values with
+// an extreme at the end, all at the negative extreme, a small range around
+// zero, alternating extremes and a ramp. `vector` has one element in front of
+// the data, so that the data is not 16-byte aligned.
+template <typename T>
+static void Fill(int pattern, uint32_t *seed, std::vector<T> *vector) {
+    const T min = std::numeric_limits<T>::min();
+    const T max = std::numeric_limits<T>::max();
+    for (size_t i = 0; i < vector->size(); i++) {
+	T &x = (*vector)[i];
+	switch (pattern) {
+	case 0:
+	case 1:
+	    x = static_cast<T>(Random(seed) >> (32 - 8 * sizeof(T)));
+	    break;
+	case 2:
+	    x = min;
+	    break;
+	case 3:
+	    x = static_cast<T>(static_cast<int>(Random(seed) % 7) - 3);
+	    break;
+	case 4:
+	    x = i % 2 ? max : min;
+	    break;
+	default:
+	    x = static_cast<T>(min + static_cast<T>(i * (max / MAX_LENGTH) * 2));
+	    break;
+	}
+    }
+    if (pattern == 1 && vector->size() > 1)
+	vector->back() = Random(seed) % 2 ? min : max;
+}
+
+template <typename T, typename F>
+static bool CompareMinMax(const char *name, F optimized, F reference) {
+    uint32_t seed = 1;
+    for (int pattern = 0; pattern < NUM_PATTERNS; pattern++) {
+	for (size_t length = 1; length <= MAX_LENGTH; length++) {
+	    std::vector<T> vector(length + 1);
+	    Fill(pattern, &seed, &vector);
+	    const T result = optimized(&vector[1], length);
+	    const T expected = reference(&vector[1], length);
+	    if (result != expected) {
+		std::cerr << name << ", pattern " << pattern << ", length " << length << ": "
+			  << result << " instead of " << expected << std::endl;
+		return false;
+	    }
+	}
+    }
+    return true;
+}
+
+static bool TestMinMax() {
+    if (!CompareMinMax<int16_t>("WebRtcSpl_MaxAbsValueW16", WebRtcSpl_MaxAbsValueW16Sse2,
+				WebRtcSpl_MaxAbsValueW16C) ||
+	!CompareMinMax<int32_t>("WebRtcSpl_MaxAbsValueW32", WebRtcSpl_MaxAbsValueW32Sse2,
+				WebRtcSpl_MaxAbsValueW32C) ||
+	!CompareMinMax<int16_t>("WebRtcSpl_MaxValueW16", WebRtcSpl_MaxValueW16Sse2,
+				WebRtcSpl_MaxValueW16C) ||
+	!CompareMinMax<int32_t>("WebRtcSpl_MaxValueW32", WebRtcSpl_MaxValueW32Sse2,
+				WebRtcSpl_MaxValueW32C) ||
+	!CompareMinMax<int16_t>("WebRtcSpl_MinValueW16", WebRtcSpl_MinValueW16Sse2,
+				WebRtcSpl_MinValueW16C) ||
+	!CompareMinMax<int32_t>("WebRtcSpl_MinValueW32", WebRtcSpl_MinValueW32Sse2,
+				WebRtcSpl_MinValueW32C))
+	return false;
+
+    uint32_t seed = 2;
+    for (int pattern = 0; pattern < NUM_PATTERNS; pattern++) {
+	for (size_t length = 1; length <= MAX_LENGTH; length++) {
+	    std::vector<int16_t> vector(length + 1);
+	    Fill(pattern, &seed, &vector);
+	    int16_t min_val, max_val;
+	    WebRtcSpl_MinMaxW16Sse2(&vector[1], length, &min_val, &max_val);
+	    if (min_val != WebRtcSpl_MinValueW16C(&vector[1], length) ||
+		max_val != WebRtcSpl_MaxValueW16C(&vector[1], length)) {
+		std::cerr << "WebRtcSpl_MinMaxW16, pattern " << pattern << ", length " << length
+			  << ": " << min_val << ", " << max_val << std::endl;
+		return false;
+	    }
+	}
+    }
+    return true;
+}
+
+// Uses the smallest right shift that keeps the C version from overflowing,
+// like the callers do, and also no shift for the patterns that cannot
+// overflow.
+static bool TestCrossCorrelation() {
+    uint32_t seed = 3;
+    for (int pattern = 0; pattern < NUM_PATTERNS; pattern++) {
+	for (size_t dim_seq = 1; dim_seq <= MAX_LENGTH; dim_seq++) {
+	    const size_t dim_cross_correlation = 1 + dim_seq % 5;
+	    for (int step_seq2 : {1, -1}) {
+		std::vector<int16_t> seq1(dim_seq + 1), seq2(dim_seq + 2 * dim_cross_correlation);
+		Fill(pattern, &seed, &seq1);
+		Fill(pattern, &seed, &seq2);
+		const int16_t *start2 =
+		    step_seq2 > 0 ? &seq2[1] : &seq2[dim_cross_correlation];
+		const int overflow_shift =
+		    WebRtcSpl_GetSizeInBits(static_cast<uint32_t>(dim_seq)) + 1;
+		for (int right_shifts : {overflow_shift, pattern == 3 ? 0 : overflow_shift + 3}) {
+		    std::vector<int32_t> result(dim_cross_correlation);
+		    std::vector<int32_t> expected(dim_cross_correlation);
+		    WebRtcSpl_CrossCorrelationSse2(result.data(), &seq1[1], start2, dim_seq,
+						   dim_cross_correlation, right_shifts, step_seq2);
+		    WebRtcSpl_CrossCorrelationC(expected.data(), &seq1[1], start2, dim_seq,
+						dim_cross_correlation, right_shifts, step_seq2);
+		    if (result != expected) {
+			std::cerr << "WebRtcSpl_CrossCorrelation, pattern " << pattern
+				  << ", length " << dim_seq << ", shift " << right_shifts
+				  << ", step " << step_seq2 << " differs" << std::endl;
+			return false;
+		    }
+		}
+	    }
+	}
+    }
+    return true;
+}
+
+// The coefficients are in Q12 and sum up to at most 1.5 in absolute value, so
+// that the C version cannot overflow, but full scale inputs still saturate.
+static bool TestDownsampleFast() {
+    uint32_t seed = 4;
+    for (int pattern = 0; pattern < NUM_PATTERNS; pattern++) {
+	for (size_t coefficients_length = 1; coefficients_length <= 25; coefficients_length++) {
+	    std::vector<int16_t> coefficients(coefficients_length);
+	    for (int16_t &coefficient : coefficients) {
+		coefficient = static_cast<int16_t>(static_cast<int>(Random(&seed) % 12289) - 6144);
+		coefficient = static_cast<int16_t>(coefficient / static_cast<int>(coefficients_length));
+	    }
+	    for (int factor = 1; factor <= 3; factor++) {
+		const size_t data_out_length = 1 + (coefficients_length * 7) % 23;
+		const size_t delay = coefficients_length - 1 + factor % 2;
+		const size_t data_in_length = delay + factor * (data_out_length - 1) + 1;
+		std::vector<int16_t> data_in(data_in_length + 1);
+		Fill(pattern, &seed, &data_in);
+		std::vector<int16_t> result(data_out_length), expected(data_out_length);
+		const int status = WebRtcSpl_DownsampleFastSse2(
+		    &data_in[1], data_in_length, result.data(), data_out_length,
+		    coefficients.data(), coefficients_length, factor, delay);
+		const int expected_status = WebRtcSpl_DownsampleFastC(
+		    &data_in[1], data_in_length, expected.data(), data_out_length,
+		    coefficients.data(), coefficients_length, factor, delay);
+		if (status != expected_status || result != expected) {
+		    std::cerr << "WebRtcSpl_DownsampleFast, pattern " << pattern << ", "
+			      << coefficients_length << " coefficients, factor " << factor
+			      << " differs" << std::endl;
+		    return false;
+		}
+	    }
+	}
+    }
+    return true;
+}
+
+int main() {
+    if (!TestMinMax() || !TestCrossCorrelation() || !TestDownsampleFast())
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Verifies the ordering, wrap-around and read position handling of
+// SpscRingBuffer, and that a concurrent producer and consumer see the elements
+// in order. Build with -Db_sanitize=thread to check the synchronization.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <webrtc/common_audio/spsc_ring_buffer.h>
+
+#define CAPACITY 8
+#define NUM_CONCURRENT_ELEMENTS 200000
+
+#define CHECK(condition)                                                  \
+    do {                                                                  \
+	if (!(condition)) {                                               \
+	    std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition   \
+		      << " failed" << std::endl;                          \
+	    return false;                                                 \
+	}                                                                 \
+    } while (0)
+
+typedef webrtc::SpscRingBuffer<int16_t> Buffer;
+
+// Returns the readable content without consuming it.
+static std::vector<int16_t> Content(const Buffer &buffer) {
+    const Buffer::ReadView view = buffer.Peek(buffer.available_read());
+    std::vector<int16_t> content(view.first.begin(), view.first.end());
+    content.insert(content.end(), view.second.begin(), view.second.end());
+    return content;
+}
+
+// Returns `count` consecutive values starting at `first`.
+static std::vector<int16_t> Sequence(int16_t first, size_t count) {
+    std::vector<int16_t> values(count);
+    std::iota(values.begin(), values.end(), first);
+    return values;
+}
+
+static bool TestWrapAround() {
+    Buffer buffer(CAPACITY);
+    CHECK(buffer.Write(Sequence(0, 6)) == 6);
+    std::vector<int16_t> read(4);
+    CHECK(buffer.Read(read) == 4);
+    CHECK(read == Sequence(0, 4));
+
+    // The next elements wrap around the end of the storage.
+    CHECK(buffer.Write(Sequence(6, 5)) == 5);
+    CHECK(buffer.available_read() == 7);
+    const Buffer::ReadView view = buffer.Peek(CAPACITY);
+    CHECK(view.first.size() == 4);
+    CHECK(view.second.size() == 3);
+    CHECK(Content(buffer) == Sequence(4, 7));
+
+    // Only the free elements are written.
+    CHECK(buffer.Write(Sequence(11, 3)) == 1);
+    CHECK(buffer.available_write() == 0);
+    read.resize(CAPACITY + 1);
+    CHECK(buffer.Read(read) == CAPACITY);
+    CHECK(std::vector<int16_t>(read.begin(), read.begin() + CAPACITY) == Sequence(4, CAPACITY));
+    CHECK(buffer.available_read() == 0);
+    return true;
+}
+
+static bool TestMoveReadPosition() {
+    Buffer buffer(CAPACITY);
+    CHECK(buffer.Write(Sequence(0, 5)) == 5);
+
+    // Flushing drops the oldest elements, at most all of them.
+    CHECK(buffer.MoveReadPosition(2) == 2);
+    CHECK(Content(buffer) == Sequence(2, 3));
+    CHECK(buffer.MoveReadPosition(0) == 0);
+
+    // Stuffing makes the consumed elements readable again.
+    CHECK(buffer.MoveReadPosition(-2) == -2);
+    CHECK(Content(buffer) == Sequence(0, 5));
+
+    CHECK(buffer.MoveReadPosition(10) == 5);
+    CHECK(buffer.available_read() == 0);
+
+    // Stuffing across the start of the storage, and at most up to the
+    // capacity.
+    CHECK(buffer.Write(Sequence(5, 6)) == 6);
+    CHECK(buffer.MoveReadPosition(6) == 6);
+    CHECK(buffer.MoveReadPosition(-3) == -3);
+    CHECK(Content(buffer) == Sequence(8, 3));
+    CHECK(buffer.MoveReadPosition(-CAPACITY) == -(CAPACITY - 3));
+    CHECK(buffer.available_write() == 0);
+    CHECK(Content(buffer) == Sequence(3, CAPACITY));
+    return true;
+}
+
+// Mirrors how AECM keeps its far-end buffer level: whole frames are flushed
+// when the render side runs ahead, and already consumed samples are reused
+// when it runs behind.
+static bool TestFarEndLevelAdjustment() {
+    const size_t frame_length = 3;
+    Buffer buffer(4 * frame_length);
+    CHECK(buffer.Write(Sequence(0, 3 * frame_length)) == 3 * frame_length);
+    CHECK(buffer.MoveReadPosition(frame_length) == static_cast<int>(frame_length));
+
+    std::vector<int16_t> frame(frame_length);
+    CHECK(buffer.Read(frame) == frame_length);
+    CHECK(frame == Sequence(frame_length, frame_length));
+    CHECK(buffer.Read(frame) == frame_length);
+    CHECK(buffer.available_read() == 0);
+
+    // The buffer ran dry, so the last frame is stuffed back and read again.
+    CHECK(buffer.MoveReadPosition(-static_cast<int>(frame_length)) ==
+	  -static_cast<int>(frame_length));
+    CHECK(buffer.Read(frame) == frame_length);
+    CHECK(frame == Sequence(2 * frame_length, frame_length));
+
+    // Writing continues after the stuffed elements.
+    CHECK(buffer.Write(Sequence(100, 2 * frame_length)) == 2 * frame_length);
+    CHECK(Content(buffer) == Sequence(100, 2 * frame_length));
+
+    buffer.Reset();
+    CHECK(buffer.available_read() == 0);
+    CHECK(buffer.MoveReadPosition(-1) == -1);
+    CHECK(Content(buffer) == std::vector<int16_t>(1, 0));
+    return true;
+}
+
+// Streams a counter through a small buffer from a second thread and checks
+// that the consumer reads every value once and in order.
+static bool TestConcurrentProducerConsumer() {
+    webrtc::SpscRingBuffer<int32_t> buffer(61);
+    std::thread producer([&buffer] {
+	std::vector<int32_t> chunk;
+	int32_t next = 0;
+	size_t chunk_size = 1;
+	while (next < NUM_CONCURRENT_ELEMENTS) {
+	    chunk.resize(std::min<size_t>(chunk_size, NUM_CONCURRENT_ELEMENTS - next));
+	    std::iota(chunk.begin(), chunk.end(), next);
+	    const size_t written = buffer.Write(chunk);
+	    if (written == 0)
+		std::this_thread::yield();
+	    next += static_cast<int32_t>(written);
+	    chunk_size = chunk_size % 17 + 1;
+	}
+    });
+
+    int32_t expected = 0;
+    bool in_order = true;
+    size_t chunk_size = 1;
+    while (expected < NUM_CONCURRENT_ELEMENTS) {
+	const webrtc::SpscRingBuffer<int32_t>::ReadView view = buffer.Peek(chunk_size);
+	for (int32_t value : view.first)
+	    in_order &= value == expected++;
+	for (int32_t value : view.second)
+	    in_order &= value == expected++;
+	buffer.Consume(view.size());
+	if (view.size() == 0)
+	    std::this_thread::yield();
+	chunk_size = chunk_size % 23 + 1;
+    }
+    producer.join();
+    CHECK(in_order);
+    CHECK(buffer.available_read() == 0);
+    return true;
+}
+
+int main() {
+    if (!TestWrapAround() || !TestMoveReadPosition() || !TestFarEndLevelAdjustment() ||
+	!TestConcurrentProducerConsumer())
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,28 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Force-included when building the scalar reference of the VAD feature
+// extraction and minimum tracking for vad-simd-test. It disables the SSE2 and
+// Neon kernels and renames the exported functions, so that the reference can
+// be linked next to the optimized code.
+
+#ifndef TESTS_VAD_SCALAR_NAMES_H_
+#define TESTS_VAD_SCALAR_NAMES_H_
+
+#ifndef WAP_DISABLE_INLINE_SSE
+#define WAP_DISABLE_INLINE_SSE
+#endif
+#undef WEBRTC_HAS_NEON
+
+#define WebRtcVad_CalculateFeatures WebRtcVadScalar_CalculateFeatures
+#define WebRtcVad_Downsampling WebRtcVadScalar_Downsampling
+#define WebRtcVad_FindMinimum WebRtcVadScalar_FindMinimum
+
+#endif  // TESTS_VAD_SCALAR_NAMES_H_
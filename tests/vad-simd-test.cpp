@@ -0,0 +1,224 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the SSE2/Neon minimum tracking of WebRtcVad_FindMinimum() and the
+// band energies of WebRtcVad_CalculateFeatures() with the scalar code, built
+// next to it with the names from vad-scalar-names.h. The minimum tracking is
+// run on feature sequences that let minima expire, and from states whose ages
+// are around the maximum age of 100 frames. The outputs and the states have
+// to be identical.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+#include <webrtc/common_audio/vad/vad_core.h>
+#include <webrtc/common_audio/vad/vad_filterbank.h>
+#include <webrtc/common_audio/vad/vad_sp.h>
+
+int16_t WebRtcVadScalar_CalculateFeatures(VadInstT *self, const int16_t *data_in,
+					  size_t data_length, int16_t *features);
+int16_t WebRtcVadScalar_FindMinimum(VadInstT *handle, int16_t feature_value, int channel);
+}
+
+#define NUM_FRAMES 3000
+#define NUM_STATES 2000
+#define STATE_FRAMES 8
+#define MAX_AGE 100
+
+static const double kPi = 3.14159265358979323846;
+
+static const size_t kFrameLengths[] = {80, 160, 240};
+
+static uint32_t Random(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+// Returns true if the minimum tracking state of both instances is the same.
+static bool SameMinima(const VadInstT &a, const VadInstT &b) {
+    return std::memcmp(a.index_vector, b.index_vector, sizeof(a.index_vector)) == 0 &&
+	   std::memcmp(a.low_value_vector, b.low_value_vector, sizeof(a.low_value_vector)) ==
+	       0 &&
+	   std::memcmp(a.mean_value, b.mean_value, sizeof(a.mean_value)) == 0;
+}
+
+// Runs WebRtcVad_FindMinimum() on both instances for all channels of one
+// frame and returns false on the first difference.
+static bool FindMinima(VadInstT *self, VadInstT *scalar, const int16_t *features,
+		       const char *description, int frame) {
+    for (int channel = 0; channel < kNumChannels; channel++) {
+	const int16_t minimum = WebRtcVad_FindMinimum(self, features[channel], channel);
+	const int16_t scalar_minimum =
+	    WebRtcVadScalar_FindMinimum(scalar, features[channel], channel);
+	if (minimum != scalar_minimum || !SameMinima(*self, *scalar)) {
+	    std::cerr << description << ", frame " << frame << ", channel " << channel
+		      << ": minimum " << minimum << " instead of " << scalar_minimum
+		      << std::endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+// Feeds feature sequences that fall, rise, repeat values and jump between the
+// extremes, with low values that are followed by long stretches of higher
+// ones, so that the minima reach the maximum age and are removed.
+static bool TestFindMinimumSequences() {
+    VadInstT self, scalar;
+    WebRtcVad_InitCore(&self);
+    WebRtcVad_InitCore(&scalar);
+    uint32_t seed = 1;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+	int16_t features[kNumChannels];
+	const int period = 3 * MAX_AGE / 2;
+	for (int channel = 0; channel < kNumChannels; channel++) {
+	    const int phase = (frame + channel * 37) % period;
+	    int value;
+	    switch (channel) {
+	    case 0:
+		// A minimum every `period` frames, which expires in between.
+		value = phase == 0 ? 100 : 2000 + static_cast<int>(Random(&seed) % 500);
+		break;
+	    case 1:
+		value = 3000 - phase * 20;
+		break;
+	    case 2:
+		value = 500 + phase * 20;
+		break;
+	    case 3:
+		// Few distinct values, which produces equal minima.
+		value = 1000 + static_cast<int>(Random(&seed) % 4) * 100;
+		break;
+	    case 4:
+		value = Random(&seed) % 2 ? INT16_MAX : INT16_MIN;
+		break;
+	    default:
+		value = static_cast<int16_t>(Random(&seed));
+		break;
+	    }
+	    features[channel] = static_cast<int16_t>(value);
+	}
+	self.frame_counter = scalar.frame_counter = frame;
+	if (!FindMinima(&self, &scalar, features, "Sequence", frame))
+	    return false;
+    }
+    return true;
+}
+
+// Starts from random states in which up to 16 minima are kept with distinct
+// ages, most of them within a few frames of the maximum age, and the unused
+// entries hold the initial values.
+static bool TestFindMinimumAges() {
+    uint32_t seed = 2;
+    for (int n = 0; n < NUM_STATES; n++) {
+	VadInstT self, scalar;
+	WebRtcVad_InitCore(&self);
+	for (int channel = 0; channel < kNumChannels; channel++) {
+	    int16_t *age = &self.index_vector[channel * 16];
+	    int16_t *values = &self.low_value_vector[channel * 16];
+	    const int num_minima = static_cast<int>(Random(&seed) % 17);
+	    std::vector<int16_t> ages;
+	    while (static_cast<int>(ages.size()) < num_minima) {
+		const int16_t candidate =
+		    static_cast<int16_t>(Random(&seed) % 4
+					     ? MAX_AGE - Random(&seed) % 6
+					     : 1 + Random(&seed) % MAX_AGE);
+		if (std::find(ages.begin(), ages.end(), candidate) == ages.end())
+		    ages.push_back(candidate);
+	    }
+	    std::vector<int16_t> sorted_values(num_minima);
+	    for (int16_t &value : sorted_values)
+		value = static_cast<int16_t>(Random(&seed) % 9000);
+	    std::sort(sorted_values.begin(), sorted_values.end());
+	    for (int k = 0; k < 16; k++) {
+		age[k] = k < num_minima ? ages[k] : (n % 2 ? 101 : 0);
+		values[k] = k < num_minima ? sorted_values[k] : 10000;
+	    }
+	    self.mean_value[channel] = static_cast<int16_t>(Random(&seed) % 9000);
+	}
+	self.frame_counter = static_cast<int32_t>(Random(&seed) % 5);
+	scalar = self;
+
+	for (int frame = 0; frame < STATE_FRAMES; frame++) {
+	    int16_t features[kNumChannels];
+	    for (int16_t &feature : features)
+		feature = static_cast<int16_t>(Random(&seed) % 10500);
+	    if (!FindMinima(&self, &scalar, features, "Random state", frame))
+		return false;
+	    self.frame_counter++;
+	    scalar.frame_counter++;
+	}
+    }
+    return true;
+}
+
+// Compares the features, the total energy and the filter states for frames of
+// tones, noise, silence and full scale square waves that include INT16_MIN.
+static bool TestCalculateFeatures() {
+    for (size_t frame_length : kFrameLengths) {
+	VadInstT self, scalar;
+	WebRtcVad_InitCore(&self);
+	WebRtcVad_InitCore(&scalar);
+	uint32_t seed = 3;
+	std::vector<int16_t> frame(frame_length);
+	for (int n = 0; n < NUM_FRAMES / 10; n++) {
+	    for (size_t i = 0; i < frame_length; i++) {
+		const double t = static_cast<double>(n * frame_length + i) / 8000.0;
+		const int noise = static_cast<int16_t>(Random(&seed));
+		switch (n % 5) {
+		case 0:
+		    frame[i] = static_cast<int16_t>(
+			std::lround(12000.0 * std::sin(2.0 * kPi * (200.0 + 50.0 * (n % 60)) * t)));
+		    break;
+		case 1:
+		    frame[i] = static_cast<int16_t>(noise >> (n % 16));
+		    break;
+		case 2:
+		    frame[i] = 0;
+		    break;
+		case 3:
+		    frame[i] = (i / (1 + n % 7)) % 2 ? INT16_MAX : INT16_MIN;
+		    break;
+		default:
+		    frame[i] = INT16_MIN;
+		    break;
+		}
+	    }
+	    int16_t features[kNumChannels], scalar_features[kNumChannels];
+	    const int16_t energy =
+		WebRtcVad_CalculateFeatures(&self, frame.data(), frame_length, features);
+	    const int16_t scalar_energy = WebRtcVadScalar_CalculateFeatures(
+		&scalar, frame.data(), frame_length, scalar_features);
+	    if (energy != scalar_energy ||
+		std::memcmp(features, scalar_features, sizeof(features)) != 0 ||
+		std::memcmp(self.upper_state, scalar.upper_state, sizeof(self.upper_state)) != 0 ||
+		std::memcmp(self.lower_state, scalar.lower_state, sizeof(self.lower_state)) != 0 ||
+		std::memcmp(self.hp_filter_state, scalar.hp_filter_state,
+			    sizeof(self.hp_filter_state)) != 0) {
+		std::cerr << "Features of frame " << n << " with " << frame_length
+			  << " samples differ" << std::endl;
+		return false;
+	    }
+	}
+    }
+    return true;
+}
+
+int main() {
+    if (!TestFindMinimumSequences() || !TestFindMinimumAges() || !TestCalculateFeatures())
+	return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
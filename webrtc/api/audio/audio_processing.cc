@@ -70,6 +70,8 @@ bool Agc1Config::operator==(const Agc1Config& rhs) const {
          analog_lhs.clipped_ratio_threshold ==
              analog_rhs.clipped_ratio_threshold &&
          analog_lhs.clipped_wait_frames == analog_rhs.clipped_wait_frames &&
+         analog_lhs.shared_channel_analysis ==
+             analog_rhs.shared_channel_analysis &&
          analog_lhs.clipping_predictor.mode ==
              analog_rhs.clipping_predictor.mode &&
          analog_lhs.clipping_predictor.window_length ==
@@ -168,6 +170,8 @@ std::string AudioProcessing::Config::ToString() const {
           << gain_controller1.analog_gain_controller.clipped_ratio_threshold
           << ", clipped_wait_frames: "
           << gain_controller1.analog_gain_controller.clipped_wait_frames
+          << ", shared_channel_analysis: "
+          << gain_controller1.analog_gain_controller.shared_channel_analysis
           << ", clipping_predictor:  { enabled: "
           << gain_controller1.analog_gain_controller.clipping_predictor.enabled
           << ", mode: "
@@ -27,8 +27,10 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/nullability.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "api/audio/audio_processing_statistics.h"
@@ -297,6 +299,11 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
         // Time in frames to wait after a clipping event before checking again.
         // Limited to values higher than 0.
         int clipped_wait_frames = 300;
+        // If true, the loudness and voice activity analysis runs once on the
+        // downmix of the capture channels instead of once per channel, so that
+        // its cost does not grow with the number of channels. Clipping is
+        // still detected on every channel.
+        bool shared_channel_analysis = false;
 
         // Enables clipping prediction functionality.
         struct ClippingPredictor {
@@ -564,6 +571,15 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
                             const StreamConfig& output_config,
                             float* const* dest) = 0;
 
+  // Accepts and produces a ~10 ms frame of interleaved float audio with the
+  // range [-1, 1] as specified in `input_config` and `output_config`. This
+  // avoids deinterleaving into separate channel buffers on the caller side.
+  // `src` and `dest` may use the same memory, if desired.
+  virtual int ProcessStream(const float* const src,
+                            const StreamConfig& input_config,
+                            const StreamConfig& output_config,
+                            float* const dest) = 0;
+
   // Accepts and produces a ~10 ms frame of interleaved 16 bit integer audio for
   // the reverse direction audio stream as specified in `input_config` and
   // `output_config`. `src` and `dest` may use the same memory, if desired.
@@ -579,6 +595,15 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
                                    const StreamConfig& output_config,
                                    float* const* dest) = 0;
 
+  // Accepts and produces a ~10 ms frame of interleaved float audio with the
+  // range [-1, 1] for the reverse direction audio stream as specified in
+  // `input_config` and `output_config`. `src` and `dest` may use the same
+  // memory, if desired.
+  virtual int ProcessReverseStream(const float* const src,
+                                   const StreamConfig& input_config,
+                                   const StreamConfig& output_config,
+                                   float* const dest) = 0;
+
   // Accepts deinterleaved float audio with the range [-1, 1]. Each element
   // of `data` points to a channel buffer, arranged according to
   // `reverse_config`.
@@ -592,6 +617,22 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   virtual bool GetLinearAecOutput(
       rtc::ArrayView<std::array<float, 160>> linear_output) const = 0;
 
+  // Returns a serialized snapshot of the converged echo canceller state, e.g.,
+  // to be stored when a call ends. It is empty if no echo canceller is active
+  // or if the echo canceller does not support warm starts. The format is
+  // specific to the library build.
+  virtual std::vector<uint8_t> GetEchoCancellerWarmStartState() = 0;
+
+  // Initializes the echo canceller from a state returned by
+  // GetEchoCancellerWarmStartState() of an instance processing the same audio
+  // path with the same channel configuration, in order to avoid the initial
+  // convergence phase. Call it once the stream formats are set, i.e., after
+  // the first ProcessStream() call, since a reinitialization of the echo
+  // canceller discards the state. Returns false, and leaves the echo canceller
+  // unaffected, if the state cannot be used.
+  virtual bool SetEchoCancellerWarmStartState(
+      rtc::ArrayView<const uint8_t> state) = 0;
+
   // This must be called prior to ProcessStream() if and only if adaptive analog
   // gain control is enabled, to pass the current analog level from the audio
   // HAL. Must be within the range [0, 255].
@@ -603,6 +644,19 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   // apply this level.
   virtual int recommended_stream_analog_level() const = 0;
 
+  // Sets a callback that `ProcessStream()` invokes with the recommended analog
+  // level whenever it differs from the applied one and from the level last
+  // passed to the callback since the applied level changed. This replaces
+  // polling `recommended_stream_analog_level()` after every frame. The applied
+  // level is kept across frames, so `set_stream_analog_level()` only needs to
+  // be called when the level changes, e.g. once the recommended level has
+  // been applied. The callback runs on the capture thread before
+  // `ProcessStream()` returns but after APM has released its capture lock, so
+  // it may call `set_stream_analog_level()`. It must not set a new callback.
+  // Pass nullptr to remove it.
+  virtual void SetRecommendedStreamAnalogLevelCallback(
+      absl::AnyInvocable<void(int)> callback) = 0;
+
   // This must be called if and only if echo processing is enabled.
   //
   // Sets the `delay` in ms between ProcessReverseStream() receiving a far-end
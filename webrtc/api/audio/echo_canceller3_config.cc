@@ -186,6 +186,7 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
                     32768.f * 32768.f);
   res = res & Limit(&c->render_levels.poor_excitation_render_limit_ds8, 0.f,
                     32768.f * 32768.f);
+  res = res & Limit(&c->render_levels.silence_limit, 0.f, 32768.f);
 
   res = res & Limit(&c->echo_model.noise_floor_hold, 0, 1000);
   res = res & Limit(&c->echo_model.min_noise_floor_power, 0, 2000000.f);
@@ -273,6 +274,15 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
 
   res = res & Limit(&c->suppressor.floor_first_increase, 0.f, 1000000.f);
 
+  res = res & Limit(&c->multi_channel.num_capture_worker_threads, 0, 15);
+
+#if defined(WEBRTC_HAS_NEON)
+  if (c->filter.half_precision_storage) {
+    c->filter.half_precision_storage = false;
+    res = false;
+  }
+#endif
+
   return res;
 }
 }  // namespace webrtc
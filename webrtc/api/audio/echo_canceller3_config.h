@@ -94,6 +94,13 @@ struct RTC_EXPORT EchoCanceller3Config {
     bool use_linear_filter = true;
     bool high_pass_filter_echo_reference = false;
     bool export_linear_aec_output = false;
+    // Stores the linear filter coefficients with half precision, which halves
+    // their memory footprint at the cost of a slightly lower echo removal.
+    // The conversion uses vector instructions only on x86 CPUs with AVX2 and
+    // F16C; elsewhere it is scalar and the filter runs slower than with single
+    // precision storage. Not supported in Neon builds, where the option is
+    // rejected by Validate() and ignored by the echo canceller.
+    bool half_precision_storage = false;
   } filter;
 
   struct Erle {
@@ -132,11 +139,17 @@ struct RTC_EXPORT EchoCanceller3Config {
     float poor_excitation_render_limit = 150.f;
     float poor_excitation_render_limit_ds8 = 20.f;
     float render_power_gain_db = 0.f;
+    // Render blocks with an RMS level at or below this limit are treated as
+    // silent.
+    float silence_limit = 1.f;
   } render_levels;
 
   struct EchoRemovalControl {
     bool has_clock_drift = false;
     bool linear_and_stable_echo_path = false;
+    // Skips the delay estimation and the linear filtering and adaptation while
+    // all the buffered render data is silent.
+    bool skip_linear_processing_during_render_silence = false;
   } echo_removal_control;
 
   struct EchoModel {
@@ -243,6 +256,13 @@ struct RTC_EXPORT EchoCanceller3Config {
     float stereo_detection_threshold = 0.0f;
     int stereo_detection_timeout_threshold_seconds = 300;
     float stereo_detection_hysteresis_seconds = 2.0f;
+    // Number of threads, in addition to the calling thread, on which the
+    // linear filtering of the capture channels is run in parallel. Zero means
+    // that all capture channels are processed on the calling thread. The
+    // threads only help when spare cores are available, and are therefore
+    // limited to one per core beyond the first, i.e., none on a single-core
+    // machine.
+    int num_capture_worker_threads = 0;
   } multi_channel;
 };
 }  // namespace webrtc
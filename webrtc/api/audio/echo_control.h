@@ -11,8 +11,12 @@
 #ifndef API_AUDIO_ECHO_CONTROL_H_
 #define API_AUDIO_ECHO_CONTROL_H_
 
+#include <stdint.h>
+
 #include <memory>
+#include <vector>
 
+#include "api/array_view.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -58,6 +62,20 @@ class EchoControl {
   // Returns wheter the signal is altered.
   virtual bool ActiveProcessing() const = 0;
 
+  // Returns a serialized snapshot of the converged echo path state. It can be
+  // passed to SetWarmStartState() of a later instance operating on the same
+  // audio path, e.g., when a call reconnects, in order to avoid the initial
+  // convergence phase. Returns an empty vector if warm starts are not
+  // supported.
+  virtual std::vector<uint8_t> GetWarmStartState() const { return {}; }
+
+  // Initializes the echo controller from a state returned by
+  // GetWarmStartState(). Returns false, and leaves the echo controller
+  // unaffected, if the state cannot be used.
+  virtual bool SetWarmStartState(rtc::ArrayView<const uint8_t> state) {
+    return false;
+  }
+
   virtual ~EchoControl() {}
 };
 
@@ -19,6 +19,13 @@
 #include "common_audio/include/audio_util.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -27,6 +34,109 @@ namespace {
 const size_t kMuteFadeFrames = 128;
 const float kMuteFadeInc = 1.0f / kMuteFadeFrames;
 
+// Averages the channel pairs of the quad frames in `src`, rounding down. `src`
+// and `dst` may point to the same buffer.
+void QuadToStereoImpl(const int16_t* src, size_t num_frames, int16_t* dst) {
+  size_t i = 0;
+#if defined(WEBRTC_HAS_NEON)
+  for (; i + 4 <= num_frames; i += 4) {
+    const int32x4_t a = vpaddlq_s16(vld1q_s16(&src[4 * i]));
+    const int32x4_t b = vpaddlq_s16(vld1q_s16(&src[4 * i + 8]));
+    vst1q_s16(&dst[2 * i], vcombine_s16(vmovn_s32(vshrq_n_s32(a, 1)),
+                                        vmovn_s32(vshrq_n_s32(b, 1))));
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  // Multiplying by one and adding pairwise sums the channel pairs.
+  const __m128i ones = _mm_set1_epi16(1);
+  for (; i + 4 <= num_frames; i += 4) {
+    const __m128i a = _mm_madd_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[4 * i])), ones);
+    const __m128i b = _mm_madd_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[4 * i + 8])),
+        ones);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(&dst[2 * i]),
+        _mm_packs_epi32(_mm_srai_epi32(a, 1), _mm_srai_epi32(b, 1)));
+  }
+#endif
+  for (; i < num_frames; ++i) {
+    dst[2 * i] = (static_cast<int32_t>(src[4 * i]) + src[4 * i + 1]) >> 1;
+    dst[2 * i + 1] =
+        (static_cast<int32_t>(src[4 * i + 2]) + src[4 * i + 3]) >> 1;
+  }
+}
+
+// Replicates the `num_frames` mono samples at the start of `data` into stereo
+// frames, in place.
+void UpmixMonoToStereo(int16_t* data, size_t num_frames) {
+  // Going backwards through the frame ensures nothing is irrevocably
+  // overwritten. The frames that do not fill a whole vector are done first.
+  size_t i = num_frames;
+#if defined(WEBRTC_HAS_NEON) || \
+    (defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE))
+  const size_t num_vectorized_frames = num_frames & ~static_cast<size_t>(7);
+#else
+  const size_t num_vectorized_frames = 0;
+#endif
+  for (; i > num_vectorized_frames; --i) {
+    data[2 * i - 1] = data[2 * i - 2] = data[i - 1];
+  }
+#if defined(WEBRTC_HAS_NEON)
+  for (; i > 0; i -= 8) {
+    int16x8x2_t stereo;
+    stereo.val[0] = stereo.val[1] = vld1q_s16(&data[i - 8]);
+    vst2q_s16(&data[2 * (i - 8)], stereo);
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  for (; i > 0; i -= 8) {
+    const __m128i mono =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i - 8]));
+    __m128i* stereo = reinterpret_cast<__m128i*>(&data[2 * (i - 8)]);
+    _mm_storeu_si128(&stereo[0], _mm_unpacklo_epi16(mono, mono));
+    _mm_storeu_si128(&stereo[1], _mm_unpackhi_epi16(mono, mono));
+  }
+#endif
+}
+
+void ScaleWithSatImpl(float scale, int16_t* data, size_t size) {
+  size_t i = 0;
+  // Saturating before the truncating conversion matches saturated_cast<>().
+#if defined(WEBRTC_HAS_NEON)
+  const float32x4_t scale_v = vdupq_n_f32(scale);
+  const float32x4_t max = vdupq_n_f32(32767.f);
+  const float32x4_t min = vdupq_n_f32(-32768.f);
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t x = vld1q_s16(&data[i]);
+    float32x4_t lo = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))),
+                               scale_v);
+    float32x4_t hi = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))),
+                               scale_v);
+    lo = vmaxq_f32(vminq_f32(lo, max), min);
+    hi = vmaxq_f32(vminq_f32(hi, max), min);
+    vst1q_s16(&data[i], vcombine_s16(vmovn_s32(vcvtq_s32_f32(lo)),
+                                     vmovn_s32(vcvtq_s32_f32(hi))));
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  const __m128 scale_v = _mm_set1_ps(scale);
+  const __m128 max = _mm_set1_ps(32767.f);
+  const __m128 min = _mm_set1_ps(-32768.f);
+  for (; i + 8 <= size; i += 8) {
+    __m128i* x = reinterpret_cast<__m128i*>(&data[i]);
+    const __m128i v = _mm_loadu_si128(x);
+    // Sign extend by placing the samples in the upper halves of the lanes.
+    __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+    __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+    lo = _mm_max_ps(_mm_min_ps(_mm_mul_ps(lo, scale_v), max), min);
+    hi = _mm_max_ps(_mm_min_ps(_mm_mul_ps(hi, scale_v), max), min);
+    _mm_storeu_si128(
+        x, _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi)));
+  }
+#endif
+  for (; i < size; ++i) {
+    data[i] = rtc::saturated_cast<int16_t>(scale * data[i]);
+  }
+}
+
 }  // namespace
 
 void AudioFrameOperations::QuadToStereo(
@@ -35,14 +145,10 @@ void AudioFrameOperations::QuadToStereo(
   RTC_DCHECK_EQ(NumChannels(src_audio), 4);
   RTC_DCHECK_EQ(NumChannels(dst_audio), 2);
   RTC_DCHECK_EQ(SamplesPerChannel(src_audio), SamplesPerChannel(dst_audio));
-  for (size_t i = 0; i < SamplesPerChannel(src_audio); ++i) {
-    auto dst_frame = i * 2;
-    dst_audio[dst_frame] =
-        (static_cast<int32_t>(src_audio[4 * i]) + src_audio[4 * i + 1]) >> 1;
-    dst_audio[dst_frame + 1] =
-        (static_cast<int32_t>(src_audio[4 * i + 2]) + src_audio[4 * i + 3]) >>
-        1;
+  if (src_audio.empty()) {
+    return;
   }
+  QuadToStereoImpl(&src_audio[0], SamplesPerChannel(src_audio), &dst_audio[0]);
 }
 
 int AudioFrameOperations::QuadToStereo(AudioFrame* frame) {
@@ -120,9 +226,13 @@ void AudioFrameOperations::UpmixChannels(size_t target_number_of_channels,
     // is irrevocably overwritten.
     auto frame_data = frame->mutable_data(frame->samples_per_channel_,
                                           target_number_of_channels);
-    for (int i = frame->samples_per_channel_ - 1; i >= 0; --i) {
-      for (size_t j = 0; j < target_number_of_channels; ++j) {
-        frame_data[target_number_of_channels * i + j] = frame_data[i];
+    if (target_number_of_channels == 2) {
+      UpmixMonoToStereo(frame_data.data().data(), frame->samples_per_channel_);
+    } else {
+      for (int i = frame->samples_per_channel_ - 1; i >= 0; --i) {
+        for (size_t j = 0; j < target_number_of_channels; ++j) {
+          frame_data[target_number_of_channels * i + j] = frame_data[i];
+        }
       }
     }
   } else {
@@ -206,11 +316,8 @@ int AudioFrameOperations::ScaleWithSat(float scale, AudioFrame* frame) {
     return 0;
   }
 
-  int16_t* frame_data = frame->mutable_data();
-  for (size_t i = 0; i < frame->samples_per_channel_ * frame->num_channels_;
-       i++) {
-    frame_data[i] = rtc::saturated_cast<int16_t>(scale * frame_data[i]);
-  }
+  ScaleWithSatImpl(scale, frame->mutable_data(),
+                   frame->samples_per_channel_ * frame->num_channels_);
   return 0;
 }
 }  // namespace webrtc
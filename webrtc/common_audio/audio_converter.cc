@@ -10,6 +10,7 @@
 
 #include "common_audio/audio_converter.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <utility>
@@ -19,8 +20,150 @@
 #include "common_audio/resampler/push_sinc_resampler.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
+namespace {
+
+// Sum or mix the channels of the leading frames that fill whole vectors and
+// return how many frames that is. The products and sums are in the same order
+// as in the scalar loops, without fused multiply-adds.
+
+#if defined(WEBRTC_HAS_NEON)
+
+size_t SumChannelsSimd(const float* const* src,
+                       size_t num_channels,
+                       size_t frames,
+                       float* dst) {
+  size_t i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    float32x4_t sum = vld1q_f32(&src[0][i]);
+    for (size_t j = 1; j < num_channels; ++j)
+      sum = vaddq_f32(sum, vld1q_f32(&src[j][i]));
+    vst1q_f32(&dst[i], sum);
+  }
+  return i;
+}
+
+size_t MixChannelsSimd(const float* const* src,
+                       size_t src_channels,
+                       const float* mix_matrix,
+                       size_t dst_channels,
+                       size_t frames,
+                       float* const* dst) {
+  size_t i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    for (size_t k = 0; k < dst_channels; ++k) {
+      const float* gains = &mix_matrix[k * src_channels];
+      float32x4_t sum = vmulq_n_f32(vld1q_f32(&src[0][i]), gains[0]);
+      for (size_t j = 1; j < src_channels; ++j)
+        sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(&src[j][i]), gains[j]));
+      vst1q_f32(&dst[k][i], sum);
+    }
+  }
+  return i;
+}
+
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+
+size_t SumChannelsSimd(const float* const* src,
+                       size_t num_channels,
+                       size_t frames,
+                       float* dst) {
+  size_t i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    __m128 sum = _mm_loadu_ps(&src[0][i]);
+    for (size_t j = 1; j < num_channels; ++j)
+      sum = _mm_add_ps(sum, _mm_loadu_ps(&src[j][i]));
+    _mm_storeu_ps(&dst[i], sum);
+  }
+  return i;
+}
+
+size_t MixChannelsSimd(const float* const* src,
+                       size_t src_channels,
+                       const float* mix_matrix,
+                       size_t dst_channels,
+                       size_t frames,
+                       float* const* dst) {
+  size_t i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    for (size_t k = 0; k < dst_channels; ++k) {
+      const float* gains = &mix_matrix[k * src_channels];
+      __m128 sum = _mm_mul_ps(_mm_loadu_ps(&src[0][i]), _mm_set1_ps(gains[0]));
+      for (size_t j = 1; j < src_channels; ++j)
+        sum = _mm_add_ps(
+            sum, _mm_mul_ps(_mm_loadu_ps(&src[j][i]), _mm_set1_ps(gains[j])));
+      _mm_storeu_ps(&dst[k][i], sum);
+    }
+  }
+  return i;
+}
+
+#else
+
+size_t SumChannelsSimd(const float* const* src,
+                       size_t num_channels,
+                       size_t frames,
+                       float* dst) {
+  return 0;
+}
+
+size_t MixChannelsSimd(const float* const* src,
+                       size_t src_channels,
+                       const float* mix_matrix,
+                       size_t dst_channels,
+                       size_t frames,
+                       float* const* dst) {
+  return 0;
+}
+
+#endif
+
+// Averages the channels of `src` into `dst`.
+void DownmixToMono(const float* const* src,
+                   size_t num_channels,
+                   size_t frames,
+                   float* dst) {
+  size_t i = SumChannelsSimd(src, num_channels, frames, dst);
+  for (; i < frames; ++i) {
+    float sum = src[0][i];
+    for (size_t j = 1; j < num_channels; ++j)
+      sum += src[j][i];
+    dst[i] = sum;
+  }
+  for (i = 0; i < frames; ++i)
+    dst[i] /= num_channels;
+}
+
+// Computes each channel of `dst` as the sum of the channels of `src` scaled by
+// the corresponding row of `mix_matrix`.
+void MixChannels(const float* const* src,
+                 size_t src_channels,
+                 const float* mix_matrix,
+                 size_t dst_channels,
+                 size_t frames,
+                 float* const* dst) {
+  for (size_t i = MixChannelsSimd(src, src_channels, mix_matrix, dst_channels,
+                                  frames, dst);
+       i < frames; ++i) {
+    for (size_t k = 0; k < dst_channels; ++k) {
+      const float* gains = &mix_matrix[k * src_channels];
+      float sum = src[0][i] * gains[0];
+      for (size_t j = 1; j < src_channels; ++j)
+        sum += src[j][i] * gains[j];
+      dst[k][i] = sum;
+    }
+  }
+}
+
+}  // namespace
 
 class CopyConverter : public AudioConverter {
  public:
@@ -43,50 +186,71 @@ class CopyConverter : public AudioConverter {
   }
 };
 
-class UpmixConverter : public AudioConverter {
+// Remixes, either with a matrix or by downmixing to mono or upmixing from
+// mono, and resamples if the frame counts differ. The resampling is done on
+// the side of the remix with fewer channels, through `buffer_`.
+class RemixConverter : public AudioConverter {
  public:
-  UpmixConverter(size_t src_channels,
+  RemixConverter(size_t src_channels,
                  size_t src_frames,
                  size_t dst_channels,
-                 size_t dst_frames)
-      : AudioConverter(src_channels, src_frames, dst_channels, dst_frames) {}
-  ~UpmixConverter() override {}
+                 size_t dst_frames,
+                 rtc::ArrayView<const float> mix_matrix)
+      : AudioConverter(src_channels, src_frames, dst_channels, dst_frames),
+        mix_matrix_(mix_matrix.begin(), mix_matrix.end()) {
+    if (src_frames != dst_frames) {
+      const size_t num_resampled = std::min(src_channels, dst_channels);
+      buffer_.reset(new ChannelBuffer<float>(
+          RemixFirst() ? src_frames : dst_frames, num_resampled));
+      resamplers_.reserve(num_resampled);
+      for (size_t i = 0; i < num_resampled; ++i)
+        resamplers_.push_back(std::unique_ptr<PushSincResampler>(
+            new PushSincResampler(src_frames, dst_frames)));
+    }
+  }
+  ~RemixConverter() override {}
 
   void Convert(const float* const* src,
                size_t src_size,
                float* const* dst,
                size_t dst_capacity) override {
     CheckSizes(src_size, dst_capacity);
-    for (size_t i = 0; i < dst_frames(); ++i) {
-      const float value = src[0][i];
-      for (size_t j = 0; j < dst_channels(); ++j)
-        dst[j][i] = value;
+    if (resamplers_.empty()) {
+      Remix(src, dst, src_frames());
+    } else if (RemixFirst()) {
+      Remix(src, buffer_->channels(), src_frames());
+      for (size_t i = 0; i < resamplers_.size(); ++i)
+        resamplers_[i]->Resample(buffer_->channels()[i], src_frames(), dst[i],
+                                 dst_frames());
+    } else {
+      for (size_t i = 0; i < resamplers_.size(); ++i)
+        resamplers_[i]->Resample(src[i], src_frames(), buffer_->channels()[i],
+                                 dst_frames());
+      Remix(buffer_->channels(), dst, dst_frames());
     }
   }
-};
 
-class DownmixConverter : public AudioConverter {
- public:
-  DownmixConverter(size_t src_channels,
-                   size_t src_frames,
-                   size_t dst_channels,
-                   size_t dst_frames)
-      : AudioConverter(src_channels, src_frames, dst_channels, dst_frames) {}
-  ~DownmixConverter() override {}
+ private:
+  bool RemixFirst() const { return dst_channels() <= src_channels(); }
 
-  void Convert(const float* const* src,
-               size_t src_size,
-               float* const* dst,
-               size_t dst_capacity) override {
-    CheckSizes(src_size, dst_capacity);
-    float* dst_mono = dst[0];
-    for (size_t i = 0; i < src_frames(); ++i) {
-      float sum = 0;
-      for (size_t j = 0; j < src_channels(); ++j)
-        sum += src[j][i];
-      dst_mono[i] = sum / src_channels();
+  void Remix(const float* const* src, float* const* dst, size_t frames) {
+    if (!mix_matrix_.empty()) {
+      MixChannels(src, src_channels(), mix_matrix_.data(), dst_channels(),
+                  frames, dst);
+    } else if (dst_channels() == 1) {
+      DownmixToMono(src, src_channels(), frames, dst[0]);
+    } else {
+      RTC_DCHECK_EQ(src_channels(), 1);
+      for (size_t i = 0; i < dst_channels(); ++i) {
+        if (dst[i] != src[0])
+          std::memcpy(dst[i], src[0], frames * sizeof(*dst[i]));
+      }
     }
   }
+
+  const std::vector<float> mix_matrix_;
+  std::unique_ptr<ChannelBuffer<float>> buffer_;
+  std::vector<std::unique_ptr<PushSincResampler>> resamplers_;
 };
 
 class ResampleConverter : public AudioConverter {
@@ -116,74 +280,16 @@ class ResampleConverter : public AudioConverter {
   std::vector<std::unique_ptr<PushSincResampler>> resamplers_;
 };
 
-// Apply a vector of converters in serial, in the order given. At least two
-// converters must be provided.
-class CompositionConverter : public AudioConverter {
- public:
-  explicit CompositionConverter(
-      std::vector<std::unique_ptr<AudioConverter>> converters)
-      : converters_(std::move(converters)) {
-    RTC_CHECK_GE(converters_.size(), 2);
-    // We need an intermediate buffer after every converter.
-    for (auto it = converters_.begin(); it != converters_.end() - 1; ++it)
-      buffers_.push_back(
-          std::unique_ptr<ChannelBuffer<float>>(new ChannelBuffer<float>(
-              (*it)->dst_frames(), (*it)->dst_channels())));
-  }
-  ~CompositionConverter() override {}
-
-  void Convert(const float* const* src,
-               size_t src_size,
-               float* const* dst,
-               size_t dst_capacity) override {
-    converters_.front()->Convert(src, src_size, buffers_.front()->channels(),
-                                 buffers_.front()->size());
-    for (size_t i = 2; i < converters_.size(); ++i) {
-      auto& src_buffer = buffers_[i - 2];
-      auto& dst_buffer = buffers_[i - 1];
-      converters_[i]->Convert(src_buffer->channels(), src_buffer->size(),
-                              dst_buffer->channels(), dst_buffer->size());
-    }
-    converters_.back()->Convert(buffers_.back()->channels(),
-                                buffers_.back()->size(), dst, dst_capacity);
-  }
-
- private:
-  std::vector<std::unique_ptr<AudioConverter>> converters_;
-  std::vector<std::unique_ptr<ChannelBuffer<float>>> buffers_;
-};
-
 std::unique_ptr<AudioConverter> AudioConverter::Create(size_t src_channels,
                                                        size_t src_frames,
                                                        size_t dst_channels,
                                                        size_t dst_frames) {
+  RTC_CHECK(dst_channels == src_channels || dst_channels == 1 ||
+            src_channels == 1);
   std::unique_ptr<AudioConverter> sp;
-  if (src_channels > dst_channels) {
-    if (src_frames != dst_frames) {
-      std::vector<std::unique_ptr<AudioConverter>> converters;
-      converters.push_back(std::unique_ptr<AudioConverter>(new DownmixConverter(
-          src_channels, src_frames, dst_channels, src_frames)));
-      converters.push_back(
-          std::unique_ptr<AudioConverter>(new ResampleConverter(
-              dst_channels, src_frames, dst_channels, dst_frames)));
-      sp.reset(new CompositionConverter(std::move(converters)));
-    } else {
-      sp.reset(new DownmixConverter(src_channels, src_frames, dst_channels,
-                                    dst_frames));
-    }
-  } else if (src_channels < dst_channels) {
-    if (src_frames != dst_frames) {
-      std::vector<std::unique_ptr<AudioConverter>> converters;
-      converters.push_back(
-          std::unique_ptr<AudioConverter>(new ResampleConverter(
-              src_channels, src_frames, src_channels, dst_frames)));
-      converters.push_back(std::unique_ptr<AudioConverter>(new UpmixConverter(
-          src_channels, dst_frames, dst_channels, dst_frames)));
-      sp.reset(new CompositionConverter(std::move(converters)));
-    } else {
-      sp.reset(new UpmixConverter(src_channels, src_frames, dst_channels,
-                                  dst_frames));
-    }
+  if (src_channels != dst_channels) {
+    sp.reset(new RemixConverter(src_channels, src_frames, dst_channels,
+                                dst_frames, {}));
   } else if (src_frames != dst_frames) {
     sp.reset(new ResampleConverter(src_channels, src_frames, dst_channels,
                                    dst_frames));
@@ -195,9 +301,18 @@ std::unique_ptr<AudioConverter> AudioConverter::Create(size_t src_channels,
   return sp;
 }
 
-// For CompositionConverter.
-AudioConverter::AudioConverter()
-    : src_channels_(0), src_frames_(0), dst_channels_(0), dst_frames_(0) {}
+std::unique_ptr<AudioConverter> AudioConverter::Create(
+    size_t src_channels,
+    size_t src_frames,
+    size_t dst_channels,
+    size_t dst_frames,
+    rtc::ArrayView<const float> mix_matrix) {
+  RTC_CHECK_GT(src_channels, 0);
+  RTC_CHECK_GT(dst_channels, 0);
+  RTC_CHECK_EQ(mix_matrix.size(), src_channels * dst_channels);
+  return std::unique_ptr<AudioConverter>(new RemixConverter(
+      src_channels, src_frames, dst_channels, dst_frames, mix_matrix));
+}
 
 AudioConverter::AudioConverter(size_t src_channels,
                                size_t src_frames,
@@ -206,10 +321,7 @@ AudioConverter::AudioConverter(size_t src_channels,
     : src_channels_(src_channels),
       src_frames_(src_frames),
       dst_channels_(dst_channels),
-      dst_frames_(dst_frames) {
-  RTC_CHECK(dst_channels == src_channels || dst_channels == 1 ||
-            src_channels == 1);
-}
+      dst_frames_(dst_frames) {}
 
 void AudioConverter::CheckSizes(size_t src_size, size_t dst_capacity) const {
   RTC_CHECK_EQ(src_size, src_channels() * src_frames());
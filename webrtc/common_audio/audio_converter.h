@@ -15,11 +15,17 @@
 
 #include <memory>
 
+#include "api/array_view.h"
+
 namespace webrtc {
 
-// Format conversion (remixing and resampling) for audio. Only simple remixing
-// conversions are supported: downmix to mono (i.e. `dst_channels` == 1) or
-// upmix from mono (i.e. |src_channels == 1|).
+// Format conversion (remixing and resampling) for audio. Without a mix matrix,
+// only simple remixing conversions are supported: downmix to mono (i.e.
+// `dst_channels` == 1) or upmix from mono (i.e. |src_channels == 1|).
+//
+// Remixing and resampling are done in a single converter, which resamples
+// whichever side of the remix has fewer channels through one intermediate
+// buffer allocated at creation.
 //
 // The source and destination chunks have the same duration in time; specifying
 // the number of frames is equivalent to specifying the sample rates.
@@ -31,6 +37,18 @@ class AudioConverter {
                                                 size_t src_frames,
                                                 size_t dst_channels,
                                                 size_t dst_frames);
+
+  // Like above, but remixes any number of channels with `mix_matrix`, which
+  // holds `dst_channels` rows of `src_channels` gains each: destination
+  // channel i is the sum of source channel j scaled by
+  // `mix_matrix[i * src_channels + j]`. The source and destination buffers
+  // passed to Convert() must not overlap.
+  static std::unique_ptr<AudioConverter> Create(
+      size_t src_channels,
+      size_t src_frames,
+      size_t dst_channels,
+      size_t dst_frames,
+      rtc::ArrayView<const float> mix_matrix);
   virtual ~AudioConverter() {}
 
   AudioConverter(const AudioConverter&) = delete;
@@ -51,7 +69,6 @@ class AudioConverter {
   size_t dst_frames() const { return dst_frames_; }
 
  protected:
-  AudioConverter();
   AudioConverter(size_t src_channels,
                  size_t src_frames,
                  size_t dst_channels,
@@ -10,45 +10,926 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
+namespace {
+
+// Vector versions of the sample format conversions and (de)interleaving
+// loops. Each returns how many samples or frames it converted, and the scalar
+// loops below convert the rest.
+
+#if defined(WEBRTC_HAS_NEON)
+
+// Saturates to the int16_t range and rounds half away from zero, like
+// FloatS16ToS16().
+inline int32x4_t FloatS16ToS32(float32x4_t v) {
+  v = vminq_f32(v, vdupq_n_f32(32767.f));
+  v = vmaxq_f32(v, vdupq_n_f32(-32768.f));
+  const uint32x4_t half = vorrq_u32(
+      vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u)),
+      vreinterpretq_u32_f32(vdupq_n_f32(0.5f)));
+  return vcvtq_s32_f32(vaddq_f32(v, vreinterpretq_f32_u32(half)));
+}
+
+size_t FloatS16ToS16Simd(const float* src,
+                         size_t size,
+                         float scaling,
+                         int16_t* dest) {
+  const float32x4_t scale = vdupq_n_f32(scaling);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int32x4_t lo = FloatS16ToS32(vmulq_f32(vld1q_f32(&src[i]), scale));
+    const int32x4_t hi =
+        FloatS16ToS32(vmulq_f32(vld1q_f32(&src[i + 4]), scale));
+    vst1q_s16(&dest[i], vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+  }
+  return i;
+}
+
+size_t S16ToFloatSimd(const int16_t* src,
+                      size_t size,
+                      float scaling,
+                      float* dest) {
+  const float32x4_t scale = vdupq_n_f32(scaling);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t v = vld1q_s16(&src[i]);
+    vst1q_f32(&dest[i],
+              vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+    vst1q_f32(&dest[i + 4],
+              vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+  }
+  return i;
+}
+
+size_t ClampAndScaleSimd(const float* src,
+                         size_t size,
+                         float limit,
+                         float scaling,
+                         float* dest) {
+  const float32x4_t max = vdupq_n_f32(limit);
+  const float32x4_t min = vdupq_n_f32(-limit);
+  const float32x4_t scale = vdupq_n_f32(scaling);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const float32x4_t v = vmaxq_f32(vminq_f32(vld1q_f32(&src[i]), max), min);
+    vst1q_f32(&dest[i], vmulq_f32(v, scale));
+  }
+  return i;
+}
+
+// Applied to the float samples as they are (de)interleaved.
+struct Identity {
+  float32x4_t operator()(float32x4_t v) const { return v; }
+};
+
+// Clamps to [-limit, limit] and scales, like ClampAndScaleSimd().
+struct ClampAndScale {
+  ClampAndScale(float limit, float scaling)
+      : max(vdupq_n_f32(limit)),
+        min(vdupq_n_f32(-limit)),
+        scale(vdupq_n_f32(scaling)) {}
+  float32x4_t operator()(float32x4_t v) const {
+    return vmulq_f32(vmaxq_f32(vminq_f32(v, max), min), scale);
+  }
+  const float32x4_t max;
+  const float32x4_t min;
+  const float32x4_t scale;
+};
+
+template <typename T>
+size_t DeinterleaveSimd(const T* interleaved,
+                        size_t num_channels,
+                        size_t samples_per_channel,
+                        T* deinterleaved);
+
+template <>
+size_t DeinterleaveSimd<int16_t>(const int16_t* interleaved,
+                                 size_t num_channels,
+                                 size_t samples_per_channel,
+                                 int16_t* deinterleaved) {
+  const size_t n = samples_per_channel;
+  int16_t* const y = deinterleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 8 <= n; j += 8) {
+      const int16x8x2_t x = vld2q_s16(&interleaved[2 * j]);
+      vst1q_s16(&y[j], x.val[0]);
+      vst1q_s16(&y[n + j], x.val[1]);
+    }
+  } else if (num_channels == 4) {
+    for (; j + 8 <= n; j += 8) {
+      const int16x8x4_t x = vld4q_s16(&interleaved[4 * j]);
+      for (int c = 0; c < 4; ++c) {
+        vst1q_s16(&y[c * n + j], x.val[c]);
+      }
+    }
+  } else if (num_channels == 8) {
+    // Every structured load covers four frames and pairs channel c with
+    // channel c + 4, which are then separated by unzipping.
+    for (; j + 8 <= n; j += 8) {
+      const int16x8x4_t a = vld4q_s16(&interleaved[8 * j]);
+      const int16x8x4_t b = vld4q_s16(&interleaved[8 * j + 32]);
+      for (int c = 0; c < 4; ++c) {
+        const int16x8x2_t x = vuzpq_s16(a.val[c], b.val[c]);
+        vst1q_s16(&y[c * n + j], x.val[0]);
+        vst1q_s16(&y[(c + 4) * n + j], x.val[1]);
+      }
+    }
+  }
+  return j;
+}
+
+template <typename Op>
+size_t DeinterleaveFloatSimd(const float* interleaved,
+                             size_t num_channels,
+                             size_t samples_per_channel,
+                             float* deinterleaved,
+                             const Op& op) {
+  const size_t n = samples_per_channel;
+  float* const y = deinterleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 4 <= n; j += 4) {
+      const float32x4x2_t x = vld2q_f32(&interleaved[2 * j]);
+      vst1q_f32(&y[j], op(x.val[0]));
+      vst1q_f32(&y[n + j], op(x.val[1]));
+    }
+  } else if (num_channels == 4) {
+    for (; j + 4 <= n; j += 4) {
+      const float32x4x4_t x = vld4q_f32(&interleaved[4 * j]);
+      for (int c = 0; c < 4; ++c) {
+        vst1q_f32(&y[c * n + j], op(x.val[c]));
+      }
+    }
+  } else if (num_channels == 8) {
+    for (; j + 4 <= n; j += 4) {
+      const float32x4x4_t a = vld4q_f32(&interleaved[8 * j]);
+      const float32x4x4_t b = vld4q_f32(&interleaved[8 * j + 16]);
+      for (int c = 0; c < 4; ++c) {
+        const float32x4x2_t x = vuzpq_f32(a.val[c], b.val[c]);
+        vst1q_f32(&y[c * n + j], op(x.val[0]));
+        vst1q_f32(&y[(c + 4) * n + j], op(x.val[1]));
+      }
+    }
+  }
+  return j;
+}
+
+template <>
+size_t DeinterleaveSimd<float>(const float* interleaved,
+                               size_t num_channels,
+                               size_t samples_per_channel,
+                               float* deinterleaved) {
+  return DeinterleaveFloatSimd(interleaved, num_channels, samples_per_channel,
+                               deinterleaved, Identity());
+}
+
+template <typename T>
+size_t InterleaveSimd(const T* deinterleaved,
+                      size_t num_channels,
+                      size_t samples_per_channel,
+                      T* interleaved);
+
+template <>
+size_t InterleaveSimd<int16_t>(const int16_t* deinterleaved,
+                               size_t num_channels,
+                               size_t samples_per_channel,
+                               int16_t* interleaved) {
+  const size_t n = samples_per_channel;
+  const int16_t* const x = deinterleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 8 <= n; j += 8) {
+      int16x8x2_t y;
+      y.val[0] = vld1q_s16(&x[j]);
+      y.val[1] = vld1q_s16(&x[n + j]);
+      vst2q_s16(&interleaved[2 * j], y);
+    }
+  } else if (num_channels == 4) {
+    for (; j + 8 <= n; j += 8) {
+      int16x8x4_t y;
+      for (int c = 0; c < 4; ++c) {
+        y.val[c] = vld1q_s16(&x[c * n + j]);
+      }
+      vst4q_s16(&interleaved[4 * j], y);
+    }
+  } else if (num_channels == 8) {
+    for (; j + 8 <= n; j += 8) {
+      int16x8x4_t a;
+      int16x8x4_t b;
+      for (int c = 0; c < 4; ++c) {
+        const int16x8x2_t y =
+            vzipq_s16(vld1q_s16(&x[c * n + j]), vld1q_s16(&x[(c + 4) * n + j]));
+        a.val[c] = y.val[0];
+        b.val[c] = y.val[1];
+      }
+      vst4q_s16(&interleaved[8 * j], a);
+      vst4q_s16(&interleaved[8 * j + 32], b);
+    }
+  }
+  return j;
+}
+
+template <typename Op>
+size_t InterleaveFloatSimd(const float* deinterleaved,
+                           size_t num_channels,
+                           size_t samples_per_channel,
+                           float* interleaved,
+                           const Op& op) {
+  const size_t n = samples_per_channel;
+  const float* const x = deinterleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 4 <= n; j += 4) {
+      float32x4x2_t y;
+      y.val[0] = op(vld1q_f32(&x[j]));
+      y.val[1] = op(vld1q_f32(&x[n + j]));
+      vst2q_f32(&interleaved[2 * j], y);
+    }
+  } else if (num_channels == 4) {
+    for (; j + 4 <= n; j += 4) {
+      float32x4x4_t y;
+      for (int c = 0; c < 4; ++c) {
+        y.val[c] = op(vld1q_f32(&x[c * n + j]));
+      }
+      vst4q_f32(&interleaved[4 * j], y);
+    }
+  } else if (num_channels == 8) {
+    for (; j + 4 <= n; j += 4) {
+      float32x4x4_t a;
+      float32x4x4_t b;
+      for (int c = 0; c < 4; ++c) {
+        const float32x4x2_t y = vzipq_f32(op(vld1q_f32(&x[c * n + j])),
+                                          op(vld1q_f32(&x[(c + 4) * n + j])));
+        a.val[c] = y.val[0];
+        b.val[c] = y.val[1];
+      }
+      vst4q_f32(&interleaved[8 * j], a);
+      vst4q_f32(&interleaved[8 * j + 16], b);
+    }
+  }
+  return j;
+}
+
+template <>
+size_t InterleaveSimd<float>(const float* deinterleaved,
+                             size_t num_channels,
+                             size_t samples_per_channel,
+                             float* interleaved) {
+  return InterleaveFloatSimd(deinterleaved, num_channels, samples_per_channel,
+                             interleaved, Identity());
+}
+
+// Divides by 2^`shift` with truncation towards zero, like the integer
+// division in the scalar downmix.
+template <int shift>
+inline int16x4_t DivideAndNarrow(int32x4_t sum) {
+  const int32x4_t bias = vreinterpretq_s32_u32(
+      vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(sum, 31)), 32 - shift));
+  return vmovn_s32(vshrq_n_s32(vaddq_s32(sum, bias), shift));
+}
+
+size_t DownmixInterleavedToMonoSimd(const int16_t* interleaved,
+                                    size_t num_frames,
+                                    int num_channels,
+                                    int16_t* deinterleaved) {
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 8 <= num_frames; j += 8) {
+      const int16x8x2_t x = vld2q_s16(&interleaved[2 * j]);
+      const int32x4_t lo = vaddl_s16(vget_low_s16(x.val[0]),
+                                     vget_low_s16(x.val[1]));
+      const int32x4_t hi = vaddl_s16(vget_high_s16(x.val[0]),
+                                     vget_high_s16(x.val[1]));
+      vst1q_s16(&deinterleaved[j],
+                vcombine_s16(DivideAndNarrow<1>(lo), DivideAndNarrow<1>(hi)));
+    }
+  } else if (num_channels == 4) {
+    for (; j + 8 <= num_frames; j += 8) {
+      const int16x8x4_t x = vld4q_s16(&interleaved[4 * j]);
+      int32x4_t lo = vaddl_s16(vget_low_s16(x.val[0]), vget_low_s16(x.val[1]));
+      int32x4_t hi =
+          vaddl_s16(vget_high_s16(x.val[0]), vget_high_s16(x.val[1]));
+      lo = vaddw_s16(vaddw_s16(lo, vget_low_s16(x.val[2])),
+                     vget_low_s16(x.val[3]));
+      hi = vaddw_s16(vaddw_s16(hi, vget_high_s16(x.val[2])),
+                     vget_high_s16(x.val[3]));
+      vst1q_s16(&deinterleaved[j],
+                vcombine_s16(DivideAndNarrow<2>(lo), DivideAndNarrow<2>(hi)));
+    }
+  }
+  return j;
+}
+
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+
+// Saturates to the int16_t range and rounds half away from zero, like
+// FloatS16ToS16().
+inline __m128i FloatS16ToS32(__m128 v) {
+  v = _mm_min_ps(v, _mm_set1_ps(32767.f));
+  v = _mm_max_ps(v, _mm_set1_ps(-32768.f));
+  const __m128 half =
+      _mm_or_ps(_mm_and_ps(v, _mm_set1_ps(-0.f)), _mm_set1_ps(0.5f));
+  return _mm_cvttps_epi32(_mm_add_ps(v, half));
+}
+
+size_t FloatS16ToS16Simd(const float* src,
+                         size_t size,
+                         float scaling,
+                         int16_t* dest) {
+  const __m128 scale = _mm_set1_ps(scaling);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i lo =
+        FloatS16ToS32(_mm_mul_ps(_mm_loadu_ps(&src[i]), scale));
+    const __m128i hi =
+        FloatS16ToS32(_mm_mul_ps(_mm_loadu_ps(&src[i + 4]), scale));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dest[i]),
+                     _mm_packs_epi32(lo, hi));
+  }
+  return i;
+}
+
+size_t S16ToFloatSimd(const int16_t* src,
+                      size_t size,
+                      float scaling,
+                      float* dest) {
+  const __m128 scale = _mm_set1_ps(scaling);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    // Sign extend by placing the samples in the upper halves of the lanes.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(&dest[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  return i;
+}
+
+size_t ClampAndScaleSimd(const float* src,
+                         size_t size,
+                         float limit,
+                         float scaling,
+                         float* dest) {
+  const __m128 max = _mm_set1_ps(limit);
+  const __m128 min = _mm_set1_ps(-limit);
+  const __m128 scale = _mm_set1_ps(scaling);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const __m128 v = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(&src[i]), max), min);
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(v, scale));
+  }
+  return i;
+}
+
+// Transposes an 8x8 matrix of 16-bit values held in eight rows.
+inline void Transpose8x8(__m128i* r) {
+  const __m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+  const __m128i t1 = _mm_unpackhi_epi16(r[0], r[1]);
+  const __m128i t2 = _mm_unpacklo_epi16(r[2], r[3]);
+  const __m128i t3 = _mm_unpackhi_epi16(r[2], r[3]);
+  const __m128i t4 = _mm_unpacklo_epi16(r[4], r[5]);
+  const __m128i t5 = _mm_unpackhi_epi16(r[4], r[5]);
+  const __m128i t6 = _mm_unpacklo_epi16(r[6], r[7]);
+  const __m128i t7 = _mm_unpackhi_epi16(r[6], r[7]);
+  const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+  const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+  const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+  const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+  const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+  const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+  const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+  const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+  r[0] = _mm_unpacklo_epi64(u0, u4);
+  r[1] = _mm_unpackhi_epi64(u0, u4);
+  r[2] = _mm_unpacklo_epi64(u1, u5);
+  r[3] = _mm_unpackhi_epi64(u1, u5);
+  r[4] = _mm_unpacklo_epi64(u2, u6);
+  r[5] = _mm_unpackhi_epi64(u2, u6);
+  r[6] = _mm_unpacklo_epi64(u3, u7);
+  r[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+inline void Transpose4x4(__m128* r) {
+  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+}
+
+// Applied to the float samples as they are (de)interleaved.
+struct Identity {
+  __m128 operator()(__m128 v) const { return v; }
+};
+
+// Clamps to [-limit, limit] and scales, like ClampAndScaleSimd().
+struct ClampAndScale {
+  ClampAndScale(float limit, float scaling)
+      : max(_mm_set1_ps(limit)),
+        min(_mm_set1_ps(-limit)),
+        scale(_mm_set1_ps(scaling)) {}
+  __m128 operator()(__m128 v) const {
+    return _mm_mul_ps(_mm_max_ps(_mm_min_ps(v, max), min), scale);
+  }
+  const __m128 max;
+  const __m128 min;
+  const __m128 scale;
+};
+
+template <typename T>
+size_t DeinterleaveSimd(const T* interleaved,
+                        size_t num_channels,
+                        size_t samples_per_channel,
+                        T* deinterleaved);
+
+template <>
+size_t DeinterleaveSimd<int16_t>(const int16_t* interleaved,
+                                 size_t num_channels,
+                                 size_t samples_per_channel,
+                                 int16_t* deinterleaved) {
+  const __m128i* x = reinterpret_cast<const __m128i*>(interleaved);
+  const size_t n = samples_per_channel;
+  int16_t* const y = deinterleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 8 <= n; j += 8, x += 2) {
+      const __m128i a = _mm_loadu_si128(&x[0]);
+      const __m128i b = _mm_loadu_si128(&x[1]);
+      // The even samples are sign extended from the lower halves of the
+      // 32-bit lanes, the odd ones from the upper halves.
+      const __m128i left =
+          _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                          _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+      const __m128i right =
+          _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[j]), left);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[n + j]), right);
+    }
+  } else if (num_channels == 4) {
+    for (; j + 4 <= n; j += 4, x += 2) {
+      const __m128i a = _mm_loadu_si128(&x[0]);
+      const __m128i b = _mm_loadu_si128(&x[1]);
+      const __m128i t0 = _mm_unpacklo_epi16(a, b);
+      const __m128i t1 = _mm_unpackhi_epi16(a, b);
+      const __m128i c01 = _mm_unpacklo_epi16(t0, t1);
+      const __m128i c23 = _mm_unpackhi_epi16(t0, t1);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&y[j]), c01);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&y[n + j]),
+                       _mm_unpackhi_epi64(c01, c01));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&y[2 * n + j]), c23);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(&y[3 * n + j]),
+                       _mm_unpackhi_epi64(c23, c23));
+    }
+  } else if (num_channels == 8) {
+    for (; j + 8 <= n; j += 8, x += 8) {
+      __m128i r[8];
+      for (int k = 0; k < 8; ++k) {
+        r[k] = _mm_loadu_si128(&x[k]);
+      }
+      Transpose8x8(r);
+      for (int c = 0; c < 8; ++c) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[c * n + j]), r[c]);
+      }
+    }
+  }
+  return j;
+}
+
+template <typename Op>
+size_t DeinterleaveFloatSimd(const float* interleaved,
+                             size_t num_channels,
+                             size_t samples_per_channel,
+                             float* deinterleaved,
+                             const Op& op) {
+  const float* x = interleaved;
+  const size_t n = samples_per_channel;
+  float* const y = deinterleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 4 <= n; j += 4, x += 8) {
+      const __m128 a = op(_mm_loadu_ps(&x[0]));
+      const __m128 b = op(_mm_loadu_ps(&x[4]));
+      _mm_storeu_ps(&y[j], _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm_storeu_ps(&y[n + j], _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+  } else if (num_channels == 4) {
+    for (; j + 4 <= n; j += 4, x += 16) {
+      __m128 r[4];
+      for (int k = 0; k < 4; ++k) {
+        r[k] = op(_mm_loadu_ps(&x[4 * k]));
+      }
+      Transpose4x4(r);
+      for (int c = 0; c < 4; ++c) {
+        _mm_storeu_ps(&y[c * n + j], r[c]);
+      }
+    }
+  } else if (num_channels == 8) {
+    // The first and last four channels of four frames are transposed
+    // separately.
+    for (; j + 4 <= n; j += 4, x += 32) {
+      __m128 lo[4];
+      __m128 hi[4];
+      for (int k = 0; k < 4; ++k) {
+        lo[k] = op(_mm_loadu_ps(&x[8 * k]));
+        hi[k] = op(_mm_loadu_ps(&x[8 * k + 4]));
+      }
+      Transpose4x4(lo);
+      Transpose4x4(hi);
+      for (int c = 0; c < 4; ++c) {
+        _mm_storeu_ps(&y[c * n + j], lo[c]);
+        _mm_storeu_ps(&y[(c + 4) * n + j], hi[c]);
+      }
+    }
+  }
+  return j;
+}
+
+template <>
+size_t DeinterleaveSimd<float>(const float* interleaved,
+                               size_t num_channels,
+                               size_t samples_per_channel,
+                               float* deinterleaved) {
+  return DeinterleaveFloatSimd(interleaved, num_channels, samples_per_channel,
+                               deinterleaved, Identity());
+}
+
+template <typename T>
+size_t InterleaveSimd(const T* deinterleaved,
+                      size_t num_channels,
+                      size_t samples_per_channel,
+                      T* interleaved);
+
+template <>
+size_t InterleaveSimd<int16_t>(const int16_t* deinterleaved,
+                               size_t num_channels,
+                               size_t samples_per_channel,
+                               int16_t* interleaved) {
+  const size_t n = samples_per_channel;
+  const int16_t* const x = deinterleaved;
+  __m128i* y = reinterpret_cast<__m128i*>(interleaved);
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 8 <= n; j += 8, y += 2) {
+      const __m128i left =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[j]));
+      const __m128i right =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[n + j]));
+      _mm_storeu_si128(&y[0], _mm_unpacklo_epi16(left, right));
+      _mm_storeu_si128(&y[1], _mm_unpackhi_epi16(left, right));
+    }
+  } else if (num_channels == 4) {
+    for (; j + 4 <= n; j += 4, y += 2) {
+      __m128i c[4];
+      for (int k = 0; k < 4; ++k) {
+        c[k] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&x[k * n + j]));
+      }
+      const __m128i c01 = _mm_unpacklo_epi16(c[0], c[1]);
+      const __m128i c23 = _mm_unpacklo_epi16(c[2], c[3]);
+      _mm_storeu_si128(&y[0], _mm_unpacklo_epi32(c01, c23));
+      _mm_storeu_si128(&y[1], _mm_unpackhi_epi32(c01, c23));
+    }
+  } else if (num_channels == 8) {
+    for (; j + 8 <= n; j += 8, y += 8) {
+      __m128i r[8];
+      for (int c = 0; c < 8; ++c) {
+        r[c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[c * n + j]));
+      }
+      Transpose8x8(r);
+      for (int k = 0; k < 8; ++k) {
+        _mm_storeu_si128(&y[k], r[k]);
+      }
+    }
+  }
+  return j;
+}
+
+template <typename Op>
+size_t InterleaveFloatSimd(const float* deinterleaved,
+                           size_t num_channels,
+                           size_t samples_per_channel,
+                           float* interleaved,
+                           const Op& op) {
+  const size_t n = samples_per_channel;
+  const float* const x = deinterleaved;
+  float* y = interleaved;
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 4 <= n; j += 4, y += 8) {
+      const __m128 left = op(_mm_loadu_ps(&x[j]));
+      const __m128 right = op(_mm_loadu_ps(&x[n + j]));
+      _mm_storeu_ps(&y[0], _mm_unpacklo_ps(left, right));
+      _mm_storeu_ps(&y[4], _mm_unpackhi_ps(left, right));
+    }
+  } else if (num_channels == 4) {
+    for (; j + 4 <= n; j += 4, y += 16) {
+      __m128 r[4];
+      for (int c = 0; c < 4; ++c) {
+        r[c] = op(_mm_loadu_ps(&x[c * n + j]));
+      }
+      Transpose4x4(r);
+      for (int k = 0; k < 4; ++k) {
+        _mm_storeu_ps(&y[4 * k], r[k]);
+      }
+    }
+  } else if (num_channels == 8) {
+    for (; j + 4 <= n; j += 4, y += 32) {
+      __m128 lo[4];
+      __m128 hi[4];
+      for (int c = 0; c < 4; ++c) {
+        lo[c] = op(_mm_loadu_ps(&x[c * n + j]));
+        hi[c] = op(_mm_loadu_ps(&x[(c + 4) * n + j]));
+      }
+      Transpose4x4(lo);
+      Transpose4x4(hi);
+      for (int k = 0; k < 4; ++k) {
+        _mm_storeu_ps(&y[8 * k], lo[k]);
+        _mm_storeu_ps(&y[8 * k + 4], hi[k]);
+      }
+    }
+  }
+  return j;
+}
+
+template <>
+size_t InterleaveSimd<float>(const float* deinterleaved,
+                             size_t num_channels,
+                             size_t samples_per_channel,
+                             float* interleaved) {
+  return InterleaveFloatSimd(deinterleaved, num_channels, samples_per_channel,
+                             interleaved, Identity());
+}
+
+// Adds the two 32-bit lanes of each 64-bit pair in `a` and `b`, giving
+// a0 + a1, a2 + a3, b0 + b1, b2 + b3.
+inline __m128i AddPairs(__m128i a, __m128i b) {
+  const __m128 fa = _mm_castsi128_ps(a);
+  const __m128 fb = _mm_castsi128_ps(b);
+  return _mm_add_epi32(
+      _mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0))),
+      _mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1))));
+}
+
+// Divides by 2^`shift` with truncation towards zero, like the integer
+// division in the scalar downmix.
+template <int shift>
+inline __m128i Divide(__m128i sum) {
+  const __m128i bias = _mm_srli_epi32(_mm_srai_epi32(sum, 31), 32 - shift);
+  return _mm_srai_epi32(_mm_add_epi32(sum, bias), shift);
+}
+
+size_t DownmixInterleavedToMonoSimd(const int16_t* interleaved,
+                                    size_t num_frames,
+                                    int num_channels,
+                                    int16_t* deinterleaved) {
+  const __m128i* x = reinterpret_cast<const __m128i*>(interleaved);
+  const __m128i ones = _mm_set1_epi16(1);
+  size_t j = 0;
+  if (num_channels == 2) {
+    for (; j + 8 <= num_frames; j += 8, x += 2) {
+      // Multiplying by one and adding pairwise sums the two channels.
+      const __m128i lo = _mm_madd_epi16(_mm_loadu_si128(&x[0]), ones);
+      const __m128i hi = _mm_madd_epi16(_mm_loadu_si128(&x[1]), ones);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&deinterleaved[j]),
+                       _mm_packs_epi32(Divide<1>(lo), Divide<1>(hi)));
+    }
+  } else if (num_channels == 4) {
+    for (; j + 8 <= num_frames; j += 8, x += 4) {
+      const __m128i s0 = _mm_madd_epi16(_mm_loadu_si128(&x[0]), ones);
+      const __m128i s1 = _mm_madd_epi16(_mm_loadu_si128(&x[1]), ones);
+      const __m128i s2 = _mm_madd_epi16(_mm_loadu_si128(&x[2]), ones);
+      const __m128i s3 = _mm_madd_epi16(_mm_loadu_si128(&x[3]), ones);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&deinterleaved[j]),
+                       _mm_packs_epi32(Divide<2>(AddPairs(s0, s1)),
+                                       Divide<2>(AddPairs(s2, s3))));
+    }
+  }
+  return j;
+}
+
+#else
+
+size_t FloatS16ToS16Simd(const float*, size_t, float, int16_t*) {
+  return 0;
+}
+
+size_t S16ToFloatSimd(const int16_t*, size_t, float, float*) {
+  return 0;
+}
+
+size_t ClampAndScaleSimd(const float*, size_t, float, float, float*) {
+  return 0;
+}
+
+template <typename T>
+size_t DeinterleaveSimd(const T*, size_t, size_t, T*) {
+  return 0;
+}
+
+template <typename T>
+size_t InterleaveSimd(const T*, size_t, size_t, T*) {
+  return 0;
+}
+
+struct ClampAndScale {
+  ClampAndScale(float, float) {}
+};
+
+template <typename Op>
+size_t DeinterleaveFloatSimd(const float*, size_t, size_t, float*, const Op&) {
+  return 0;
+}
+
+template <typename Op>
+size_t InterleaveFloatSimd(const float*, size_t, size_t, float*, const Op&) {
+  return 0;
+}
+
+size_t DownmixInterleavedToMonoSimd(const int16_t*, size_t, int, int16_t*) {
+  return 0;
+}
+
+#endif
+
+// Deinterleaves the frames from `first_frame` onwards, applying `op` to each
+// sample.
+template <typename T, typename Op>
+void DeinterleaveFrom(size_t first_frame,
+                      const InterleavedView<const T>& interleaved,
+                      const DeinterleavedView<T>& deinterleaved,
+                      Op op) {
+  const size_t num_channels = NumChannels(interleaved);
+  for (size_t i = 0; i < num_channels; ++i) {
+    MonoView<T> channel = deinterleaved[i];
+    size_t interleaved_idx = first_frame * num_channels + i;
+    for (size_t j = first_frame; j < channel.size(); ++j) {
+      channel[j] = op(interleaved[interleaved_idx]);
+      interleaved_idx += num_channels;
+    }
+  }
+}
+
+// Interleaves the frames from `first_frame` onwards, applying `op` to each
+// sample.
+template <typename T, typename Op>
+void InterleaveFrom(size_t first_frame,
+                    const DeinterleavedView<const T>& deinterleaved,
+                    const InterleavedView<T>& interleaved,
+                    Op op) {
+  const size_t num_channels = NumChannels(deinterleaved);
+  for (size_t i = 0; i < num_channels; ++i) {
+    const auto channel = deinterleaved[i];
+    size_t interleaved_idx = first_frame * num_channels + i;
+    for (size_t j = first_frame; j < channel.size(); ++j) {
+      interleaved[interleaved_idx] = op(channel[j]);
+      interleaved_idx += num_channels;
+    }
+  }
+}
+
+template <typename T>
+void DeinterleaveImpl(const InterleavedView<const T>& interleaved,
+                      const DeinterleavedView<T>& deinterleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  if (interleaved.empty()) {
+    return;
+  }
+  const size_t done = DeinterleaveSimd<T>(
+      interleaved.data().data(), NumChannels(interleaved),
+      SamplesPerChannel(interleaved), deinterleaved.data().data());
+  DeinterleaveFrom(done, interleaved, deinterleaved, [](T v) { return v; });
+}
+
+template <typename T>
+void InterleaveImpl(const DeinterleavedView<const T>& deinterleaved,
+                    const InterleavedView<T>& interleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  if (interleaved.empty()) {
+    return;
+  }
+  const size_t done = InterleaveSimd<T>(
+      deinterleaved.data().data(), NumChannels(deinterleaved),
+      SamplesPerChannel(deinterleaved), interleaved.data().data());
+  InterleaveFrom(done, deinterleaved, interleaved, [](T v) { return v; });
+}
+
+}  // namespace
 
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = FloatS16ToS16Simd(src, size, 32768.f, dest); i < size; ++i)
     dest[i] = FloatToS16(src[i]);
 }
 
 void S16ToFloat(const int16_t* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = S16ToFloatSimd(src, size, 1.f / 32768.f, dest); i < size;
+       ++i)
     dest[i] = S16ToFloat(src[i]);
 }
 
 void S16ToFloatS16(const int16_t* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = S16ToFloatSimd(src, size, 1.f, dest); i < size; ++i)
     dest[i] = src[i];
 }
 
 void FloatS16ToS16(const float* src, size_t size, int16_t* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = FloatS16ToS16Simd(src, size, 1.f, dest); i < size; ++i)
     dest[i] = FloatS16ToS16(src[i]);
 }
 
 void FloatToFloatS16(const float* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = ClampAndScaleSimd(src, size, 1.f, 32768.f, dest); i < size;
+       ++i)
     dest[i] = FloatToFloatS16(src[i]);
 }
 
 void FloatS16ToFloat(const float* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  for (size_t i = ClampAndScaleSimd(src, size, 32768.f, 1.f / 32768.f, dest);
+       i < size; ++i)
     dest[i] = FloatS16ToFloat(src[i]);
 }
 
+template <>
+void Deinterleave<int16_t>(const InterleavedView<const int16_t>& interleaved,
+                           const DeinterleavedView<int16_t>& deinterleaved) {
+  DeinterleaveImpl(interleaved, deinterleaved);
+}
+
+template <>
+void Deinterleave<float>(const InterleavedView<const float>& interleaved,
+                         const DeinterleavedView<float>& deinterleaved) {
+  DeinterleaveImpl(interleaved, deinterleaved);
+}
+
+template <>
+void Interleave<int16_t>(const DeinterleavedView<const int16_t>& deinterleaved,
+                         const InterleavedView<int16_t>& interleaved) {
+  InterleaveImpl(deinterleaved, interleaved);
+}
+
+template <>
+void Interleave<float>(const DeinterleavedView<const float>& deinterleaved,
+                       const InterleavedView<float>& interleaved) {
+  InterleaveImpl(deinterleaved, interleaved);
+}
+
+void DeinterleaveFloatToFloatS16(
+    const InterleavedView<const float>& interleaved,
+    const DeinterleavedView<float>& deinterleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  if (interleaved.empty()) {
+    return;
+  }
+  const size_t done = DeinterleaveFloatSimd(
+      interleaved.data().data(), NumChannels(interleaved),
+      SamplesPerChannel(interleaved), deinterleaved.data().data(),
+      ClampAndScale(1.f, 32768.f));
+  DeinterleaveFrom(done, interleaved, deinterleaved,
+                   [](float v) { return FloatToFloatS16(v); });
+}
+
+void InterleaveFloatS16ToFloat(
+    const DeinterleavedView<const float>& deinterleaved,
+    const InterleavedView<float>& interleaved) {
+  RTC_DCHECK_EQ(NumChannels(interleaved), NumChannels(deinterleaved));
+  RTC_DCHECK_EQ(SamplesPerChannel(interleaved),
+                SamplesPerChannel(deinterleaved));
+  if (interleaved.empty()) {
+    return;
+  }
+  const size_t done = InterleaveFloatSimd(
+      deinterleaved.data().data(), NumChannels(deinterleaved),
+      SamplesPerChannel(deinterleaved), interleaved.data().data(),
+      ClampAndScale(32768.f, 1.f / 32768.f));
+  InterleaveFrom(done, deinterleaved, interleaved,
+                 [](float v) { return FloatS16ToFloat(v); });
+}
+
 template <>
 void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        size_t num_frames,
                                        int num_channels,
                                        int16_t* deinterleaved) {
-  DownmixInterleavedToMonoImpl<int16_t, int32_t>(interleaved, num_frames,
-                                                 num_channels, deinterleaved);
+  RTC_DCHECK_GT(num_channels, 0);
+  RTC_DCHECK_GT(num_frames, 0);
+  const size_t done = DownmixInterleavedToMonoSimd(interleaved, num_frames,
+                                                   num_channels, deinterleaved);
+  if (done < num_frames) {
+    DownmixInterleavedToMonoImpl<int16_t, int32_t>(
+        interleaved + done * num_channels, num_frames - done, num_channels,
+        deinterleaved + done);
+  }
 }
 
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #include "common_audio/fir_filter_factory.h"
 
 #include "common_audio/fir_filter_c.h"
+#include "common_audio/fir_filter_fft.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/system/arch.h"
 
@@ -23,6 +24,13 @@
 #endif
 
 namespace webrtc {
+namespace {
+
+// From this length on, the partitioned FFT convolution is cheaper than the
+// vectorized direct form.
+constexpr size_t kMinCoefficientsLengthForFft = 256;
+
+}  // namespace
 
 FIRFilter* CreateFirFilter(const float* coefficients,
                            size_t coefficients_length,
@@ -32,6 +40,11 @@ FIRFilter* CreateFirFilter(const float* coefficients,
     return nullptr;
   }
 
+  if (coefficients_length >= kMinCoefficientsLengthForFft) {
+    return new FIRFilterFFT(coefficients, coefficients_length,
+                            max_input_length);
+  }
+
   FIRFilter* filter = nullptr;
 // If we know the minimum architecture at compile time, avoid CPU detection.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
@@ -23,6 +23,8 @@ class FIRFilter;
 // `max_input_length`. This is needed because, when vectorizing it is
 // necessary to concatenate the input after the state, and resizing this array
 // dynamically is expensive.
+// Long filters are implemented with partitioned FFT convolution (see
+// FIRFilterFFT), which gives slightly different rounding than the direct form.
 FIRFilter* CreateFirFilter(const float* coefficients,
                            size_t coefficients_length,
                            size_t max_input_length);
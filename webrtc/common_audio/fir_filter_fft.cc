@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/fir_filter_fft.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "common_audio/fir_filter_factory.h"
+#include "rtc_base/checks.h"
+#include "third_party/pffft/src/pffft.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kFftSize = 2 * FIRFilterFFT::kBlockSize;
+
+float* AllocateZeroed(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  float* buffer = static_cast<float*>(AlignedMalloc(sizeof(float) * size, 16));
+  memset(buffer, 0, sizeof(float) * size);
+  return buffer;
+}
+
+}  // namespace
+
+FIRFilterFFT::FIRFilterFFT(const float* coefficients,
+                           size_t coefficients_length,
+                           size_t max_input_length,
+                           size_t num_channels)
+    : num_partitions_((coefficients_length - 1) / kBlockSize),
+      fft_setup_(pffft_new_setup(kFftSize, PFFFT_REAL)),
+      partitions_(AllocateZeroed(num_partitions_ * kFftSize)),
+      fft_work_(AllocateZeroed(kFftSize)),
+      channels_(num_channels) {
+  RTC_DCHECK_GT(coefficients_length, 0);
+  RTC_DCHECK_GT(num_channels, 0);
+  RTC_CHECK(fft_setup_);
+
+  // The partitions are scaled by the inverse of the FFT size, which the
+  // backward transform does not compensate for.
+  AlignedBuffer partition(AllocateZeroed(kFftSize));
+  for (size_t p = 0; p < num_partitions_; ++p) {
+    const size_t first = (p + 1) * kBlockSize;
+    const size_t length = std::min(kBlockSize, coefficients_length - first);
+    for (size_t i = 0; i < length; ++i) {
+      partition[i] = coefficients[first + i] / kFftSize;
+    }
+    std::fill(&partition[length], &partition[kFftSize], 0.f);
+    pffft_transform(fft_setup_, partition.get(), &partitions_[p * kFftSize],
+                    fft_work_.get(), PFFFT_FORWARD);
+  }
+
+  const size_t head_length = std::min(coefficients_length, kBlockSize);
+  for (ChannelState& channel : channels_) {
+    channel.head_filter.reset(CreateFirFilter(
+        coefficients, head_length, std::min(max_input_length, kBlockSize)));
+    channel.input.reset(AllocateZeroed(kFftSize));
+    channel.spectra.reset(AllocateZeroed(num_partitions_ * kFftSize));
+    channel.accumulator.reset(AllocateZeroed(kFftSize));
+  }
+}
+
+FIRFilterFFT::~FIRFilterFFT() {
+  pffft_destroy_setup(fft_setup_);
+}
+
+void FIRFilterFFT::Filter(const float* in, size_t length, float* out) {
+  Filter(rtc::ArrayView<const float* const>(&in, 1), length,
+         rtc::ArrayView<float* const>(&out, 1));
+}
+
+void FIRFilterFFT::Filter(rtc::ArrayView<const float* const> in,
+                          size_t length,
+                          rtc::ArrayView<float* const> out) {
+  RTC_DCHECK_EQ(in.size(), channels_.size());
+  RTC_DCHECK_EQ(out.size(), channels_.size());
+
+  // The input is processed up to each block boundary at a time, where the
+  // output of the partitions for the next block is computed.
+  for (size_t done = 0; done < length;) {
+    const size_t chunk = std::min(length - done, kBlockSize - block_position_);
+    for (size_t ch = 0; ch < channels_.size(); ++ch) {
+      ChannelState& channel = channels_[ch];
+      // The input is stored first, since `in` and `out` may alias.
+      memcpy(&channel.input[kBlockSize + block_position_], &in[ch][done],
+             chunk * sizeof(float));
+      channel.head_filter->Filter(&in[ch][done], chunk, &out[ch][done]);
+      const float* tail = &channel.accumulator[kBlockSize + block_position_];
+      for (size_t i = 0; i < chunk; ++i) {
+        out[ch][done + i] += tail[i];
+      }
+    }
+
+    done += chunk;
+    block_position_ += chunk;
+    if (block_position_ == kBlockSize) {
+      ProcessBlock();
+      block_position_ = 0;
+    }
+  }
+}
+
+void FIRFilterFFT::ProcessBlock() {
+  if (num_partitions_ == 0) {
+    return;
+  }
+
+  // The spectra are stored backwards, so that the one delayed by `p` blocks is
+  // the `p`-th following the newest.
+  newest_spectrum_ =
+      newest_spectrum_ == 0 ? num_partitions_ - 1 : newest_spectrum_ - 1;
+  for (ChannelState& channel : channels_) {
+    pffft_transform(fft_setup_, channel.input.get(),
+                    &channel.spectra[newest_spectrum_ * kFftSize],
+                    fft_work_.get(), PFFFT_FORWARD);
+    memcpy(channel.input.get(), &channel.input[kBlockSize],
+           kBlockSize * sizeof(float));
+    memset(channel.accumulator.get(), 0, kFftSize * sizeof(float));
+  }
+
+  // The newest spectrum is multiplied with the partition delayed by one block,
+  // since its output is for the next block. Each partition is applied to all
+  // channels before moving on to the next.
+  size_t spectrum = newest_spectrum_;
+  for (size_t p = 0; p < num_partitions_; ++p) {
+    const float* partition = &partitions_[p * kFftSize];
+    for (ChannelState& channel : channels_) {
+      pffft_zconvolve_accumulate(fft_setup_,
+                                 &channel.spectra[spectrum * kFftSize],
+                                 partition, channel.accumulator.get(), 1.f);
+    }
+    spectrum = spectrum + 1 == num_partitions_ ? 0 : spectrum + 1;
+  }
+
+  // Overlap-save: only the second half of the circular convolution is valid.
+  for (ChannelState& channel : channels_) {
+    pffft_transform(fft_setup_, channel.accumulator.get(),
+                    channel.accumulator.get(), fft_work_.get(),
+                    PFFFT_BACKWARD);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_FIR_FILTER_FFT_H_
+#define COMMON_AUDIO_FIR_FILTER_FFT_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "common_audio/fir_filter.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+// Forward declaration.
+struct PFFFT_Setup;
+
+namespace webrtc {
+
+// FIR filter for long filters, whose cost per sample grows with the logarithm
+// of the number of coefficients instead of linearly.
+//
+// The first kBlockSize coefficients are applied in the time domain by a
+// direct-form filter, so that the output has no added latency and the input
+// can be fed in chunks of any length. The remaining coefficients are split in
+// partitions of kBlockSize, which are applied with uniformly partitioned
+// overlap-save convolution: each completed block of input is transformed once
+// and multiplied with the transformed partitions of all delays. Since these
+// partitions are delayed by at least one block, their output is ready before
+// the input it belongs to arrives.
+//
+// Several channels can be filtered together with the same coefficients. They
+// share the transformed partitions, which are then only read once per block
+// for all channels.
+class FIRFilterFFT : public FIRFilter {
+ public:
+  static constexpr size_t kBlockSize = 128;
+
+  FIRFilterFFT(const float* coefficients,
+               size_t coefficients_length,
+               size_t max_input_length,
+               size_t num_channels = 1);
+  ~FIRFilterFFT() override;
+
+  // Filters a single channel. Must only be used if there is one channel.
+  void Filter(const float* in, size_t length, float* out) override;
+
+  // Filters `length` samples of each channel. `in` and `out` must hold one
+  // pointer per channel.
+  void Filter(rtc::ArrayView<const float* const> in,
+              size_t length,
+              rtc::ArrayView<float* const> out);
+
+ private:
+  using AlignedBuffer = std::unique_ptr<float[], AlignedFreeDeleter>;
+
+  struct ChannelState {
+    // Filters with the first kBlockSize coefficients.
+    std::unique_ptr<FIRFilter> head_filter;
+    // The previous and the current block of input.
+    AlignedBuffer input;
+    // Spectra of the last `num_partitions_` input windows, newest at
+    // `newest_spectrum_`.
+    AlignedBuffer spectra;
+    // Accumulates the spectrum of the output of the partitions, which is then
+    // transformed in place. Its second half is the output for the current
+    // block.
+    AlignedBuffer accumulator;
+  };
+
+  // Transforms the completed input block of every channel and computes the
+  // output of the partitions for the next block.
+  void ProcessBlock();
+
+  const size_t num_partitions_;
+  PFFFT_Setup* const fft_setup_;
+  // Transformed partitions of the coefficients following the first
+  // kBlockSize.
+  AlignedBuffer partitions_;
+  AlignedBuffer fft_work_;
+  std::vector<ChannelState> channels_;
+  size_t block_position_ = 0;
+  size_t newest_spectrum_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_FIR_FILTER_FFT_H_
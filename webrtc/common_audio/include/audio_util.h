@@ -141,6 +141,14 @@ void Deinterleave(const InterleavedView<const T>& interleaved,
   }
 }
 
+// Vectorized for two, four and eight channels.
+template <>
+void Deinterleave<int16_t>(const InterleavedView<const int16_t>& interleaved,
+                           const DeinterleavedView<int16_t>& deinterleaved);
+template <>
+void Deinterleave<float>(const InterleavedView<const float>& interleaved,
+                         const DeinterleavedView<float>& deinterleaved);
+
 // Interleave audio from the channel buffers pointed to by `deinterleaved` to
 // `interleaved`. There must be sufficient space allocated in `interleaved`
 // (`samples_per_channel` * `num_channels`).
@@ -160,6 +168,26 @@ void Interleave(const DeinterleavedView<const T>& deinterleaved,
   }
 }
 
+// Vectorized for two, four and eight channels.
+template <>
+void Interleave<int16_t>(const DeinterleavedView<const int16_t>& deinterleaved,
+                         const InterleavedView<int16_t>& interleaved);
+template <>
+void Interleave<float>(const DeinterleavedView<const float>& deinterleaved,
+                       const InterleavedView<float>& interleaved);
+
+// Like Deinterleave(), but also converts from the Float to the FloatS16 range
+// in the same pass over the data.
+void DeinterleaveFloatToFloatS16(
+    const InterleavedView<const float>& interleaved,
+    const DeinterleavedView<float>& deinterleaved);
+
+// Like Interleave(), but also converts from the FloatS16 to the Float range in
+// the same pass over the data.
+void InterleaveFloatS16ToFloat(
+    const DeinterleavedView<const float>& deinterleaved,
+    const InterleavedView<float>& interleaved);
+
 // Downmixes an interleaved multichannel signal to a single channel by averaging
 // all channels.
 // TODO: b/335805780 - Accept InterleavedView and DeinterleavedView.
@@ -192,6 +220,7 @@ void DownmixInterleavedToMono(const T* interleaved,
                               int num_channels,
                               T* deinterleaved);
 
+// Vectorized for two and four channels.
 // TODO: b/335805780 - Accept InterleavedView and DeinterleavedView.
 template <>
 void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
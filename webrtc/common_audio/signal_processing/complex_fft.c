@@ -19,6 +19,10 @@
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "rtc_base/system/arch.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 #define CFFTSFT 14
 #define CFFTRND 1
 #define CFFTRND2 16384
@@ -26,6 +30,139 @@
 #define CIFFTSFT 14
 #define CIFFTRND 1
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+// Four high-accuracy (mode 1) butterflies between the complex values in `q`
+// and `x`, with the twiddle factors as (wr, -wi) pairs in `w_re` and (wi, wr)
+// pairs in `w_im`. The integer arithmetic is the same as in the scalar loops
+// below.
+static inline void ButterflySse2(__m128i* q,
+                                 __m128i* x,
+                                 __m128i w_re,
+                                 __m128i w_im,
+                                 __m128i round,
+                                 __m128i shift)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i low_mask = _mm_set1_epi32(0x0000ffff);
+    const __m128i high_mask = _mm_set1_epi32((int32_t)0xffff0000);
+
+    __m128i tr32 = _mm_add_epi32(_mm_madd_epi16(*x, w_re), one);
+    __m128i ti32 = _mm_add_epi32(_mm_madd_epi16(*x, w_im), one);
+    tr32 = _mm_srai_epi32(tr32, 15 - CFFTSFT);
+    ti32 = _mm_srai_epi32(ti32, 15 - CFFTSFT);
+
+    // The real and imaginary parts of `q`, scaled by 1 << CFFTSFT.
+    const __m128i qr32 = _mm_srai_epi32(_mm_slli_epi32(*q, 16), 16 - CFFTSFT);
+    const __m128i qi32 =
+        _mm_srai_epi32(_mm_and_si128(*q, high_mask), 16 - CFFTSFT);
+
+    const __m128i jr = _mm_sra_epi32(
+        _mm_add_epi32(_mm_sub_epi32(qr32, tr32), round), shift);
+    const __m128i ji = _mm_sra_epi32(
+        _mm_add_epi32(_mm_sub_epi32(qi32, ti32), round), shift);
+    const __m128i ir = _mm_sra_epi32(
+        _mm_add_epi32(_mm_add_epi32(qr32, tr32), round), shift);
+    const __m128i ii = _mm_sra_epi32(
+        _mm_add_epi32(_mm_add_epi32(qi32, ti32), round), shift);
+
+    // Truncate to 16 bits and interleave the real and imaginary parts.
+    *x = _mm_or_si128(_mm_and_si128(jr, low_mask), _mm_slli_epi32(ji, 16));
+    *q = _mm_or_si128(_mm_and_si128(ir, low_mask), _mm_slli_epi32(ii, 16));
+}
+
+// Runs all the butterflies of one high-accuracy stage, four at a time.
+// Requires `n` >= 8.
+static void ButterfliesSse2(int16_t frfi[], int n, int l, int k, int inverse,
+                            int32_t round, int shift)
+{
+    const __m128i round_v = _mm_set1_epi32(round);
+    const __m128i shift_v = _mm_cvtsi32_si128(shift);
+    const int istep = l << 1;
+    int16_t wr[4], wi[4];
+    int i, m, t;
+
+    for (m = 0; m < l && m < 4; ++m)
+    {
+        const int j = m << k;
+        wr[m] = kSinTable1024[j + 256];
+        wi[m] = inverse ? kSinTable1024[j] : -kSinTable1024[j];
+    }
+
+    if (l == 1)
+    {
+        // Butterflies between neighbors: deinterleave the even and odd
+        // complex values of eight at a time.
+        const __m128i w_re = _mm_set_epi16(-wi[0], wr[0], -wi[0], wr[0],
+                                           -wi[0], wr[0], -wi[0], wr[0]);
+        const __m128i w_im = _mm_set_epi16(wr[0], wi[0], wr[0], wi[0],
+                                           wr[0], wi[0], wr[0], wi[0]);
+        for (i = 0; i < n; i += 8)
+        {
+            __m128i* const p = (__m128i*)&frfi[2 * i];
+            const __m128i a = _mm_shuffle_epi32(_mm_loadu_si128(p),
+                                                _MM_SHUFFLE(3, 1, 2, 0));
+            const __m128i b = _mm_shuffle_epi32(_mm_loadu_si128(p + 1),
+                                                _MM_SHUFFLE(3, 1, 2, 0));
+            __m128i q = _mm_unpacklo_epi64(a, b);
+            __m128i x = _mm_unpackhi_epi64(a, b);
+            ButterflySse2(&q, &x, w_re, w_im, round_v, shift_v);
+            _mm_storeu_si128(p, _mm_shuffle_epi32(_mm_unpacklo_epi64(q, x),
+                                                  _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_si128(p + 1,
+                             _mm_shuffle_epi32(_mm_unpackhi_epi64(q, x),
+                                               _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+    } else if (l == 2)
+    {
+        // Butterflies two apart: pair up the halves of two groups of four.
+        const __m128i w_re = _mm_set_epi16(-wi[1], wr[1], -wi[0], wr[0],
+                                           -wi[1], wr[1], -wi[0], wr[0]);
+        const __m128i w_im = _mm_set_epi16(wr[1], wi[1], wr[0], wi[0],
+                                           wr[1], wi[1], wr[0], wi[0]);
+        for (i = 0; i < n; i += 8)
+        {
+            __m128i* const p = (__m128i*)&frfi[2 * i];
+            const __m128i a = _mm_loadu_si128(p);
+            const __m128i b = _mm_loadu_si128(p + 1);
+            __m128i q = _mm_unpacklo_epi64(a, b);
+            __m128i x = _mm_unpackhi_epi64(a, b);
+            ButterflySse2(&q, &x, w_re, w_im, round_v, shift_v);
+            _mm_storeu_si128(p, _mm_unpacklo_epi64(q, x));
+            _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(q, x));
+        }
+    } else
+    {
+        for (m = 0; m < l; m += 4)
+        {
+            if (m > 0)
+            {
+                for (t = 0; t < 4; ++t)
+                {
+                    const int j = (m + t) << k;
+                    wr[t] = kSinTable1024[j + 256];
+                    wi[t] = inverse ? kSinTable1024[j] : -kSinTable1024[j];
+                }
+            }
+            const __m128i w_re = _mm_set_epi16(-wi[3], wr[3], -wi[2], wr[2],
+                                               -wi[1], wr[1], -wi[0], wr[0]);
+            const __m128i w_im = _mm_set_epi16(wr[3], wi[3], wr[2], wi[2],
+                                               wr[1], wi[1], wr[0], wi[0]);
+
+            for (i = m; i < n; i += istep)
+            {
+                __m128i* const p_i = (__m128i*)&frfi[2 * i];
+                __m128i* const p_j = (__m128i*)&frfi[2 * (i + l)];
+                __m128i q = _mm_loadu_si128(p_i);
+                __m128i x = _mm_loadu_si128(p_j);
+                ButterflySse2(&q, &x, w_re, w_im, round_v, shift_v);
+                _mm_storeu_si128(p_i, q);
+                _mm_storeu_si128(p_j, x);
+            }
+        }
+    }
+}
+#endif
+
 
 int WebRtcSpl_ComplexFFT(int16_t frfi[], int stages, int mode)
 {
@@ -91,7 +228,15 @@ int WebRtcSpl_ComplexFFT(int16_t frfi[], int stages, int mode)
         {
             istep = l << 1;
 
-            for (m = 0; m < l; ++m)
+            m = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+            if (n >= 8)
+            {
+                ButterfliesSse2(frfi, n, l, k, 0, CFFTRND2, 1 + CFFTSFT);
+                m = l;
+            }
+#endif
+            for (; m < l; ++m)
             {
                 j = m << k;
 
@@ -233,7 +378,16 @@ int WebRtcSpl_ComplexIFFT(int16_t frfi[], int stages, int mode)
         {
             // mode==1: High-complexity and High-accuracy mode
 
-            for (m = 0; m < l; ++m)
+            m = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+            if (n >= 8)
+            {
+                ButterfliesSse2(frfi, (int)n, (int)l, k, 1, round2,
+                                shift + CIFFTSFT);
+                m = l;
+            }
+#endif
+            for (; m < l; ++m)
             {
                 j = m << k;
 
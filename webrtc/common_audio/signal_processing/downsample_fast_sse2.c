@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Reverses the order of eight 16-bit lanes.
+static inline __m128i ReverseW16(__m128i v) {
+  v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+// SSE2 version of WebRtcSpl_DownsampleFast() for x86 platforms. The taps are
+// accumulated with 32-bit wrap-around like in the C version, so the output is
+// identical.
+int WebRtcSpl_DownsampleFastSse2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+  const size_t coefficients_length8 = coefficients_length & ~(size_t)7;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+
+  for (i = delay; i < endpos; i += factor) {
+    // Negative indexes are permitted here, the filter state is stored in the
+    // "negative" positions of the input vector.
+    const int16_t* in = &data_in[i];
+    __m128i sum = _mm_setzero_si128();
+    uint32_t out_u32 = 2048;  // Round value, 0.5 in Q12.
+
+    for (j = 0; j < coefficients_length8; j += 8) {
+      const __m128i coef = _mm_loadu_si128((const __m128i*)&coefficients[j]);
+      const __m128i x = _mm_loadu_si128((const __m128i*)(in - j - 7));
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(coef, ReverseW16(x)));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    out_u32 += (uint32_t)_mm_cvtsi128_si32(sum);
+
+    for (; j < coefficients_length; j++) {
+      out_u32 += (uint32_t)(coefficients[j] * in[-(ptrdiff_t)j]);
+    }
+
+    // Q0. Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16((int32_t)out_u32 >> 12);
+  }
+
+  return 0;
+}
@@ -28,6 +28,7 @@
 #include <limits.h>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
 // TODO(bjorn/kma): Consolidate function pairs (e.g. combine
@@ -239,6 +240,8 @@ void WebRtcSpl_MinMaxW16(const int16_t* vector, size_t length,
                          int16_t* min_val, int16_t* max_val) {
 #if defined(WEBRTC_HAS_NEON)
   return WebRtcSpl_MinMaxW16Neon(vector, length, min_val, max_val);
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  return WebRtcSpl_MinMaxW16Sse2(vector, length, min_val, max_val);
 #else
   int16_t minimum = WEBRTC_SPL_WORD16_MAX;
   int16_t maximum = WEBRTC_SPL_WORD16_MIN;
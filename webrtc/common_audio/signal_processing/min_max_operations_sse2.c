@@ -0,0 +1,256 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include "rtc_base/checks.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Horizontal maximum and minimum of eight 16-bit lanes.
+static inline int16_t HorizontalMaxW16(__m128i v) {
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_max_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static inline int16_t HorizontalMinW16(__m128i v) {
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+// SSE2 lacks 32-bit max and min instructions; select through a compare.
+static inline __m128i MaxW32(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, a),
+                      _mm_andnot_si128(a_greater, b));
+}
+
+static inline __m128i MinW32(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, b),
+                      _mm_andnot_si128(a_greater, a));
+}
+
+static inline int32_t HorizontalMaxW32(__m128i v) {
+  v = MaxW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = MaxW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+static inline int32_t HorizontalMinW32(__m128i v) {
+  v = MinW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = MinW32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Maximum absolute value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16Sse2(const int16_t* vector, size_t length) {
+  int absolute = 0, maximum = 0;
+  size_t i = 0;
+  const size_t length8 = length & ~(size_t)7;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length8 > 0) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i max_v = zero;
+    for (; i < length8; i += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+      // The saturating negation maps -32768 to 32767, which is also what the
+      // final guard below turns abs(-32768) into.
+      max_v = _mm_max_epi16(max_v, _mm_max_epi16(v, _mm_subs_epi16(zero, v)));
+    }
+    maximum = HorizontalMaxW16(max_v);
+  }
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
+
+// Maximum absolute value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MaxAbsValueW32Sse2(const int32_t* vector, size_t length) {
+  // Use uint32_t for the local variables, to accommodate the return value
+  // of abs(0x80000000), which is 0x80000000.
+  uint32_t absolute = 0, maximum = 0;
+  size_t i = 0;
+  const size_t length4 = length & ~(size_t)3;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length4 > 0) {
+    __m128i max_v = _mm_setzero_si128();
+    for (; i < length4; i += 4) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+      const __m128i sign = _mm_srai_epi32(v, 31);
+      __m128i abs_v = _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+      // Only 0x80000000 is still negative; flipping its bits saturates it to
+      // 0x7fffffff, the value the final guard below would produce.
+      abs_v = _mm_xor_si128(abs_v, _mm_srai_epi32(abs_v, 31));
+      max_v = MaxW32(max_v, abs_v);
+    }
+    maximum = (uint32_t)HorizontalMaxW32(max_v);
+  }
+
+  for (; i < length; i++) {
+    absolute =
+        (vector[i] != INT_MIN) ? abs((int)vector[i]) : INT_MAX + (uint32_t)1;
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard against the case for 0x80000000.
+  maximum = WEBRTC_SPL_MIN(maximum, WEBRTC_SPL_WORD32_MAX);
+
+  return (int32_t)maximum;
+}
+
+// Maximum value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxValueW16Sse2(const int16_t* vector, size_t length) {
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  size_t i = 0;
+  const size_t length8 = length & ~(size_t)7;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length8 > 0) {
+    __m128i max_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+    for (; i < length8; i += 8) {
+      max_v = _mm_max_epi16(max_v,
+                            _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    maximum = HorizontalMaxW16(max_v);
+  }
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Maximum value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MaxValueW32Sse2(const int32_t* vector, size_t length) {
+  int32_t maximum = WEBRTC_SPL_WORD32_MIN;
+  size_t i = 0;
+  const size_t length4 = length & ~(size_t)3;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length4 > 0) {
+    __m128i max_v = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+    for (; i < length4; i += 4) {
+      max_v = MaxW32(max_v, _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    maximum = HorizontalMaxW32(max_v);
+  }
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
+
+// Minimum value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MinValueW16Sse2(const int16_t* vector, size_t length) {
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+  size_t i = 0;
+  const size_t length8 = length & ~(size_t)7;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length8 > 0) {
+    __m128i min_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+    for (; i < length8; i += 8) {
+      min_v = _mm_min_epi16(min_v,
+                            _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    minimum = HorizontalMinW16(min_v);
+  }
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
+
+// Minimum value of word32 vector. SSE2 version for x86 platforms.
+int32_t WebRtcSpl_MinValueW32Sse2(const int32_t* vector, size_t length) {
+  int32_t minimum = WEBRTC_SPL_WORD32_MAX;
+  size_t i = 0;
+  const size_t length4 = length & ~(size_t)3;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length4 > 0) {
+    __m128i min_v = _mm_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+    for (; i < length4; i += 4) {
+      min_v = MinW32(min_v, _mm_loadu_si128((const __m128i*)&vector[i]));
+    }
+    minimum = HorizontalMinW32(min_v);
+  }
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+  }
+  return minimum;
+}
+
+// Finds both the minimum and maximum elements in an array of 16-bit integers.
+void WebRtcSpl_MinMaxW16Sse2(const int16_t* vector, size_t length,
+                             int16_t* min_val, int16_t* max_val) {
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  size_t i = 0;
+  const size_t length8 = length & ~(size_t)7;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length8 > 0) {
+    __m128i min_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+    __m128i max_v = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+    for (; i < length8; i += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+      min_v = _mm_min_epi16(min_v, v);
+      max_v = _mm_max_epi16(max_v, v);
+    }
+    minimum = HorizontalMinW16(min_v);
+    maximum = HorizontalMaxW16(max_v);
+  }
+
+  for (; i < length; i++) {
+    if (vector[i] < minimum)
+      minimum = vector[i];
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  *min_val = minimum;
+  *max_val = maximum;
+}
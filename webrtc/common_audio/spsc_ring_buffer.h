@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_SPSC_RING_BUFFER_H_
+#define COMMON_AUDIO_SPSC_RING_BUFFER_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Fixed-capacity ring buffer of elements of type T. A single producer calls
+// Write() and a single consumer reads, and they may do so concurrently from
+// different threads without locking: like SwapQueue, the two sides only
+// synchronize through an atomic element count. Unlike SwapQueue, the elements
+// are samples rather than whole frames, any number of which may be written or
+// read at once, and the consumer can read the content in place through
+// Peek() instead of having it copied out.
+//
+// The producer and consumer state live on separate cache lines so that the
+// two sides do not invalidate each other's cache on every access.
+template <typename T>
+class SpscRingBuffer {
+ public:
+  // The readable content, in order. It is split in two views when it wraps
+  // around the end of the storage; `second` is empty otherwise.
+  struct ReadView {
+    size_t size() const { return first.size() + second.size(); }
+
+    rtc::ArrayView<const T> first;
+    rtc::ArrayView<const T> second;
+  };
+
+  // Creates a buffer holding at most `capacity` elements, which are zeroed.
+  explicit SpscRingBuffer(size_t capacity) : buffer_(capacity) {
+    RTC_DCHECK_GT(capacity, 0);
+  }
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  size_t capacity() const { return buffer_.size(); }
+
+  // Drops the content and zeroes the storage. Neither the producer nor the
+  // consumer may access the buffer concurrently.
+  void Reset() {
+    std::fill(buffer_.begin(), buffer_.end(), T());
+    write_index_ = 0;
+    read_index_ = 0;
+    num_elements_.store(0, std::memory_order_relaxed);
+  }
+
+  // Producer side.
+
+  // Appends as much of `data` as there is room for and returns the number of
+  // elements written.
+  size_t Write(rtc::ArrayView<const T> data) {
+    // Acquire memory ordering prevents the writes below from being reordered
+    // to before the load. (The free elements might be read by a concurrent
+    // call to Consume() until the load finishes.)
+    const size_t num_elements =
+        num_elements_.load(std::memory_order_acquire);
+    const size_t count = std::min(data.size(), capacity() - num_elements);
+    const size_t first = std::min(count, capacity() - write_index_);
+    std::copy(data.begin(), data.begin() + first,
+              buffer_.begin() + write_index_);
+    std::copy(data.begin() + first, data.begin() + count, buffer_.begin());
+    write_index_ = Advance(write_index_, count);
+
+    // Release memory ordering makes the written elements visible to the
+    // consumer before it can see the updated count.
+    num_elements_.fetch_add(count, std::memory_order_release);
+    return count;
+  }
+
+  // Returns the number of elements that can be written. Since elements may be
+  // concurrently consumed, this is a lower bound.
+  size_t available_write() const {
+    return capacity() - num_elements_.load(std::memory_order_acquire);
+  }
+
+  // Consumer side.
+
+  // Returns the number of elements that can be read. Since elements may be
+  // concurrently written, this is a lower bound.
+  size_t available_read() const {
+    return num_elements_.load(std::memory_order_acquire);
+  }
+
+  // Returns views of the oldest min(`count`, available_read()) elements
+  // without consuming them. The views stay valid until the elements are
+  // consumed.
+  ReadView Peek(size_t count) const {
+    count = std::min(count, available_read());
+    const size_t first = std::min(count, capacity() - read_index_);
+    ReadView view;
+    view.first = rtc::ArrayView<const T>(&buffer_[read_index_], first);
+    if (count > first) {
+      view.second = rtc::ArrayView<const T>(buffer_.data(), count - first);
+    }
+    return view;
+  }
+
+  // Drops the oldest `count` elements, which must not exceed available_read().
+  void Consume(size_t count) {
+    RTC_DCHECK_LE(count, available_read());
+    read_index_ = Advance(read_index_, count);
+    // Release memory ordering prevents the reads of the consumed elements
+    // from being reordered to after the decrement. (Once it has finished, a
+    // concurrent Write() might overwrite them.)
+    num_elements_.fetch_sub(count, std::memory_order_release);
+  }
+
+  // Copies the oldest elements into `data`, consumes them and returns their
+  // number.
+  size_t Read(rtc::ArrayView<T> data) {
+    const ReadView view = Peek(data.size());
+    std::copy(view.first.begin(), view.first.end(), data.begin());
+    std::copy(view.second.begin(), view.second.end(),
+              data.begin() + view.first.size());
+    Consume(view.size());
+    return view.size();
+  }
+
+  // Moves the read position by `count` elements and returns the number of
+  // elements it was moved. A positive `count` flushes up to available_read()
+  // elements. A negative `count` stuffs the buffer by making up to
+  // available_write() of the already consumed elements readable again; as
+  // those may be overwritten at any time, this requires that the producer does
+  // not write concurrently.
+  int MoveReadPosition(int count) {
+    if (count >= 0) {
+      const size_t flushed =
+          std::min(static_cast<size_t>(count), available_read());
+      Consume(flushed);
+      return static_cast<int>(flushed);
+    }
+    const size_t stuffed =
+        std::min(static_cast<size_t>(-count), available_write());
+    read_index_ = Advance(read_index_, capacity() - stuffed);
+    num_elements_.fetch_add(stuffed, std::memory_order_relaxed);
+    return -static_cast<int>(stuffed);
+  }
+
+ private:
+  // Returns `index` moved `count` <= capacity() elements forward.
+  size_t Advance(size_t index, size_t count) const {
+    index += count;
+    return index >= capacity() ? index - capacity() : index;
+  }
+
+  // The elements are accessed by both the producer and the consumer, mediated
+  // by `num_elements_`. buffer_.size() is constant.
+  std::vector<T> buffer_;
+
+  // Only accessed by the single producer.
+  alignas(64) size_t write_index_ = 0;
+
+  // Only accessed by the single consumer.
+  alignas(64) size_t read_index_ = 0;
+
+  // Accessed by both the producer and the consumer and used for
+  // synchronization between them.
+  alignas(64) std::atomic<size_t> num_elements_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_SPSC_RING_BUFFER_H_
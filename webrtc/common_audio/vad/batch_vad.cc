@@ -0,0 +1,229 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/vad/include/batch_vad.h"
+
+#include <memory>
+#include <vector>
+
+#include "common_audio/vad/batch_vad_kernels.h"
+#include "common_audio/vad/include/webrtc_vad.h"
+#include "rtc_base/checks.h"
+
+extern "C" {
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/vad/vad_core.h"
+}
+
+namespace webrtc {
+
+namespace {
+
+using batch_vad::kLanes;
+
+constexpr size_t kMaxFrameLength8khz = 240;  // 30 ms.
+constexpr size_t kFrameLength10ms48khz = 480;
+constexpr size_t kFrameLength10ms8khz = 80;
+
+// The streams are processed in groups of `kLanes`, which share vectors from
+// the downsampling to the model update. The filter states and the models are
+// stored per group, one array of lanes per state variable. The minimum
+// tracking and the hang over take their own branches per stream and stay in
+// its VadInstT.
+struct LaneGroup {
+  int32_t downsampling_states[4][kLanes];
+  batch_vad::FilterbankLanes filterbank;
+  batch_vad::Resampler48khzTo8khzLanes resampler;
+  batch_vad::GmmLanes gmm;
+};
+
+class BatchVadImpl final : public BatchVad {
+ public:
+  BatchVadImpl(size_t num_streams,
+               Vad::Aggressiveness aggressiveness,
+               int sample_rate_hz,
+               size_t frame_length)
+      : sample_rate_hz_(sample_rate_hz),
+        frame_length_(frame_length),
+        frame_length_8khz_(frame_length * 8000 / sample_rate_hz),
+        num_streams_(num_streams),
+        groups_((num_streams + kLanes - 1) / kLanes),
+        states_(groups_.size() * kLanes),
+        silence_(frame_length, 0) {
+    // All streams start from the same state, which is set up once and copied.
+    RTC_CHECK_EQ(WebRtcVad_InitCore(&initial_state_), 0);
+    RTC_CHECK_EQ(WebRtcVad_set_mode_core(&initial_state_, aggressiveness), 0);
+    Reset();
+  }
+
+  bool Process(rtc::ArrayView<const int16_t> audio,
+               size_t num_frames,
+               rtc::ArrayView<uint8_t> decisions) override {
+    if (audio.size() != num_streams_ * num_frames * frame_length_ ||
+        decisions.size() != num_streams_ * num_frames) {
+      return false;
+    }
+
+    // Each group runs through all of its frames before moving on, which keeps
+    // its state in cache for the whole batch. The lanes beyond the last
+    // stream are fed with silence.
+    for (size_t g = 0; g < groups_.size(); ++g) {
+      const int16_t* frames[kLanes];
+      uint8_t* lane_decisions[kLanes] = {};
+      for (size_t l = 0; l < kLanes; ++l) {
+        const size_t stream = g * kLanes + l;
+        if (stream < num_streams_) {
+          frames[l] = audio.data() + stream * num_frames * frame_length_;
+          lane_decisions[l] = decisions.data() + stream * num_frames;
+        } else {
+          frames[l] = silence_.data();
+        }
+      }
+      for (size_t k = 0; k < num_frames; ++k) {
+        ProcessFrame(g, frames, lane_decisions);
+        for (size_t l = 0; l < kLanes; ++l) {
+          if (lane_decisions[l]) {
+            frames[l] += frame_length_;
+            ++lane_decisions[l];
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  void Reset() override {
+    for (size_t stream = 0; stream < states_.size(); ++stream) {
+      ResetStream(stream);
+    }
+  }
+
+  void Reset(size_t stream) override {
+    RTC_DCHECK_LT(stream, num_streams_);
+    ResetStream(stream);
+  }
+
+  size_t num_streams() const override { return num_streams_; }
+  size_t frame_length() const override { return frame_length_; }
+
+ private:
+  void ResetStream(size_t stream) {
+    VadInstT& state = states_[stream];
+    state = initial_state_;
+    LaneGroup& group = groups_[stream / kLanes];
+    const size_t l = stream % kLanes;
+    for (size_t i = 0; i < 4; ++i) {
+      group.downsampling_states[i][l] = state.downsampling_filter_states[i];
+      group.filterbank.hp_filter_state[i][l] = state.hp_filter_state[i];
+    }
+    const WebRtcSpl_State48khzTo8khz& resampler = state.state_48_to_8;
+    for (size_t i = 0; i < 8; ++i) {
+      group.resampler.S_48_24[i][l] = resampler.S_48_24[i];
+      group.resampler.S_24_16[i][l] = resampler.S_24_16[i];
+      group.resampler.S_16_8[i][l] = resampler.S_16_8[i];
+    }
+    for (size_t i = 0; i < 16; ++i) {
+      group.resampler.S_24_24[i][l] = resampler.S_24_24[i];
+    }
+    for (size_t i = 0; i < 5; ++i) {
+      group.filterbank.upper_state[i][l] = state.upper_state[i];
+      group.filterbank.lower_state[i][l] = state.lower_state[i];
+    }
+    for (int gaussian = 0; gaussian < kTableSize; ++gaussian) {
+      group.gmm.noise_means[gaussian][l] = state.noise_means[gaussian];
+      group.gmm.speech_means[gaussian][l] = state.speech_means[gaussian];
+      group.gmm.noise_stds[gaussian][l] = state.noise_stds[gaussian];
+      group.gmm.speech_stds[gaussian][l] = state.speech_stds[gaussian];
+    }
+  }
+
+  // Classifies the next frame of each lane of group `g`, from `frames`, and
+  // writes the decisions of the lanes which hold a stream.
+  void ProcessFrame(size_t g,
+                    const int16_t* const frames[kLanes],
+                    uint8_t* const decisions[kLanes]) {
+    LaneGroup& group = groups_[g];
+    VadInstT* const states = &states_[g * kLanes];
+
+    // Downsample to 8 kHz, interleaved.
+    alignas(16) int16_t interleaved[4 * kMaxFrameLength8khz * kLanes];
+    alignas(16) int16_t wideband[2 * kMaxFrameLength8khz * kLanes];
+    alignas(16) int16_t narrowband[kMaxFrameLength8khz * kLanes];
+    switch (sample_rate_hz_) {
+      case 8000:
+        batch_vad::InterleaveLanes(frames, frame_length_, narrowband);
+        break;
+      case 16000:
+        batch_vad::InterleaveLanes(frames, frame_length_, interleaved);
+        batch_vad::DownsampleLanes(interleaved, frame_length_,
+                                   &group.downsampling_states[0], narrowband);
+        break;
+      case 32000:
+        batch_vad::InterleaveLanes(frames, frame_length_, interleaved);
+        batch_vad::DownsampleLanes(interleaved, frame_length_,
+                                   &group.downsampling_states[2], wideband);
+        batch_vad::DownsampleLanes(wideband, frame_length_ / 2,
+                                   &group.downsampling_states[0], narrowband);
+        break;
+      case 48000:
+        // Like WebRtcVad_CalcVad48khz(), which passes the start of the frame
+        // for each 10 ms.
+        batch_vad::InterleaveLanes(frames, kFrameLength10ms48khz, interleaved);
+        for (size_t i = 0; i < frame_length_8khz_; i += kFrameLength10ms8khz) {
+          batch_vad::Resample48khzTo8khzLanes(interleaved, &group.resampler,
+                                              &narrowband[i * kLanes]);
+        }
+        break;
+    }
+
+    int16_t features[kNumChannels][kLanes];
+    int16_t total_power[kLanes];
+    batch_vad::CalculateFeaturesLanes(&group.filterbank, narrowband,
+                                      frame_length_8khz_, features,
+                                      total_power);
+
+    int16_t vad[kLanes];
+    batch_vad::GmmProbabilityLanes(&group.gmm, states, features, total_power,
+                                   frame_length_8khz_, vad);
+    for (size_t l = 0; l < kLanes; ++l) {
+      states[l].vad = vad[l];
+      if (decisions[l]) {
+        *decisions[l] = vad[l] > 0 ? 1 : 0;
+      }
+    }
+  }
+
+  const int sample_rate_hz_;
+  const size_t frame_length_;
+  const size_t frame_length_8khz_;
+  const size_t num_streams_;
+  VadInstT initial_state_;
+  std::vector<LaneGroup> groups_;
+  // One per lane of `groups_`, i.e., also for the lanes beyond the last
+  // stream.
+  std::vector<VadInstT> states_;
+  const std::vector<int16_t> silence_;
+};
+
+}  // namespace
+
+std::unique_ptr<BatchVad> CreateBatchVad(size_t num_streams,
+                                         Vad::Aggressiveness aggressiveness,
+                                         int sample_rate_hz,
+                                         size_t frame_length) {
+  if (num_streams == 0 ||
+      WebRtcVad_ValidRateAndFrameLength(sample_rate_hz, frame_length) != 0) {
+    return nullptr;
+  }
+  return std::make_unique<BatchVadImpl>(num_streams, aggressiveness,
+                                        sample_rate_hz, frame_length);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,1300 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/vad/batch_vad_kernels.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+extern "C" {
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/vad/vad_sp.h"
+}
+
+namespace webrtc {
+namespace batch_vad {
+namespace {
+
+// Constants of vad_filterbank.c and vad_sp.c.
+constexpr int16_t kLogConst = 24660;          // 160*log10(2) in Q9.
+constexpr int16_t kLogEnergyIntPart = 14336;  // 14 in Q10
+constexpr int16_t kHpZeroCoefs[3] = {6631, -13262, 6631};  // Q14.
+constexpr int16_t kHpPoleCoefs[3] = {16384, -7756, 5620};  // Q14.
+constexpr int16_t kAllPassCoefsQ15[2] = {20972, 5571};
+constexpr int16_t kOffsetVector[6] = {368, 368, 272, 176, 176, 176};
+constexpr int16_t kAllPassCoefsQ13[2] = {5243, 1392};
+
+// The part of LogOfEnergy() in vad_filterbank.c that follows the computation
+// of `energy`, which is in Q(-`tot_rshifts`). Returns the log energy.
+int16_t LogOfEnergy(uint32_t energy,
+                    int tot_rshifts,
+                    int16_t offset,
+                    int16_t* total_energy) {
+  if (energy == 0) {
+    return offset;
+  }
+  const int normalizing_rshifts = 17 - WebRtcSpl_NormU32(energy);
+  tot_rshifts += normalizing_rshifts;
+  if (normalizing_rshifts < 0) {
+    energy <<= -normalizing_rshifts;
+  } else {
+    energy >>= normalizing_rshifts;
+  }
+  const int16_t log2_energy =
+      kLogEnergyIntPart + static_cast<int16_t>((energy & 0x00003FFF) >> 4);
+  int16_t log_energy = static_cast<int16_t>(((kLogConst * log2_energy) >> 19) +
+                                            ((tot_rshifts * kLogConst) >> 9));
+  if (log_energy < 0) {
+    log_energy = 0;
+  }
+  log_energy = static_cast<int16_t>(log_energy + offset);
+
+  if (*total_energy <= kMinEnergy) {
+    if (tot_rshifts >= 0) {
+      *total_energy += kMinEnergy + 1;
+    } else {
+      *total_energy += static_cast<int16_t>(energy >> -tot_rshifts);
+    }
+  }
+  return log_energy;
+}
+
+// Scaling of WebRtcSpl_GetScalingSquare() for a signal of `length` samples
+// with the largest absolute value `smax`.
+int EnergyScaling(int16_t smax, size_t length) {
+  if (smax == 0) {
+    return 0;
+  }
+  const int16_t nbits = WebRtcSpl_GetSizeInBits(static_cast<uint32_t>(length));
+  const int16_t t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+  return t > nbits ? 0 : nbits - t;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+
+// Constants of vad_gmm.c.
+constexpr int32_t kCompVar = 22005;
+constexpr int16_t kLog2Exp = 5909;  // log2(exp(1)) in Q12.
+
+// Constants of vad_core.c.
+constexpr int16_t kSpectrumWeight[kNumChannels] = {6, 8, 10, 12, 14, 16};
+constexpr int16_t kNoiseUpdateConst = 655;    // Q15
+constexpr int16_t kSpeechUpdateConst = 6554;  // Q15
+constexpr int16_t kBackEta = 154;             // Q8
+constexpr int16_t kMinimumDifference[kNumChannels] = {544, 544, 576,
+                                                      576, 576, 576};
+constexpr int16_t kMaximumSpeech[kNumChannels] = {11392, 11392, 11520,
+                                                  11520, 11520, 11520};
+constexpr int16_t kMinimumMean[kNumGaussians] = {640, 768};
+constexpr int16_t kMaximumNoise[kNumChannels] = {9216, 9088, 8960,
+                                                 8832, 8704, 8576};
+constexpr int16_t kNoiseDataWeights[kTableSize] = {34, 62, 72, 66, 53, 25,
+                                                   94, 66, 56, 62, 75, 103};
+constexpr int16_t kSpeechDataWeights[kTableSize] = {48, 82, 45, 87, 50, 47,
+                                                    80, 46, 83, 41, 78, 81};
+constexpr int16_t kMaxSpeechFrames = 6;
+constexpr int16_t kMinStd = 384;
+
+// Constants of resample_by_2_internal.c and resample_fractional.c.
+constexpr int16_t kResampleAllpass[2][3] = {{821, 6110, 12382},
+                                            {3050, 9368, 15063}};
+constexpr int16_t kCoefficients48To32[2][8] = {
+    {778, -2050, 1087, 23285, 12903, -3783, 441, 222},
+    {222, 441, -3783, 12903, 23285, 1087, -2050, 778}};
+
+// The SSE2 kernels hold the 8 lanes of a signal in one vector of int16 and
+// the lanes of 32 bit intermediates in two vectors, lanes 0-3 and 4-7. The
+// helpers below reproduce the implicit conversions of the scalar code.
+
+// Sign extends the int16 lanes of `x`.
+inline void Widen(__m128i x, __m128i* lo, __m128i* hi) {
+  *lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+  *hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+}
+
+// Multiplies the int16 lanes of `a` and `b` into int32 lanes.
+inline void Multiply(__m128i a, __m128i b, __m128i* lo, __m128i* hi) {
+  const __m128i product_lo = _mm_mullo_epi16(a, b);
+  const __m128i product_hi = _mm_mulhi_epi16(a, b);
+  *lo = _mm_unpacklo_epi16(product_lo, product_hi);
+  *hi = _mm_unpackhi_epi16(product_lo, product_hi);
+}
+
+// Truncates int32 lanes to int16, like a cast.
+inline __m128i Narrow(__m128i lo, __m128i hi) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+}
+
+// Returns the lower 32 bits of the products of the int32 lanes of `a` and
+// `b`, which is what the scalar code gets when they overflow.
+inline __m128i MultiplyLow32(__m128i a, __m128i b) {
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd =
+      _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// Returns the lower 32 bits of the products of the int32 lanes of `x` and
+// `c`, from 16 bit products of the halves of `x`. The high half of the
+// unsigned product of the low half is corrected for a negative `c`.
+inline __m128i MultiplyByConstant(__m128i x, int16_t c) {
+  const __m128i low_products = _mm_mullo_epi16(x, _mm_set1_epi16(c));
+  const __m128i high_products =
+      _mm_mulhi_epu16(x, _mm_set1_epi32(static_cast<uint16_t>(c)));
+  __m128i product =
+      _mm_add_epi32(low_products, _mm_slli_epi32(high_products, 16));
+  if (c < 0) {
+    product = _mm_sub_epi32(product, _mm_slli_epi32(x, 16));
+  }
+  return product;
+}
+
+// Returns a mask of the lanes of `count` which have `bit` set.
+inline __m128i BitMask16(__m128i count, int bit) {
+  const __m128i b = _mm_set1_epi16(bit);
+  return _mm_cmpeq_epi16(_mm_and_si128(count, b), b);
+}
+
+inline __m128i BitMask32(__m128i count, int bit) {
+  const __m128i b = _mm_set1_epi32(bit);
+  return _mm_cmpeq_epi32(_mm_and_si128(count, b), b);
+}
+
+inline __m128i Select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i Load(const int16_t* x) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+}
+
+inline __m128i Load(const int32_t* x) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+}
+
+inline void Store(__m128i x, int16_t* y) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(y), x);
+}
+
+inline void Store(__m128i x, int32_t* y) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(y), x);
+}
+
+// Lane version of SplitFilter() in vad_filterbank.c. The recursion rules out
+// vectorizing over time, but the lanes are independent.
+void SplitFilterLanes(const int16_t* data_in,
+                      size_t data_length,
+                      int16_t* upper_state,
+                      int16_t* lower_state,
+                      int16_t* hp_data_out,
+                      int16_t* lp_data_out) {
+  const __m128i upper_coef = _mm_set1_epi16(kAllPassCoefsQ15[0]);
+  const __m128i lower_coef = _mm_set1_epi16(kAllPassCoefsQ15[1]);
+  __m128i upper_lo, upper_hi, lower_lo, lower_hi;
+  __m128i product_lo, product_hi, x_lo, x_hi;
+  Widen(Load(upper_state), &upper_lo, &upper_hi);
+  Widen(Load(lower_state), &lower_lo, &lower_hi);
+  upper_lo = _mm_slli_epi32(upper_lo, 16);  // Q15
+  upper_hi = _mm_slli_epi32(upper_hi, 16);
+  lower_lo = _mm_slli_epi32(lower_lo, 16);
+  lower_hi = _mm_slli_epi32(lower_hi, 16);
+
+  for (size_t i = 0; i < data_length / 2; ++i) {
+    const __m128i x0 = Load(&data_in[2 * i * kLanes]);
+    const __m128i x1 = Load(&data_in[(2 * i + 1) * kLanes]);
+
+    // All-pass filtering upper branch.
+    Multiply(x0, upper_coef, &product_lo, &product_hi);
+    const __m128i upper = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_add_epi32(upper_lo, product_lo), 16),
+        _mm_srai_epi32(_mm_add_epi32(upper_hi, product_hi), 16));  // Q(-1)
+    Multiply(upper, upper_coef, &product_lo, &product_hi);
+    Widen(x0, &x_lo, &x_hi);
+    upper_lo = _mm_slli_epi32(
+        _mm_sub_epi32(_mm_slli_epi32(x_lo, 14), product_lo), 1);  // Q15
+    upper_hi = _mm_slli_epi32(
+        _mm_sub_epi32(_mm_slli_epi32(x_hi, 14), product_hi), 1);
+
+    // All-pass filtering lower branch.
+    Multiply(x1, lower_coef, &product_lo, &product_hi);
+    const __m128i lower = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_add_epi32(lower_lo, product_lo), 16),
+        _mm_srai_epi32(_mm_add_epi32(lower_hi, product_hi), 16));  // Q(-1)
+    Multiply(lower, lower_coef, &product_lo, &product_hi);
+    Widen(x1, &x_lo, &x_hi);
+    lower_lo = _mm_slli_epi32(
+        _mm_sub_epi32(_mm_slli_epi32(x_lo, 14), product_lo), 1);  // Q15
+    lower_hi = _mm_slli_epi32(
+        _mm_sub_epi32(_mm_slli_epi32(x_hi, 14), product_hi), 1);
+
+    Store(_mm_sub_epi16(upper, lower), &hp_data_out[i * kLanes]);
+    Store(_mm_add_epi16(lower, upper), &lp_data_out[i * kLanes]);
+  }
+
+  Store(_mm_packs_epi32(_mm_srai_epi32(upper_lo, 16),
+                        _mm_srai_epi32(upper_hi, 16)),
+        upper_state);
+  Store(_mm_packs_epi32(_mm_srai_epi32(lower_lo, 16),
+                        _mm_srai_epi32(lower_hi, 16)),
+        lower_state);
+}
+
+// Lane version of HighPassFilter() in vad_filterbank.c. The five taps are
+// summed in pairs by _mm_madd_epi16().
+void HighPassFilterLanes(const int16_t* data_in,
+                         size_t data_length,
+                         int16_t (*filter_state)[kLanes],
+                         int16_t* data_out) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i coefs_0 = _mm_setr_epi16(
+      kHpZeroCoefs[0], kHpZeroCoefs[1], kHpZeroCoefs[0], kHpZeroCoefs[1],
+      kHpZeroCoefs[0], kHpZeroCoefs[1], kHpZeroCoefs[0], kHpZeroCoefs[1]);
+  const __m128i coefs_1 = _mm_setr_epi16(
+      kHpZeroCoefs[2], -kHpPoleCoefs[1], kHpZeroCoefs[2], -kHpPoleCoefs[1],
+      kHpZeroCoefs[2], -kHpPoleCoefs[1], kHpZeroCoefs[2], -kHpPoleCoefs[1]);
+  const __m128i coefs_2 = _mm_setr_epi16(-kHpPoleCoefs[2], 0, -kHpPoleCoefs[2],
+                                         0, -kHpPoleCoefs[2], 0,
+                                         -kHpPoleCoefs[2], 0);
+  __m128i state_0 = Load(filter_state[0]);
+  __m128i state_1 = Load(filter_state[1]);
+  __m128i state_2 = Load(filter_state[2]);
+  __m128i state_3 = Load(filter_state[3]);
+
+  for (size_t i = 0; i < data_length; ++i) {
+    const __m128i x = Load(&data_in[i * kLanes]);
+    const __m128i x_state_0 = _mm_unpacklo_epi16(x, state_0);
+    const __m128i x_state_0_hi = _mm_unpackhi_epi16(x, state_0);
+    const __m128i state_1_2 = _mm_unpacklo_epi16(state_1, state_2);
+    const __m128i state_1_2_hi = _mm_unpackhi_epi16(state_1, state_2);
+    const __m128i state_3_0 = _mm_unpacklo_epi16(state_3, zero);
+    const __m128i state_3_0_hi = _mm_unpackhi_epi16(state_3, zero);
+    const __m128i y_lo = _mm_add_epi32(
+        _mm_add_epi32(_mm_madd_epi16(x_state_0, coefs_0),
+                      _mm_madd_epi16(state_1_2, coefs_1)),
+        _mm_madd_epi16(state_3_0, coefs_2));
+    const __m128i y_hi = _mm_add_epi32(
+        _mm_add_epi32(_mm_madd_epi16(x_state_0_hi, coefs_0),
+                      _mm_madd_epi16(state_1_2_hi, coefs_1)),
+        _mm_madd_epi16(state_3_0_hi, coefs_2));
+    state_1 = state_0;
+    state_0 = x;
+    state_3 = state_2;
+    state_2 = Narrow(_mm_srai_epi32(y_lo, 14), _mm_srai_epi32(y_hi, 14));
+    Store(state_2, &data_out[i * kLanes]);
+  }
+
+  Store(state_0, filter_state[0]);
+  Store(state_1, filter_state[1]);
+  Store(state_2, filter_state[2]);
+  Store(state_3, filter_state[3]);
+}
+
+// Lane version of LogOfEnergy() in vad_filterbank.c. Each lane is scaled by
+// its own shift, which is at most 7 for the at most 120 samples per band, and
+// is applied in three conditional steps.
+void LogOfEnergyLanes(const int16_t* data_in,
+                      size_t data_length,
+                      int16_t offset,
+                      int16_t* total_energy,
+                      int16_t* log_energy) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i smax = _mm_set1_epi16(-1);
+  // The negation wraps -32768 onto itself, just like the scalar code.
+  for (size_t i = 0; i < data_length; ++i) {
+    const __m128i x = Load(&data_in[i * kLanes]);
+    smax = _mm_max_epi16(smax, _mm_max_epi16(x, _mm_sub_epi16(zero, x)));
+  }
+  alignas(16) int16_t smax_lanes[kLanes];
+  alignas(16) int32_t scaling[kLanes];
+  Store(smax, smax_lanes);
+  for (size_t l = 0; l < kLanes; ++l) {
+    scaling[l] = EnergyScaling(smax_lanes[l], data_length);
+  }
+
+  const __m128i scaling_lo = Load(&scaling[0]);
+  const __m128i scaling_hi = Load(&scaling[4]);
+  const __m128i shift_1_lo = BitMask32(scaling_lo, 1);
+  const __m128i shift_1_hi = BitMask32(scaling_hi, 1);
+  const __m128i shift_2_lo = BitMask32(scaling_lo, 2);
+  const __m128i shift_2_hi = BitMask32(scaling_hi, 2);
+  const __m128i shift_4_lo = BitMask32(scaling_lo, 4);
+  const __m128i shift_4_hi = BitMask32(scaling_hi, 4);
+  __m128i energy_lo = zero;
+  __m128i energy_hi = zero;
+  __m128i square_lo, square_hi;
+  for (size_t i = 0; i < data_length; ++i) {
+    const __m128i x = Load(&data_in[i * kLanes]);
+    Multiply(x, x, &square_lo, &square_hi);
+    square_lo =
+        Select(shift_1_lo, _mm_srai_epi32(square_lo, 1), square_lo);
+    square_hi =
+        Select(shift_1_hi, _mm_srai_epi32(square_hi, 1), square_hi);
+    square_lo =
+        Select(shift_2_lo, _mm_srai_epi32(square_lo, 2), square_lo);
+    square_hi =
+        Select(shift_2_hi, _mm_srai_epi32(square_hi, 2), square_hi);
+    square_lo =
+        Select(shift_4_lo, _mm_srai_epi32(square_lo, 4), square_lo);
+    square_hi =
+        Select(shift_4_hi, _mm_srai_epi32(square_hi, 4), square_hi);
+    energy_lo = _mm_add_epi32(energy_lo, square_lo);
+    energy_hi = _mm_add_epi32(energy_hi, square_hi);
+  }
+  alignas(16) int32_t energy[kLanes];
+  Store(energy_lo, &energy[0]);
+  Store(energy_hi, &energy[4]);
+
+  for (size_t l = 0; l < kLanes; ++l) {
+    log_energy[l] = LogOfEnergy(static_cast<uint32_t>(energy[l]), scaling[l],
+                                offset, &total_energy[l]);
+  }
+}
+
+// Lane version of WebRtcVad_GaussianProbability(), which returns the
+// probabilities in `probability_lo` and `probability_hi`.
+void GaussianProbability(__m128i input,
+                         __m128i mean,
+                         __m128i std,
+                         __m128i* probability_lo,
+                         __m128i* probability_hi,
+                         __m128i* delta) {
+  __m128i std_lo, std_hi, lo, hi;
+  Widen(std, &std_lo, &std_hi);
+
+  // `inv_std` = 1 / s, in Q10. The numerator has at most 18 significant bits,
+  // so the single precision quotient never rounds across an integer and its
+  // truncation equals the integer division of WebRtcSpl_DivW32W16(). The
+  // standard deviations are never zero.
+  const __m128i one_q17 = _mm_set1_epi32(131072);
+  const __m128i inv_std_lo = _mm_cvttps_epi32(_mm_div_ps(
+      _mm_cvtepi32_ps(_mm_add_epi32(one_q17, _mm_srai_epi32(std_lo, 1))),
+      _mm_cvtepi32_ps(std_lo)));
+  const __m128i inv_std_hi = _mm_cvttps_epi32(_mm_div_ps(
+      _mm_cvtepi32_ps(_mm_add_epi32(one_q17, _mm_srai_epi32(std_hi, 1))),
+      _mm_cvtepi32_ps(std_hi)));
+  const __m128i inv_std = Narrow(inv_std_lo, inv_std_hi);
+
+  // `inv_std2` = 1 / s^2, in Q14.
+  const __m128i inv_std_q8 = _mm_srai_epi16(inv_std, 2);
+  Multiply(inv_std_q8, inv_std_q8, &lo, &hi);
+  const __m128i inv_std2 =
+      Narrow(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+
+  // x - m, in Q7.
+  const __m128i diff =
+      _mm_sub_epi16(_mm_slli_epi16(input, 3), mean);
+
+  // `delta` = (x - m) / s^2, in Q11.
+  Multiply(inv_std2, diff, &lo, &hi);
+  *delta = Narrow(_mm_srai_epi32(lo, 10), _mm_srai_epi32(hi, 10));
+
+  // The exponent (x - m)^2 / (2 * s^2), in Q10.
+  Multiply(*delta, diff, &lo, &hi);
+  const __m128i exponent_lo = _mm_srai_epi32(lo, 9);
+  const __m128i exponent_hi = _mm_srai_epi32(hi, 9);
+  const __m128i comp_var = _mm_set1_epi32(kCompVar);
+  const __m128i nonzero =
+      _mm_packs_epi32(_mm_cmplt_epi32(exponent_lo, comp_var),
+                      _mm_cmplt_epi32(exponent_hi, comp_var));
+
+  // `exp_value` ~= exp2(-log2(exp(1)) * exponent), in Q10.
+  const __m128i log2_exp = _mm_set1_epi32(kLog2Exp);
+  __m128i t = _mm_sub_epi16(
+      _mm_setzero_si128(),
+      Narrow(_mm_srai_epi32(MultiplyLow32(log2_exp, exponent_lo), 12),
+             _mm_srai_epi32(MultiplyLow32(log2_exp, exponent_hi), 12)));
+  __m128i exp_value = _mm_or_si128(_mm_set1_epi16(0x0400),
+                                   _mm_and_si128(t, _mm_set1_epi16(0x03FF)));
+  t = _mm_xor_si128(t, _mm_set1_epi16(-1));
+  const __m128i shift =
+      _mm_add_epi16(_mm_srai_epi16(t, 10), _mm_set1_epi16(1));
+  // `exp_value` has 11 bits, so shifts of 16 or more clear it.
+  exp_value = Select(BitMask16(shift, 1), _mm_srli_epi16(exp_value, 1),
+                     exp_value);
+  exp_value = Select(BitMask16(shift, 2), _mm_srli_epi16(exp_value, 2),
+                     exp_value);
+  exp_value = Select(BitMask16(shift, 4), _mm_srli_epi16(exp_value, 4),
+                     exp_value);
+  exp_value = Select(BitMask16(shift, 8), _mm_srli_epi16(exp_value, 8),
+                     exp_value);
+  exp_value = _mm_andnot_si128(BitMask16(shift, 16), exp_value);
+  exp_value = _mm_and_si128(nonzero, exp_value);
+
+  // (1 / s) * exp(-(x - m)^2 / (2 * s^2)), in Q20.
+  Multiply(inv_std, exp_value, probability_lo, probability_hi);
+}
+
+// One of the all-pass chains of resample_by_2_internal.c for four lanes,
+// with the four state variables in `state`. Returns the filtered `x`.
+inline __m128i AllpassLanes(__m128i x, const int16_t* coefs, __m128i* state) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i diff = _mm_srai_epi32(
+      _mm_add_epi32(_mm_sub_epi32(x, state[1]), _mm_set1_epi32(1 << 13)), 14);
+  const __m128i tmp1 =
+      _mm_add_epi32(state[0], MultiplyByConstant(diff, coefs[0]));
+  state[0] = x;
+  // The shifts below round towards zero.
+  diff = _mm_srai_epi32(_mm_sub_epi32(tmp1, state[2]), 14);
+  diff = _mm_sub_epi32(diff, _mm_cmplt_epi32(diff, zero));
+  const __m128i tmp0 =
+      _mm_add_epi32(state[1], MultiplyByConstant(diff, coefs[1]));
+  state[1] = tmp1;
+  diff = _mm_srai_epi32(_mm_sub_epi32(tmp0, state[3]), 14);
+  diff = _mm_sub_epi32(diff, _mm_cmplt_epi32(diff, zero));
+  state[3] = _mm_add_epi32(state[2], MultiplyByConstant(diff, coefs[2]));
+  state[2] = tmp0;
+  return state[3];
+}
+
+void LoadStates(const int32_t (*state)[kLanes],
+                size_t count,
+                size_t lane,
+                __m128i* x) {
+  for (size_t i = 0; i < count; ++i) {
+    x[i] = Load(&state[i][lane]);
+  }
+}
+
+void StoreStates(const __m128i* x,
+                 size_t count,
+                 size_t lane,
+                 int32_t (*state)[kLanes]) {
+  for (size_t i = 0; i < count; ++i) {
+    Store(x[i], &state[i][lane]);
+  }
+}
+
+// Returns the int32 lanes of `num` divided by the int16 lanes of `den`,
+// truncated to int16 like the callers of WebRtcSpl_DivW32W16() do. The double
+// precision quotient of an int32 by an int16 is never rounded across an
+// integer, so its truncation equals the integer division.
+__m128i Divide(__m128i num_lo, __m128i num_hi, __m128i den) {
+  __m128i den_lo, den_hi;
+  Widen(den, &den_lo, &den_hi);
+  __m128i quotient[2];
+  const __m128i num[2] = {num_lo, num_hi};
+  const __m128i dens[2] = {den_lo, den_hi};
+  for (int i = 0; i < 2; ++i) {
+    const __m128d q0 = _mm_div_pd(_mm_cvtepi32_pd(num[i]),
+                                  _mm_cvtepi32_pd(dens[i]));
+    const __m128d q1 = _mm_div_pd(
+        _mm_cvtepi32_pd(_mm_shuffle_epi32(num[i], _MM_SHUFFLE(1, 0, 3, 2))),
+        _mm_cvtepi32_pd(_mm_shuffle_epi32(dens[i], _MM_SHUFFLE(1, 0, 3, 2))));
+    quotient[i] =
+        _mm_unpacklo_epi64(_mm_cvttpd_epi32(q0), _mm_cvttpd_epi32(q1));
+  }
+  return Narrow(quotient[0], quotient[1]);
+}
+
+// WebRtcSpl_NormW32() of the non-negative int32 lanes of `x`, except that
+// zero gives 31, as in GmmProbability(). The exponent of the float conversion
+// is floor(log2(x)), once `x` is short enough to convert exactly.
+__m128i NormW32(__m128i x) {
+  const __m128i large = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x00FFFFFF));
+  const __m128i exact = Select(large, _mm_srli_epi32(x, 8), x);
+  const __m128i exponent =
+      _mm_srli_epi32(_mm_castps_si128(_mm_cvtepi32_ps(exact)), 23);
+  const __m128i norm =
+      _mm_sub_epi32(_mm_sub_epi32(_mm_set1_epi32(127 + 30), exponent),
+                    _mm_and_si128(large, _mm_set1_epi32(8)));
+  return Select(_mm_cmpeq_epi32(x, _mm_setzero_si128()), _mm_set1_epi32(31),
+                norm);
+}
+
+// (x + 2^(shift - 1)) >> shift of the int16 lanes of `x`, which in the scalar
+// code is computed in int and never overflows.
+__m128i RoundedShift(__m128i x, int shift) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  const __m128i fraction = _mm_and_si128(x, _mm_set1_epi16((1 << shift) - 1));
+  return _mm_add_epi16(
+      _mm_sra_epi16(x, count),
+      _mm_sra_epi16(_mm_add_epi16(fraction, _mm_set1_epi16(1 << (shift - 1))),
+                    count));
+}
+
+// WeightedAverage() in vad_core.c of the two Gaussians `data_0` and `data_1`,
+// with the weights of `channel`.
+void WeightedAverage(__m128i data_0,
+                     __m128i data_1,
+                     const int16_t* weights,
+                     __m128i* lo,
+                     __m128i* hi) {
+  const __m128i w = _mm_unpacklo_epi16(_mm_set1_epi16(weights[0]),
+                                       _mm_set1_epi16(weights[kNumChannels]));
+  *lo = _mm_madd_epi16(_mm_unpacklo_epi16(data_0, data_1), w);
+  *hi = _mm_madd_epi16(_mm_unpackhi_epi16(data_0, data_1), w);
+}
+
+// The conditional probabilities of the two Gaussians of a channel in Q14, from
+// the weighted probability of the first, `first_lo` and `first_hi`, and the
+// sum over both, `total_lo` and `total_hi`. Lanes with a too small sum get
+// `fallback` for the first Gaussian and 0 for the second.
+void ConditionalProbabilities(__m128i first_lo,
+                              __m128i first_hi,
+                              __m128i total_lo,
+                              __m128i total_hi,
+                              int16_t fallback,
+                              __m128i* first,
+                              __m128i* second) {
+  const __m128i total = Narrow(_mm_srai_epi32(total_lo, 12),
+                               _mm_srai_epi32(total_hi, 12));  // Q15
+  const __m128i positive = _mm_cmpgt_epi16(total, _mm_setzero_si128());
+  const __m128i mask = _mm_set1_epi32(static_cast<int32_t>(0xFFFFF000));
+  const __m128i quotient =
+      Divide(_mm_slli_epi32(_mm_and_si128(first_lo, mask), 2),
+             _mm_slli_epi32(_mm_and_si128(first_hi, mask), 2),
+             Select(positive, total, _mm_set1_epi16(1)));  // Q14
+  *first = Select(positive, quotient, _mm_set1_epi16(fallback));
+  *second =
+      _mm_and_si128(positive, _mm_sub_epi16(_mm_set1_epi16(16384), quotient));
+}
+
+#else
+
+void SplitFilterLanes(const int16_t* data_in,
+                      size_t data_length,
+                      int16_t* upper_state,
+                      int16_t* lower_state,
+                      int16_t* hp_data_out,
+                      int16_t* lp_data_out) {
+  for (size_t l = 0; l < kLanes; ++l) {
+    int32_t upper_state32 = upper_state[l] * (1 << 16);  // Q15
+    int32_t lower_state32 = lower_state[l] * (1 << 16);  // Q15
+    for (size_t i = 0; i < data_length / 2; ++i) {
+      const int16_t x0 = data_in[2 * i * kLanes + l];
+      const int16_t x1 = data_in[(2 * i + 1) * kLanes + l];
+      const int16_t upper = static_cast<int16_t>(
+          (upper_state32 + kAllPassCoefsQ15[0] * x0) >> 16);
+      upper_state32 = ((x0 * (1 << 14)) - kAllPassCoefsQ15[0] * upper) * 2;
+      const int16_t lower = static_cast<int16_t>(
+          (lower_state32 + kAllPassCoefsQ15[1] * x1) >> 16);
+      lower_state32 = ((x1 * (1 << 14)) - kAllPassCoefsQ15[1] * lower) * 2;
+      hp_data_out[i * kLanes + l] = static_cast<int16_t>(upper - lower);
+      lp_data_out[i * kLanes + l] = static_cast<int16_t>(lower + upper);
+    }
+    upper_state[l] = static_cast<int16_t>(upper_state32 >> 16);
+    lower_state[l] = static_cast<int16_t>(lower_state32 >> 16);
+  }
+}
+
+void HighPassFilterLanes(const int16_t* data_in,
+                         size_t data_length,
+                         int16_t (*filter_state)[kLanes],
+                         int16_t* data_out) {
+  for (size_t l = 0; l < kLanes; ++l) {
+    for (size_t i = 0; i < data_length; ++i) {
+      const int16_t x = data_in[i * kLanes + l];
+      int32_t tmp32 = kHpZeroCoefs[0] * x;
+      tmp32 += kHpZeroCoefs[1] * filter_state[0][l];
+      tmp32 += kHpZeroCoefs[2] * filter_state[1][l];
+      filter_state[1][l] = filter_state[0][l];
+      filter_state[0][l] = x;
+      tmp32 -= kHpPoleCoefs[1] * filter_state[2][l];
+      tmp32 -= kHpPoleCoefs[2] * filter_state[3][l];
+      filter_state[3][l] = filter_state[2][l];
+      filter_state[2][l] = static_cast<int16_t>(tmp32 >> 14);
+      data_out[i * kLanes + l] = filter_state[2][l];
+    }
+  }
+}
+
+void LogOfEnergyLanes(const int16_t* data_in,
+                      size_t data_length,
+                      int16_t offset,
+                      int16_t* total_energy,
+                      int16_t* log_energy) {
+  for (size_t l = 0; l < kLanes; ++l) {
+    int16_t smax = -1;
+    for (size_t i = 0; i < data_length; ++i) {
+      const int16_t x = data_in[i * kLanes + l];
+      const int16_t sabs = x > 0 ? x : static_cast<int16_t>(-x);
+      smax = sabs > smax ? sabs : smax;
+    }
+    const int scaling = EnergyScaling(smax, data_length);
+    int32_t energy = 0;
+    for (size_t i = 0; i < data_length; ++i) {
+      const int16_t x = data_in[i * kLanes + l];
+      energy += (x * x) >> scaling;
+    }
+    log_energy[l] = LogOfEnergy(static_cast<uint32_t>(energy), scaling, offset,
+                                &total_energy[l]);
+  }
+}
+
+#endif
+
+}  // namespace
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+
+void InterleaveLanes(const int16_t* const in[kLanes],
+                     size_t length,
+                     int16_t* out) {
+  RTC_DCHECK_EQ(length % kLanes, 0);
+  for (size_t i = 0; i < length; i += kLanes) {
+    // 8x8 transpose of 16 bit values.
+    const __m128i a0 = Load(&in[0][i]);
+    const __m128i a1 = Load(&in[1][i]);
+    const __m128i a2 = Load(&in[2][i]);
+    const __m128i a3 = Load(&in[3][i]);
+    const __m128i a4 = Load(&in[4][i]);
+    const __m128i a5 = Load(&in[5][i]);
+    const __m128i a6 = Load(&in[6][i]);
+    const __m128i a7 = Load(&in[7][i]);
+    const __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    const __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    const __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    const __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+    const __m128i b4 = _mm_unpacklo_epi16(a4, a5);
+    const __m128i b5 = _mm_unpackhi_epi16(a4, a5);
+    const __m128i b6 = _mm_unpacklo_epi16(a6, a7);
+    const __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+    const __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    const __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    const __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    const __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    const __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    const __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    const __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    const __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+    int16_t* y = &out[i * kLanes];
+    Store(_mm_unpacklo_epi64(c0, c4), &y[0 * kLanes]);
+    Store(_mm_unpackhi_epi64(c0, c4), &y[1 * kLanes]);
+    Store(_mm_unpacklo_epi64(c1, c5), &y[2 * kLanes]);
+    Store(_mm_unpackhi_epi64(c1, c5), &y[3 * kLanes]);
+    Store(_mm_unpacklo_epi64(c2, c6), &y[4 * kLanes]);
+    Store(_mm_unpackhi_epi64(c2, c6), &y[5 * kLanes]);
+    Store(_mm_unpacklo_epi64(c3, c7), &y[6 * kLanes]);
+    Store(_mm_unpackhi_epi64(c3, c7), &y[7 * kLanes]);
+  }
+}
+
+void DownsampleLanes(const int16_t* signal_in,
+                     size_t in_length,
+                     int32_t filter_state[2][kLanes],
+                     int16_t* signal_out) {
+  const __m128i upper_coef = _mm_set1_epi16(kAllPassCoefsQ13[0]);
+  const __m128i lower_coef = _mm_set1_epi16(kAllPassCoefsQ13[1]);
+  __m128i upper_lo = Load(&filter_state[0][0]);
+  __m128i upper_hi = Load(&filter_state[0][4]);
+  __m128i lower_lo = Load(&filter_state[1][0]);
+  __m128i lower_hi = Load(&filter_state[1][4]);
+  __m128i product_lo, product_hi, x_lo, x_hi;
+
+  for (size_t n = 0; n < in_length / 2; ++n) {
+    const __m128i x0 = Load(&signal_in[2 * n * kLanes]);
+    const __m128i x1 = Load(&signal_in[(2 * n + 1) * kLanes]);
+
+    // All-pass filtering upper branch.
+    Multiply(x0, upper_coef, &product_lo, &product_hi);
+    const __m128i upper = Narrow(
+        _mm_add_epi32(_mm_srai_epi32(upper_lo, 1),
+                      _mm_srai_epi32(product_lo, 14)),
+        _mm_add_epi32(_mm_srai_epi32(upper_hi, 1),
+                      _mm_srai_epi32(product_hi, 14)));
+    Multiply(upper, upper_coef, &product_lo, &product_hi);
+    Widen(x0, &x_lo, &x_hi);
+    upper_lo = _mm_sub_epi32(x_lo, _mm_srai_epi32(product_lo, 12));
+    upper_hi = _mm_sub_epi32(x_hi, _mm_srai_epi32(product_hi, 12));
+
+    // All-pass filtering lower branch.
+    Multiply(x1, lower_coef, &product_lo, &product_hi);
+    const __m128i lower = Narrow(
+        _mm_add_epi32(_mm_srai_epi32(lower_lo, 1),
+                      _mm_srai_epi32(product_lo, 14)),
+        _mm_add_epi32(_mm_srai_epi32(lower_hi, 1),
+                      _mm_srai_epi32(product_hi, 14)));
+    Multiply(lower, lower_coef, &product_lo, &product_hi);
+    Widen(x1, &x_lo, &x_hi);
+    lower_lo = _mm_sub_epi32(x_lo, _mm_srai_epi32(product_lo, 12));
+    lower_hi = _mm_sub_epi32(x_hi, _mm_srai_epi32(product_hi, 12));
+
+    Store(_mm_add_epi16(upper, lower), &signal_out[n * kLanes]);
+  }
+
+  Store(upper_lo, &filter_state[0][0]);
+  Store(upper_hi, &filter_state[0][4]);
+  Store(lower_lo, &filter_state[1][0]);
+  Store(lower_hi, &filter_state[1][4]);
+}
+
+void Resample48khzTo8khzLanes(const int16_t* signal_in,
+                              Resampler48khzTo8khzLanes* state,
+                              int16_t* signal_out) {
+  // The stages of WebRtcSpl_Resample48khzTo8khz(), see there, on int32 samples
+  // in two halves of four lanes. The all-pass chains are recursive, so the two
+  // halves are filtered in the same loop to interleave their chains.
+  // `resampled_24khz` is preceded by the history of the 24 kHz to 16 kHz
+  // filter.
+  alignas(16) int32_t downsampled_24khz[240 * kLanes];
+  alignas(16) int32_t resampled_24khz[(8 + 240) * kLanes];
+  alignas(16) int32_t resampled_16khz[160 * kLanes];
+  constexpr size_t kHalves[2] = {0, 4};
+  __m128i s[2][16];
+
+  // 48 kHz to 24 kHz.
+  for (int h = 0; h < 2; ++h) {
+    LoadStates(state->S_48_24, 8, kHalves[h], s[h]);
+  }
+  const __m128i offset = _mm_set1_epi32(1 << 14);
+  for (size_t i = 0; i < 240; ++i) {
+    const __m128i x0 = Load(&signal_in[2 * i * kLanes]);
+    const __m128i x1 = Load(&signal_in[(2 * i + 1) * kLanes]);
+    __m128i x0_32[2], x1_32[2];
+    Widen(x0, &x0_32[0], &x0_32[1]);
+    Widen(x1, &x1_32[0], &x1_32[1]);
+    for (int h = 0; h < 2; ++h) {
+      const __m128i upper =
+          AllpassLanes(_mm_add_epi32(_mm_slli_epi32(x0_32[h], 15), offset),
+                       kResampleAllpass[1], &s[h][0]);
+      const __m128i lower =
+          AllpassLanes(_mm_add_epi32(_mm_slli_epi32(x1_32[h], 15), offset),
+                       kResampleAllpass[0], &s[h][4]);
+      Store(_mm_add_epi32(_mm_srai_epi32(upper, 1), _mm_srai_epi32(lower, 1)),
+            &downsampled_24khz[i * kLanes + kHalves[h]]);
+    }
+  }
+  for (int h = 0; h < 2; ++h) {
+    StoreStates(s[h], 8, kHalves[h], state->S_48_24);
+  }
+
+  // Lowpass filtering at 24 kHz. The first chain is fed with the odd samples
+  // delayed by one, which the last chain keeps as its first state.
+  for (int h = 0; h < 2; ++h) {
+    LoadStates(state->S_24_24, 16, kHalves[h], s[h]);
+  }
+  for (size_t i = 0; i < 120; ++i) {
+    for (int h = 0; h < 2; ++h) {
+      const __m128i x0 =
+          Load(&downsampled_24khz[2 * i * kLanes + kHalves[h]]);
+      const __m128i x1 =
+          Load(&downsampled_24khz[(2 * i + 1) * kLanes + kHalves[h]]);
+      const __m128i y0 = AllpassLanes(s[h][12], kResampleAllpass[1], &s[h][0]);
+      const __m128i y1 = AllpassLanes(x0, kResampleAllpass[0], &s[h][4]);
+      const __m128i y2 = AllpassLanes(x0, kResampleAllpass[1], &s[h][8]);
+      const __m128i y3 = AllpassLanes(x1, kResampleAllpass[0], &s[h][12]);
+      Store(_mm_srai_epi32(
+                _mm_add_epi32(_mm_srai_epi32(y0, 1), _mm_srai_epi32(y1, 1)),
+                15),
+            &resampled_24khz[(8 + 2 * i) * kLanes + kHalves[h]]);
+      Store(_mm_srai_epi32(
+                _mm_add_epi32(_mm_srai_epi32(y2, 1), _mm_srai_epi32(y3, 1)),
+                15),
+            &resampled_24khz[(8 + 2 * i + 1) * kLanes + kHalves[h]]);
+    }
+  }
+  for (int h = 0; h < 2; ++h) {
+    StoreStates(s[h], 16, kHalves[h], state->S_24_24);
+  }
+
+  // 24 kHz to 16 kHz.
+  for (size_t i = 0; i < 8 * kLanes; i += 4) {
+    Store(Load(&state->S_24_16[0][i]), &resampled_24khz[i]);
+    Store(Load(&resampled_24khz[240 * kLanes + i]), &state->S_24_16[0][i]);
+  }
+  for (size_t m = 0; m < 80; ++m) {
+    for (int h = 0; h < 2; ++h) {
+      const int32_t* x = &resampled_24khz[3 * m * kLanes + kHalves[h]];
+      __m128i y0 = _mm_set1_epi32(1 << 14);
+      __m128i y1 = y0;
+      for (size_t k = 0; k < 8; ++k) {
+        y0 = _mm_add_epi32(y0, MultiplyByConstant(Load(&x[k * kLanes]),
+                                                  kCoefficients48To32[0][k]));
+        y1 = _mm_add_epi32(y1, MultiplyByConstant(Load(&x[(k + 1) * kLanes]),
+                                                  kCoefficients48To32[1][k]));
+      }
+      Store(y0, &resampled_16khz[2 * m * kLanes + kHalves[h]]);
+      Store(y1, &resampled_16khz[(2 * m + 1) * kLanes + kHalves[h]]);
+    }
+  }
+
+  // 16 kHz to 8 kHz.
+  for (int h = 0; h < 2; ++h) {
+    LoadStates(state->S_16_8, 8, kHalves[h], s[h]);
+  }
+  for (size_t i = 0; i < 80; ++i) {
+    __m128i y[2];
+    for (int h = 0; h < 2; ++h) {
+      const __m128i upper =
+          AllpassLanes(Load(&resampled_16khz[2 * i * kLanes + kHalves[h]]),
+                       kResampleAllpass[1], &s[h][0]);
+      const __m128i lower = AllpassLanes(
+          Load(&resampled_16khz[(2 * i + 1) * kLanes + kHalves[h]]),
+          kResampleAllpass[0], &s[h][4]);
+      y[h] = _mm_srai_epi32(
+          _mm_add_epi32(_mm_srai_epi32(upper, 1), _mm_srai_epi32(lower, 1)),
+          15);
+    }
+    Store(_mm_packs_epi32(y[0], y[1]), &signal_out[i * kLanes]);
+  }
+  for (int h = 0; h < 2; ++h) {
+    StoreStates(s[h], 8, kHalves[h], state->S_16_8);
+  }
+}
+
+void GmmProbabilityLanes(GmmLanes* gmm,
+                         VadInstT* states,
+                         const int16_t features[kNumChannels][kLanes],
+                         const int16_t total_power[kLanes],
+                         size_t frame_length,
+                         int16_t vad[kLanes]) {
+  // The thresholds depend on the mode and on the frame length, which all lanes
+  // share.
+  const size_t index = frame_length == 80 ? 0 : frame_length == 160 ? 1 : 2;
+  const int16_t individual_test = states[0].individual[index];
+  const int16_t total_test = states[0].total[index];
+  const __m128i active =
+      _mm_cmpgt_epi16(Load(total_power), _mm_set1_epi16(kMinEnergy));
+  __m128i vadflag = _mm_setzero_si128();
+
+  // The lanes without enough energy are computed as well, but neither their
+  // models nor their decisions are kept.
+  if (_mm_movemask_epi8(active) != 0) {
+    __m128i delta_noise[kTableSize], delta_speech[kTableSize];
+    __m128i ngprvec[kTableSize], sgprvec[kTableSize];
+    __m128i sum_log_likelihood_ratios = _mm_setzero_si128();
+    __m128i lo, hi;
+
+    // Likelihood ratio test, see WebRtcVad_GmmProbability().
+    for (int channel = 0; channel < kNumChannels; ++channel) {
+      const __m128i feature = Load(features[channel]);
+      __m128i h0_lo = _mm_setzero_si128();
+      __m128i h0_hi = _mm_setzero_si128();
+      __m128i h1_lo = _mm_setzero_si128();
+      __m128i h1_hi = _mm_setzero_si128();
+      __m128i noise_lo, noise_hi, speech_lo, speech_hi;
+      for (int k = 0; k < kNumGaussians; ++k) {
+        const int gaussian = channel + k * kNumChannels;
+        // Probability under H0, in Q27.
+        GaussianProbability(feature, Load(gmm->noise_means[gaussian]),
+                            Load(gmm->noise_stds[gaussian]), &lo, &hi,
+                            &delta_noise[gaussian]);
+        const __m128i noise_weight =
+            _mm_set1_epi32(kNoiseDataWeights[gaussian]);
+        lo = MultiplyLow32(lo, noise_weight);
+        hi = MultiplyLow32(hi, noise_weight);
+        h0_lo = _mm_add_epi32(h0_lo, lo);
+        h0_hi = _mm_add_epi32(h0_hi, hi);
+        if (k == 0) {
+          noise_lo = lo;
+          noise_hi = hi;
+        }
+
+        // Probability under H1, in Q27.
+        GaussianProbability(feature, Load(gmm->speech_means[gaussian]),
+                            Load(gmm->speech_stds[gaussian]), &lo, &hi,
+                            &delta_speech[gaussian]);
+        const __m128i speech_weight =
+            _mm_set1_epi32(kSpeechDataWeights[gaussian]);
+        lo = MultiplyLow32(lo, speech_weight);
+        hi = MultiplyLow32(hi, speech_weight);
+        h1_lo = _mm_add_epi32(h1_lo, lo);
+        h1_hi = _mm_add_epi32(h1_hi, hi);
+        if (k == 0) {
+          speech_lo = lo;
+          speech_hi = hi;
+        }
+      }
+
+      const __m128i log_likelihood_ratio = _mm_sub_epi16(
+          _mm_packs_epi32(NormW32(h0_lo), NormW32(h0_hi)),
+          _mm_packs_epi32(NormW32(h1_lo), NormW32(h1_hi)));
+      sum_log_likelihood_ratios = _mm_add_epi16(
+          sum_log_likelihood_ratios,
+          _mm_mullo_epi16(log_likelihood_ratio,
+                          _mm_set1_epi16(kSpectrumWeight[channel])));
+
+      // Local VAD decision.
+      vadflag = _mm_or_si128(
+          vadflag, _mm_cmpgt_epi16(_mm_slli_epi16(log_likelihood_ratio, 2),
+                                   _mm_set1_epi16(individual_test)));
+
+      ConditionalProbabilities(noise_lo, noise_hi, h0_lo, h0_hi, 16384,
+                               &ngprvec[channel],
+                               &ngprvec[channel + kNumChannels]);
+      ConditionalProbabilities(speech_lo, speech_hi, h1_lo, h1_hi, 0,
+                               &sgprvec[channel],
+                               &sgprvec[channel + kNumChannels]);
+    }
+
+    // Global VAD decision.
+    vadflag = _mm_or_si128(
+        vadflag, _mm_cmpgt_epi16(sum_log_likelihood_ratios,
+                                 _mm_set1_epi16(total_test - 1)));
+
+    // The minimum tracking takes its own branches per lane, and is vectorized
+    // over the 16 minima of a lane instead.
+    alignas(16) int16_t active_lanes[kLanes];
+    alignas(16) int16_t feature_minimum[kNumChannels][kLanes] = {};
+    Store(active, active_lanes);
+    for (size_t l = 0; l < kLanes; ++l) {
+      if (active_lanes[l]) {
+        for (int channel = 0; channel < kNumChannels; ++channel) {
+          feature_minimum[channel][l] =
+              WebRtcVad_FindMinimum(&states[l], features[channel][l], channel);
+        }
+      }
+    }
+
+    // Update the models, noise where `vadflag` is clear and speech where it is
+    // set, by selecting between the updated and the current values.
+    int16_t maxspe = 12800;
+    for (int channel = 0; channel < kNumChannels; ++channel) {
+      const __m128i feature = Load(features[channel]);
+      __m128i noise_means[kNumGaussians], speech_means[kNumGaussians];
+      __m128i noise_stds[kNumGaussians], speech_stds[kNumGaussians];
+      for (int k = 0; k < kNumGaussians; ++k) {
+        const int gaussian = channel + k * kNumChannels;
+        noise_means[k] = Load(gmm->noise_means[gaussian]);
+        speech_means[k] = Load(gmm->speech_means[gaussian]);
+        noise_stds[k] = Load(gmm->noise_stds[gaussian]);
+        speech_stds[k] = Load(gmm->speech_stds[gaussian]);
+      }
+
+      WeightedAverage(noise_means[0], noise_means[1],
+                      &kNoiseDataWeights[channel], &lo, &hi);
+      const __m128i noise_global_mean =
+          Narrow(_mm_srai_epi32(lo, 6), _mm_srai_epi32(hi, 6));  // Q8
+      const __m128i ndelt = _mm_sub_epi16(
+          _mm_slli_epi16(Load(feature_minimum[channel]), 4),
+          noise_global_mean);  // Q8
+
+      for (int k = 0; k < kNumGaussians; ++k) {
+        const int gaussian = channel + k * kNumChannels;
+        const __m128i nmk = noise_means[k];
+        const __m128i smk = speech_means[k];
+        const __m128i nsk = noise_stds[k];
+        const __m128i ssk = speech_stds[k];
+
+        // Noise mean, with the long term correction.
+        Multiply(ngprvec[gaussian], delta_noise[gaussian], &lo, &hi);
+        const __m128i noise_delt =
+            Narrow(_mm_srai_epi32(lo, 11), _mm_srai_epi32(hi, 11));  // Q14
+        Multiply(noise_delt, _mm_set1_epi16(kNoiseUpdateConst), &lo, &hi);
+        const __m128i nmk2 = Select(
+            vadflag, nmk,
+            _mm_add_epi16(nmk, Narrow(_mm_srai_epi32(lo, 22),
+                                      _mm_srai_epi32(hi, 22))));
+        Multiply(ndelt, _mm_set1_epi16(kBackEta), &lo, &hi);
+        __m128i nmk3 = _mm_add_epi16(
+            nmk2, Narrow(_mm_srai_epi32(lo, 9), _mm_srai_epi32(hi, 9)));
+        nmk3 = _mm_max_epi16(nmk3, _mm_set1_epi16((k + 5) << 7));
+        nmk3 = _mm_min_epi16(nmk3, _mm_set1_epi16((72 + k - channel) << 7));
+        noise_means[k] = nmk3;
+
+        // Speech mean.
+        Multiply(sgprvec[gaussian], delta_speech[gaussian], &lo, &hi);
+        const __m128i speech_delt =
+            Narrow(_mm_srai_epi32(lo, 11), _mm_srai_epi32(hi, 11));  // Q14
+        Multiply(speech_delt, _mm_set1_epi16(kSpeechUpdateConst), &lo, &hi);
+        __m128i smk2 = _mm_add_epi16(
+            smk, RoundedShift(Narrow(_mm_srai_epi32(lo, 21),
+                                     _mm_srai_epi32(hi, 21)),
+                              1));
+        smk2 = _mm_max_epi16(smk2, _mm_set1_epi16(kMinimumMean[k]));
+        smk2 = _mm_min_epi16(smk2, _mm_set1_epi16(maxspe + 640));
+        speech_means[k] = Select(vadflag, smk2, smk);
+
+        // Speech standard deviation.
+        Multiply(delta_speech[gaussian],
+                 _mm_sub_epi16(feature, RoundedShift(smk, 3)), &lo, &hi);
+        const __m128i four_q12 = _mm_set1_epi32(4096);
+        const __m128i speech_diff_lo =
+            _mm_sub_epi32(_mm_srai_epi32(lo, 3), four_q12);  // Q12
+        const __m128i speech_diff_hi =
+            _mm_sub_epi32(_mm_srai_epi32(hi, 3), four_q12);
+        Widen(_mm_srai_epi16(sgprvec[gaussian], 2), &lo, &hi);
+        lo = _mm_srai_epi32(MultiplyLow32(lo, speech_diff_lo), 4);  // Q20
+        hi = _mm_srai_epi32(MultiplyLow32(hi, speech_diff_hi), 4);
+        __m128i ssk2 = Divide(lo, hi, _mm_mullo_epi16(ssk, _mm_set1_epi16(10)));
+        ssk2 = _mm_add_epi16(
+            ssk, _mm_srai_epi16(_mm_add_epi16(ssk2, _mm_set1_epi16(128)), 8));
+        ssk2 = _mm_max_epi16(ssk2, _mm_set1_epi16(kMinStd));
+        speech_stds[k] = Select(vadflag, ssk2, ssk);
+
+        // Noise standard deviation.
+        Multiply(delta_noise[gaussian],
+                 _mm_sub_epi16(feature, _mm_srai_epi16(nmk, 3)), &lo, &hi);
+        const __m128i noise_diff_lo =
+            _mm_sub_epi32(_mm_srai_epi32(lo, 3), four_q12);  // Q12
+        const __m128i noise_diff_hi =
+            _mm_sub_epi32(_mm_srai_epi32(hi, 3), four_q12);
+        Widen(RoundedShift(ngprvec[gaussian], 2), &lo, &hi);
+        lo = _mm_srai_epi32(MultiplyLow32(lo, noise_diff_lo), 14);  // Q20
+        hi = _mm_srai_epi32(MultiplyLow32(hi, noise_diff_hi), 14);
+        __m128i nsk2 = Divide(lo, hi, nsk);
+        nsk2 = _mm_add_epi16(
+            nsk, _mm_srai_epi16(_mm_add_epi16(nsk2, _mm_set1_epi16(32)), 6));
+        nsk2 = _mm_max_epi16(nsk2, _mm_set1_epi16(kMinStd));
+        noise_stds[k] = Select(vadflag, nsk, nsk2);
+      }
+
+      // Separate the models if they are too close.
+      __m128i noise_lo, noise_hi, speech_lo, speech_hi;
+      WeightedAverage(noise_means[0], noise_means[1],
+                      &kNoiseDataWeights[channel], &noise_lo, &noise_hi);
+      WeightedAverage(speech_means[0], speech_means[1],
+                      &kSpeechDataWeights[channel], &speech_lo, &speech_hi);
+      const __m128i diff = _mm_sub_epi16(
+          Narrow(_mm_srai_epi32(speech_lo, 9), _mm_srai_epi32(speech_hi, 9)),
+          Narrow(_mm_srai_epi32(noise_lo, 9), _mm_srai_epi32(noise_hi, 9)));
+      const __m128i minimum_difference =
+          _mm_set1_epi16(kMinimumDifference[channel]);
+      const __m128i shortfall =
+          _mm_and_si128(_mm_cmplt_epi16(diff, minimum_difference),
+                        _mm_sub_epi16(minimum_difference, diff));
+      Multiply(shortfall, _mm_set1_epi16(13), &lo, &hi);
+      const __m128i speech_offset =
+          Narrow(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+      Multiply(shortfall, _mm_set1_epi16(3), &lo, &hi);
+      const __m128i noise_offset =
+          Narrow(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+      for (int k = 0; k < kNumGaussians; ++k) {
+        speech_means[k] = _mm_add_epi16(speech_means[k], speech_offset);
+        noise_means[k] = _mm_sub_epi16(noise_means[k], noise_offset);
+      }
+
+      // Control that the speech and noise means do not drift too much.
+      maxspe = kMaximumSpeech[channel];
+      WeightedAverage(speech_means[0], speech_means[1],
+                      &kSpeechDataWeights[channel], &lo, &hi);
+      const __m128i speech_global_mean =
+          Narrow(_mm_srai_epi32(lo, 7), _mm_srai_epi32(hi, 7));
+      const __m128i max_speech = _mm_set1_epi16(maxspe);
+      const __m128i speech_excess =
+          _mm_and_si128(_mm_cmpgt_epi16(speech_global_mean, max_speech),
+                        _mm_sub_epi16(speech_global_mean, max_speech));
+      WeightedAverage(noise_means[0], noise_means[1],
+                      &kNoiseDataWeights[channel], &lo, &hi);
+      const __m128i noise_global_mean_q7 =
+          Narrow(_mm_srai_epi32(lo, 7), _mm_srai_epi32(hi, 7));
+      const __m128i max_noise = _mm_set1_epi16(kMaximumNoise[channel]);
+      const __m128i noise_excess =
+          _mm_and_si128(_mm_cmpgt_epi16(noise_global_mean_q7, max_noise),
+                        _mm_sub_epi16(noise_global_mean_q7, max_noise));
+
+      for (int k = 0; k < kNumGaussians; ++k) {
+        const int gaussian = channel + k * kNumChannels;
+        Store(Select(active, _mm_sub_epi16(noise_means[k], noise_excess),
+                     Load(gmm->noise_means[gaussian])),
+              gmm->noise_means[gaussian]);
+        Store(Select(active, _mm_sub_epi16(speech_means[k], speech_excess),
+                     Load(gmm->speech_means[gaussian])),
+              gmm->speech_means[gaussian]);
+        Store(Select(active, noise_stds[k], Load(gmm->noise_stds[gaussian])),
+              gmm->noise_stds[gaussian]);
+        Store(Select(active, speech_stds[k], Load(gmm->speech_stds[gaussian])),
+              gmm->speech_stds[gaussian]);
+      }
+    }
+  }
+
+  // Smooth with respect to transition hysteresis, per lane.
+  alignas(16) int16_t vadflags[kLanes];
+  Store(_mm_and_si128(vadflag, active), vadflags);
+  for (size_t l = 0; l < kLanes; ++l) {
+    VadInstT& self = states[l];
+    if (total_power[l] > kMinEnergy) {
+      self.frame_counter++;
+    }
+    if (!vadflags[l]) {
+      vad[l] = 0;
+      if (self.over_hang > 0) {
+        vad[l] = 2 + self.over_hang;
+        self.over_hang--;
+      }
+      self.num_of_speech = 0;
+    } else {
+      vad[l] = 1;
+      self.num_of_speech++;
+      if (self.num_of_speech > kMaxSpeechFrames) {
+        self.num_of_speech = kMaxSpeechFrames;
+        self.over_hang = self.over_hang_max_2[index];
+      } else {
+        self.over_hang = self.over_hang_max_1[index];
+      }
+    }
+  }
+}
+
+#else
+
+void InterleaveLanes(const int16_t* const in[kLanes],
+                     size_t length,
+                     int16_t* out) {
+  RTC_DCHECK_EQ(length % kLanes, 0);
+  for (size_t i = 0; i < length; ++i) {
+    for (size_t l = 0; l < kLanes; ++l) {
+      out[i * kLanes + l] = in[l][i];
+    }
+  }
+}
+
+void DownsampleLanes(const int16_t* signal_in,
+                     size_t in_length,
+                     int32_t filter_state[2][kLanes],
+                     int16_t* signal_out) {
+  for (size_t l = 0; l < kLanes; ++l) {
+    int32_t tmp32_1 = filter_state[0][l];
+    int32_t tmp32_2 = filter_state[1][l];
+    for (size_t n = 0; n < in_length / 2; ++n) {
+      const int16_t x0 = signal_in[2 * n * kLanes + l];
+      const int16_t x1 = signal_in[(2 * n + 1) * kLanes + l];
+      const int16_t tmp16_1 = static_cast<int16_t>(
+          (tmp32_1 >> 1) + ((kAllPassCoefsQ13[0] * x0) >> 14));
+      tmp32_1 = x0 - ((kAllPassCoefsQ13[0] * tmp16_1) >> 12);
+      const int16_t tmp16_2 = static_cast<int16_t>(
+          (tmp32_2 >> 1) + ((kAllPassCoefsQ13[1] * x1) >> 14));
+      tmp32_2 = x1 - ((kAllPassCoefsQ13[1] * tmp16_2) >> 12);
+      signal_out[n * kLanes + l] = static_cast<int16_t>(tmp16_1 + tmp16_2);
+    }
+    filter_state[0][l] = tmp32_1;
+    filter_state[1][l] = tmp32_2;
+  }
+}
+
+void Resample48khzTo8khzLanes(const int16_t* signal_in,
+                              Resampler48khzTo8khzLanes* state,
+                              int16_t* signal_out) {
+  int16_t lane_in[480];
+  int16_t lane_out[80];
+  int32_t tmp_mem[480 + 256];
+  for (size_t l = 0; l < kLanes; ++l) {
+    WebRtcSpl_State48khzTo8khz lane_state;
+    for (size_t i = 0; i < 8; ++i) {
+      lane_state.S_48_24[i] = state->S_48_24[i][l];
+      lane_state.S_24_16[i] = state->S_24_16[i][l];
+      lane_state.S_16_8[i] = state->S_16_8[i][l];
+    }
+    for (size_t i = 0; i < 16; ++i) {
+      lane_state.S_24_24[i] = state->S_24_24[i][l];
+    }
+    for (size_t i = 0; i < 480; ++i) {
+      lane_in[i] = signal_in[i * kLanes + l];
+    }
+    WebRtcSpl_Resample48khzTo8khz(lane_in, lane_out, &lane_state, tmp_mem);
+    for (size_t i = 0; i < 80; ++i) {
+      signal_out[i * kLanes + l] = lane_out[i];
+    }
+    for (size_t i = 0; i < 8; ++i) {
+      state->S_48_24[i][l] = lane_state.S_48_24[i];
+      state->S_24_16[i][l] = lane_state.S_24_16[i];
+      state->S_16_8[i][l] = lane_state.S_16_8[i];
+    }
+    for (size_t i = 0; i < 16; ++i) {
+      state->S_24_24[i][l] = lane_state.S_24_24[i];
+    }
+  }
+}
+
+void GmmProbabilityLanes(GmmLanes* gmm,
+                         VadInstT* states,
+                         const int16_t features[kNumChannels][kLanes],
+                         const int16_t total_power[kLanes],
+                         size_t frame_length,
+                         int16_t vad[kLanes]) {
+  for (size_t l = 0; l < kLanes; ++l) {
+    VadInstT& self = states[l];
+    for (int gaussian = 0; gaussian < kTableSize; ++gaussian) {
+      self.noise_means[gaussian] = gmm->noise_means[gaussian][l];
+      self.speech_means[gaussian] = gmm->speech_means[gaussian][l];
+      self.noise_stds[gaussian] = gmm->noise_stds[gaussian][l];
+      self.speech_stds[gaussian] = gmm->speech_stds[gaussian][l];
+    }
+    int16_t lane_features[kNumChannels];
+    for (int channel = 0; channel < kNumChannels; ++channel) {
+      lane_features[channel] = features[channel][l];
+    }
+    vad[l] = WebRtcVad_GmmProbability(&self, lane_features, total_power[l],
+                                      frame_length);
+    for (int gaussian = 0; gaussian < kTableSize; ++gaussian) {
+      gmm->noise_means[gaussian][l] = self.noise_means[gaussian];
+      gmm->speech_means[gaussian][l] = self.speech_means[gaussian];
+      gmm->noise_stds[gaussian][l] = self.noise_stds[gaussian];
+      gmm->speech_stds[gaussian][l] = self.speech_stds[gaussian];
+    }
+  }
+}
+
+#endif
+
+void CalculateFeaturesLanes(FilterbankLanes* state,
+                            const int16_t* data_in,
+                            size_t data_length,
+                            int16_t features[kNumChannels][kLanes],
+                            int16_t total_energy[kLanes]) {
+  // Same band split as WebRtcVad_CalculateFeatures(), see there.
+  alignas(16) int16_t hp_120[120 * kLanes];
+  alignas(16) int16_t lp_120[120 * kLanes];
+  alignas(16) int16_t hp_60[60 * kLanes];
+  alignas(16) int16_t lp_60[60 * kLanes];
+  const size_t half_data_length = data_length >> 1;
+  size_t length = half_data_length;
+
+  RTC_DCHECK_LE(data_length, 240);
+  for (size_t l = 0; l < kLanes; ++l) {
+    total_energy[l] = 0;
+  }
+
+  // Split at 2000 Hz and downsample.
+  SplitFilterLanes(data_in, data_length, state->upper_state[0],
+                   state->lower_state[0], hp_120, lp_120);
+
+  // For the upper band (2000 Hz - 4000 Hz) split at 3000 Hz and downsample.
+  SplitFilterLanes(hp_120, length, state->upper_state[1],
+                   state->lower_state[1], hp_60, lp_60);
+
+  // Energy in 3000 Hz - 4000 Hz and 2000 Hz - 3000 Hz.
+  length >>= 1;
+  LogOfEnergyLanes(hp_60, length, kOffsetVector[5], total_energy, features[5]);
+  LogOfEnergyLanes(lp_60, length, kOffsetVector[4], total_energy, features[4]);
+
+  // For the lower band (0 Hz - 2000 Hz) split at 1000 Hz and downsample.
+  length = half_data_length;
+  SplitFilterLanes(lp_120, length, state->upper_state[2],
+                   state->lower_state[2], hp_60, lp_60);
+
+  // Energy in 1000 Hz - 2000 Hz.
+  length >>= 1;
+  LogOfEnergyLanes(hp_60, length, kOffsetVector[3], total_energy, features[3]);
+
+  // For the lower band (0 Hz - 1000 Hz) split at 500 Hz and downsample.
+  SplitFilterLanes(lp_60, length, state->upper_state[3],
+                   state->lower_state[3], hp_120, lp_120);
+
+  // Energy in 500 Hz - 1000 Hz.
+  length >>= 1;
+  LogOfEnergyLanes(hp_120, length, kOffsetVector[2], total_energy,
+                   features[2]);
+
+  // For the lower band (0 Hz - 500 Hz) split at 250 Hz and downsample.
+  SplitFilterLanes(lp_120, length, state->upper_state[4],
+                   state->lower_state[4], hp_60, lp_60);
+
+  // Energy in 250 Hz - 500 Hz.
+  length >>= 1;
+  LogOfEnergyLanes(hp_60, length, kOffsetVector[1], total_energy, features[1]);
+
+  // Remove 0 Hz - 80 Hz, by high pass filtering the lower band.
+  HighPassFilterLanes(lp_60, length, state->hp_filter_state, hp_120);
+
+  // Energy in 80 Hz - 250 Hz.
+  LogOfEnergyLanes(hp_120, length, kOffsetVector[0], total_energy,
+                   features[0]);
+}
+
+}  // namespace batch_vad
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_VAD_BATCH_VAD_KERNELS_H_
+#define COMMON_AUDIO_VAD_BATCH_VAD_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+#include "common_audio/vad/vad_core.h"
+}
+
+namespace webrtc {
+namespace batch_vad {
+
+// The kernels below run the VAD of `kLanes` streams side by side. Signals are
+// stored interleaved, sample n of lane l at index n * `kLanes` + l, and the
+// states as one array of `kLanes` values per scalar state variable. Each lane
+// gives the same results as the scalar VAD code does for its stream.
+constexpr size_t kLanes = 8;
+
+// Filter states of WebRtcVad_CalculateFeatures() for `kLanes` streams.
+struct FilterbankLanes {
+  int16_t upper_state[5][kLanes];
+  int16_t lower_state[5][kLanes];
+  int16_t hp_filter_state[4][kLanes];
+};
+
+// Interleaves `length` samples of each of the `kLanes` signals in `in` into
+// `out`. `length` must be a multiple of `kLanes`.
+void InterleaveLanes(const int16_t* const in[kLanes],
+                     size_t length,
+                     int16_t* out);
+
+// Lane version of WebRtcVad_Downsampling(). `filter_state` holds the two
+// states of WebRtcVad_Downsampling() for each lane.
+void DownsampleLanes(const int16_t* signal_in,
+                     size_t in_length,
+                     int32_t filter_state[2][kLanes],
+                     int16_t* signal_out);
+
+// States of WebRtcSpl_Resample48khzTo8khz() for `kLanes` streams.
+struct Resampler48khzTo8khzLanes {
+  int32_t S_48_24[8][kLanes];
+  int32_t S_24_24[16][kLanes];
+  int32_t S_24_16[8][kLanes];
+  int32_t S_16_8[8][kLanes];
+};
+
+// Lane version of WebRtcSpl_Resample48khzTo8khz(), which resamples 10 ms,
+// i.e., 480 samples per lane.
+void Resample48khzTo8khzLanes(const int16_t* signal_in,
+                              Resampler48khzTo8khzLanes* state,
+                              int16_t* signal_out);
+
+// Lane version of WebRtcVad_CalculateFeatures(), which writes the features of
+// the frame in each lane to `features` and its total energy to `total_energy`.
+void CalculateFeaturesLanes(FilterbankLanes* state,
+                            const int16_t* data_in,
+                            size_t data_length,
+                            int16_t features[kNumChannels][kLanes],
+                            int16_t total_energy[kLanes]);
+
+// Gaussian mixture models of WebRtcVad_GmmProbability() for `kLanes` streams.
+struct GmmLanes {
+  int16_t noise_means[kTableSize][kLanes];
+  int16_t speech_means[kTableSize][kLanes];
+  int16_t noise_stds[kTableSize][kLanes];
+  int16_t speech_stds[kTableSize][kLanes];
+};
+
+// Lane version of WebRtcVad_GmmProbability(), which writes the decision of
+// each lane to `vad`. The models are taken from `gmm`, and the rest of the
+// state of each lane, i.e., the feature minima, the frame counter and the hang
+// over, from its element of `states`.
+void GmmProbabilityLanes(GmmLanes* gmm,
+                         VadInstT* states,
+                         const int16_t features[kNumChannels][kLanes],
+                         const int16_t total_power[kLanes],
+                         size_t frame_length,
+                         int16_t vad[kLanes]);
+
+}  // namespace batch_vad
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_VAD_BATCH_VAD_KERNELS_H_
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_VAD_INCLUDE_BATCH_VAD_H_
+#define COMMON_AUDIO_VAD_INCLUDE_BATCH_VAD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/array_view.h"
+#include "common_audio/vad/include/vad.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Voice activity detector that classifies many frames of many independent
+// streams per call. All streams share the aggressiveness, the sample rate and
+// the frame length, which are validated once at creation instead of on every
+// frame. The decisions are identical to those of one WebRtcVad instance per
+// stream fed with the same frames. The streams are classified eight at a time,
+// with one SIMD lane each, so multiples of eight streams use it best.
+class BatchVad {
+ public:
+  virtual ~BatchVad() = default;
+
+  // Classifies `num_frames` consecutive frames of every stream. `audio` holds
+  // `num_frames` * frame_length() samples per stream, one stream after the
+  // other. One decision per frame, 1 for active voice and 0 otherwise, is
+  // written to `decisions`, also one stream after the other. Returns false,
+  // without processing anything, if the sizes do not match.
+  virtual bool Process(rtc::ArrayView<const int16_t> audio,
+                       size_t num_frames,
+                       rtc::ArrayView<uint8_t> decisions) = 0;
+
+  // Resets the state of all streams.
+  virtual void Reset() = 0;
+
+  // Resets the state of `stream`, e.g., when it is reused for a new talker.
+  virtual void Reset(size_t stream) = 0;
+
+  virtual size_t num_streams() const = 0;
+  virtual size_t frame_length() const = 0;
+};
+
+// Returns a BatchVad for `num_streams` streams, or nullptr if `sample_rate_hz`
+// and `frame_length` are not a valid combination (see
+// WebRtcVad_ValidRateAndFrameLength()) or `num_streams` is zero.
+RTC_EXPORT std::unique_ptr<BatchVad> CreateBatchVad(
+    size_t num_streams,
+    Vad::Aggressiveness aggressiveness,
+    int sample_rate_hz,
+    size_t frame_length);
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_VAD_INCLUDE_BATCH_VAD_H_
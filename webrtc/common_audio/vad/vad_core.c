@@ -119,19 +119,8 @@ static inline int32_t RTC_NO_SANITIZE("signed-integer-overflow")
   return a * b;
 }
 
-// Calculates the probabilities for both speech and background noise using
-// Gaussian Mixture Models (GMM). A hypothesis-test is performed to decide which
-// type of signal is most probable.
-//
-// - self           [i/o] : Pointer to VAD instance
-// - features       [i]   : Feature vector of length `kNumChannels`
-//                          = log10(energy in frequency band)
-// - total_power    [i]   : Total power in audio frame.
-// - frame_length   [i]   : Number of input samples
-//
-// - returns              : the VAD decision (0 - noise, 1 - speech).
-static int16_t GmmProbability(VadInstT* self, int16_t* features,
-                              int16_t total_power, size_t frame_length) {
+int16_t WebRtcVad_GmmProbability(VadInstT* self, const int16_t* features,
+                                 int16_t total_power, size_t frame_length) {
   int channel, k;
   int16_t feature_minimum;
   int16_t h0, h1;
@@ -679,7 +668,8 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
                                               feature_vector);
 
     // Make a VAD
-    inst->vad = GmmProbability(inst, feature_vector, total_power, frame_length);
+    inst->vad = WebRtcVad_GmmProbability(inst, feature_vector, total_power,
+                                         frame_length);
 
     return inst->vad;
 }
@@ -120,4 +120,21 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst,
                           const int16_t* speech_frame,
                           size_t frame_length);
 
+// Calculates the probabilities for both speech and background noise using
+// Gaussian Mixture Models (GMM). A hypothesis-test is performed to decide which
+// type of signal is most probable. Called by WebRtcVad_CalcVad8khz() with the
+// features from WebRtcVad_CalculateFeatures().
+//
+// - self           [i/o] : Pointer to VAD instance
+// - features       [i]   : Feature vector of length `kNumChannels`
+//                          = log10(energy in frequency band)
+// - total_power    [i]   : Total power in audio frame.
+// - frame_length   [i]   : Number of input samples
+//
+// - returns              : the VAD decision (0 - noise, 1 - speech).
+int16_t WebRtcVad_GmmProbability(VadInstT* self,
+                                 const int16_t* features,
+                                 int16_t total_power,
+                                 size_t frame_length);
+
 #endif  // COMMON_AUDIO_VAD_VAD_CORE_H_
@@ -11,8 +11,15 @@
 #include "common_audio/vad/vad_filterbank.h"
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 // Constants used in LogOfEnergy().
 static const int16_t kLogConst = 24660;  // 160*log10(2) in Q9.
 static const int16_t kLogEnergyIntPart = 14336;  // 14 in Q10
@@ -69,43 +76,14 @@ static void HighPassFilter(const int16_t* data_in, size_t data_length,
   }
 }
 
-// All pass filtering of `data_in`, used before splitting the signal into two
-// frequency bands (low pass vs high pass).
-// Note that `data_in` and `data_out` can NOT correspond to the same address.
-//
-// - data_in            [i]   : Input audio signal given in Q0.
-// - data_length        [i]   : Length of input and output data.
-// - filter_coefficient [i]   : Given in Q15.
-// - filter_state       [i/o] : State of the filter given in Q(-1).
-// - data_out           [o]   : Output audio signal given in Q(-1).
-static void AllPassFilter(const int16_t* data_in, size_t data_length,
-                          int16_t filter_coefficient, int16_t* filter_state,
-                          int16_t* data_out) {
-  // The filter can only cause overflow (in the w16 output variable)
-  // if more than 4 consecutive input numbers are of maximum value and
-  // has the the same sign as the impulse responses first taps.
-  // First 6 taps of the impulse response:
-  // 0.6399 0.5905 -0.3779 0.2418 -0.1547 0.0990
-
-  size_t i;
-  int16_t tmp16 = 0;
-  int32_t tmp32 = 0;
-  int32_t state32 = ((int32_t) (*filter_state) * (1 << 16));  // Q15
-
-  for (i = 0; i < data_length; i++) {
-    tmp32 = state32 + filter_coefficient * *data_in;
-    tmp16 = (int16_t) (tmp32 >> 16);  // Q(-1)
-    *data_out++ = tmp16;
-    state32 = (*data_in * (1 << 14)) - filter_coefficient * tmp16;  // Q14
-    state32 *= 2;  // Q15.
-    data_in += 2;
-  }
-
-  *filter_state = (int16_t) (state32 >> 16);  // Q(-1)
-}
-
 // Splits `data_in` into `hp_data_out` and `lp_data_out` corresponding to
-// an upper (high pass) part and a lower (low pass) part respectively.
+// an upper (high pass) part and a lower (low pass) part respectively. The
+// splitting is done by all pass filtering the even samples (upper branch) and
+// the odd samples (lower branch) of `data_in`.
+// The all pass filters are recursive, so their throughput is bound by the
+// latency of each update rather than by the number of operations, which also
+// rules out vectorizing them over time. The two branches are independent,
+// hence they are run in the same loop such that their updates overlap.
 //
 // - data_in      [i]   : Input audio data to be split into two frequency bands.
 // - data_length  [i]   : Length of `data_in`.
@@ -118,25 +96,148 @@ static void AllPassFilter(const int16_t* data_in, size_t data_length,
 static void SplitFilter(const int16_t* data_in, size_t data_length,
                         int16_t* upper_state, int16_t* lower_state,
                         int16_t* hp_data_out, int16_t* lp_data_out) {
+  // The all pass filters can only cause overflow (in the w16 output variable)
+  // if more than 4 consecutive input numbers are of maximum value and
+  // has the the same sign as the impulse responses first taps.
+  // First 6 taps of the impulse response of the upper filter:
+  // 0.6399 0.5905 -0.3779 0.2418 -0.1547 0.0990
+
   size_t i;
   size_t half_length = data_length >> 1;  // Downsampling by 2.
-  int16_t tmp_out;
+  int16_t upper = 0, lower = 0;
+  int32_t upper_state32 = ((int32_t) (*upper_state) * (1 << 16));  // Q15
+  int32_t lower_state32 = ((int32_t) (*lower_state) * (1 << 16));  // Q15
 
-  // All-pass filtering upper branch.
-  AllPassFilter(&data_in[0], half_length, kAllPassCoefsQ15[0], upper_state,
-                hp_data_out);
+  for (i = 0; i < half_length; i++) {
+    // All-pass filtering upper branch, coefficient in Q15.
+    upper = (int16_t) ((upper_state32 +
+        kAllPassCoefsQ15[0] * data_in[0]) >> 16);  // Q(-1)
+    upper_state32 = (data_in[0] * (1 << 14)) -
+        kAllPassCoefsQ15[0] * upper;  // Q14
+    upper_state32 *= 2;  // Q15.
+
+    // All-pass filtering lower branch, coefficient in Q15.
+    lower = (int16_t) ((lower_state32 +
+        kAllPassCoefsQ15[1] * data_in[1]) >> 16);  // Q(-1)
+    lower_state32 = (data_in[1] * (1 << 14)) -
+        kAllPassCoefsQ15[1] * lower;  // Q14
+    lower_state32 *= 2;  // Q15.
+    data_in += 2;
 
-  // All-pass filtering lower branch.
-  AllPassFilter(&data_in[1], half_length, kAllPassCoefsQ15[1], lower_state,
-                lp_data_out);
+    // Make LP and HP signals.
+    *hp_data_out++ = upper - lower;
+    *lp_data_out++ = lower + upper;
+  }
 
-  // Make LP and HP signals.
-  for (i = 0; i < half_length; i++) {
-    tmp_out = *hp_data_out;
-    *hp_data_out++ -= *lp_data_out;
-    *lp_data_out++ += tmp_out;
+  *upper_state = (int16_t) (upper_state32 >> 16);  // Q(-1)
+  *lower_state = (int16_t) (lower_state32 >> 16);  // Q(-1)
+}
+
+#if defined(WEBRTC_HAS_NEON) || \
+    (defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE))
+// Vectorized version of WebRtcSpl_Energy(), with an identical result: the
+// energy of `data_in`, with each squared sample right shifted by the
+// `scale_factor` that avoids overflow.
+static int32_t Energy(const int16_t* data_in, size_t data_length,
+                      int* scale_factor) {
+  const int16_t nbits = WebRtcSpl_GetSizeInBits((uint32_t)data_length);
+  size_t i = 0;
+  int16_t smax = -1;
+  int16_t sabs;
+  int scaling = 0;
+  int32_t energy = 0;
+
+#if defined(WEBRTC_HAS_NEON)
+  {
+    int16x8_t max = vdupq_n_s16(-1);
+    int16x4_t max4;
+    int32x4_t acc = vdupq_n_s32(0);
+    int32x4_t shift;
+    int16x8_t x;
+    // vnegq_s16() wraps -32768 onto itself, just like the scalar code.
+    for (; i + 8 <= data_length; i += 8) {
+      x = vld1q_s16(&data_in[i]);
+      max = vmaxq_s16(max, vmaxq_s16(x, vnegq_s16(x)));
+    }
+    max4 = vmax_s16(vget_low_s16(max), vget_high_s16(max));
+    max4 = vpmax_s16(max4, max4);
+    max4 = vpmax_s16(max4, max4);
+    smax = vget_lane_s16(max4, 0);
+    for (; i < data_length; i++) {
+      sabs = data_in[i] > 0 ? data_in[i] : -data_in[i];
+      smax = sabs > smax ? sabs : smax;
+    }
+    if (smax != 0) {
+      const int16_t t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+      scaling = t > nbits ? 0 : nbits - t;
+    }
+
+    shift = vdupq_n_s32(-scaling);
+    for (i = 0; i + 8 <= data_length; i += 8) {
+      x = vld1q_s16(&data_in[i]);
+      acc = vaddq_s32(acc, vshlq_s32(vmull_s16(vget_low_s16(x),
+                                               vget_low_s16(x)),
+                                     shift));
+      acc = vaddq_s32(acc, vshlq_s32(vmull_s16(vget_high_s16(x),
+                                               vget_high_s16(x)),
+                                     shift));
+    }
+    energy = vgetq_lane_s32(acc, 0) + vgetq_lane_s32(acc, 1) +
+             vgetq_lane_s32(acc, 2) + vgetq_lane_s32(acc, 3);
   }
+#else
+  {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i max = _mm_set1_epi16(-1);
+    __m128i acc = zero;
+    __m128i shift, x, square_lo, square_hi;
+    // The negation wraps -32768 onto itself, just like the scalar code.
+    for (; i + 8 <= data_length; i += 8) {
+      x = _mm_loadu_si128((const __m128i*)&data_in[i]);
+      max = _mm_max_epi16(max, _mm_max_epi16(x, _mm_sub_epi16(zero, x)));
+    }
+    max = _mm_max_epi16(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(1, 0, 3, 2)));
+    max = _mm_max_epi16(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(2, 3, 0, 1)));
+    max = _mm_max_epi16(max,
+                        _mm_shufflelo_epi16(max, _MM_SHUFFLE(2, 3, 0, 1)));
+    smax = (int16_t)_mm_cvtsi128_si32(max);
+    for (; i < data_length; i++) {
+      sabs = data_in[i] > 0 ? data_in[i] : -data_in[i];
+      smax = sabs > smax ? sabs : smax;
+    }
+    if (smax != 0) {
+      const int16_t t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+      scaling = t > nbits ? 0 : nbits - t;
+    }
+
+    shift = _mm_cvtsi32_si128(scaling);
+    for (i = 0; i + 8 <= data_length; i += 8) {
+      x = _mm_loadu_si128((const __m128i*)&data_in[i]);
+      square_lo = _mm_mullo_epi16(x, x);
+      square_hi = _mm_mulhi_epi16(x, x);
+      acc = _mm_add_epi32(
+          acc, _mm_sra_epi32(_mm_unpacklo_epi16(square_lo, square_hi), shift));
+      acc = _mm_add_epi32(
+          acc, _mm_sra_epi32(_mm_unpackhi_epi16(square_lo, square_hi), shift));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    energy = _mm_cvtsi128_si32(acc);
+  }
+#endif
+
+  for (; i < data_length; i++) {
+    energy += (data_in[i] * data_in[i]) >> scaling;
+  }
+  *scale_factor = scaling;
+  return energy;
+}
+#else
+static int32_t Energy(const int16_t* data_in, size_t data_length,
+                      int* scale_factor) {
+  return WebRtcSpl_Energy((int16_t*)data_in, data_length, scale_factor);
 }
+#endif
 
 // Calculates the energy of `data_in` in dB, and also updates an overall
 // `total_energy` if necessary.
@@ -161,8 +262,7 @@ static void LogOfEnergy(const int16_t* data_in, size_t data_length,
   RTC_DCHECK(data_in);
   RTC_DCHECK_GT(data_length, 0);
 
-  energy = (uint32_t) WebRtcSpl_Energy((int16_t*) data_in, data_length,
-                                       &tot_rshifts);
+  energy = (uint32_t) Energy(data_in, data_length, &tot_rshifts);
 
   if (energy != 0) {
     // By construction, normalizing to 15 bits is equivalent with 17 leading
@@ -11,7 +11,14 @@
 #include "common_audio/vad/vad_sp.h"
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
 #include "common_audio/vad/vad_core.h"
 
 // Allpass filter coefficients, upper and lower, in Q13.
@@ -19,6 +26,7 @@
 static const int16_t kAllPassCoefsQ13[2] = { 5243, 1392 };  // Q13.
 static const int16_t kSmoothingDown = 6553;  // 0.2 in Q15.
 static const int16_t kSmoothingUp = 32439;  // 0.99 in Q15.
+static const int16_t kMaxAge = 100;  // Frames a minimum is kept.
 
 // TODO(bjornv): Move this function to vad_filterbank.c.
 // Downsampling filter based on splitting filter and allpass functions.
@@ -52,30 +60,13 @@ void WebRtcVad_Downsampling(const int16_t* signal_in,
   filter_state[1] = tmp32_2;
 }
 
-// Inserts `feature_value` into `low_value_vector`, if it is one of the 16
-// smallest values the last 100 frames. Then calculates and returns the median
-// of the five smallest values.
-int16_t WebRtcVad_FindMinimum(VadInstT* self,
-                              int16_t feature_value,
-                              int channel) {
+// Makes the 16 smallest values of a channel one frame older, and removes the
+// values that have become too old by shifting larger values downwards.
+static void AgeMinima(int16_t* age, int16_t* smallest_values) {
   int i = 0, j = 0;
-  int position = -1;
-  // Offset to beginning of the 16 minimum values in memory.
-  const int offset = (channel << 4);
-  int16_t current_median = 1600;
-  int16_t alpha = 0;
-  int32_t tmp32 = 0;
-  // Pointer to memory for the 16 minimum values and the age of each value of
-  // the `channel`.
-  int16_t* age = &self->index_vector[offset];
-  int16_t* smallest_values = &self->low_value_vector[offset];
 
-  RTC_DCHECK_LT(channel, kNumChannels);
-
-  // Each value in `smallest_values` is getting 1 loop older. Update `age`, and
-  // remove old values.
   for (i = 0; i < 16; i++) {
-    if (age[i] != 100) {
+    if (age[i] != kMaxAge) {
       age[i]++;
     } else {
       // Too old value. Remove from memory and shift larger values downwards.
@@ -87,6 +78,132 @@ int16_t WebRtcVad_FindMinimum(VadInstT* self,
       smallest_values[15] = 10000;
     }
   }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE) && \
+    !defined(WEBRTC_HAS_NEON)
+// Returns the lanes of `a` where `mask` is set and those of `b` elsewhere.
+static __m128i Select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON) || \
+    (defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE))
+// Ages the 16 smallest values and inserts `feature_value` if it is smaller
+// than any of them. The values are kept sorted, hence the ones larger than
+// `feature_value` form a suffix of `smallest_values`, which starts at the
+// insertion position. Instead of searching for the position and moving the
+// values one at a time, each entry of the suffix is replaced by its lower
+// neighbor, or by `feature_value` at the start of the suffix, in two vectors
+// of eight values and without branches. Only the removal of too old values,
+// which happens in a small fraction of the frames, is done in scalar code.
+static void UpdateMinima(int16_t* age, int16_t* smallest_values,
+                         int16_t feature_value) {
+#if defined(WEBRTC_HAS_NEON)
+  const int16x8_t value = vdupq_n_s16(feature_value);
+  const int16x8_t one = vdupq_n_s16(1);
+  const int16x8_t max_age = vdupq_n_s16(kMaxAge);
+  int16x8_t age_lo = vld1q_s16(&age[0]);
+  int16x8_t age_hi = vld1q_s16(&age[8]);
+  int16x8_t values_lo, values_hi;
+  uint16x8_t larger_lo, larger_hi, prev_larger_lo, prev_larger_hi;
+  const uint64x2_t expired = vreinterpretq_u64_u16(
+      vorrq_u16(vceqq_s16(age_lo, max_age), vceqq_s16(age_hi, max_age)));
+
+  if ((vgetq_lane_u64(expired, 0) | vgetq_lane_u64(expired, 1)) != 0) {
+    AgeMinima(age, smallest_values);
+    age_lo = vld1q_s16(&age[0]);
+    age_hi = vld1q_s16(&age[8]);
+  } else {
+    age_lo = vaddq_s16(age_lo, one);
+    age_hi = vaddq_s16(age_hi, one);
+  }
+  values_lo = vld1q_s16(&smallest_values[0]);
+  values_hi = vld1q_s16(&smallest_values[8]);
+
+  larger_lo = vcgtq_s16(values_lo, value);
+  larger_hi = vcgtq_s16(values_hi, value);
+  prev_larger_lo = vextq_u16(vdupq_n_u16(0), larger_lo, 7);
+  prev_larger_hi = vextq_u16(larger_lo, larger_hi, 7);
+
+  vst1q_s16(&smallest_values[8],
+            vbslq_s16(larger_hi,
+                      vbslq_s16(prev_larger_hi,
+                                vextq_s16(values_lo, values_hi, 7), value),
+                      values_hi));
+  vst1q_s16(&smallest_values[0],
+            vbslq_s16(larger_lo,
+                      vbslq_s16(prev_larger_lo,
+                                vextq_s16(vdupq_n_s16(0), values_lo, 7), value),
+                      values_lo));
+  vst1q_s16(&age[8],
+            vbslq_s16(larger_hi,
+                      vbslq_s16(prev_larger_hi, vextq_s16(age_lo, age_hi, 7),
+                                one),
+                      age_hi));
+  vst1q_s16(&age[0],
+            vbslq_s16(larger_lo,
+                      vbslq_s16(prev_larger_lo,
+                                vextq_s16(vdupq_n_s16(0), age_lo, 7), one),
+                      age_lo));
+#else
+  const __m128i value = _mm_set1_epi16(feature_value);
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i max_age = _mm_set1_epi16(kMaxAge);
+  __m128i age_lo = _mm_loadu_si128((const __m128i*)&age[0]);
+  __m128i age_hi = _mm_loadu_si128((const __m128i*)&age[8]);
+  __m128i values_lo, values_hi, larger_lo, larger_hi, prev_larger_lo,
+      prev_larger_hi, shifted_lo, shifted_hi;
+
+  if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(age_lo, max_age),
+                                     _mm_cmpeq_epi16(age_hi, max_age)))) {
+    AgeMinima(age, smallest_values);
+    age_lo = _mm_loadu_si128((const __m128i*)&age[0]);
+    age_hi = _mm_loadu_si128((const __m128i*)&age[8]);
+  } else {
+    age_lo = _mm_add_epi16(age_lo, one);
+    age_hi = _mm_add_epi16(age_hi, one);
+  }
+  values_lo = _mm_loadu_si128((const __m128i*)&smallest_values[0]);
+  values_hi = _mm_loadu_si128((const __m128i*)&smallest_values[8]);
+
+  larger_lo = _mm_cmpgt_epi16(values_lo, value);
+  larger_hi = _mm_cmpgt_epi16(values_hi, value);
+  prev_larger_lo = _mm_slli_si128(larger_lo, 2);
+  prev_larger_hi = _mm_or_si128(_mm_slli_si128(larger_hi, 2),
+                                _mm_srli_si128(larger_lo, 14));
+
+  shifted_lo = _mm_slli_si128(values_lo, 2);
+  shifted_hi = _mm_or_si128(_mm_slli_si128(values_hi, 2),
+                            _mm_srli_si128(values_lo, 14));
+  _mm_storeu_si128(
+      (__m128i*)&smallest_values[0],
+      Select(larger_lo, Select(prev_larger_lo, shifted_lo, value), values_lo));
+  _mm_storeu_si128(
+      (__m128i*)&smallest_values[8],
+      Select(larger_hi, Select(prev_larger_hi, shifted_hi, value), values_hi));
+
+  shifted_lo = _mm_slli_si128(age_lo, 2);
+  shifted_hi =
+      _mm_or_si128(_mm_slli_si128(age_hi, 2), _mm_srli_si128(age_lo, 14));
+  _mm_storeu_si128(
+      (__m128i*)&age[0],
+      Select(larger_lo, Select(prev_larger_lo, shifted_lo, one), age_lo));
+  _mm_storeu_si128(
+      (__m128i*)&age[8],
+      Select(larger_hi, Select(prev_larger_hi, shifted_hi, one), age_hi));
+#endif
+}
+#else
+// Ages the 16 smallest values and inserts `feature_value` if it is smaller
+// than any of them.
+static void UpdateMinima(int16_t* age, int16_t* smallest_values,
+                         int16_t feature_value) {
+  int i = 0;
+  int position = -1;
+
+  AgeMinima(age, smallest_values);
 
   // Check if `feature_value` is smaller than any of the values in
   // `smallest_values`. If so, find the `position` where to insert the new value
@@ -151,6 +268,28 @@ int16_t WebRtcVad_FindMinimum(VadInstT* self,
     smallest_values[position] = feature_value;
     age[position] = 1;
   }
+}
+#endif
+
+// Inserts `feature_value` into `low_value_vector`, if it is one of the 16
+// smallest values the last 100 frames. Then calculates and returns the median
+// of the five smallest values.
+int16_t WebRtcVad_FindMinimum(VadInstT* self,
+                              int16_t feature_value,
+                              int channel) {
+  // Offset to beginning of the 16 minimum values in memory.
+  const int offset = (channel << 4);
+  int16_t current_median = 1600;
+  int16_t alpha = 0;
+  int32_t tmp32 = 0;
+  // Pointer to memory for the 16 minimum values and the age of each value of
+  // the `channel`.
+  int16_t* age = &self->index_vector[offset];
+  int16_t* smallest_values = &self->low_value_vector[offset];
+
+  RTC_DCHECK_LT(channel, kNumChannels);
+
+  UpdateMinima(age, smallest_values, feature_value);
 
   // Get `current_median`.
   if (self->frame_counter > 2) {
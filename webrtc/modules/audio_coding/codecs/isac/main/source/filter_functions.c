@@ -16,6 +16,13 @@
 
 #include "modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
 #include "modules/audio_coding/codecs/isac/main/source/isac_vad.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
 
 static void WebRtcIsac_AllPoleFilter(double* InOut,
                                      double* Coef,
@@ -96,7 +103,65 @@ void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order) {
   double sum, prod;
   const double *x_lag;
 
-  for (lag = 0; lag <= order; lag++)
+  lag = 0;
+#if (defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)) || \
+    (defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS))
+  /* Eight lags at a time, two per vector. Each lag is still accumulated
+   * sample by sample from the first one, so that the result is exactly the
+   * same as the scalar code below; the lags only provide independent sums
+   * that hide the latency of the additions. The last group may compute lags
+   * beyond `order`, which are dropped. */
+  for (; lag <= order && lag + 8 <= N; lag += 8) {
+    double acc[8];
+    size_t k;
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    float64x2_t acc2 = vdupq_n_f64(0.0);
+    float64x2_t acc3 = vdupq_n_f64(0.0);
+    /* All eight lags have the samples up to N - lag - 7. */
+    for (n = 0; n + lag + 7 < N; n++) {
+      const double* x_n_lag = &x[n + lag];
+      acc0 = vaddq_f64(acc0, vmulq_n_f64(vld1q_f64(&x_n_lag[0]), x[n]));
+      acc1 = vaddq_f64(acc1, vmulq_n_f64(vld1q_f64(&x_n_lag[2]), x[n]));
+      acc2 = vaddq_f64(acc2, vmulq_n_f64(vld1q_f64(&x_n_lag[4]), x[n]));
+      acc3 = vaddq_f64(acc3, vmulq_n_f64(vld1q_f64(&x_n_lag[6]), x[n]));
+    }
+    vst1q_f64(&acc[0], acc0);
+    vst1q_f64(&acc[2], acc1);
+    vst1q_f64(&acc[4], acc2);
+    vst1q_f64(&acc[6], acc3);
+#else
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    /* All eight lags have the samples up to N - lag - 7. */
+    for (n = 0; n + lag + 7 < N; n++) {
+      const double* x_n_lag = &x[n + lag];
+      const __m128d x_n = _mm_set1_pd(x[n]);
+      acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(&x_n_lag[0]), x_n));
+      acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(&x_n_lag[2]), x_n));
+      acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(&x_n_lag[4]), x_n));
+      acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(&x_n_lag[6]), x_n));
+    }
+    _mm_storeu_pd(&acc[0], acc0);
+    _mm_storeu_pd(&acc[2], acc1);
+    _mm_storeu_pd(&acc[4], acc2);
+    _mm_storeu_pd(&acc[6], acc3);
+#endif
+    /* The shorter lags have up to seven samples left. */
+    for (k = 0; k < 8 && lag + k <= order; k++) {
+      sum = acc[k];
+      for (n = N - lag - 7; n < N - lag - k; n++) {
+        sum += x[n] * x[n + lag + k];
+      }
+      r[lag + k] = sum;
+    }
+  }
+#endif
+
+  for (; lag <= order; lag++)
   {
     sum = 0.0f;
     x_lag = &x[lag];
@@ -11,6 +11,7 @@
 #include "modules/audio_coding/codecs/isac/main/source/isac_vad.h"
 
 #include <math.h>
+#include <string.h>
 
 void WebRtcIsac_InitPitchFilter(PitchFiltstr* pitchfiltdata) {
   int k;
@@ -152,6 +153,9 @@ const float WebRtcIsac_kLowerApFactorsFloat[2] = {0.15440000000000f,
 /* This function performs all-pass filtering--a series of first order all-pass
  * sections are used to filter the input in a cascade manner.
  * The input is overwritten!!
+ * Each sample is passed through all the sections before the next one, which
+ * gives the same result as filtering the whole input section by section, but
+ * lets the recursions of the different sections overlap.
  */
 void WebRtcIsac_AllPassFilter2Float(float* InOut,
                                     const float* APSectionFactors,
@@ -159,19 +163,57 @@ void WebRtcIsac_AllPassFilter2Float(float* InOut,
                                     int NumberOfSections,
                                     float* FilterState) {
   int n, j;
-  float temp;
-  for (j = 0; j < NumberOfSections; j++) {
-    for (n = 0; n < lengthInOut; n++) {
-      temp = FilterState[j] + APSectionFactors[j] * InOut[n];
-      FilterState[j] = -APSectionFactors[j] * temp + InOut[n];
-      InOut[n] = temp;
+  float temp, in;
+  for (n = 0; n < lengthInOut; n++) {
+    in = InOut[n];
+    for (j = 0; j < NumberOfSections; j++) {
+      temp = FilterState[j] + APSectionFactors[j] * in;
+      FilterState[j] = -APSectionFactors[j] * temp + in;
+      in = temp;
     }
+    InOut[n] = in;
   }
 }
 
 /* The number of composite all-pass filter factors */
 #define NUMBEROFCOMPOSITEAPSECTIONS 4
 
+/* Same as WebRtcIsac_AllPassFilter2Float() on two independent signals, which
+ * are filtered side by side so that their recursions overlap. The states are
+ * kept in locals, as the compiler cannot tell that they do not alias the
+ * signals. At most NUMBEROFCOMPOSITEAPSECTIONS sections are supported. */
+static void AllPassFilter2FloatPair(float* InOut1,
+                                    float* InOut2,
+                                    const float* APSectionFactors1,
+                                    const float* APSectionFactors2,
+                                    int lengthInOut,
+                                    int NumberOfSections,
+                                    float* FilterState1,
+                                    float* FilterState2) {
+  int n, j;
+  float temp1, temp2, in1, in2;
+  float state1[NUMBEROFCOMPOSITEAPSECTIONS];
+  float state2[NUMBEROFCOMPOSITEAPSECTIONS];
+  memcpy(state1, FilterState1, sizeof(float) * NumberOfSections);
+  memcpy(state2, FilterState2, sizeof(float) * NumberOfSections);
+  for (n = 0; n < lengthInOut; n++) {
+    in1 = InOut1[n];
+    in2 = InOut2[n];
+    for (j = 0; j < NumberOfSections; j++) {
+      temp1 = state1[j] + APSectionFactors1[j] * in1;
+      temp2 = state2[j] + APSectionFactors2[j] * in2;
+      state1[j] = -APSectionFactors1[j] * temp1 + in1;
+      state2[j] = -APSectionFactors2[j] * temp2 + in2;
+      in1 = temp1;
+      in2 = temp2;
+    }
+    InOut1[n] = in1;
+    InOut2[n] = in2;
+  }
+  memcpy(FilterState1, state1, sizeof(float) * NumberOfSections);
+  memcpy(FilterState2, state2, sizeof(float) * NumberOfSections);
+}
+
 /* Function WebRtcIsac_SplitAndFilter
  * This function creates low-pass and high-pass decimated versions of part of
  the input signal, and part of the signal in the input 'lookahead buffer'.
@@ -215,9 +257,11 @@ void WebRtcIsac_SplitAndFilterFloat(float* pin,
                                     PreFiltBankstr* prefiltdata) {
   int k, n;
   float CompositeAPFilterState[NUMBEROFCOMPOSITEAPSECTIONS];
+  float CompositeAPFilterState2[NUMBEROFCOMPOSITEAPSECTIONS];
   float ForTransform_CompositeAPFilterState[NUMBEROFCOMPOSITEAPSECTIONS];
   float ForTransform_CompositeAPFilterState2[NUMBEROFCOMPOSITEAPSECTIONS];
   float tempinoutvec[FRAMESAMPLES + MAX_AR_MODEL_ORDER];
+  float tempinoutvec2[FRAMESAMPLES_HALF];
   float tempin_ch1[FRAMESAMPLES + MAX_AR_MODEL_ORDER];
   float tempin_ch2[FRAMESAMPLES + MAX_AR_MODEL_ORDER];
   float in[FRAMESAMPLES];
@@ -258,42 +302,52 @@ void WebRtcIsac_SplitAndFilterFloat(float* pin,
     prefiltdata->HPstates_float[0] = ftmp;
   }
 
-  /* First Channel */
+  /* Both channels are filtered side by side; the second channel is exactly
+     like the first one, except that the even samples are now filtered
+     instead (lower channel). */
 
   /*initial state of composite filter is zero */
   for (k = 0; k < NUMBEROFCOMPOSITEAPSECTIONS; k++) {
     CompositeAPFilterState[k] = 0.0;
+    CompositeAPFilterState2[k] = 0.0;
   }
   /* put every other sample of input into a temporary vector in reverse
    * (backward) order*/
   for (k = 0; k < FRAMESAMPLES_HALF; k++) {
     tempinoutvec[k] = in[FRAMESAMPLES - 1 - 2 * k];
+    tempinoutvec2[k] = in[FRAMESAMPLES - 2 - 2 * k];
   }
 
-  /* now all-pass filter the backwards vector.  Output values overwrite the
-   * input vector. */
-  WebRtcIsac_AllPassFilter2Float(
-      tempinoutvec, WebRtcIsac_kCompositeApFactorsFloat, FRAMESAMPLES_HALF,
-      NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
+  /* now all-pass filter the backwards vectors.  Output values overwrite the
+   * input vectors. */
+  AllPassFilter2FloatPair(tempinoutvec, tempinoutvec2,
+                          WebRtcIsac_kCompositeApFactorsFloat,
+                          WebRtcIsac_kCompositeApFactorsFloat,
+                          FRAMESAMPLES_HALF, NUMBEROFCOMPOSITEAPSECTIONS,
+                          CompositeAPFilterState, CompositeAPFilterState2);
 
   /* save the backwards filtered output for later forward filtering,
      but write it in forward order*/
   for (k = 0; k < FRAMESAMPLES_HALF; k++) {
     tempin_ch1[FRAMESAMPLES_HALF + QLOOKAHEAD - 1 - k] = tempinoutvec[k];
+    tempin_ch2[FRAMESAMPLES_HALF + QLOOKAHEAD - 1 - k] = tempinoutvec2[k];
   }
 
   /* save the backwards filter state  becaue it will be transformed
      later into a forward state */
   for (k = 0; k < NUMBEROFCOMPOSITEAPSECTIONS; k++) {
     ForTransform_CompositeAPFilterState[k] = CompositeAPFilterState[k];
+    ForTransform_CompositeAPFilterState2[k] = CompositeAPFilterState2[k];
   }
 
-  /* now backwards filter the samples in the lookahead buffer. The samples were
-     placed there in the encoding of the previous frame.  The output samples
-     overwrite the input samples */
-  WebRtcIsac_AllPassFilter2Float(
-      prefiltdata->INLABUF1_float, WebRtcIsac_kCompositeApFactorsFloat,
-      QLOOKAHEAD, NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
+  /* now backwards filter the samples in the lookahead buffers. The samples
+     were placed there in the encoding of the previous frame.  The output
+     samples overwrite the input samples */
+  AllPassFilter2FloatPair(
+      prefiltdata->INLABUF1_float, prefiltdata->INLABUF2_float,
+      WebRtcIsac_kCompositeApFactorsFloat, WebRtcIsac_kCompositeApFactorsFloat,
+      QLOOKAHEAD, NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState,
+      CompositeAPFilterState2);
 
   /* save the output, but write it in forward order */
   /* write the lookahead samples for the next encoding iteration. Every other
@@ -302,35 +356,6 @@ void WebRtcIsac_SplitAndFilterFloat(float* pin,
   for (k = 0; k < QLOOKAHEAD; k++) {
     tempin_ch1[QLOOKAHEAD - 1 - k] = prefiltdata->INLABUF1_float[k];
     prefiltdata->INLABUF1_float[k] = in[FRAMESAMPLES - 1 - 2 * k];
-  }
-
-  /* Second Channel.  This is exactly like the first channel, except that the
-     even samples are now filtered instead (lower channel). */
-  for (k = 0; k < NUMBEROFCOMPOSITEAPSECTIONS; k++) {
-    CompositeAPFilterState[k] = 0.0;
-  }
-
-  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
-    tempinoutvec[k] = in[FRAMESAMPLES - 2 - 2 * k];
-  }
-
-  WebRtcIsac_AllPassFilter2Float(
-      tempinoutvec, WebRtcIsac_kCompositeApFactorsFloat, FRAMESAMPLES_HALF,
-      NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
-
-  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
-    tempin_ch2[FRAMESAMPLES_HALF + QLOOKAHEAD - 1 - k] = tempinoutvec[k];
-  }
-
-  for (k = 0; k < NUMBEROFCOMPOSITEAPSECTIONS; k++) {
-    ForTransform_CompositeAPFilterState2[k] = CompositeAPFilterState[k];
-  }
-
-  WebRtcIsac_AllPassFilter2Float(
-      prefiltdata->INLABUF2_float, WebRtcIsac_kCompositeApFactorsFloat,
-      QLOOKAHEAD, NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
-
-  for (k = 0; k < QLOOKAHEAD; k++) {
     tempin_ch2[QLOOKAHEAD - 1 - k] = prefiltdata->INLABUF2_float[k];
     prefiltdata->INLABUF2_float[k] = in[FRAMESAMPLES - 2 - 2 * k];
   }
@@ -366,12 +391,11 @@ void WebRtcIsac_SplitAndFilterFloat(float* pin,
    * corresponding channel filters */
   /* The all pass filtering automatically updates the filter states which are
      exported in the prefiltdata structure */
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1, WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
-                                 prefiltdata->INSTAT1_float);
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2, WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
-                                 prefiltdata->INSTAT2_float);
+  AllPassFilter2FloatPair(tempin_ch1, tempin_ch2,
+                          WebRtcIsac_kUpperApFactorsFloat,
+                          WebRtcIsac_kLowerApFactorsFloat, FRAMESAMPLES_HALF,
+                          NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTAT1_float,
+                          prefiltdata->INSTAT2_float);
 
   /* Now Construct low-pass and high-pass signals as combinations of polyphase
    * components */
@@ -395,12 +419,12 @@ void WebRtcIsac_SplitAndFilterFloat(float* pin,
 
   /* the input filter states are passed in and updated by the all-pass filtering
      routine and exported in the prefiltdata structure*/
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1, WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
-                                 prefiltdata->INSTATLA1_float);
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2, WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
-                                 prefiltdata->INSTATLA2_float);
+  AllPassFilter2FloatPair(tempin_ch1, tempin_ch2,
+                          WebRtcIsac_kUpperApFactorsFloat,
+                          WebRtcIsac_kLowerApFactorsFloat, FRAMESAMPLES_HALF,
+                          NUMBEROFCHANNELAPSECTIONS,
+                          prefiltdata->INSTATLA1_float,
+                          prefiltdata->INSTATLA2_float);
 
   for (k = 0; k < FRAMESAMPLES_HALF; k++) {
     LP_la[k] = (float)(0.5f * (tempin_ch1[k] + tempin_ch2[k]));  /*low pass */
@@ -19,8 +19,15 @@
 
 #include "modules/audio_coding/codecs/isac/main/source/filter_functions.h"
 #include "modules/audio_coding/codecs/isac/main/source/pitch_filter.h"
+#include "rtc_base/system/arch.h"
 #include "rtc_base/system/ignore_warnings.h"
 
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
 static const double kInterpolWin[8] = {-0.00067556028640,  0.02184247643159, -0.12203175715679,  0.60086484101160,
                                        0.60086484101160, -0.12203175715679,  0.02184247643159, -0.00067556028640};
 
@@ -97,32 +104,78 @@ static void PCorr(const double *in, double *outcorr)
   double sum, ysum, prod;
   const double *x, *inptr;
   int k, n;
+  /* correlation between x and the PITCH_CORR_LEN2 samples from in[k] */
+  double corr[PITCH_LAG_SPAN2];
+
+  x = in + PITCH_MAX_LAG/2 + 2;
+  k = 0;
+#if (defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)) || \
+    (defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS))
+  /* Eight lags at a time, two per vector. Each lag is accumulated sample by
+   * sample as in the scalar code, so the result is exactly the same. */
+  for (; k + 8 <= PITCH_LAG_SPAN2; k += 8) {
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+    float64x2_t acc2 = vdupq_n_f64(0.0);
+    float64x2_t acc3 = vdupq_n_f64(0.0);
+    for (n = 0; n < PITCH_CORR_LEN2; n++) {
+      inptr = &in[k + n];
+      acc0 = vaddq_f64(acc0, vmulq_n_f64(vld1q_f64(&inptr[0]), x[n]));
+      acc1 = vaddq_f64(acc1, vmulq_n_f64(vld1q_f64(&inptr[2]), x[n]));
+      acc2 = vaddq_f64(acc2, vmulq_n_f64(vld1q_f64(&inptr[4]), x[n]));
+      acc3 = vaddq_f64(acc3, vmulq_n_f64(vld1q_f64(&inptr[6]), x[n]));
+    }
+    vst1q_f64(&corr[k], acc0);
+    vst1q_f64(&corr[k + 2], acc1);
+    vst1q_f64(&corr[k + 4], acc2);
+    vst1q_f64(&corr[k + 6], acc3);
+#else
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    for (n = 0; n < PITCH_CORR_LEN2; n++) {
+      const __m128d x_n = _mm_set1_pd(x[n]);
+      inptr = &in[k + n];
+      acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(&inptr[0]), x_n));
+      acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(&inptr[2]), x_n));
+      acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(&inptr[4]), x_n));
+      acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(&inptr[6]), x_n));
+    }
+    _mm_storeu_pd(&corr[k], acc0);
+    _mm_storeu_pd(&corr[k + 2], acc1);
+    _mm_storeu_pd(&corr[k + 4], acc2);
+    _mm_storeu_pd(&corr[k + 6], acc3);
+#endif
+  }
+#endif
+  for (; k < PITCH_LAG_SPAN2; k++) {
+    sum = 0.0;
+    inptr = &in[k];
+    prod = x[0] * inptr[0];
+    for (n = 1; n < PITCH_CORR_LEN2; n++) {
+      sum += prod;
+      prod = x[n] * inptr[n];
+    }
+    sum += prod;
+    corr[k] = sum;
+  }
 
   //ysum = 1e-6;          /* use this with float (i.s.o. double)! */
   ysum = 1e-13;
-  sum = 0.0;
-  x = in + PITCH_MAX_LAG/2 + 2;
   for (n = 0; n < PITCH_CORR_LEN2; n++) {
     ysum += in[n] * in[n];
-    sum += x[n] * in[n];
   }
 
   outcorr += PITCH_LAG_SPAN2 - 1;     /* index of last element in array */
-  *outcorr = sum / sqrt(ysum);
+  *outcorr = corr[0] / sqrt(ysum);
 
   for (k = 1; k < PITCH_LAG_SPAN2; k++) {
     ysum -= in[k-1] * in[k-1];
     ysum += in[PITCH_CORR_LEN2 + k - 1] * in[PITCH_CORR_LEN2 + k - 1];
-    sum = 0.0;
-    inptr = &in[k];
-    prod = x[0] * inptr[0];
-    for (n = 1; n < PITCH_CORR_LEN2; n++) {
-      sum += prod;
-      prod = x[n] * inptr[n];
-    }
-    sum += prod;
     outcorr--;
-    *outcorr = sum / sqrt(ysum);
+    *outcorr = corr[k] / sqrt(ysum);
   }
 }
 
@@ -599,19 +652,46 @@ void WebRtcIsac_PitchAnalysis(const double *in,               /* PITCH_FRAME_LEN
     WebRtcIsac_PitchfilterPre_gains(Whitened, out_G, out_dG, &(State->PFstr_wght), lags, gains);
 
     /* gradient and approximate Hessian (lower triangle) for minimizing the filter's output power */
-    for (k = 0; k < 4; k++) {
-      tmp = 0.0;
-      for (n = 0; n < PITCH_FRAME_LEN + QLOOKAHEAD; n++)
-        tmp += out_G[n] * out_dG[k][n];
-      grad[k] = tmp * Wnrg;
-    }
-    for (k = 0; k < 4; k++) {
-      for (m = 0; m <= k; m++) {
-        tmp = 0.0;
-        for (n = 0; n < PITCH_FRAME_LEN + QLOOKAHEAD; n++)
-          tmp += out_dG[m][n] * out_dG[k][n];
-        H[k][m] = tmp * Wnrg;
+    /* all the sums are accumulated in one pass, each of them in the same order
+     * as on its own; the independent sums hide the latency of the additions */
+    {
+      double g0 = 0.0, g1 = 0.0, g2 = 0.0, g3 = 0.0;
+      double h00 = 0.0, h10 = 0.0, h11 = 0.0, h20 = 0.0, h21 = 0.0;
+      double h22 = 0.0, h30 = 0.0, h31 = 0.0, h32 = 0.0, h33 = 0.0;
+      for (n = 0; n < PITCH_FRAME_LEN + QLOOKAHEAD; n++) {
+        const double d0 = out_dG[0][n];
+        const double d1 = out_dG[1][n];
+        const double d2 = out_dG[2][n];
+        const double d3 = out_dG[3][n];
+        g0 += out_G[n] * d0;
+        g1 += out_G[n] * d1;
+        g2 += out_G[n] * d2;
+        g3 += out_G[n] * d3;
+        h00 += d0 * d0;
+        h10 += d0 * d1;
+        h11 += d1 * d1;
+        h20 += d0 * d2;
+        h21 += d1 * d2;
+        h22 += d2 * d2;
+        h30 += d0 * d3;
+        h31 += d1 * d3;
+        h32 += d2 * d3;
+        h33 += d3 * d3;
       }
+      grad[0] = g0 * Wnrg;
+      grad[1] = g1 * Wnrg;
+      grad[2] = g2 * Wnrg;
+      grad[3] = g3 * Wnrg;
+      H[0][0] = h00 * Wnrg;
+      H[1][0] = h10 * Wnrg;
+      H[1][1] = h11 * Wnrg;
+      H[2][0] = h20 * Wnrg;
+      H[2][1] = h21 * Wnrg;
+      H[2][2] = h22 * Wnrg;
+      H[3][0] = h30 * Wnrg;
+      H[3][1] = h31 * Wnrg;
+      H[3][2] = h32 * Wnrg;
+      H[3][3] = h33 * Wnrg;
     }
 
     /* add gradient and Hessian (lower triangle) for dampening fast gain changes */
@@ -15,6 +15,14 @@
 #include "modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
 #include "modules/audio_coding/codecs/isac/main/source/os_specific_inline.h"
 #include "rtc_base/compile_assert_c.h"
+#include "rtc_base/system/arch.h"
+#include "rtc_base/system/ignore_warnings.h"
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
 
 /*
  * We are implementing the following filters;
@@ -98,8 +106,12 @@ typedef enum {
  *                    'PitchFilterOperation' for operational modes.
  * num_samples      : number of samples to be processed in each segment.
  * index            : index of the input and output sample.
- * damper_state_dg  : state of damping filter for different trial gains.
+ * damper_state_dg  : state of damping filter for different trial gains, with
+ *                    the sub-frames interleaved.
  * gain_mult        : differential changes to gain.
+ * dg_buffer        : outputs of the different trial gains, with the sub-frames
+ *                    interleaved and preceded by PITCH_BUFFSIZE zeros. The
+ *                    outputs of sub-frames that are not reached yet are zero.
  */
 typedef struct {
   double buffer[PITCH_INTBUFFSIZE + QLOOKAHEAD];
@@ -114,14 +126,217 @@ typedef struct {
   int num_samples;
   int index;
 
-  double damper_state_dg[4][PITCH_DAMPORDER];
-  double gain_mult[4];
+  double damper_state_dg[PITCH_DAMPORDER][PITCH_SUBFRAMES];
+  double gain_mult[PITCH_SUBFRAMES];
+  double dg_buffer[PITCH_BUFFSIZE + PITCH_FRAME_LEN + QLOOKAHEAD]
+                  [PITCH_SUBFRAMES];
 } PitchFilterParam;
 
+/* Computes `length` samples of the fractional-lag interpolation
+ *   out[n] = sum_m in[n + m] * coeff[m],  m = 0, ..., PITCH_FRACORDER - 1.
+ * The products are accumulated in the order of the scalar filter, so that
+ * every output is exactly the same as if it was computed on its own. */
+static void Interpolate(const double* in, const double* coeff, int length,
+                        double* out) {
+  int n = 0;
+  int m;
+  double sum;
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+  for (; n + 2 <= length; n += 2) {
+    float64x2_t acc = vdupq_n_f64(0.0);
+    for (m = 0; m < PITCH_FRACORDER; ++m) {
+      acc = vaddq_f64(acc, vmulq_n_f64(vld1q_f64(&in[n + m]), coeff[m]));
+    }
+    vst1q_f64(&out[n], acc);
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  for (; n + 2 <= length; n += 2) {
+    __m128d acc = _mm_setzero_pd();
+    for (m = 0; m < PITCH_FRACORDER; ++m) {
+      acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(&in[n + m]),
+                                       _mm_set1_pd(coeff[m])));
+    }
+    _mm_storeu_pd(&out[n], acc);
+  }
+#endif
+  for (; n < length; ++n) {
+    sum = 0.0;
+    for (m = 0; m < PITCH_FRACORDER; ++m) {
+      sum += in[n + m] * coeff[m];
+    }
+    out[n] = sum;
+  }
+}
+
+/* Filters `length` samples for the different trial gains of the sub-frames up
+ * to the current one, given the fractional-lag samples `fractional` of the
+ * pitch filter. The sub-frames are interleaved in `dg_buffer`, so two of them
+ * are filtered at once; the trial gains of later sub-frames are still zero,
+ * and so are their outputs. */
+static void FilterDg(PitchFilterParam* parameters, const double* fractional,
+                     int length,
+                     double out_dg[][PITCH_FRAME_LEN + QLOOKAHEAD]) {
+  /* Outputs at negative indices are the leading zeros of `dg_buffer`. */
+  double(*dg_buffer)[PITCH_SUBFRAMES] =
+      &parameters->dg_buffer[PITCH_BUFFSIZE];
+  double(*damper_state)[PITCH_SUBFRAMES] = parameters->damper_state_dg;
+  const double(*lagged)[PITCH_SUBFRAMES];
+  const double* coeff = parameters->interpol_coeff;
+  int index;
+  int n;
+  int m;
+  int j;
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_64_BITS)
+  for (j = 0; j <= parameters->sub_frame; j += 2) {
+    const float64x2_t gain_mult = vld1q_f64(&parameters->gain_mult[j]);
+    float64x2_t state[PITCH_DAMPORDER];
+    float64x2_t sum;
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      state[m] = vld1q_f64(&damper_state[m][j]);
+    }
+    for (n = 0; n < length; ++n) {
+      index = parameters->index + n;
+      lagged = &dg_buffer[index - parameters->lag_offset];
+      /* Filter for fractional pitch. */
+      sum = vdupq_n_f64(0.0);
+      for (m = PITCH_FRACORDER - 1; m >= 0; --m) {
+        sum = vaddq_f64(sum, vmulq_n_f64(vld1q_f64(&lagged[m][j]), coeff[m]));
+      }
+      /* Update the damper state, adding the contribution of differential
+       * gain change. */
+      for (m = PITCH_DAMPORDER - 1; m > 0; --m) {
+        state[m] = state[m - 1];
+      }
+      state[0] = vaddq_f64(vmulq_n_f64(gain_mult, fractional[n]),
+                           vmulq_n_f64(sum, parameters->gain));
+      /* Filter with damping filter, and store the results. */
+      sum = vdupq_n_f64(0.0);
+      for (m = 0; m < PITCH_DAMPORDER; ++m) {
+        sum = vsubq_f64(sum, vmulq_n_f64(state[m], kDampFilter[m]));
+      }
+      vst1q_f64(&dg_buffer[index][j], sum);
+      out_dg[j][index] = vgetq_lane_f64(sum, 0);
+      if (j + 1 <= parameters->sub_frame) {
+        out_dg[j + 1][index] = vgetq_lane_f64(sum, 1);
+      }
+    }
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      vst1q_f64(&damper_state[m][j], state[m]);
+    }
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+  const __m128d gain = _mm_set1_pd(parameters->gain);
+  for (j = 0; j <= parameters->sub_frame; j += 2) {
+    const __m128d gain_mult = _mm_loadu_pd(&parameters->gain_mult[j]);
+    __m128d state[PITCH_DAMPORDER];
+    __m128d sum;
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      state[m] = _mm_loadu_pd(&damper_state[m][j]);
+    }
+    for (n = 0; n < length; ++n) {
+      index = parameters->index + n;
+      lagged = &dg_buffer[index - parameters->lag_offset];
+      /* Filter for fractional pitch. */
+      sum = _mm_setzero_pd();
+      for (m = PITCH_FRACORDER - 1; m >= 0; --m) {
+        sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(&lagged[m][j]),
+                                         _mm_set1_pd(coeff[m])));
+      }
+      /* Update the damper state, adding the contribution of differential
+       * gain change. */
+      for (m = PITCH_DAMPORDER - 1; m > 0; --m) {
+        state[m] = state[m - 1];
+      }
+      state[0] = _mm_add_pd(_mm_mul_pd(gain_mult, _mm_set1_pd(fractional[n])),
+                            _mm_mul_pd(gain, sum));
+      /* Filter with damping filter, and store the results. */
+      sum = _mm_setzero_pd();
+      for (m = 0; m < PITCH_DAMPORDER; ++m) {
+        sum = _mm_sub_pd(sum,
+                         _mm_mul_pd(state[m], _mm_set1_pd(kDampFilter[m])));
+      }
+      _mm_storeu_pd(&dg_buffer[index][j], sum);
+      _mm_storel_pd(&out_dg[j][index], sum);
+      if (j + 1 <= parameters->sub_frame) {
+        _mm_storeh_pd(&out_dg[j + 1][index], sum);
+      }
+    }
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      _mm_storeu_pd(&damper_state[m][j], state[m]);
+    }
+  }
+#else
+  double sum;
+  for (j = 0; j <= parameters->sub_frame; ++j) {
+    for (n = 0; n < length; ++n) {
+      index = parameters->index + n;
+      lagged = &dg_buffer[index - parameters->lag_offset];
+      /* Filter for fractional pitch. */
+      sum = 0.0;
+      for (m = PITCH_FRACORDER - 1; m >= 0; --m) {
+        sum += lagged[m][j] * coeff[m];
+      }
+      /* Update the damper state, adding the contribution of differential
+       * gain change. */
+      for (m = PITCH_DAMPORDER - 1; m > 0; --m) {
+        damper_state[m][j] = damper_state[m - 1][j];
+      }
+      damper_state[0][j] =
+          parameters->gain_mult[j] * fractional[n] + parameters->gain * sum;
+      /* Filter with damping filter, and store the results. */
+      sum = 0.0;
+      for (m = 0; m < PITCH_DAMPORDER; ++m) {
+        sum -= damper_state[m][j] * kDampFilter[m];
+      }
+      dg_buffer[index][j] = sum;
+      out_dg[j][index] = sum;
+    }
+  }
+#endif
+}
+
+/* Copies the damper state into the first PITCH_DAMPORDER - 1 entries of
+ * `damper_in`, oldest sample first. */
+static void LoadDamperState(const double* damper_state, double* damper_in) {
+  int m;
+  for (m = 0; m < PITCH_DAMPORDER - 1; ++m) {
+    damper_in[m] = damper_state[PITCH_DAMPORDER - 2 - m];
+  }
+}
+
+/* Inverse of LoadDamperState() after `length` new samples were appended. */
+static void StoreDamperState(const double* damper_in, int length,
+                             double* damper_state) {
+  int m;
+  for (m = 0; m < PITCH_DAMPORDER; ++m) {
+    damper_state[m] = damper_in[PITCH_DAMPORDER - 2 + length - m];
+  }
+}
+
+/* Applies the damping filter to `damper_in`, which holds PITCH_DAMPORDER - 1
+ * past samples followed by `length` new ones. */
+static void Damp(const double* damper_in, int length, double* out) {
+  int n;
+  int m;
+  double sum;
+  for (n = 0; n < length; ++n) {
+    sum = 0.0;
+    for (m = 0; m < PITCH_DAMPORDER; ++m) {
+      sum += damper_in[PITCH_DAMPORDER - 1 + n - m] * kDampFilter[m];
+    }
+    out[n] = sum;
+  }
+}
+
 /**********************************************************************
  * FilterSegment()
  * Filter one segment, a quarter of a frame.
  *
+ * The segment is processed in blocks that are short enough for the
+ * fractional-lag interpolation of a whole block to only read samples from
+ * before the block, i.e., at most lag_offset - (PITCH_FRACORDER - 1) samples.
+ * The interpolation and the damping then run over the whole block at once.
+ *
  * Inputs
  *   in_data      : pointer to the input signal of 30 ms at 8 kHz sample-rate.
  *   filter_param : pitch filter parameters.
@@ -135,80 +350,53 @@ typedef struct {
 static void FilterSegment(const double* in_data, PitchFilterParam* parameters,
                           double* out_data,
                           double out_dg[][PITCH_FRAME_LEN + QLOOKAHEAD]) {
+  /* Past inputs of the damping filter, oldest first, followed by the new
+   * inputs of the block. */
+  double damper_in[PITCH_DAMPORDER - 1 + QLOOKAHEAD];
+  double fractional[QLOOKAHEAD];
+  double damped[QLOOKAHEAD];
+  int max_block_length = parameters->lag_offset - (PITCH_FRACORDER - 1);
+  int remaining = parameters->num_samples;
+  int block_length;
   int n;
-  int m;
-  int j;
-  double sum;
-  double sum2;
-  /* Index of `parameters->buffer` where the output is written to. */
-  int pos = parameters->index + PITCH_BUFFSIZE;
-  /* Index of `parameters->buffer` where samples are read for fractional-lag
-   * computation. */
-  int pos_lag = pos - parameters->lag_offset;
-
-  for (n = 0; n < parameters->num_samples; ++n) {
-    /* Shift low pass filter states. */
-    for (m = PITCH_DAMPORDER - 1; m > 0; --m) {
-      parameters->damper_state[m] = parameters->damper_state[m - 1];
-    }
+
+  RTC_COMPILE_ASSERT(PITCH_UPDATE <= QLOOKAHEAD);
+  if (max_block_length < 1) {
+    max_block_length = 1;
+  }
+
+  for (; remaining > 0; remaining -= block_length) {
+    /* Index of `parameters->buffer` where the output is written to. */
+    const int pos = parameters->index + PITCH_BUFFSIZE;
+    block_length =
+        remaining < max_block_length ? remaining : max_block_length;
+
     /* Filter to get fractional pitch. */
-    sum = 0.0;
-    for (m = 0; m < PITCH_FRACORDER; ++m) {
-      sum += parameters->buffer[pos_lag + m] * parameters->interpol_coeff[m];
-    }
-    /* Multiply with gain. */
-    parameters->damper_state[0] = parameters->gain * sum;
+    Interpolate(&parameters->buffer[pos - parameters->lag_offset],
+                parameters->interpol_coeff, block_length, fractional);
 
     if (parameters->mode == kPitchFilterPreGain) {
-      int lag_index = parameters->index - parameters->lag_offset;
-      int m_tmp = (lag_index < 0) ? -lag_index : 0;
-      /* Update the damper state for the new sample. */
-      for (m = PITCH_DAMPORDER - 1; m > 0; --m) {
-        for (j = 0; j < 4; ++j) {
-          parameters->damper_state_dg[j][m] =
-              parameters->damper_state_dg[j][m - 1];
-        }
-      }
-
-      for (j = 0; j < parameters->sub_frame + 1; ++j) {
-        /* Filter for fractional pitch. */
-        sum2 = 0.0;
-        for (m = PITCH_FRACORDER-1; m >= m_tmp; --m) {
-          /* `lag_index + m` is always larger than or equal to zero, see how
-           * m_tmp is computed. This is equivalent to assume samples outside
-           * `out_dg[j]` are zero. */
-          sum2 += out_dg[j][lag_index + m] * parameters->interpol_coeff[m];
-        }
-        /* Add the contribution of differential gain change. */
-        parameters->damper_state_dg[j][0] = parameters->gain_mult[j] * sum +
-            parameters->gain * sum2;
-      }
+      FilterDg(parameters, fractional, block_length, out_dg);
+    }
 
-      /* Filter with damping filter, and store the results. */
-      for (j = 0; j < parameters->sub_frame + 1; ++j) {
-        sum = 0.0;
-        for (m = 0; m < PITCH_DAMPORDER; ++m) {
-          sum -= parameters->damper_state_dg[j][m] * kDampFilter[m];
-        }
-        out_dg[j][parameters->index] = sum;
-      }
+    /* Multiply with gain. */
+    LoadDamperState(parameters->damper_state, damper_in);
+    for (n = 0; n < block_length; ++n) {
+      damper_in[PITCH_DAMPORDER - 1 + n] = parameters->gain * fractional[n];
     }
+    StoreDamperState(damper_in, block_length, parameters->damper_state);
     /* Filter with damping filter. */
-    sum = 0.0;
-    for (m = 0; m < PITCH_DAMPORDER; ++m) {
-      sum += parameters->damper_state[m] * kDampFilter[m];
-    }
+    Damp(damper_in, block_length, damped);
 
     /* Subtract from input and update buffer. */
-    out_data[parameters->index] = in_data[parameters->index] - sum;
-    parameters->buffer[pos] = in_data[parameters->index] +
-        out_data[parameters->index];
-
-    ++parameters->index;
-    ++pos;
-    ++pos_lag;
+    for (n = 0; n < block_length; ++n) {
+      out_data[parameters->index + n] =
+          in_data[parameters->index + n] - damped[n];
+      parameters->buffer[pos + n] =
+          in_data[parameters->index + n] + out_data[parameters->index + n];
+    }
+    parameters->index += block_length;
   }
-  return;
 }
 
 /* Update filter parameters based on the pitch-gains and pitch-lags. */
@@ -235,6 +423,8 @@ static void Update(PitchFilterParam* parameters) {
   }
 }
 
+RTC_PUSH_IGNORING_WFRAME_LARGER_THAN()
+
 /******************************************************************************
  * FilterFrame()
  * Filter a frame of 30 millisecond, given pitch-lags and pitch-gains.
@@ -288,6 +478,8 @@ static void FilterFrame(const double* in_data, PitchFiltstr* filter_state,
     memset(filter_parameters.gain_mult, 0, sizeof(filter_parameters.gain_mult));
     memset(filter_parameters.damper_state_dg, 0,
            sizeof(filter_parameters.damper_state_dg));
+    memset(filter_parameters.dg_buffer, 0,
+           sizeof(filter_parameters.dg_buffer));
     for (n = 0; n < PITCH_SUBFRAMES; ++n) {
       //memset(out_dg[n], 0, sizeof(double) * (PITCH_FRAME_LEN + QLOOKAHEAD));
       memset(out_dg[n], 0, sizeof(out_dg[n]));
@@ -360,6 +552,8 @@ static void FilterFrame(const double* in_data, PitchFiltstr* filter_state,
   }
 }
 
+RTC_POP_IGNORING_WFRAME_LARGER_THAN()
+
 void WebRtcIsac_PitchfilterPre(double* in_data, double* out_data,
                                PitchFiltstr* pf_state, double* lags,
                                double* gains) {
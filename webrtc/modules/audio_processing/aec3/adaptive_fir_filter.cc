@@ -26,6 +26,7 @@
 
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
@@ -450,15 +451,93 @@ void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
 }
 #endif
 
+// Computes and stores the frequency response of the half precision filter.
+void ComputeFrequencyResponse(
+    size_t num_partitions,
+    const std::vector<std::vector<CompactFftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  for (auto& H2_ch : *H2) {
+    H2_ch.fill(0.f);
+  }
+
+  const size_t num_render_channels = H[0].size();
+  RTC_DCHECK_EQ(H.size(), H2->capacity());
+  for (size_t p = 0; p < num_partitions; ++p) {
+    RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
+        const float re = HalfToFloat(H[p][ch].re[j]);
+        const float im = HalfToFloat(H[p][ch].im[j]);
+        (*H2)[p][j] = std::max((*H2)[p][j], re * re + im * im);
+      }
+    }
+  }
+}
+
+// Adapts the half precision filter partitions as H(t+1)=H(t)+G(t)*conj(X(t)).
+void AdaptPartitions(const RenderBuffer& render_buffer,
+                     const FftData& G,
+                     size_t num_partitions,
+                     std::vector<std::vector<CompactFftData>>* H) {
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  size_t index = render_buffer.Position();
+  const size_t num_render_channels = render_buffer_data[index].size();
+  for (size_t p = 0; p < num_partitions; ++p) {
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      const FftData& X_p_ch = render_buffer_data[index][ch];
+      CompactFftData& H_p_ch = (*H)[p][ch];
+      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+        const float re = HalfToFloat(H_p_ch.re[k]) + X_p_ch.re[k] * G.re[k] +
+                         X_p_ch.im[k] * G.im[k];
+        const float im = HalfToFloat(H_p_ch.im[k]) + X_p_ch.re[k] * G.im[k] -
+                         X_p_ch.im[k] * G.re[k];
+        H_p_ch.re[k] = FloatToHalf(re);
+        H_p_ch.im[k] = FloatToHalf(im);
+      }
+    }
+    index = index < (render_buffer_data.size() - 1) ? index + 1 : 0;
+  }
+}
+
+// Produces the output of the half precision filter.
+void ApplyFilter(const RenderBuffer& render_buffer,
+                 size_t num_partitions,
+                 const std::vector<std::vector<CompactFftData>>& H,
+                 FftData* S) {
+  S->re.fill(0.f);
+  S->im.fill(0.f);
+
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  size_t index = render_buffer.Position();
+  const size_t num_render_channels = render_buffer_data[index].size();
+  for (size_t p = 0; p < num_partitions; ++p) {
+    RTC_DCHECK_EQ(num_render_channels, H[p].size());
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      const FftData& X_p_ch = render_buffer_data[index][ch];
+      const CompactFftData& H_p_ch = H[p][ch];
+      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+        const float re = HalfToFloat(H_p_ch.re[k]);
+        const float im = HalfToFloat(H_p_ch.im[k]);
+        S->re[k] += X_p_ch.re[k] * re - X_p_ch.im[k] * im;
+        S->im[k] += X_p_ch.re[k] * im + X_p_ch.im[k] * re;
+      }
+    }
+    index = index < (render_buffer_data.size() - 1) ? index + 1 : 0;
+  }
+}
+
 }  // namespace aec3
 
 namespace {
 
 // Ensures that the newly added filter partitions after a size increase are set
 // to zero.
-void ZeroFilter(size_t old_size,
-                size_t new_size,
-                std::vector<std::vector<FftData>>* H) {
+template <typename T>
+void ZeroPartitions(size_t old_size,
+                    size_t new_size,
+                    std::vector<std::vector<T>>* H) {
   RTC_DCHECK_GE(H->size(), old_size);
   RTC_DCHECK_GE(H->size(), new_size);
 
@@ -476,39 +555,58 @@ AdaptiveFirFilter::AdaptiveFirFilter(size_t max_size_partitions,
                                      size_t initial_size_partitions,
                                      size_t size_change_duration_blocks,
                                      size_t num_render_channels,
+                                     bool half_precision_storage,
                                      Aec3Optimization optimization,
                                      ApmDataDumper* data_dumper)
     : data_dumper_(data_dumper),
       fft_(),
       optimization_(optimization),
+      half_precision_storage_(half_precision_storage),
+      use_f16c_kernels_(optimization == Aec3Optimization::kAvx2 &&
+                        GetCPUInfo(kF16C) != 0),
       num_render_channels_(num_render_channels),
       max_size_partitions_(max_size_partitions),
       size_change_duration_blocks_(
           static_cast<int>(size_change_duration_blocks)),
       current_size_partitions_(initial_size_partitions),
       target_size_partitions_(initial_size_partitions),
-      old_target_size_partitions_(initial_size_partitions),
-      H_(max_size_partitions_, std::vector<FftData>(num_render_channels_)) {
+      old_target_size_partitions_(initial_size_partitions) {
   RTC_DCHECK(data_dumper_);
   RTC_DCHECK_GE(max_size_partitions, initial_size_partitions);
 
   RTC_DCHECK_LT(0, size_change_duration_blocks_);
   one_by_size_change_duration_blocks_ = 1.f / size_change_duration_blocks_;
 
-  ZeroFilter(0, max_size_partitions_, &H_);
+  if (half_precision_storage_) {
+    H_compact_.resize(max_size_partitions_,
+                      std::vector<CompactFftData>(num_render_channels_));
+  } else {
+    H_.resize(max_size_partitions_, std::vector<FftData>(num_render_channels_));
+  }
+  ZeroFilter(0, max_size_partitions_);
 
   SetSizePartitions(current_size_partitions_, true);
 }
 
 AdaptiveFirFilter::~AdaptiveFirFilter() = default;
 
+void AdaptiveFirFilter::ZeroFilter(size_t old_size, size_t new_size) {
+  if (half_precision_storage_) {
+    ZeroPartitions(old_size, new_size, &H_compact_);
+  } else {
+    ZeroPartitions(old_size, new_size, &H_);
+  }
+}
+
 void AdaptiveFirFilter::HandleEchoPathChange() {
   // TODO(peah): Check the value and purpose of the code below.
-  ZeroFilter(current_size_partitions_, max_size_partitions_, &H_);
+  ZeroFilter(current_size_partitions_, max_size_partitions_);
 }
 
 void AdaptiveFirFilter::SetSizePartitions(size_t size, bool immediate_effect) {
-  RTC_DCHECK_EQ(max_size_partitions_, H_.capacity());
+  RTC_DCHECK_EQ(max_size_partitions_, half_precision_storage_
+                                          ? H_compact_.capacity()
+                                          : H_.capacity());
   RTC_DCHECK_LE(size, max_size_partitions_);
 
   target_size_partitions_ = std::min(max_size_partitions_, size);
@@ -516,7 +614,7 @@ void AdaptiveFirFilter::SetSizePartitions(size_t size, bool immediate_effect) {
     size_t old_size_partitions_ = current_size_partitions_;
     current_size_partitions_ = old_target_size_partitions_ =
         target_size_partitions_;
-    ZeroFilter(old_size_partitions_, current_size_partitions_, &H_);
+    ZeroFilter(old_size_partitions_, current_size_partitions_);
 
     partition_to_constrain_ =
         std::min(partition_to_constrain_, current_size_partitions_ - 1);
@@ -548,13 +646,25 @@ void AdaptiveFirFilter::UpdateSize() {
     current_size_partitions_ = old_target_size_partitions_ =
         target_size_partitions_;
   }
-  ZeroFilter(old_size_partitions_, current_size_partitions_, &H_);
+  ZeroFilter(old_size_partitions_, current_size_partitions_);
   RTC_DCHECK_LE(0, size_change_counter_);
 }
 
 void AdaptiveFirFilter::Filter(const RenderBuffer& render_buffer,
                                FftData* S) const {
   RTC_DCHECK(S);
+  if (half_precision_storage_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (use_f16c_kernels_) {
+      aec3::ApplyFilter_Avx2(render_buffer, current_size_partitions_,
+                             H_compact_, S);
+      return;
+    }
+#endif
+    aec3::ApplyFilter(render_buffer, current_size_partitions_, H_compact_, S);
+    return;
+  }
+
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #if !defined(WAP_DISABLE_INLINE_SSE)
@@ -601,6 +711,18 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
 
   H2->resize(current_size_partitions_);
 
+  if (half_precision_storage_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (use_f16c_kernels_) {
+      aec3::ComputeFrequencyResponse_Avx2(current_size_partitions_, H_compact_,
+                                          H2);
+      return;
+    }
+#endif
+    aec3::ComputeFrequencyResponse(current_size_partitions_, H_compact_, H2);
+    return;
+  }
+
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #if !defined(WAP_DISABLE_INLINE_SSE)
@@ -628,6 +750,19 @@ void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
   UpdateSize();
 
   // Adapt the filter.
+  if (half_precision_storage_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (use_f16c_kernels_) {
+      aec3::AdaptPartitions_Avx2(render_buffer, G, current_size_partitions_,
+                                 &H_compact_);
+      return;
+    }
+#endif
+    aec3::AdaptPartitions(render_buffer, G, current_size_partitions_,
+                          &H_compact_);
+    return;
+  }
+
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #if !defined(WAP_DISABLE_INLINE_SSE)
@@ -667,8 +802,15 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
       impulse_response->begin() + (partition_to_constrain_ + 1) * kFftLengthBy2,
       0.f);
 
+  FftData H_compact_p_ch;
   for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-    fft_.Ifft(H_[partition_to_constrain_][ch], &h);
+    FftData* H_p_ch = &H_compact_p_ch;
+    if (half_precision_storage_) {
+      H_compact_[partition_to_constrain_][ch].CopyTo(H_p_ch);
+    } else {
+      H_p_ch = &H_[partition_to_constrain_][ch];
+    }
+    fft_.Ifft(*H_p_ch, &h);
 
     static constexpr float kScale = 1.0f / kFftLengthBy2;
     std::for_each(h.begin(), h.begin() + kFftLengthBy2,
@@ -688,7 +830,10 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
       }
     }
 
-    fft_.Fft(&h, &H_[partition_to_constrain_][ch]);
+    fft_.Fft(&h, H_p_ch);
+    if (half_precision_storage_) {
+      H_compact_[partition_to_constrain_][ch].Assign(*H_p_ch);
+    }
   }
 
   partition_to_constrain_ =
@@ -701,15 +846,25 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
 // time via setting the relevant time-domain coefficients to zero.
 void AdaptiveFirFilter::Constrain() {
   std::array<float, kFftLength> h;
+  FftData H_compact_p_ch;
   for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-    fft_.Ifft(H_[partition_to_constrain_][ch], &h);
+    FftData* H_p_ch = &H_compact_p_ch;
+    if (half_precision_storage_) {
+      H_compact_[partition_to_constrain_][ch].CopyTo(H_p_ch);
+    } else {
+      H_p_ch = &H_[partition_to_constrain_][ch];
+    }
+    fft_.Ifft(*H_p_ch, &h);
 
     static constexpr float kScale = 1.0f / kFftLengthBy2;
     std::for_each(h.begin(), h.begin() + kFftLengthBy2,
                   [](float& a) { a *= kScale; });
     std::fill(h.begin() + kFftLengthBy2, h.end(), 0.f);
 
-    fft_.Fft(&h, &H_[partition_to_constrain_][ch]);
+    fft_.Fft(&h, H_p_ch);
+    if (half_precision_storage_) {
+      H_compact_[partition_to_constrain_][ch].Assign(*H_p_ch);
+    }
   }
 
   partition_to_constrain_ =
@@ -719,6 +874,20 @@ void AdaptiveFirFilter::Constrain() {
 }
 
 void AdaptiveFirFilter::ScaleFilter(float factor) {
+  FftData H_p_ch;
+  for (auto& H_compact_p : H_compact_) {
+    for (auto& H_compact_p_ch : H_compact_p) {
+      H_compact_p_ch.CopyTo(&H_p_ch);
+      for (auto& re : H_p_ch.re) {
+        re *= factor;
+      }
+      for (auto& im : H_p_ch.im) {
+        im *= factor;
+      }
+      H_compact_p_ch.Assign(H_p_ch);
+    }
+  }
+
   for (auto& H_p : H_) {
     for (auto& H_p_ch : H_p) {
       for (auto& re : H_p_ch.re) {
@@ -737,14 +906,68 @@ void AdaptiveFirFilter::SetFilter(size_t num_partitions,
   const size_t min_num_partitions =
       std::min(current_size_partitions_, num_partitions);
   for (size_t p = 0; p < min_num_partitions; ++p) {
-    RTC_DCHECK_EQ(H_[p].size(), H[p].size());
-    RTC_DCHECK_EQ(num_render_channels_, H_[p].size());
+    RTC_DCHECK_EQ(num_render_channels_, H[p].size());
+
+    for (size_t ch = 0; ch < num_render_channels_; ++ch) {
+      if (half_precision_storage_) {
+        H_compact_[p][ch].Assign(H[p][ch]);
+      } else {
+        std::copy(H[p][ch].re.begin(), H[p][ch].re.end(),
+                  H_[p][ch].re.begin());
+        std::copy(H[p][ch].im.begin(), H[p][ch].im.end(),
+                  H_[p][ch].im.begin());
+      }
+    }
+  }
+}
 
+void AdaptiveFirFilter::SetFilter(size_t num_partitions,
+                                  const AdaptiveFirFilter& filter) {
+  RTC_DCHECK_EQ(num_render_channels_, filter.num_render_channels_);
+  if (half_precision_storage_ == filter.half_precision_storage_) {
+    const size_t min_num_partitions =
+        std::min(current_size_partitions_, num_partitions);
+    if (half_precision_storage_) {
+      std::copy(filter.H_compact_.begin(),
+                filter.H_compact_.begin() + min_num_partitions,
+                H_compact_.begin());
+    } else {
+      std::copy(filter.H_.begin(), filter.H_.begin() + min_num_partitions,
+                H_.begin());
+    }
+    return;
+  }
+
+  std::vector<std::vector<FftData>> H;
+  filter.GetFilter(num_partitions, &H);
+  SetFilter(num_partitions, H);
+}
+
+void AdaptiveFirFilter::GetFilter(size_t num_partitions,
+                                  std::vector<std::vector<FftData>>* H) const {
+  RTC_DCHECK_GE(max_size_partitions_, num_partitions);
+  if (!half_precision_storage_) {
+    H->assign(H_.begin(), H_.begin() + num_partitions);
+    return;
+  }
+
+  H->resize(num_partitions);
+  for (size_t p = 0; p < num_partitions; ++p) {
+    (*H)[p].resize(num_render_channels_);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      std::copy(H[p][ch].re.begin(), H[p][ch].re.end(), H_[p][ch].re.begin());
-      std::copy(H[p][ch].im.begin(), H[p][ch].im.end(), H_[p][ch].im.begin());
+      H_compact_[p][ch].CopyTo(&(*H)[p][ch]);
     }
   }
 }
 
+void AdaptiveFirFilter::SetFilter(size_t num_partitions,
+                                  const std::vector<std::vector<FftData>>& H,
+                                  std::vector<float>* impulse_response) {
+  SetFilter(num_partitions, H);
+  partition_to_constrain_ = 0;
+  for (size_t p = 0; p < current_size_partitions_; ++p) {
+    ConstrainAndUpdateImpulseResponse(impulse_response);
+  }
+}
+
 }  // namespace webrtc
@@ -20,6 +20,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/compact_fft_data.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
@@ -96,15 +97,45 @@ void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
                       FftData* S);
 #endif
 
+// Variants of the functions above for filters stored with half precision.
+void ComputeFrequencyResponse(
+    size_t num_partitions,
+    const std::vector<std::vector<CompactFftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+void AdaptPartitions(const RenderBuffer& render_buffer,
+                     const FftData& G,
+                     size_t num_partitions,
+                     std::vector<std::vector<CompactFftData>>* H);
+void ApplyFilter(const RenderBuffer& render_buffer,
+                 size_t num_partitions,
+                 const std::vector<std::vector<CompactFftData>>& H,
+                 FftData* S);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void ComputeFrequencyResponse_Avx2(
+    size_t num_partitions,
+    const std::vector<std::vector<CompactFftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+void AdaptPartitions_Avx2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t num_partitions,
+                          std::vector<std::vector<CompactFftData>>* H);
+void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
+                      size_t num_partitions,
+                      const std::vector<std::vector<CompactFftData>>& H,
+                      FftData* S);
+#endif
+
 }  // namespace aec3
 
-// Provides a frequency domain adaptive filter functionality.
+// Provides a frequency domain adaptive filter functionality. The filter
+// coefficients are optionally stored with half precision.
 class AdaptiveFirFilter {
  public:
   AdaptiveFirFilter(size_t max_size_partitions,
                     size_t initial_size_partitions,
                     size_t size_change_duration_blocks,
                     size_t num_render_channels,
+                    bool half_precision_storage,
                     Aec3Optimization optimization,
                     ApmDataDumper* data_dumper);
 
@@ -144,8 +175,15 @@ class AdaptiveFirFilter {
 
   void DumpFilter(absl::string_view name_frequency_domain) {
     for (size_t p = 0; p < max_size_partitions_; ++p) {
-      data_dumper_->DumpRaw(name_frequency_domain, H_[p][0].re);
-      data_dumper_->DumpRaw(name_frequency_domain, H_[p][0].im);
+      if (half_precision_storage_) {
+        FftData H_p;
+        H_compact_[p][0].CopyTo(&H_p);
+        data_dumper_->DumpRaw(name_frequency_domain, H_p.re);
+        data_dumper_->DumpRaw(name_frequency_domain, H_p.im);
+      } else {
+        data_dumper_->DumpRaw(name_frequency_domain, H_[p][0].re);
+        data_dumper_->DumpRaw(name_frequency_domain, H_[p][0].im);
+      }
     }
   }
 
@@ -156,8 +194,18 @@ class AdaptiveFirFilter {
   void SetFilter(size_t num_partitions,
                  const std::vector<std::vector<FftData>>& H);
 
-  // Gets the filter coefficients.
-  const std::vector<std::vector<FftData>>& GetFilter() const { return H_; }
+  // Sets the filter coefficients, constrains all the partitions and updates an
+  // externally stored impulse response estimate accordingly.
+  void SetFilter(size_t num_partitions,
+                 const std::vector<std::vector<FftData>>& H,
+                 std::vector<float>* impulse_response);
+
+  // Sets the filter coefficients to those of another filter.
+  void SetFilter(size_t num_partitions, const AdaptiveFirFilter& filter);
+
+  // Gets the coefficients of the first `num_partitions` filter partitions.
+  void GetFilter(size_t num_partitions,
+                 std::vector<std::vector<FftData>>* H) const;
 
  private:
   // Adapts the filter and updates the filter size.
@@ -172,9 +220,16 @@ class AdaptiveFirFilter {
   // Gradually Updates the current filter size towards the target size.
   void UpdateSize();
 
+  // Sets the filter partitions from `old_size` up to `new_size` to zero.
+  void ZeroFilter(size_t old_size, size_t new_size);
+
   ApmDataDumper* const data_dumper_;
   const Aec3Fft fft_;
   const Aec3Optimization optimization_;
+  const bool half_precision_storage_;
+  // Whether the half precision filter uses the AVX2 kernels, which also
+  // require the F16C conversion instructions.
+  const bool use_f16c_kernels_;
   const size_t num_render_channels_;
   const size_t max_size_partitions_;
   const int size_change_duration_blocks_;
@@ -183,7 +238,10 @@ class AdaptiveFirFilter {
   size_t target_size_partitions_;
   size_t old_target_size_partitions_;
   int size_change_counter_ = 0;
+  // Only one of the coefficient storages is allocated, depending on whether
+  // half precision storage is used.
   std::vector<std::vector<FftData>> H_;
+  std::vector<std::vector<CompactFftData>> H_compact_;
   size_t partition_to_constrain_ = 0;
 };
 
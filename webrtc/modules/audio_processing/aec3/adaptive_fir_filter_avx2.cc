@@ -184,5 +184,165 @@ void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
   } while (p < lim2);
 }
 
+namespace {
+
+// Loads eight half precision values and widens them to single precision.
+__m256 LoadHalf(const uint16_t* x) {
+  return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x)));
+}
+
+// Narrows eight single precision values to half precision and stores them.
+void StoreHalf(__m256 x, uint16_t* y) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(y),
+                   _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT));
+}
+
+}  // namespace
+
+// Computes and stores the frequency response of the half precision filter
+// (AVX2 variant).
+void ComputeFrequencyResponse_Avx2(
+    size_t num_partitions,
+    const std::vector<std::vector<CompactFftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  for (auto& H2_ch : *H2) {
+    H2_ch.fill(0.f);
+  }
+
+  const size_t num_render_channels = H[0].size();
+  RTC_DCHECK_EQ(H.size(), H2->capacity());
+  for (size_t p = 0; p < num_partitions; ++p) {
+    RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
+    auto& H2_p = (*H2)[p];
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      const CompactFftData& H_p_ch = H[p][ch];
+      for (size_t j = 0; j < kFftLengthBy2; j += 8) {
+        __m256 re = LoadHalf(&H_p_ch.re[j]);
+        __m256 re2 = _mm256_mul_ps(re, re);
+        __m256 im = LoadHalf(&H_p_ch.im[j]);
+        re2 = _mm256_fmadd_ps(im, im, re2);
+        __m256 H2_k_j = _mm256_loadu_ps(&H2_p[j]);
+        H2_k_j = _mm256_max_ps(H2_k_j, re2);
+        _mm256_storeu_ps(&H2_p[j], H2_k_j);
+      }
+      const float re = HalfToFloat(H_p_ch.re[kFftLengthBy2]);
+      const float im = HalfToFloat(H_p_ch.im[kFftLengthBy2]);
+      H2_p[kFftLengthBy2] = std::max(H2_p[kFftLengthBy2], re * re + im * im);
+    }
+  }
+}
+
+// Adapts the half precision filter partitions (AVX2 variant).
+void AdaptPartitions_Avx2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t num_partitions,
+                          std::vector<std::vector<CompactFftData>>* H) {
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data[0].size();
+  const size_t lim1 = std::min(
+      render_buffer_data.size() - render_buffer.Position(), num_partitions);
+  const size_t lim2 = num_partitions;
+  constexpr size_t kNumEightBinBands = kFftLengthBy2 / 8;
+
+  size_t X_partition = render_buffer.Position();
+  size_t limit = lim1;
+  size_t p = 0;
+  do {
+    for (; p < limit; ++p, ++X_partition) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        CompactFftData& H_p_ch = (*H)[p][ch];
+        const FftData& X = render_buffer_data[X_partition][ch];
+
+        for (size_t k = 0, n = 0; n < kNumEightBinBands; ++n, k += 8) {
+          const __m256 G_re = _mm256_loadu_ps(&G.re[k]);
+          const __m256 G_im = _mm256_loadu_ps(&G.im[k]);
+          const __m256 X_re = _mm256_loadu_ps(&X.re[k]);
+          const __m256 X_im = _mm256_loadu_ps(&X.im[k]);
+          const __m256 H_re = LoadHalf(&H_p_ch.re[k]);
+          const __m256 H_im = LoadHalf(&H_p_ch.im[k]);
+          const __m256 a = _mm256_mul_ps(X_re, G_re);
+          const __m256 b = _mm256_mul_ps(X_im, G_im);
+          const __m256 c = _mm256_mul_ps(X_re, G_im);
+          const __m256 d = _mm256_mul_ps(X_im, G_re);
+          const __m256 e = _mm256_add_ps(a, b);
+          const __m256 f = _mm256_sub_ps(c, d);
+          const __m256 g = _mm256_add_ps(H_re, e);
+          const __m256 h = _mm256_add_ps(H_im, f);
+          StoreHalf(g, &H_p_ch.re[k]);
+          StoreHalf(h, &H_p_ch.im[k]);
+        }
+
+        const float re = HalfToFloat(H_p_ch.re[kFftLengthBy2]) +
+                         X.re[kFftLengthBy2] * G.re[kFftLengthBy2] +
+                         X.im[kFftLengthBy2] * G.im[kFftLengthBy2];
+        const float im = HalfToFloat(H_p_ch.im[kFftLengthBy2]) +
+                         X.re[kFftLengthBy2] * G.im[kFftLengthBy2] -
+                         X.im[kFftLengthBy2] * G.re[kFftLengthBy2];
+        H_p_ch.re[kFftLengthBy2] = FloatToHalf(re);
+        H_p_ch.im[kFftLengthBy2] = FloatToHalf(im);
+      }
+    }
+    X_partition = 0;
+    limit = lim2;
+  } while (p < lim2);
+}
+
+// Produces the output of the half precision filter (AVX2 variant).
+void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
+                      size_t num_partitions,
+                      const std::vector<std::vector<CompactFftData>>& H,
+                      FftData* S) {
+  S->re.fill(0.f);
+  S->im.fill(0.f);
+
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data[0].size();
+  const size_t lim1 = std::min(
+      render_buffer_data.size() - render_buffer.Position(), num_partitions);
+  const size_t lim2 = num_partitions;
+  constexpr size_t kNumEightBinBands = kFftLengthBy2 / 8;
+
+  size_t X_partition = render_buffer.Position();
+  size_t p = 0;
+  size_t limit = lim1;
+  do {
+    for (; p < limit; ++p, ++X_partition) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        const CompactFftData& H_p_ch = H[p][ch];
+        const FftData& X = render_buffer_data[X_partition][ch];
+        for (size_t k = 0, n = 0; n < kNumEightBinBands; ++n, k += 8) {
+          const __m256 X_re = _mm256_loadu_ps(&X.re[k]);
+          const __m256 X_im = _mm256_loadu_ps(&X.im[k]);
+          const __m256 H_re = LoadHalf(&H_p_ch.re[k]);
+          const __m256 H_im = LoadHalf(&H_p_ch.im[k]);
+          const __m256 S_re = _mm256_loadu_ps(&S->re[k]);
+          const __m256 S_im = _mm256_loadu_ps(&S->im[k]);
+          const __m256 a = _mm256_mul_ps(X_re, H_re);
+          const __m256 b = _mm256_mul_ps(X_im, H_im);
+          const __m256 c = _mm256_mul_ps(X_re, H_im);
+          const __m256 d = _mm256_mul_ps(X_im, H_re);
+          const __m256 e = _mm256_sub_ps(a, b);
+          const __m256 f = _mm256_add_ps(c, d);
+          const __m256 g = _mm256_add_ps(S_re, e);
+          const __m256 h = _mm256_add_ps(S_im, f);
+          _mm256_storeu_ps(&S->re[k], g);
+          _mm256_storeu_ps(&S->im[k], h);
+        }
+
+        const float H_re = HalfToFloat(H_p_ch.re[kFftLengthBy2]);
+        const float H_im = HalfToFloat(H_p_ch.im[kFftLengthBy2]);
+        S->re[kFftLengthBy2] +=
+            X.re[kFftLengthBy2] * H_re - X.im[kFftLengthBy2] * H_im;
+        S->im[kFftLengthBy2] +=
+            X.re[kFftLengthBy2] * H_im + X.im[kFftLengthBy2] * H_re;
+      }
+    }
+    limit = lim2;
+    X_partition = 0;
+  } while (p < lim2);
+}
+
 }  // namespace aec3
 }  // namespace webrtc
@@ -25,19 +25,31 @@ namespace webrtc {
 
 enum class Aec3Optimization { kNone, kSse2, kAvx2, kNeon };
 
-constexpr int kNumBlocksPerSecond = 250;
+// The block size is set at build time. Blocks of 32 samples lower the
+// algorithmic delay, while blocks of 128 samples lower the per-block overhead.
+// The frequency bins, filter lengths and default delay in EchoCanceller3Config
+// refer to 64-sample blocks and are rescaled when the config is applied, while
+// the remaining parameters expressed in blocks scale with the block size.
+#ifndef WEBRTC_AEC3_BLOCK_SIZE_LOG2
+#error "Set WEBRTC_AEC3_BLOCK_SIZE_LOG2 to 5, 6 or 7"
+#endif
+static_assert(WEBRTC_AEC3_BLOCK_SIZE_LOG2 >= 5 &&
+                  WEBRTC_AEC3_BLOCK_SIZE_LOG2 <= 7,
+              "Supported block sizes are 32, 64 and 128 samples");
+
+constexpr size_t kFftLengthBy2Log2 = WEBRTC_AEC3_BLOCK_SIZE_LOG2;
+constexpr size_t kFftLengthBy2 = size_t{1} << kFftLengthBy2Log2;
+constexpr size_t kFftLengthBy2Plus1 = kFftLengthBy2 + 1;
+constexpr size_t kFftLengthBy2Minus1 = kFftLengthBy2 - 1;
+constexpr size_t kFftLength = 2 * kFftLengthBy2;
+
+constexpr int kNumBlocksPerSecond = static_cast<int>(16000 / kFftLengthBy2);
 
 constexpr int kMetricsReportingIntervalBlocks = 10 * kNumBlocksPerSecond;
 constexpr int kMetricsComputationBlocks = 3;
 constexpr int kMetricsCollectionBlocks =
     kMetricsReportingIntervalBlocks - kMetricsComputationBlocks;
 
-constexpr size_t kFftLengthBy2 = 64;
-constexpr size_t kFftLengthBy2Plus1 = kFftLengthBy2 + 1;
-constexpr size_t kFftLengthBy2Minus1 = kFftLengthBy2 - 1;
-constexpr size_t kFftLength = 2 * kFftLengthBy2;
-constexpr size_t kFftLengthBy2Log2 = 6;
-
 constexpr int kRenderTransferQueueSizeFrames = 100;
 
 constexpr size_t kMaxNumBands = 3;
@@ -48,7 +60,8 @@ constexpr size_t kBlockSize = kFftLengthBy2;
 constexpr size_t kBlockSizeLog2 = kFftLengthBy2Log2;
 
 constexpr size_t kExtendedBlockSize = 2 * kFftLengthBy2;
-constexpr size_t kMatchedFilterWindowSizeSubBlocks = 32;
+// The matched filter windows span 128 ms regardless of the block size.
+constexpr size_t kMatchedFilterWindowSizeSubBlocks = 2048 / kBlockSize;
 constexpr size_t kMatchedFilterAlignmentShiftSizeSubBlocks =
     kMatchedFilterWindowSizeSubBlocks * 3 / 4;
 
@@ -15,14 +15,15 @@
 
 #include "api/array_view.h"
 #include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
+#include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-// Wrapper class that provides 128 point real valued FFT functionality with the
-// FftData type.
+// Wrapper class that provides kFftLength point real valued FFT functionality
+// with the FftData type.
 class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
@@ -36,14 +37,22 @@ class Aec3Fft {
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
+#if WEBRTC_AEC3_BLOCK_SIZE_LOG2 == 6
     ooura_fft_.Fft(x->data());
+#else
+    Rdft(1, x->data());
+#endif
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
     X.CopyToPackedArray(x);
+#if WEBRTC_AEC3_BLOCK_SIZE_LOG2 == 6
     ooura_fft_.InverseFft(x->data());
+#else
+    Rdft(-1, x->data());
+#endif
   }
 
   // Windows the input using a Hanning window, and then adds padding of
@@ -67,7 +76,27 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
+#if WEBRTC_AEC3_BLOCK_SIZE_LOG2 == 6
   const OouraFft ooura_fft_;
+#else
+  // Runs the generic size Ooura FFT in the given direction. WebRtc_rdft uses
+  // the bit reversal state beyond its first two elements as scratch space, so
+  // each call works on its own copy and the transforms of one instance may run
+  // concurrently, as they do with the capture channel workers.
+  void Rdft(int direction, float* x) const {
+    std::array<size_t, kFftLengthBy2> bit_reversal_state;
+    bit_reversal_state[0] = bit_reversal_state_[0];
+    bit_reversal_state[1] = bit_reversal_state_[1];
+    WebRtc_rdft(kFftLength, direction, x, bit_reversal_state.data(),
+                tables_.data());
+  }
+
+  // Sizes of the tables, in the first two elements, and the tables of the
+  // generic size Ooura FFT. Both are initialized in the constructor, after
+  // which WebRtc_rdft only reads the tables.
+  std::array<size_t, kFftLengthBy2> bit_reversal_state_;
+  mutable std::array<float, kFftLengthBy2> tables_;
+#endif
 };
 
 }  // namespace webrtc
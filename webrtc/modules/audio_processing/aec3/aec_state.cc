@@ -169,6 +169,41 @@ void AecState::HandleEchoPathChange(
   }
 }
 
+void AecState::SetWarmStartState(const Aec3WarmStartState& state) {
+  RTC_DCHECK_EQ(num_capture_channels_, state.erle.size());
+  RTC_DCHECK_EQ(num_capture_channels_, state.fullband_erle_log2.size());
+  erl_estimator_.SetErl(state.erl, state.erl_time_domain);
+  erle_estimator_.SetErle(state.erle, state.fullband_erle_log2);
+  reverb_model_estimator_.SetReverbModel(state.reverb_decay,
+                                         state.reverb_average_decay,
+                                         state.reverb_frequency_response);
+  initial_state_.Exit();
+  filter_quality_state_.SetConverged();
+  // Let the filter analyzer, rather than the default delay, determine the
+  // direct-path delay right away.
+  strong_not_saturated_render_blocks_ =
+      std::max(strong_not_saturated_render_blocks_,
+               static_cast<size_t>(2 * kNumBlocksPerSecond));
+}
+
+void AecState::GetWarmStartState(Aec3WarmStartState* state) const {
+  RTC_DCHECK(state);
+  state->erl = erl_estimator_.Erl();
+  state->erl_time_domain = erl_estimator_.ErlTimeDomain();
+  const auto erle = erle_estimator_.SubbandErle();
+  state->erle.assign(erle.begin(), erle.end());
+  const auto fullband_erle_log2 = erle_estimator_.FullbandErleLog2PerChannel();
+  state->fullband_erle_log2.assign(fullband_erle_log2.begin(),
+                                   fullband_erle_log2.end());
+  state->reverb_decay = reverb_model_estimator_.ReverbDecay(/*mild=*/false);
+  state->reverb_average_decay = reverb_model_estimator_.AverageDecay();
+  const auto reverb_frequency_response =
+      reverb_model_estimator_.GetReverbFrequencyResponse();
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, reverb_frequency_response.size());
+  std::copy(reverb_frequency_response.begin(), reverb_frequency_response.end(),
+            state->reverb_frequency_response.begin());
+}
+
 void AecState::Update(
     const std::optional<DelayEstimate>& external_delay,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
@@ -339,18 +374,28 @@ void AecState::InitialState::InitialState::Update(bool active_render,
 
   // Flag whether the initial state is still active.
   bool prev_initial_state = initial_state_;
-  if (conservative_initial_phase_) {
-    initial_state_ =
-        strong_not_saturated_render_blocks_ < 5 * kNumBlocksPerSecond;
-  } else {
-    initial_state_ = strong_not_saturated_render_blocks_ <
-                     initial_state_seconds_ * kNumBlocksPerSecond;
-  }
+  initial_state_ =
+      strong_not_saturated_render_blocks_ < InitialStateLengthBlocks();
 
   // Flag whether the transition from the initial state has started.
   transition_triggered_ = !initial_state_ && prev_initial_state;
 }
 
+void AecState::InitialState::Exit() {
+  strong_not_saturated_render_blocks_ = std::max(
+      strong_not_saturated_render_blocks_, InitialStateLengthBlocks());
+  initial_state_ = false;
+  transition_triggered_ = false;
+}
+
+size_t AecState::InitialState::InitialStateLengthBlocks() const {
+  if (conservative_initial_phase_) {
+    return 5 * kNumBlocksPerSecond;
+  }
+  return static_cast<size_t>(
+      ceilf(initial_state_seconds_ * kNumBlocksPerSecond));
+}
+
 AecState::FilterDelay::FilterDelay(const EchoCanceller3Config& config,
                                    size_t num_capture_channels)
     : delay_headroom_blocks_(config.delay.delay_headroom_samples / kBlockSize),
@@ -401,6 +446,16 @@ void AecState::FilteringQualityAnalyzer::Reset() {
   filter_update_blocks_since_reset_ = 0;
 }
 
+void AecState::FilteringQualityAnalyzer::SetConverged() {
+  filter_update_blocks_since_reset_ =
+      std::max(filter_update_blocks_since_reset_,
+               static_cast<size_t>(kNumBlocksPerSecond));
+  filter_update_blocks_since_start_ =
+      std::max(filter_update_blocks_since_start_,
+               static_cast<size_t>(kNumBlocksPerSecond));
+  convergence_seen_ = true;
+}
+
 void AecState::FilteringQualityAnalyzer::Update(
     bool active_render,
     bool transparent_mode,
@@ -33,6 +33,7 @@
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/aec3/subtractor_output_analyzer.h"
 #include "modules/audio_processing/aec3/transparent_mode.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -154,6 +155,13 @@ class AecState {
     return filter_analyzer_.FilterLengthBlocks();
   }
 
+  // Initializes the echo path estimates from a state exported during a
+  // previous call over the same echo path and leaves the initial state.
+  void SetWarmStartState(const Aec3WarmStartState& state);
+
+  // Copies the echo path estimates into `state`.
+  void GetWarmStartState(Aec3WarmStartState* state) const;
+
  private:
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
@@ -174,6 +182,9 @@ class AecState {
     // Updates the state based on new data.
     void Update(bool active_render, bool saturated_capture);
 
+    // Leaves the initial state without triggering a transition.
+    void Exit();
+
     // Returns whether the initial state is active or not.
     bool InitialStateActive() const { return initial_state_; }
 
@@ -181,6 +192,10 @@ class AecState {
     bool TransitionTriggered() const { return transition_triggered_; }
 
    private:
+    // Returns the number of blocks of strong render activity that the initial
+    // state lasts for.
+    size_t InitialStateLengthBlocks() const;
+
     const bool conservative_initial_phase_;
     const float initial_state_seconds_;
     bool transition_triggered_ = false;
@@ -249,6 +264,10 @@ class AecState {
     // Resets the state of the analyzer.
     void Reset();
 
+    // Treats the filter as converged and sufficiently adapted, which is used
+    // when the filter has been initialized from a previous call.
+    void SetConverged();
+
     // Updates the analysis based on new data.
     void Update(bool active_render,
                 bool transparent_mode,
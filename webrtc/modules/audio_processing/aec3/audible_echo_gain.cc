@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/audible_echo_gain.h"
+
+#include <algorithm>
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace aec3 {
+
+void GainToNoAudibleEcho(rtc::ArrayView<const float> nearend,
+                         rtc::ArrayView<const float> echo,
+                         rtc::ArrayView<const float> masker,
+                         rtc::ArrayView<const float> enr_transparent,
+                         rtc::ArrayView<const float> enr_suppress,
+                         rtc::ArrayView<const float> emr_transparent,
+                         rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(gain.size(), nearend.size());
+  RTC_DCHECK_EQ(gain.size(), echo.size());
+  RTC_DCHECK_EQ(gain.size(), masker.size());
+  for (size_t k = 0; k < gain.size(); ++k) {
+    float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
+    float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
+    float g = 1.0f;
+    if (enr > enr_transparent[k] && emr > emr_transparent[k]) {
+      g = (enr_suppress[k] - enr) / (enr_suppress[k] - enr_transparent[k]);
+      g = std::max(g, emr_transparent[k] / emr);
+    }
+    gain[k] = g;
+  }
+}
+
+void MinGainForEchoPower(float min_echo_power,
+                         rtc::ArrayView<const float> echo,
+                         rtc::ArrayView<float> min_gain) {
+  RTC_DCHECK_EQ(min_gain.size(), echo.size());
+  for (size_t k = 0; k < min_gain.size(); ++k) {
+    min_gain[k] = echo[k] > 0.f ? min_echo_power / echo[k] : 1.f;
+    min_gain[k] = std::min(min_gain[k], 1.f);
+  }
+}
+
+void ApplyGainBounds(rtc::ArrayView<const float> G,
+                     rtc::ArrayView<const float> min_gain,
+                     rtc::ArrayView<const float> max_gain,
+                     rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(gain.size(), G.size());
+  RTC_DCHECK_EQ(gain.size(), min_gain.size());
+  RTC_DCHECK_EQ(gain.size(), max_gain.size());
+  for (size_t k = 0; k < gain.size(); ++k) {
+    const float G_k = std::max(std::min(G[k], max_gain[k]), min_gain[k]);
+    gain[k] = std::min(gain[k], G_k);
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+// The operand order of the min and max instructions below is chosen to match
+// std::min and std::max, which return their first argument on ties.
+void GainToNoAudibleEcho_SSE2(rtc::ArrayView<const float> nearend,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<const float> masker,
+                              rtc::ArrayView<const float> enr_transparent,
+                              rtc::ArrayView<const float> enr_suppress,
+                              rtc::ArrayView<const float> emr_transparent,
+                              rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, gain.size());
+  const __m128 one = _mm_set1_ps(1.f);
+  for (size_t k = 0; k < kFftLengthBy2; k += 4) {
+    const __m128 echo_k = _mm_loadu_ps(&echo[k]);
+    const __m128 enr =
+        _mm_div_ps(echo_k, _mm_add_ps(_mm_loadu_ps(&nearend[k]), one));
+    const __m128 emr =
+        _mm_div_ps(echo_k, _mm_add_ps(_mm_loadu_ps(&masker[k]), one));
+    const __m128 enr_transparent_k = _mm_loadu_ps(&enr_transparent[k]);
+    const __m128 enr_suppress_k = _mm_loadu_ps(&enr_suppress[k]);
+    const __m128 emr_transparent_k = _mm_loadu_ps(&emr_transparent[k]);
+    const __m128 suppress = _mm_and_ps(_mm_cmpgt_ps(enr, enr_transparent_k),
+                                       _mm_cmpgt_ps(emr, emr_transparent_k));
+    __m128 g = _mm_div_ps(_mm_sub_ps(enr_suppress_k, enr),
+                          _mm_sub_ps(enr_suppress_k, enr_transparent_k));
+    g = _mm_max_ps(_mm_div_ps(emr_transparent_k, emr), g);
+    g = _mm_or_ps(_mm_and_ps(suppress, g), _mm_andnot_ps(suppress, one));
+    _mm_storeu_ps(&gain[k], g);
+  }
+  GainToNoAudibleEcho(nearend.subview(kFftLengthBy2),
+                      echo.subview(kFftLengthBy2),
+                      masker.subview(kFftLengthBy2),
+                      enr_transparent.subview(kFftLengthBy2),
+                      enr_suppress.subview(kFftLengthBy2),
+                      emr_transparent.subview(kFftLengthBy2),
+                      gain.subview(kFftLengthBy2));
+}
+
+void MinGainForEchoPower_SSE2(float min_echo_power,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<float> min_gain) {
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, min_gain.size());
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 min_echo_power_v = _mm_set1_ps(min_echo_power);
+  for (size_t k = 0; k < kFftLengthBy2; k += 4) {
+    const __m128 echo_k = _mm_loadu_ps(&echo[k]);
+    const __m128 nonzero = _mm_cmpgt_ps(echo_k, zero);
+    __m128 g = _mm_div_ps(min_echo_power_v, echo_k);
+    g = _mm_or_ps(_mm_and_ps(nonzero, g), _mm_andnot_ps(nonzero, one));
+    _mm_storeu_ps(&min_gain[k], _mm_min_ps(one, g));
+  }
+  MinGainForEchoPower(min_echo_power, echo.subview(kFftLengthBy2),
+                      min_gain.subview(kFftLengthBy2));
+}
+
+void ApplyGainBounds_SSE2(rtc::ArrayView<const float> G,
+                          rtc::ArrayView<const float> min_gain,
+                          rtc::ArrayView<const float> max_gain,
+                          rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, gain.size());
+  for (size_t k = 0; k < kFftLengthBy2; k += 4) {
+    __m128 G_k = _mm_min_ps(_mm_loadu_ps(&max_gain[k]), _mm_loadu_ps(&G[k]));
+    G_k = _mm_max_ps(_mm_loadu_ps(&min_gain[k]), G_k);
+    _mm_storeu_ps(&gain[k], _mm_min_ps(G_k, _mm_loadu_ps(&gain[k])));
+  }
+  ApplyGainBounds(G.subview(kFftLengthBy2), min_gain.subview(kFftLengthBy2),
+                  max_gain.subview(kFftLengthBy2), gain.subview(kFftLengthBy2));
+}
+#endif
+
+}  // namespace aec3
+}  // namespace webrtc
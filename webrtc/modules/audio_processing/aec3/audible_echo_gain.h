@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_AUDIBLE_ECHO_GAIN_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_AUDIBLE_ECHO_GAIN_H_
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// Computes the per-band gain that reduces the echo to a non-audible level,
+// given the nearend and masker powers and the per-band masking thresholds.
+void GainToNoAudibleEcho(rtc::ArrayView<const float> nearend,
+                         rtc::ArrayView<const float> echo,
+                         rtc::ArrayView<const float> masker,
+                         rtc::ArrayView<const float> enr_transparent,
+                         rtc::ArrayView<const float> enr_suppress,
+                         rtc::ArrayView<const float> emr_transparent,
+                         rtc::ArrayView<float> gain);
+
+// Computes the attenuating gain, limited to at most 1, that puts the echo power
+// at `min_echo_power`.
+void MinGainForEchoPower(float min_echo_power,
+                         rtc::ArrayView<const float> echo,
+                         rtc::ArrayView<float> min_gain);
+
+// Bounds the gain G to the range given by `min_gain` and `max_gain` and lowers
+// `gain` to the bounded gain where that is smaller.
+void ApplyGainBounds(rtc::ArrayView<const float> G,
+                     rtc::ArrayView<const float> min_gain,
+                     rtc::ArrayView<const float> max_gain,
+                     rtc::ArrayView<float> gain);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void GainToNoAudibleEcho_SSE2(rtc::ArrayView<const float> nearend,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<const float> masker,
+                              rtc::ArrayView<const float> enr_transparent,
+                              rtc::ArrayView<const float> enr_suppress,
+                              rtc::ArrayView<const float> emr_transparent,
+                              rtc::ArrayView<float> gain);
+
+void MinGainForEchoPower_SSE2(float min_echo_power,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<float> min_gain);
+
+void ApplyGainBounds_SSE2(rtc::ArrayView<const float> G,
+                          rtc::ArrayView<const float> min_gain,
+                          rtc::ArrayView<const float> max_gain,
+                          rtc::ArrayView<float> gain);
+
+void GainToNoAudibleEcho_AVX2(rtc::ArrayView<const float> nearend,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<const float> masker,
+                              rtc::ArrayView<const float> enr_transparent,
+                              rtc::ArrayView<const float> enr_suppress,
+                              rtc::ArrayView<const float> emr_transparent,
+                              rtc::ArrayView<float> gain);
+
+void MinGainForEchoPower_AVX2(float min_echo_power,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<float> min_gain);
+
+void ApplyGainBounds_AVX2(rtc::ArrayView<const float> G,
+                          rtc::ArrayView<const float> min_gain,
+                          rtc::ArrayView<const float> max_gain,
+                          rtc::ArrayView<float> gain);
+#endif
+
+}  // namespace aec3
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_AUDIBLE_ECHO_GAIN_H_
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/aec3/audible_echo_gain.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// The operand order of the min and max instructions below is chosen to match
+// std::min and std::max, which return their first argument on ties.
+void GainToNoAudibleEcho_AVX2(rtc::ArrayView<const float> nearend,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<const float> masker,
+                              rtc::ArrayView<const float> enr_transparent,
+                              rtc::ArrayView<const float> enr_suppress,
+                              rtc::ArrayView<const float> emr_transparent,
+                              rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, gain.size());
+  const __m256 one = _mm256_set1_ps(1.f);
+  for (size_t k = 0; k < kFftLengthBy2; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&echo[k]);
+    const __m256 enr =
+        _mm256_div_ps(echo_k, _mm256_add_ps(_mm256_loadu_ps(&nearend[k]), one));
+    const __m256 emr =
+        _mm256_div_ps(echo_k, _mm256_add_ps(_mm256_loadu_ps(&masker[k]), one));
+    const __m256 enr_transparent_k = _mm256_loadu_ps(&enr_transparent[k]);
+    const __m256 enr_suppress_k = _mm256_loadu_ps(&enr_suppress[k]);
+    const __m256 emr_transparent_k = _mm256_loadu_ps(&emr_transparent[k]);
+    const __m256 suppress =
+        _mm256_and_ps(_mm256_cmp_ps(enr, enr_transparent_k, _CMP_GT_OQ),
+                      _mm256_cmp_ps(emr, emr_transparent_k, _CMP_GT_OQ));
+    __m256 g = _mm256_div_ps(_mm256_sub_ps(enr_suppress_k, enr),
+                             _mm256_sub_ps(enr_suppress_k, enr_transparent_k));
+    g = _mm256_max_ps(_mm256_div_ps(emr_transparent_k, emr), g);
+    _mm256_storeu_ps(&gain[k], _mm256_blendv_ps(one, g, suppress));
+  }
+  GainToNoAudibleEcho(nearend.subview(kFftLengthBy2),
+                      echo.subview(kFftLengthBy2),
+                      masker.subview(kFftLengthBy2),
+                      enr_transparent.subview(kFftLengthBy2),
+                      enr_suppress.subview(kFftLengthBy2),
+                      emr_transparent.subview(kFftLengthBy2),
+                      gain.subview(kFftLengthBy2));
+}
+
+void MinGainForEchoPower_AVX2(float min_echo_power,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<float> min_gain) {
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, min_gain.size());
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 min_echo_power_v = _mm256_set1_ps(min_echo_power);
+  for (size_t k = 0; k < kFftLengthBy2; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&echo[k]);
+    const __m256 nonzero = _mm256_cmp_ps(echo_k, zero, _CMP_GT_OQ);
+    const __m256 g = _mm256_blendv_ps(
+        one, _mm256_div_ps(min_echo_power_v, echo_k), nonzero);
+    _mm256_storeu_ps(&min_gain[k], _mm256_min_ps(one, g));
+  }
+  MinGainForEchoPower(min_echo_power, echo.subview(kFftLengthBy2),
+                      min_gain.subview(kFftLengthBy2));
+}
+
+void ApplyGainBounds_AVX2(rtc::ArrayView<const float> G,
+                          rtc::ArrayView<const float> min_gain,
+                          rtc::ArrayView<const float> max_gain,
+                          rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, gain.size());
+  for (size_t k = 0; k < kFftLengthBy2; k += 8) {
+    __m256 G_k =
+        _mm256_min_ps(_mm256_loadu_ps(&max_gain[k]), _mm256_loadu_ps(&G[k]));
+    G_k = _mm256_max_ps(_mm256_loadu_ps(&min_gain[k]), G_k);
+    _mm256_storeu_ps(&gain[k], _mm256_min_ps(G_k, _mm256_loadu_ps(&gain[k])));
+  }
+  ApplyGainBounds(G.subview(kFftLengthBy2), min_gain.subview(kFftLengthBy2),
+                  max_gain.subview(kFftLengthBy2), gain.subview(kFftLengthBy2));
+}
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -20,64 +20,48 @@ namespace webrtc {
 BlockFramer::BlockFramer(size_t num_bands, size_t num_channels)
     : num_bands_(num_bands),
       num_channels_(num_channels),
-      buffer_(num_bands_,
-              std::vector<std::vector<float>>(
-                  num_channels,
-                  std::vector<float>(kBlockSize, 0.f))) {
+      buffer_(num_bands_ * num_channels_ * kBufferSize, 0.f) {
   RTC_DCHECK_LT(0, num_bands);
   RTC_DCHECK_LT(0, num_channels);
 }
 
 BlockFramer::~BlockFramer() = default;
 
-// All the constants are chosen so that the buffer is either empty or has enough
-// samples for InsertBlockAndExtractSubFrame to produce a frame. In order to
-// achieve this, the InsertBlockAndExtractSubFrame and InsertBlock methods need
-// to be called in the correct order.
+// The buffer initially holds one block of zeros. Together with the
+// FrameBlocker never holding back more than one block, this ensures that
+// ExtractSubFrame always has enough samples to produce a subframe once all
+// blocks available for a subframe have been inserted.
 void BlockFramer::InsertBlock(const Block& block) {
   RTC_DCHECK_EQ(num_bands_, block.NumBands());
   RTC_DCHECK_EQ(num_channels_, block.NumChannels());
+  RTC_DCHECK_GE(kBufferSize, num_buffered_samples_ + kBlockSize);
   for (size_t band = 0; band < num_bands_; ++band) {
     for (size_t channel = 0; channel < num_channels_; ++channel) {
-      RTC_DCHECK_EQ(0, buffer_[band][channel].size());
-
-      buffer_[band][channel].insert(buffer_[band][channel].begin(),
-                                    block.begin(band, channel),
-                                    block.end(band, channel));
+      std::copy(block.begin(band, channel), block.end(band, channel),
+                &buffer_[GetIndex(band, channel) + num_buffered_samples_]);
     }
   }
+  num_buffered_samples_ += kBlockSize;
 }
 
-void BlockFramer::InsertBlockAndExtractSubFrame(
-    const Block& block,
+void BlockFramer::ExtractSubFrame(
     std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame) {
   RTC_DCHECK(sub_frame);
-  RTC_DCHECK_EQ(num_bands_, block.NumBands());
-  RTC_DCHECK_EQ(num_channels_, block.NumChannels());
   RTC_DCHECK_EQ(num_bands_, sub_frame->size());
+  RTC_DCHECK_LE(kSubFrameLength, num_buffered_samples_);
+  const size_t num_remaining_samples = num_buffered_samples_ - kSubFrameLength;
   for (size_t band = 0; band < num_bands_; ++band) {
-    RTC_DCHECK_EQ(num_channels_, (*sub_frame)[0].size());
+    RTC_DCHECK_EQ(num_channels_, (*sub_frame)[band].size());
     for (size_t channel = 0; channel < num_channels_; ++channel) {
-      RTC_DCHECK_LE(kSubFrameLength,
-                    buffer_[band][channel].size() + kBlockSize);
-      RTC_DCHECK_GE(kBlockSize, buffer_[band][channel].size());
       RTC_DCHECK_EQ(kSubFrameLength, (*sub_frame)[band][channel].size());
-
-      const int samples_to_frame =
-          kSubFrameLength - buffer_[band][channel].size();
-      std::copy(buffer_[band][channel].begin(), buffer_[band][channel].end(),
+      float* buffer = &buffer_[GetIndex(band, channel)];
+      std::copy(buffer, buffer + kSubFrameLength,
                 (*sub_frame)[band][channel].begin());
-      std::copy(
-          block.begin(band, channel),
-          block.begin(band, channel) + samples_to_frame,
-          (*sub_frame)[band][channel].begin() + buffer_[band][channel].size());
-      buffer_[band][channel].clear();
-      buffer_[band][channel].insert(
-          buffer_[band][channel].begin(),
-          block.begin(band, channel) + samples_to_frame,
-          block.end(band, channel));
+      std::copy(buffer + kSubFrameLength,
+                buffer + kSubFrameLength + num_remaining_samples, buffer);
     }
   }
+  num_buffered_samples_ = num_remaining_samples;
 }
 
 }  // namespace webrtc
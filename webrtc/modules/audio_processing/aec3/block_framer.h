@@ -20,11 +20,11 @@
 namespace webrtc {
 
 // Class for producing frames consisting of 2 subframes of 80 samples each
-// from 64 sample blocks. The class is designed to work together with the
-// FrameBlocker class which performs the reverse conversion. Used together with
-// that, this class produces output frames are the same rate as frames are
-// received by the FrameBlocker class. Note that the internal buffers will
-// overrun if any other rate of packets insertion is used.
+// from kBlockSize sample blocks. The class is designed to work together with
+// the FrameBlocker class which performs the reverse conversion. Used together
+// with that, this class produces output frames are the same rate as frames are
+// received by the FrameBlocker class, delayed by one block. Note that the
+// internal buffers will overrun if any other rate of packets insertion is used.
 class BlockFramer {
  public:
   BlockFramer(size_t num_bands, size_t num_channels);
@@ -32,17 +32,30 @@ class BlockFramer {
   BlockFramer(const BlockFramer&) = delete;
   BlockFramer& operator=(const BlockFramer&) = delete;
 
-  // Adds a 64 sample block into the data that will form the next output frame.
+  // Adds a kBlockSize sample block into the data that will form the next
+  // output subframes.
   void InsertBlock(const Block& block);
-  // Adds a 64 sample block and extracts an 80 sample subframe.
-  void InsertBlockAndExtractSubFrame(
-      const Block& block,
+  // Extracts an 80 sample subframe.
+  void ExtractSubFrame(
       std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame);
 
  private:
+  // Maximum number of samples buffered per band and channel.
+  static constexpr size_t kBufferSize = kBlockSize + kSubFrameLength;
+
+  // Returns the index of the first buffered sample of the requested |band| and
+  // |channel|.
+  size_t GetIndex(size_t band, size_t channel) const {
+    return (band * num_channels_ + channel) * kBufferSize;
+  }
+
   const size_t num_bands_;
   const size_t num_channels_;
-  std::vector<std::vector<std::vector<float>>> buffer_;
+  // Samples not yet extracted into a subframe, for all bands and channels,
+  // stored in one flat allocation. All bands and channels always hold the same
+  // number of samples.
+  std::vector<float> buffer_;
+  size_t num_buffered_samples_ = kBlockSize;
 };
 }  // namespace webrtc
 
@@ -35,6 +35,11 @@ namespace {
 
 enum class BlockProcessorApiCall { kCapture, kRender };
 
+// Number of blocks without render buffer underruns or overruns that are
+// required before any warm-start state is applied. This avoids the imported
+// delay being discarded by the buffer adjustments at the start of a call.
+constexpr size_t kWarmStartSettlingBlocks = 10;
+
 class BlockProcessorImpl final : public BlockProcessor {
  public:
   BlockProcessorImpl(const EchoCanceller3Config& config,
@@ -63,12 +68,17 @@ class BlockProcessorImpl final : public BlockProcessor {
   void SetAudioBufferDelay(int delay_ms) override;
   void SetCaptureOutputUsage(bool capture_output_used) override;
 
+  void GetWarmStartState(Aec3WarmStartState* state) const override;
+  void SetWarmStartState(const Aec3WarmStartState& state) override;
+
  private:
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const EchoCanceller3Config config_;
   bool capture_properly_started_ = false;
   bool render_properly_started_ = false;
+  bool capture_output_used_ = true;
+  bool buffer_flushed_while_output_unused_ = false;
   const size_t sample_rate_hz_;
   std::unique_ptr<RenderDelayBuffer> render_buffer_;
   std::unique_ptr<RenderDelayController> delay_controller_;
@@ -77,6 +87,8 @@ class BlockProcessorImpl final : public BlockProcessor {
   RenderDelayBuffer::BufferingEvent render_event_;
   size_t capture_call_counter_ = 0;
   std::optional<DelayEstimate> estimated_delay_;
+  std::optional<Aec3WarmStartState> pending_warm_start_state_;
+  size_t blocks_since_buffering_event_ = 0;
 };
 
 std::atomic<int> BlockProcessorImpl::instance_count_(0);
@@ -155,18 +167,69 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
       delay_controller_->Reset(false);
   }
 
+  if (buffer_event == RenderDelayBuffer::BufferingEvent::kRenderUnderrun ||
+      echo_path_variability.delay_change !=
+          EchoPathVariability::DelayAdjustment::kNone) {
+    blocks_since_buffering_event_ = 0;
+  } else {
+    ++blocks_since_buffering_event_;
+  }
+
+  // While the capture output is unused, only keep the render buffering in step
+  // with the capture calls. The delay estimation and the echo removal are
+  // resumed from their previous state once the output is used again, and are
+  // then notified of any buffer flush that happened in the meantime.
+  if (!capture_output_used_) {
+    buffer_flushed_while_output_unused_ =
+        buffer_flushed_while_output_unused_ ||
+        echo_path_variability.delay_change !=
+            EchoPathVariability::DelayAdjustment::kNone;
+    metrics_.UpdateCapture(false);
+    return;
+  }
+  if (buffer_flushed_while_output_unused_) {
+    echo_path_variability.delay_change =
+        EchoPathVariability::DelayAdjustment::kBufferFlush;
+    buffer_flushed_while_output_unused_ = false;
+  }
+
   data_dumper_->DumpWav("aec3_processblock_capture_input2",
                         capture_block->View(/*band=*/0, /*channel=*/0), 16000,
                         1);
 
   bool has_delay_estimator = !config_.delay.use_external_delay_estimator;
+
+  // Apply any pending warm-start state once the buffering has settled. The
+  // delay is aligned directly, rather than via the delay controller output, so
+  // that it is not treated as a delay change that would reset the imported
+  // state.
+  if (pending_warm_start_state_ &&
+      blocks_since_buffering_event_ >= kWarmStartSettlingBlocks) {
+    if (has_delay_estimator && pending_warm_start_state_->delay_blocks) {
+      const size_t delay_blocks = *pending_warm_start_state_->delay_blocks;
+      delay_controller_->SetDelay(delay_blocks);
+      render_buffer_->AlignFromDelay(delay_blocks);
+    }
+    echo_remover_->SetWarmStartState(*pending_warm_start_state_);
+    pending_warm_start_state_ = std::nullopt;
+  }
+
+  // While all the buffered render data is silent, the render signal carries no
+  // information about the delay and the delay estimate is kept unchanged.
+  const bool skip_delay_estimation =
+      config_.echo_removal_control
+          .skip_linear_processing_during_render_silence &&
+      render_buffer_->GetRenderBuffer()->GetRenderSilence();
+
   if (has_delay_estimator) {
     RTC_DCHECK(delay_controller_);
     // Compute and apply the render delay required to achieve proper signal
     // alignment.
-    estimated_delay_ = delay_controller_->GetDelay(
-        render_buffer_->GetDownsampledRenderBuffer(), render_buffer_->Delay(),
-        *capture_block);
+    if (!skip_delay_estimation) {
+      estimated_delay_ = delay_controller_->GetDelay(
+          render_buffer_->GetDownsampledRenderBuffer(),
+          render_buffer_->Delay(), *capture_block);
+    }
 
     if (estimated_delay_) {
       bool delay_change =
@@ -222,7 +285,7 @@ void BlockProcessorImpl::UpdateEchoLeakageStatus(bool leakage_detected) {
 
 void BlockProcessorImpl::GetMetrics(EchoControl::Metrics* metrics) const {
   echo_remover_->GetMetrics(metrics);
-  constexpr int block_size_ms = 4;
+  constexpr int block_size_ms = 1000 / kNumBlocksPerSecond;
   std::optional<size_t> delay = render_buffer_->Delay();
   metrics->delay_ms = delay ? static_cast<int>(*delay) * block_size_ms : 0;
 }
@@ -232,9 +295,22 @@ void BlockProcessorImpl::SetAudioBufferDelay(int delay_ms) {
 }
 
 void BlockProcessorImpl::SetCaptureOutputUsage(bool capture_output_used) {
+  capture_output_used_ = capture_output_used;
   echo_remover_->SetCaptureOutputUsage(capture_output_used);
 }
 
+void BlockProcessorImpl::GetWarmStartState(Aec3WarmStartState* state) const {
+  RTC_DCHECK(state);
+  state->delay_blocks =
+      estimated_delay_ ? std::optional<size_t>(estimated_delay_->delay)
+                       : std::nullopt;
+  echo_remover_->GetWarmStartState(state);
+}
+
+void BlockProcessorImpl::SetWarmStartState(const Aec3WarmStartState& state) {
+  pending_warm_start_state_ = state;
+}
+
 }  // namespace
 
 BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
@@ -22,10 +22,12 @@
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
-// Class for performing echo cancellation on 64 sample blocks of audio data.
+// Class for performing echo cancellation on blocks of kBlockSize samples of
+// audio data.
 class BlockProcessor {
  public:
   static BlockProcessor* Create(const EchoCanceller3Config& config,
@@ -74,6 +76,14 @@ class BlockProcessor {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Copies the converged echo path state into `state`.
+  virtual void GetWarmStartState(Aec3WarmStartState* state) const = 0;
+
+  // Initializes the echo path state from a state exported during a previous
+  // call over the same echo path. The state is applied at the next capture
+  // block that is processed.
+  virtual void SetWarmStartState(const Aec3WarmStartState& state) = 0;
 };
 
 }  // namespace webrtc
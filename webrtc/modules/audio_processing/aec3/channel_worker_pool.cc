@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ChannelWorkerPool::ChannelWorkerPool(int num_worker_threads) {
+  RTC_DCHECK_LE(0, num_worker_threads);
+  workers_.reserve(num_worker_threads);
+  for (int k = 0; k < num_worker_threads; ++k) {
+    workers_.push_back(std::make_unique<Worker>());
+    Worker* worker = workers_.back().get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker] { RunWorker(worker); }, "Aec3ChannelWorker",
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+  }
+}
+
+ChannelWorkerPool::~ChannelWorkerPool() {
+  stop_.store(true, std::memory_order_relaxed);
+  for (auto& worker : workers_) {
+    worker->start.Set();
+    worker->thread.Finalize();
+  }
+}
+
+void ChannelWorkerPool::ParallelFor(
+    size_t num_channels,
+    rtc::FunctionView<void(size_t)> process_channel) {
+  // Only wake up as many workers as there are channels left for them after the
+  // calling thread has claimed its first channel.
+  const int num_workers_to_start = static_cast<int>(
+      std::min(workers_.size(), num_channels > 0 ? num_channels - 1 : 0));
+
+  num_channels_ = num_channels;
+  process_channel_ = &process_channel;
+  next_channel_.store(0, std::memory_order_relaxed);
+  num_active_workers_.store(num_workers_to_start, std::memory_order_relaxed);
+  for (int k = 0; k < num_workers_to_start; ++k) {
+    workers_[k]->start.Set();
+  }
+
+  ProcessChannels();
+
+  if (num_workers_to_start > 0) {
+    done_.Wait(rtc::Event::kForever, rtc::Event::kForever);
+  }
+  process_channel_ = nullptr;
+}
+
+void ChannelWorkerPool::RunWorker(Worker* worker) {
+  while (true) {
+    worker->start.Wait(rtc::Event::kForever, rtc::Event::kForever);
+    if (stop_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    ProcessChannels();
+    if (num_active_workers_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      done_.Set();
+    }
+  }
+}
+
+void ChannelWorkerPool::ProcessChannels() {
+  for (size_t ch = next_channel_.fetch_add(1, std::memory_order_relaxed);
+       ch < num_channels_;
+       ch = next_channel_.fetch_add(1, std::memory_order_relaxed)) {
+    (*process_channel_)(ch);
+  }
+}
+
+}  // namespace webrtc
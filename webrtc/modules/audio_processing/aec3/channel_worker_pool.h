@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_CHANNEL_WORKER_POOL_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_CHANNEL_WORKER_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+// Small pool of worker threads for processing the capture channels of one
+// AEC3 instance in parallel. The calling thread takes part in the work and
+// the channels are claimed one at a time from a shared counter, so that
+// threads that finish early pick up the remaining channels. ParallelFor()
+// does not return until all channels have been processed, which gives a
+// deterministic join point. As each channel only touches its own state, the
+// output is identical to that of serial processing.
+class ChannelWorkerPool {
+ public:
+  // Creates a pool with `num_worker_threads` threads in addition to the
+  // calling thread.
+  explicit ChannelWorkerPool(int num_worker_threads);
+  ~ChannelWorkerPool();
+  ChannelWorkerPool(const ChannelWorkerPool&) = delete;
+  ChannelWorkerPool& operator=(const ChannelWorkerPool&) = delete;
+
+  // Calls `process_channel(ch)` once for each ch in [0, num_channels) and
+  // returns when all the calls have completed.
+  void ParallelFor(size_t num_channels,
+                   rtc::FunctionView<void(size_t)> process_channel);
+
+ private:
+  struct Worker {
+    rtc::Event start;
+    rtc::PlatformThread thread;
+  };
+
+  void RunWorker(Worker* worker);
+  void ProcessChannels();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  rtc::Event done_;
+  std::atomic<bool> stop_{false};
+  std::atomic<size_t> next_channel_{0};
+  std::atomic<int> num_active_workers_{0};
+  size_t num_channels_ = 0;
+  rtc::FunctionView<void(size_t)>* process_channel_ = nullptr;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_CHANNEL_WORKER_POOL_H_
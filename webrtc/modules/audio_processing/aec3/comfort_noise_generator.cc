@@ -13,7 +13,7 @@
 // Defines WEBRTC_ARCH_X86_FAMILY, used below.
 #include "rtc_base/system/arch.h"
 
-#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
 #include <emmintrin.h>
 #endif
 #include <algorithm>
@@ -21,35 +21,15 @@
 #include <cmath>
 #include <cstdint>
 #include <functional>
-#include <numeric>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
-#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-namespace {
-
-// Computes the noise floor value that matches a WGN input of noise_floor_dbfs.
-float GetNoiseFloorFactor(float noise_floor_dbfs) {
-  // kdBfsNormalization = 20.f*log10(32768.f).
-  constexpr float kdBfsNormalization = 90.30899869919436f;
-  return 64.f * powf(10.f, (kdBfsNormalization + noise_floor_dbfs) * 0.1f);
-}
-
-// Table of sqrt(2) * sin(2*pi*i/32).
-constexpr float kSqrt2Sin[32] = {
-    +0.0000000f, +0.2758994f, +0.5411961f, +0.7856950f, +1.0000000f,
-    +1.1758756f, +1.3065630f, +1.3870398f, +1.4142136f, +1.3870398f,
-    +1.3065630f, +1.1758756f, +1.0000000f, +0.7856950f, +0.5411961f,
-    +0.2758994f, +0.0000000f, -0.2758994f, -0.5411961f, -0.7856950f,
-    -1.0000000f, -1.1758756f, -1.3065630f, -1.3870398f, -1.4142136f,
-    -1.3870398f, -1.3065630f, -1.1758756f, -1.0000000f, -0.7856950f,
-    -0.5411961f, -0.2758994f};
+namespace aec3 {
 
-void GenerateComfortNoise(Aec3Optimization optimization,
-                          const std::array<float, kFftLengthBy2Plus1>& N2,
+void EstimateComfortNoise(const std::array<float, kFftLengthBy2Plus1>& N2,
                           uint32_t* seed,
                           FftData* lower_band_noise,
                           FftData* upper_band_noise) {
@@ -58,15 +38,11 @@ void GenerateComfortNoise(Aec3Optimization optimization,
 
   // Compute square root spectrum.
   std::array<float, kFftLengthBy2Plus1> N;
-  std::copy(N2.begin(), N2.end(), N.begin());
-  aec3::VectorMath(optimization).Sqrt(N);
+  std::transform(N2.begin(), N2.end(), N.begin(),
+                 [](float a) { return sqrtf(a); });
 
   // Compute the noise level for the upper bands.
-  constexpr float kOneByNumBands = 1.f / (kFftLengthBy2Plus1 / 2 + 1);
-  constexpr int kFftLengthBy2Plus1By2 = kFftLengthBy2Plus1 / 2;
-  const float high_band_noise_level =
-      std::accumulate(N.begin() + kFftLengthBy2Plus1By2, N.end(), 0.f) *
-      kOneByNumBands;
+  const float high_band_noise_level = HighBandNoiseLevel(N);
 
   // The analysis and synthesis windowing cause loss of power when
   // cross-fading the noise where frames are completely uncorrelated
@@ -78,7 +54,7 @@ void GenerateComfortNoise(Aec3Optimization optimization,
   for (size_t k = 1; k < kFftLengthBy2; k++) {
     constexpr int kIndexMask = 32 - 1;
     // Generate a random 31-bit integer.
-    seed[0] = (seed[0] * 69069 + 1) & (0x80000000 - 1);
+    seed[0] = (seed[0] * kNoiseSeedMultiplier + 1) & kNoiseSeedMask;
     // Convert to a 5-bit index.
     int i = seed[0] >> 26;
 
@@ -97,6 +73,128 @@ void GenerateComfortNoise(Aec3Optimization optimization,
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+namespace {
+
+// Multiplies the 32-bit lanes of a and b, keeping the lower 32 bits of the
+// products.
+__m128i MultiplyLo32(__m128i a, __m128i b) {
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd =
+      _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+}  // namespace
+
+void EstimateComfortNoise_SSE2(const std::array<float, kFftLengthBy2Plus1>& N2,
+                               uint32_t* seed,
+                               FftData* lower_band_noise,
+                               FftData* upper_band_noise) {
+  FftData* N_low = lower_band_noise;
+  FftData* N_high = upper_band_noise;
+
+  // Compute square root spectrum.
+  std::array<float, kFftLengthBy2Plus1> N;
+  for (size_t k = 0; k < kFftLengthBy2; k += 4) {
+    _mm_storeu_ps(&N[k], _mm_sqrt_ps(_mm_loadu_ps(&N2[k])));
+  }
+  N[kFftLengthBy2] = sqrtf(N2[kFftLengthBy2]);
+
+  // Compute the noise level for the upper bands.
+  const float high_band_noise_level = HighBandNoiseLevel(N);
+  const __m128 high_band_noise_level_v = _mm_set1_ps(high_band_noise_level);
+
+  N_low->re[0] = N_low->re[kFftLengthBy2] = N_high->re[0] =
+      N_high->re[kFftLengthBy2] = 0.f;
+
+  // Seed the lanes with four consecutive random numbers and advance all of
+  // them by four generator steps at a time.
+  alignas(16) uint32_t seeds[4];
+  uint32_t s = seed[0];
+  for (auto& seed_l : seeds) {
+    s = (s * kNoiseSeedMultiplier + 1) & kNoiseSeedMask;
+    seed_l = s;
+  }
+  __m128i seeds_v = _mm_load_si128(reinterpret_cast<const __m128i*>(seeds));
+  const __m128i multiplier = _mm_set1_epi32(NoiseSeedMultiplier(4));
+  const __m128i increment = _mm_set1_epi32(NoiseSeedIncrement(4));
+  const __m128i mask = _mm_set1_epi32(kNoiseSeedMask);
+
+  size_t k = 1;
+  for (; k + 4 <= kFftLengthBy2; k += 4) {
+    alignas(16) int32_t i[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(i),
+                    _mm_srli_epi32(seeds_v, 26));
+    const __m128 x = _mm_set_ps(kSqrt2Sin[i[3]], kSqrt2Sin[i[2]],
+                                kSqrt2Sin[i[1]], kSqrt2Sin[i[0]]);
+    const __m128 y =
+        _mm_set_ps(kSqrt2Sin[(i[3] + 8) & 31], kSqrt2Sin[(i[2] + 8) & 31],
+                   kSqrt2Sin[(i[1] + 8) & 31], kSqrt2Sin[(i[0] + 8) & 31]);
+
+    const __m128 N_k = _mm_loadu_ps(&N[k]);
+    _mm_storeu_ps(&N_low->re[k], _mm_mul_ps(N_k, x));
+    _mm_storeu_ps(&N_low->im[k], _mm_mul_ps(N_k, y));
+    _mm_storeu_ps(&N_high->re[k], _mm_mul_ps(high_band_noise_level_v, x));
+    _mm_storeu_ps(&N_high->im[k], _mm_mul_ps(high_band_noise_level_v, y));
+
+    seeds_v = _mm_and_si128(
+        _mm_add_epi32(MultiplyLo32(seeds_v, multiplier), increment), mask);
+  }
+
+  // The remaining bins use the leading lanes of the seed vector.
+  _mm_store_si128(reinterpret_cast<__m128i*>(seeds), seeds_v);
+  size_t j = 0;
+  for (; k < kFftLengthBy2; ++k, ++j) {
+    const int i = seeds[j] >> 26;
+    const float x = kSqrt2Sin[i];
+    const float y = kSqrt2Sin[(i + 8) & 31];
+    N_low->re[k] = N[k] * x;
+    N_low->im[k] = N[k] * y;
+    N_high->re[k] = high_band_noise_level * x;
+    N_high->im[k] = high_band_noise_level * y;
+  }
+  RTC_DCHECK_LT(0, j);
+  seed[0] = seeds[j - 1];
+}
+#endif
+
+}  // namespace aec3
+
+namespace {
+
+// Computes the noise floor value that matches a WGN input of noise_floor_dbfs.
+float GetNoiseFloorFactor(float noise_floor_dbfs) {
+  // kdBfsNormalization = 20.f*log10(32768.f).
+  constexpr float kdBfsNormalization = 90.30899869919436f;
+  return kFftLengthBy2 *
+         powf(10.f, (kdBfsNormalization + noise_floor_dbfs) * 0.1f);
+}
+
+void GenerateComfortNoise(Aec3Optimization optimization,
+                          const std::array<float, kFftLengthBy2Plus1>& N2,
+                          uint32_t* seed,
+                          FftData* lower_band_noise,
+                          FftData* upper_band_noise) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+      aec3::EstimateComfortNoise_SSE2(N2, seed, lower_band_noise,
+                                      upper_band_noise);
+      break;
+#endif
+    case Aec3Optimization::kAvx2:
+      aec3::EstimateComfortNoise_AVX2(N2, seed, lower_band_noise,
+                                      upper_band_noise);
+      break;
+#endif
+    default:
+      aec3::EstimateComfortNoise(N2, seed, lower_band_noise, upper_band_noise);
+  }
+}
+
 }  // namespace
 
 ComfortNoiseGenerator::ComfortNoiseGenerator(const EchoCanceller3Config& config,
@@ -15,20 +15,74 @@
 
 #include <array>
 #include <memory>
+#include <numeric>
+#include <vector>
 
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
-#include "modules/audio_processing/aec3/aec_state.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
 namespace aec3 {
-#if defined(WEBRTC_ARCH_X86_FAMILY)
 
+// Table of sqrt(2) * sin(2*pi*i/32), used for looking up the random phases of
+// the comfort noise.
+constexpr float kSqrt2Sin[32] = {
+    +0.0000000f, +0.2758994f, +0.5411961f, +0.7856950f, +1.0000000f,
+    +1.1758756f, +1.3065630f, +1.3870398f, +1.4142136f, +1.3870398f,
+    +1.3065630f, +1.1758756f, +1.0000000f, +0.7856950f, +0.5411961f,
+    +0.2758994f, +0.0000000f, -0.2758994f, -0.5411961f, -0.7856950f,
+    -1.0000000f, -1.1758756f, -1.3065630f, -1.3870398f, -1.4142136f,
+    -1.3870398f, -1.3065630f, -1.1758756f, -1.0000000f, -0.7856950f,
+    -0.5411961f, -0.2758994f};
+
+// Linear congruential generator used for producing the random phases. Each
+// step maps the 31-bit seed s to (s * kNoiseSeedMultiplier + 1) mod 2^31.
+constexpr uint32_t kNoiseSeedMultiplier = 69069;
+constexpr uint32_t kNoiseSeedMask = 0x80000000 - 1;
+
+// Returns the multiplier and increment that advance the generator by
+// `num_steps` steps at once, allowing several consecutive seeds to be produced
+// in parallel.
+constexpr uint32_t NoiseSeedMultiplier(int num_steps) {
+  uint32_t multiplier = 1;
+  for (int k = 0; k < num_steps; ++k) {
+    multiplier *= kNoiseSeedMultiplier;
+  }
+  return multiplier;
+}
+constexpr uint32_t NoiseSeedIncrement(int num_steps) {
+  uint32_t increment = 0;
+  for (int k = 0; k < num_steps; ++k) {
+    increment = increment * kNoiseSeedMultiplier + 1;
+  }
+  return increment;
+}
+
+// Computes the noise level for the upper bands from the square root spectrum
+// N.
+inline float HighBandNoiseLevel(
+    const std::array<float, kFftLengthBy2Plus1>& N) {
+  constexpr float kOneByNumBands = 1.f / (kFftLengthBy2Plus1 / 2 + 1);
+  constexpr int kFftLengthBy2Plus1By2 = kFftLengthBy2Plus1 / 2;
+  return std::accumulate(N.begin() + kFftLengthBy2Plus1By2, N.end(), 0.f) *
+         kOneByNumBands;
+}
+
+// Generates the lower and upper band comfort noise from the noise power
+// spectrum N2 using random phases.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
 void EstimateComfortNoise_SSE2(const std::array<float, kFftLengthBy2Plus1>& N2,
                                uint32_t* seed,
                                FftData* lower_band_noise,
                                FftData* upper_band_noise);
+
+void EstimateComfortNoise_AVX2(const std::array<float, kFftLengthBy2Plus1>& N2,
+                               uint32_t* seed,
+                               FftData* lower_band_noise,
+                               FftData* upper_band_noise);
 #endif
 void EstimateComfortNoise(const std::array<float, kFftLengthBy2Plus1>& N2,
                           uint32_t* seed,
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "modules/audio_processing/aec3/comfort_noise_generator.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// Generates the lower and upper band comfort noise from the noise power
+// spectrum N2, producing eight random phases at a time.
+void EstimateComfortNoise_AVX2(const std::array<float, kFftLengthBy2Plus1>& N2,
+                               uint32_t* seed,
+                               FftData* lower_band_noise,
+                               FftData* upper_band_noise) {
+  FftData* N_low = lower_band_noise;
+  FftData* N_high = upper_band_noise;
+
+  // Compute square root spectrum.
+  std::array<float, kFftLengthBy2Plus1> N;
+  for (size_t k = 0; k < kFftLengthBy2; k += 8) {
+    _mm256_storeu_ps(&N[k], _mm256_sqrt_ps(_mm256_loadu_ps(&N2[k])));
+  }
+  N[kFftLengthBy2] = sqrtf(N2[kFftLengthBy2]);
+
+  // Compute the noise level for the upper bands.
+  const float high_band_noise_level = HighBandNoiseLevel(N);
+  const __m256 high_band_noise_level_v = _mm256_set1_ps(high_band_noise_level);
+
+  N_low->re[0] = N_low->re[kFftLengthBy2] = N_high->re[0] =
+      N_high->re[kFftLengthBy2] = 0.f;
+
+  // Seed the lanes with eight consecutive random numbers and advance all of
+  // them by eight generator steps at a time.
+  alignas(32) uint32_t seeds[8];
+  uint32_t s = seed[0];
+  for (auto& seed_l : seeds) {
+    s = (s * kNoiseSeedMultiplier + 1) & kNoiseSeedMask;
+    seed_l = s;
+  }
+  __m256i seeds_v = _mm256_load_si256(reinterpret_cast<const __m256i*>(seeds));
+  const __m256i multiplier = _mm256_set1_epi32(NoiseSeedMultiplier(8));
+  const __m256i increment = _mm256_set1_epi32(NoiseSeedIncrement(8));
+  const __m256i mask = _mm256_set1_epi32(kNoiseSeedMask);
+  const __m256i quarter_turn = _mm256_set1_epi32(8);
+  const __m256i index_mask = _mm256_set1_epi32(31);
+
+  size_t k = 1;
+  for (; k + 8 <= kFftLengthBy2; k += 8) {
+    // Look up sqrt(2) * sin(a) and sqrt(2) * cos(a) = sqrt(2) * sin(a + pi/2).
+    const __m256i i = _mm256_srli_epi32(seeds_v, 26);
+    const __m256 x = _mm256_i32gather_ps(kSqrt2Sin, i, 4);
+    const __m256 y = _mm256_i32gather_ps(
+        kSqrt2Sin,
+        _mm256_and_si256(_mm256_add_epi32(i, quarter_turn), index_mask), 4);
+
+    const __m256 N_k = _mm256_loadu_ps(&N[k]);
+    _mm256_storeu_ps(&N_low->re[k], _mm256_mul_ps(N_k, x));
+    _mm256_storeu_ps(&N_low->im[k], _mm256_mul_ps(N_k, y));
+    _mm256_storeu_ps(&N_high->re[k], _mm256_mul_ps(high_band_noise_level_v, x));
+    _mm256_storeu_ps(&N_high->im[k], _mm256_mul_ps(high_band_noise_level_v, y));
+
+    seeds_v = _mm256_and_si256(
+        _mm256_add_epi32(_mm256_mullo_epi32(seeds_v, multiplier), increment),
+        mask);
+  }
+
+  // The remaining bins use the leading lanes of the seed vector.
+  _mm256_store_si256(reinterpret_cast<__m256i*>(seeds), seeds_v);
+  size_t j = 0;
+  for (; k < kFftLengthBy2; ++k, ++j) {
+    const int i = seeds[j] >> 26;
+    const float x = kSqrt2Sin[i];
+    const float y = kSqrt2Sin[(i + 8) & 31];
+    N_low->re[k] = N[k] * x;
+    N_low->im[k] = N[k] * y;
+    N_high->re[k] = high_band_noise_level * x;
+    N_high->im[k] = high_band_noise_level * y;
+  }
+  RTC_DCHECK_LT(0, j);
+  seed[0] = seeds[j - 1];
+}
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_COMPACT_FFT_DATA_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_COMPACT_FFT_DATA_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <array>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// Converts a single precision value to half precision (IEEE 754 binary16),
+// rounding to nearest even. Values beyond the half precision range become
+// infinite.
+inline uint16_t FloatToHalf(float x) {
+  uint32_t f;
+  memcpy(&f, &x, sizeof(f));
+  const uint16_t sign = static_cast<uint16_t>((f >> 16) & 0x8000);
+  f &= 0x7fffffff;
+  if (f >= 0x47800000) {
+    // Overflow, infinity or NaN.
+    return static_cast<uint16_t>(sign | (f > 0x7f800000 ? 0x7e00 : 0x7c00));
+  }
+  if (f < 0x38800000) {
+    // Subnormal half precision value or zero: let the float addition perform
+    // the rounding of the shifted mantissa.
+    constexpr uint32_t kDenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+    float magic;
+    memcpy(&magic, &kDenormMagic, sizeof(magic));
+    float y;
+    memcpy(&y, &f, sizeof(y));
+    y += magic;
+    memcpy(&f, &y, sizeof(f));
+    return static_cast<uint16_t>(sign | (f - kDenormMagic));
+  }
+  // Normal value: rebias the exponent and round the mantissa.
+  const uint32_t mantissa_odd = (f >> 13) & 1;
+  f += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + mantissa_odd;
+  return static_cast<uint16_t>(sign | (f >> 13));
+}
+
+// Converts a half precision (IEEE 754 binary16) value to single precision.
+inline float HalfToFloat(uint16_t h) {
+  constexpr uint32_t kShiftedExponent = 0x7c00 << 13;
+  uint32_t f = static_cast<uint32_t>(h & 0x7fff) << 13;
+  const uint32_t exponent = f & kShiftedExponent;
+  f += (127 - 15) << 23;
+  if (exponent == kShiftedExponent) {
+    // Infinity or NaN.
+    f += (128 - 16) << 23;
+  } else if (exponent == 0) {
+    // Zero or subnormal: renormalize through a float subtraction.
+    constexpr uint32_t kMagic = 113 << 23;
+    float magic;
+    memcpy(&magic, &kMagic, sizeof(magic));
+    f += 1 << 23;
+    float y;
+    memcpy(&y, &f, sizeof(y));
+    y -= magic;
+    memcpy(&f, &y, sizeof(f));
+  }
+  f |= static_cast<uint32_t>(h & 0x8000) << 16;
+  float x;
+  memcpy(&x, &f, sizeof(x));
+  return x;
+}
+
+}  // namespace aec3
+
+// Struct that holds the same data as FftData, stored with half precision in
+// order to halve the memory footprint and bandwidth of long filters.
+struct CompactFftData {
+  // Stores the data in src with half precision.
+  void Assign(const FftData& src) {
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      re[k] = aec3::FloatToHalf(src.re[k]);
+      im[k] = aec3::FloatToHalf(src.im[k]);
+    }
+  }
+
+  // Copies the data into dst with single precision.
+  void CopyTo(FftData* dst) const {
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      dst->re[k] = aec3::HalfToFloat(re[k]);
+      dst->im[k] = aec3::HalfToFloat(im[k]);
+    }
+  }
+
+  // Clears all the data.
+  void Clear() {
+    re.fill(0);
+    im.fill(0);
+  }
+
+  std::array<uint16_t, kFftLengthBy2Plus1> re;
+  std::array<uint16_t, kFftLengthBy2Plus1> im;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_COMPACT_FFT_DATA_H_
@@ -12,6 +12,8 @@
 
 #include <numeric>
 
+#include "modules/audio_processing/aec3/aec3_common.h"
+
 namespace webrtc {
 DominantNearendDetector::DominantNearendDetector(
     const EchoCanceller3Config::Suppressor::DominantNearendDetection& config,
@@ -37,8 +39,10 @@ void DominantNearendDetector::Update(
   nearend_state_ = false;
 
   auto low_frequency_energy = [](rtc::ArrayView<const float> spectrum) {
-    RTC_DCHECK_LE(16, spectrum.size());
-    return std::accumulate(spectrum.begin() + 1, spectrum.begin() + 16, 0.f);
+    constexpr size_t kLastBin = kFftLengthBy2 / 4;
+    RTC_DCHECK_LE(kLastBin, spectrum.size());
+    return std::accumulate(spectrum.begin() + 1, spectrum.begin() + kLastBin,
+                           0.f);
   };
 
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
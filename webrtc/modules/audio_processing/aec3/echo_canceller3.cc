@@ -97,12 +97,12 @@ void FillSubFrameView(
 
 void FillSubFrameView(
     bool proper_downmix_needed,
-    std::vector<std::vector<std::vector<float>>>* frame,
+    RenderFrame* frame,
     size_t sub_frame_index,
     std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame_view) {
   RTC_DCHECK_GE(1, sub_frame_index);
-  RTC_DCHECK_EQ(frame->size(), sub_frame_view->size());
-  const size_t frame_num_channels = (*frame)[0].size();
+  RTC_DCHECK_EQ(frame->NumBands(), sub_frame_view->size());
+  const size_t frame_num_channels = frame->NumChannels();
   const size_t sub_frame_num_channels = (*sub_frame_view)[0].size();
   if (frame_num_channels > sub_frame_num_channels) {
     RTC_DCHECK_EQ(sub_frame_num_channels, 1u);
@@ -111,32 +111,33 @@ void FillSubFrameView(
       // is present in the echo reference signal but the echo canceller does the
       // processing in mono) downmix the echo reference by averaging the channel
       // content (otherwise downmixing is done by selecting channel 0).
-      for (size_t band = 0; band < frame->size(); ++band) {
+      for (int band = 0; band < frame->NumBands(); ++band) {
+        float* downmix =
+            &frame->View(band, /*channel=*/0)[sub_frame_index * kSubFrameLength];
         for (size_t ch = 1; ch < frame_num_channels; ++ch) {
+          const float* channel =
+              &frame->View(band, ch)[sub_frame_index * kSubFrameLength];
           for (size_t k = 0; k < kSubFrameLength; ++k) {
-            (*frame)[band][/*channel=*/0]
-                    [sub_frame_index * kSubFrameLength + k] +=
-                (*frame)[band][ch][sub_frame_index * kSubFrameLength + k];
+            downmix[k] += channel[k];
           }
         }
         const float one_by_num_channels = 1.0f / frame_num_channels;
         for (size_t k = 0; k < kSubFrameLength; ++k) {
-          (*frame)[band][/*channel=*/0][sub_frame_index * kSubFrameLength +
-                                        k] *= one_by_num_channels;
+          downmix[k] *= one_by_num_channels;
         }
       }
     }
-    for (size_t band = 0; band < frame->size(); ++band) {
+    for (int band = 0; band < frame->NumBands(); ++band) {
       (*sub_frame_view)[band][/*channel=*/0] = rtc::ArrayView<float>(
-          &(*frame)[band][/*channel=*/0][sub_frame_index * kSubFrameLength],
+          &frame->View(band, /*channel=*/0)[sub_frame_index * kSubFrameLength],
           kSubFrameLength);
     }
   } else {
     RTC_DCHECK_EQ(frame_num_channels, sub_frame_num_channels);
-    for (size_t band = 0; band < frame->size(); ++band) {
-      for (size_t channel = 0; channel < (*frame)[band].size(); ++channel) {
+    for (int band = 0; band < frame->NumBands(); ++band) {
+      for (int channel = 0; channel < frame->NumChannels(); ++channel) {
         (*sub_frame_view)[band][channel] = rtc::ArrayView<float>(
-            &(*frame)[band][channel][sub_frame_index * kSubFrameLength],
+            &frame->View(band, channel)[sub_frame_index * kSubFrameLength],
             kSubFrameLength);
       }
     }
@@ -169,51 +170,29 @@ void ProcessCaptureFrameContent(
                      linear_output_sub_frame_view);
   }
 
-  capture_blocker->InsertSubFrameAndExtractBlock(*capture_sub_frame_view,
-                                                 capture_block);
-  block_processor->ProcessCapture(
-      /*echo_path_gain_change=*/level_change ||
-          aec_reference_is_downmixed_stereo,
-      saturated_microphone_signal, linear_output_block, capture_block);
-  output_framer->InsertBlockAndExtractSubFrame(*capture_block,
-                                               capture_sub_frame_view);
-
-  if (linear_output) {
-    RTC_DCHECK(linear_output_framer);
-    linear_output_framer->InsertBlockAndExtractSubFrame(
-        *linear_output_block, linear_output_sub_frame_view);
-  }
-}
-
-void ProcessRemainingCaptureFrameContent(bool level_change,
-                                         bool aec_reference_is_downmixed_stereo,
-                                         bool saturated_microphone_signal,
-                                         FrameBlocker* capture_blocker,
-                                         BlockFramer* linear_output_framer,
-                                         BlockFramer* output_framer,
-                                         BlockProcessor* block_processor,
-                                         Block* linear_output_block,
-                                         Block* block) {
-  if (!capture_blocker->IsBlockAvailable()) {
-    return;
+  capture_blocker->InsertSubFrame(*capture_sub_frame_view);
+  while (capture_blocker->IsBlockAvailable()) {
+    capture_blocker->ExtractBlock(capture_block);
+    block_processor->ProcessCapture(
+        /*echo_path_gain_change=*/level_change ||
+            aec_reference_is_downmixed_stereo,
+        saturated_microphone_signal, linear_output_block, capture_block);
+    output_framer->InsertBlock(*capture_block);
+
+    if (linear_output) {
+      linear_output_framer->InsertBlock(*linear_output_block);
+    }
   }
 
-  capture_blocker->ExtractBlock(block);
-  block_processor->ProcessCapture(
-      /*echo_path_gain_change=*/level_change ||
-          aec_reference_is_downmixed_stereo,
-      saturated_microphone_signal, linear_output_block, block);
-  output_framer->InsertBlock(*block);
-
-  if (linear_output_framer) {
-    RTC_DCHECK(linear_output_block);
-    linear_output_framer->InsertBlock(*linear_output_block);
+  output_framer->ExtractSubFrame(capture_sub_frame_view);
+  if (linear_output) {
+    linear_output_framer->ExtractSubFrame(linear_output_sub_frame_view);
   }
 }
 
 void BufferRenderFrameContent(
     bool proper_downmix_needed,
-    std::vector<std::vector<std::vector<float>>>* render_frame,
+    RenderFrame* render_frame,
     size_t sub_frame_index,
     FrameBlocker* render_blocker,
     BlockProcessor* block_processor,
@@ -221,38 +200,87 @@ void BufferRenderFrameContent(
     std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame_view) {
   FillSubFrameView(proper_downmix_needed, render_frame, sub_frame_index,
                    sub_frame_view);
-  render_blocker->InsertSubFrameAndExtractBlock(*sub_frame_view, block);
-  block_processor->BufferRender(*block);
-}
-
-void BufferRemainingRenderFrameContent(FrameBlocker* render_blocker,
-                                       BlockProcessor* block_processor,
-                                       Block* block) {
-  if (!render_blocker->IsBlockAvailable()) {
-    return;
+  render_blocker->InsertSubFrame(*sub_frame_view);
+  while (render_blocker->IsBlockAvailable()) {
+    render_blocker->ExtractBlock(block);
+    block_processor->BufferRender(*block);
   }
-  render_blocker->ExtractBlock(block);
-  block_processor->BufferRender(*block);
 }
 
 void CopyBufferIntoFrame(const AudioBuffer& buffer,
                          size_t num_bands,
                          size_t num_channels,
-                         std::vector<std::vector<std::vector<float>>>* frame) {
-  RTC_DCHECK_EQ(num_bands, frame->size());
-  RTC_DCHECK_EQ(num_channels, (*frame)[0].size());
-  RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, (*frame)[0][0].size());
+                         RenderFrame* frame) {
+  RTC_DCHECK_EQ(num_bands, frame->NumBands());
+  RTC_DCHECK_EQ(num_channels, frame->NumChannels());
+  RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, kFrameSize);
   for (size_t band = 0; band < num_bands; ++band) {
     for (size_t channel = 0; channel < num_channels; ++channel) {
       rtc::ArrayView<const float> buffer_view(
           &buffer.split_bands_const(channel)[band][0],
           AudioBuffer::kSplitBandSize);
       std::copy(buffer_view.begin(), buffer_view.end(),
-                (*frame)[band][channel].begin());
+                frame->View(band, channel).begin());
     }
   }
 }
 
+// The frequency bins and the filter lengths in the config are expressed for
+// the default block size of 64 samples. Rescales them to the block size that
+// the echo canceller is built with so that they cover the same frequencies and
+// the same echo path length.
+void AdaptToBlockSize(EchoCanceller3Config* config) {
+  constexpr size_t kDefaultBlockSize = 64;
+  if (kBlockSize == kDefaultBlockSize) {
+    return;
+  }
+  auto bin = [](size_t k) {
+    return (k * kFftLengthBy2 + kDefaultBlockSize / 2) / kDefaultBlockSize;
+  };
+  auto int_bin = [&](int k) {
+    return static_cast<int>(bin(static_cast<size_t>(k)));
+  };
+  auto blocks = [](size_t num_blocks) {
+    return std::max<size_t>(
+        1, (num_blocks * kDefaultBlockSize + kBlockSize - 1) / kBlockSize);
+  };
+
+  auto& suppressor = config->suppressor;
+  suppressor.last_permanent_lf_smoothing_band =
+      int_bin(suppressor.last_permanent_lf_smoothing_band);
+  suppressor.last_lf_smoothing_band =
+      int_bin(suppressor.last_lf_smoothing_band);
+  suppressor.last_lf_band = int_bin(suppressor.last_lf_band);
+  suppressor.first_hf_band = std::max(int_bin(suppressor.first_hf_band),
+                                      suppressor.last_lf_band + 1);
+  auto& subbands = suppressor.subband_nearend_detection;
+  subbands.subband1 = {bin(subbands.subband1.low),
+                       bin(subbands.subband1.high)};
+  subbands.subband2 = {bin(subbands.subband2.low),
+                       bin(subbands.subband2.high)};
+
+  auto& filter = config->filter;
+  filter.refined.length_blocks = blocks(filter.refined.length_blocks);
+  filter.refined_initial.length_blocks =
+      blocks(filter.refined_initial.length_blocks);
+  filter.coarse.length_blocks = blocks(filter.coarse.length_blocks);
+  filter.coarse_initial.length_blocks =
+      blocks(filter.coarse_initial.length_blocks);
+  config->erle.num_sections =
+      std::min(config->erle.num_sections, filter.refined.length_blocks);
+  config->delay.default_delay = blocks(config->delay.default_delay);
+}
+
+std::optional<EchoCanceller3Config> AdaptToBlockSize(
+    const std::optional<EchoCanceller3Config>& config) {
+  if (!config) {
+    return std::nullopt;
+  }
+  EchoCanceller3Config adapted_config = *config;
+  AdaptToBlockSize(&adapted_config);
+  return adapted_config;
+}
+
 }  // namespace
 
 // TODO(webrtc:5298): Move this to a separate file.
@@ -640,6 +668,8 @@ EchoCanceller3Config AdjustConfig(const EchoCanceller3Config& config) {
       &max_allowed_excess_render_blocks_override);
   adjusted_cfg.buffering.max_allowed_excess_render_blocks =
       max_allowed_excess_render_blocks_override;
+
+  AdaptToBlockSize(&adjusted_cfg);
   return adjusted_cfg;
 }
 
@@ -647,8 +677,8 @@ class EchoCanceller3::RenderWriter {
  public:
   RenderWriter(ApmDataDumper* data_dumper,
                const EchoCanceller3Config& config,
-               SwapQueue<std::vector<std::vector<std::vector<float>>>,
-                         Aec3RenderQueueItemVerifier>* render_transfer_queue,
+               SwapQueue<RenderFrame, Aec3RenderQueueItemVerifier>*
+                   render_transfer_queue,
                size_t num_bands,
                size_t num_channels);
 
@@ -664,26 +694,20 @@ class EchoCanceller3::RenderWriter {
   const size_t num_bands_;
   const size_t num_channels_;
   std::unique_ptr<HighPassFilter> high_pass_filter_;
-  std::vector<std::vector<std::vector<float>>> render_queue_input_frame_;
-  SwapQueue<std::vector<std::vector<std::vector<float>>>,
-            Aec3RenderQueueItemVerifier>* render_transfer_queue_;
+  RenderFrame render_queue_input_frame_;
+  SwapQueue<RenderFrame, Aec3RenderQueueItemVerifier>* render_transfer_queue_;
 };
 
 EchoCanceller3::RenderWriter::RenderWriter(
     ApmDataDumper* data_dumper,
     const EchoCanceller3Config& config,
-    SwapQueue<std::vector<std::vector<std::vector<float>>>,
-              Aec3RenderQueueItemVerifier>* render_transfer_queue,
+    SwapQueue<RenderFrame, Aec3RenderQueueItemVerifier>* render_transfer_queue,
     size_t num_bands,
     size_t num_channels)
     : data_dumper_(data_dumper),
       num_bands_(num_bands),
       num_channels_(num_channels),
-      render_queue_input_frame_(
-          num_bands_,
-          std::vector<std::vector<float>>(
-              num_channels_,
-              std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
+      render_queue_input_frame_(num_bands_, num_channels_),
       render_transfer_queue_(render_transfer_queue) {
   RTC_DCHECK(data_dumper);
   if (config.filter.high_pass_filter_echo_reference) {
@@ -708,7 +732,10 @@ void EchoCanceller3::RenderWriter::Insert(const AudioBuffer& input) {
   CopyBufferIntoFrame(input, num_bands_, num_channels_,
                       &render_queue_input_frame_);
   if (high_pass_filter_) {
-    high_pass_filter_->Process(&render_queue_input_frame_[0]);
+    for (size_t channel = 0; channel < num_channels_; ++channel) {
+      high_pass_filter_->Process(
+          channel, render_queue_input_frame_.View(/*band=*/0, channel));
+    }
   }
 
   static_cast<void>(render_transfer_queue_->Insert(&render_queue_input_frame_));
@@ -729,7 +756,7 @@ EchoCanceller3::EchoCanceller3(
       num_render_input_channels_(num_render_channels),
       num_capture_channels_(num_capture_channels),
       config_selector_(AdjustConfig(config),
-                       multichannel_config,
+                       AdaptToBlockSize(multichannel_config),
                        num_render_input_channels_),
       multichannel_content_detector_(
           config_selector_.active_config().multi_channel.detect_stereo_content,
@@ -744,19 +771,9 @@ EchoCanceller3::EchoCanceller3(
       capture_blocker_(num_bands_, num_capture_channels_),
       render_transfer_queue_(
           kRenderTransferQueueSizeFrames,
-          std::vector<std::vector<std::vector<float>>>(
-              num_bands_,
-              std::vector<std::vector<float>>(
-                  num_render_input_channels_,
-                  std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
-          Aec3RenderQueueItemVerifier(num_bands_,
-                                      num_render_input_channels_,
-                                      AudioBuffer::kSplitBandSize)),
-      render_queue_output_frame_(
-          num_bands_,
-          std::vector<std::vector<float>>(
-              num_render_input_channels_,
-              std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
+          RenderFrame(num_bands_, num_render_input_channels_),
+          Aec3RenderQueueItemVerifier(num_bands_, num_render_input_channels_)),
+      render_queue_output_frame_(num_bands_, num_render_input_channels_),
       render_block_(num_bands_, num_render_input_channels_),
       capture_block_(num_bands_, num_capture_channels_),
       capture_sub_frame_view_(
@@ -900,13 +917,6 @@ void EchoCanceller3::ProcessCapture(AudioBuffer* capture,
       linear_output_block_.get(), &linear_output_sub_frame_view_,
       &capture_block_, &capture_sub_frame_view_);
 
-  ProcessRemainingCaptureFrameContent(
-      level_change,
-      multichannel_content_detector_.IsTemporaryMultiChannelContentDetected(),
-      saturated_microphone_signal_, &capture_blocker_,
-      linear_output_framer_.get(), &output_framer_, block_processor_.get(),
-      linear_output_block_.get(), &capture_block_);
-
   data_dumper_->DumpWav("aec3_capture_output", AudioBuffer::kSplitBandSize,
                         &capture->split_bands(0)[0][0], 16000, 1);
 }
@@ -928,6 +938,51 @@ void EchoCanceller3::SetCaptureOutputUsage(bool capture_output_used) {
   block_processor_->SetCaptureOutputUsage(capture_output_used);
 }
 
+std::vector<uint8_t> EchoCanceller3::GetWarmStartState() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  Aec3WarmStartState state;
+  block_processor_->GetWarmStartState(&state);
+  return SerializeWarmStartState(state);
+}
+
+bool EchoCanceller3::SetWarmStartState(
+    rtc::ArrayView<const uint8_t> serialized_state) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  const std::optional<Aec3WarmStartState> parsed_state =
+      DeserializeWarmStartState(serialized_state);
+  if (!parsed_state) {
+    return false;
+  }
+  const Aec3WarmStartState& state = *parsed_state;
+  if (state.filters.size() != num_capture_channels_ ||
+      state.erle.size() != num_capture_channels_ ||
+      state.fullband_erle_log2.size() != num_capture_channels_) {
+    return false;
+  }
+  const EchoCanceller3Config& config = config_selector_.active_config();
+  const size_t max_delay_blocks = GetRenderDelayBufferSize(
+      config.delay.down_sampling_factor, config.delay.num_filters,
+      config.filter.refined.length_blocks);
+  if (state.delay_blocks && *state.delay_blocks >= max_delay_blocks) {
+    return false;
+  }
+  const size_t max_num_partitions =
+      std::max(config.filter.refined.length_blocks,
+               config.filter.refined_initial.length_blocks);
+  for (const auto& filter : state.filters) {
+    if (filter.size() > max_num_partitions) {
+      return false;
+    }
+    for (const auto& partition : filter) {
+      if (partition.size() != num_render_channels_to_aec_) {
+        return false;
+      }
+    }
+  }
+  block_processor_->SetWarmStartState(state);
+  return true;
+}
+
 bool EchoCanceller3::ActiveProcessing() const {
   return true;
 }
@@ -981,9 +1036,6 @@ void EchoCanceller3::EmptyRenderQueue() {
         &render_queue_output_frame_, 1, render_blocker_.get(),
         block_processor_.get(), &render_block_, &render_sub_frame_view_);
 
-    BufferRemainingRenderFrameContent(render_blocker_.get(),
-                                      block_processor_.get(), &render_block_);
-
     frame_to_buffer =
         render_transfer_queue_.Remove(&render_queue_output_frame_);
   }
@@ -12,6 +12,7 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_ECHO_CANCELLER3_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <atomic>
 #include <memory>
@@ -28,6 +29,8 @@
 #include "modules/audio_processing/aec3/config_selector.h"
 #include "modules/audio_processing/aec3/frame_blocker.h"
 #include "modules/audio_processing/aec3/multi_channel_content_detector.h"
+#include "modules/audio_processing/aec3/render_frame.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -46,41 +49,24 @@ EchoCanceller3Config AdjustConfig(const EchoCanceller3Config& config);
 // queue.
 class Aec3RenderQueueItemVerifier {
  public:
-  Aec3RenderQueueItemVerifier(size_t num_bands,
-                              size_t num_channels,
-                              size_t frame_length)
-      : num_bands_(num_bands),
-        num_channels_(num_channels),
-        frame_length_(frame_length) {}
-
-  bool operator()(const std::vector<std::vector<std::vector<float>>>& v) const {
-    if (v.size() != num_bands_) {
-      return false;
-    }
-    for (const auto& band : v) {
-      if (band.size() != num_channels_) {
-        return false;
-      }
-      for (const auto& channel : band) {
-        if (channel.size() != frame_length_) {
-          return false;
-        }
-      }
-    }
-    return true;
+  Aec3RenderQueueItemVerifier(size_t num_bands, size_t num_channels)
+      : num_bands_(num_bands), num_channels_(num_channels) {}
+
+  bool operator()(const RenderFrame& v) const {
+    return static_cast<size_t>(v.NumBands()) == num_bands_ &&
+           static_cast<size_t>(v.NumChannels()) == num_channels_;
   }
 
  private:
   const size_t num_bands_;
   const size_t num_channels_;
-  const size_t frame_length_;
 };
 
 // Main class for the echo canceller3.
 // It does 4 things:
 // -Receives 10 ms frames of band-split audio.
 // -Provides the lower level echo canceller functionality with
-// blocks of 64 samples of audio data.
+// blocks of kBlockSize samples of audio data.
 // -Partially handles the jitter in the render and capture API
 // call sequence.
 //
@@ -126,6 +112,17 @@ class EchoCanceller3 : public EchoControl {
 
   bool ActiveProcessing() const override;
 
+  // Returns a serialized snapshot of the converged echo path state (linear
+  // filters, delay, ERL, ERLE and reverb model).
+  std::vector<uint8_t> GetWarmStartState() const override;
+
+  // Initializes the echo canceller from a state returned by
+  // GetWarmStartState(). The state is applied when the next capture block is
+  // processed. Returns false, and leaves the echo canceller unaffected, if the
+  // state is malformed, holds non-finite values, or does not match the channel
+  // configuration or the filter and delay ranges of this instance.
+  bool SetWarmStartState(rtc::ArrayView<const uint8_t> state) override;
+
   // Signals whether an external detector has detected echo leakage from the
   // echo canceller.
   // Note that in the case echo leakage has been flagged, it should be unflagged
@@ -201,13 +198,10 @@ class EchoCanceller3 : public EchoControl {
   FrameBlocker capture_blocker_ RTC_GUARDED_BY(capture_race_checker_);
   std::unique_ptr<FrameBlocker> render_blocker_
       RTC_GUARDED_BY(capture_race_checker_);
-  SwapQueue<std::vector<std::vector<std::vector<float>>>,
-            Aec3RenderQueueItemVerifier>
-      render_transfer_queue_;
+  SwapQueue<RenderFrame, Aec3RenderQueueItemVerifier> render_transfer_queue_;
   std::unique_ptr<BlockProcessor> block_processor_
       RTC_GUARDED_BY(capture_race_checker_);
-  std::vector<std::vector<std::vector<float>>> render_queue_output_frame_
-      RTC_GUARDED_BY(capture_race_checker_);
+  RenderFrame render_queue_output_frame_ RTC_GUARDED_BY(capture_race_checker_);
   bool saturated_microphone_signal_ RTC_GUARDED_BY(capture_race_checker_) =
       false;
   Block render_block_ RTC_GUARDED_BY(capture_race_checker_);
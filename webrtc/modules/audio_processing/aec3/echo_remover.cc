@@ -17,11 +17,13 @@
 #include <atomic>
 #include <cmath>
 #include <memory>
+#include <thread>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/aec_state.h"
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
 #include "modules/audio_processing/aec3/comfort_noise_generator.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/echo_remover_metrics.h"
@@ -67,6 +69,27 @@ void LinearEchoPower(const FftData& E,
   }
 }
 
+// Creates a pool for processing the capture channels in parallel if that is
+// configured and there is more than one capture channel to process. The
+// workers only pay off when they run on otherwise idle cores, so there is at
+// most one per additional core, and none on a single-core machine.
+std::unique_ptr<ChannelWorkerPool> CreateChannelWorkerPool(
+    const EchoCanceller3Config& config,
+    size_t num_capture_channels) {
+  int num_worker_threads =
+      std::min(config.multi_channel.num_capture_worker_threads,
+               static_cast<int>(num_capture_channels) - 1);
+  // hardware_concurrency() returns 0 when the number of cores is unknown.
+  const int num_cores = static_cast<int>(std::thread::hardware_concurrency());
+  if (num_cores > 0) {
+    num_worker_threads = std::min(num_worker_threads, num_cores - 1);
+  }
+  if (num_worker_threads <= 0) {
+    return nullptr;
+  }
+  return std::make_unique<ChannelWorkerPool>(num_worker_threads);
+}
+
 // Fades between two input signals using a fix-sized transition.
 void SignalTransition(rtc::ArrayView<const float> from,
                       rtc::ArrayView<const float> to,
@@ -135,6 +158,9 @@ class EchoRemoverImpl final : public EchoRemover {
     capture_output_used_ = capture_output_used;
   }
 
+  void GetWarmStartState(Aec3WarmStartState* state) const override;
+  void SetWarmStartState(const Aec3WarmStartState& state) override;
+
  private:
   // Selects which of the coarse and refined linear filter outputs that is most
   // appropriate to pass to the suppressor and forms the linear filter output by
@@ -151,6 +177,8 @@ class EchoRemoverImpl final : public EchoRemover {
   const size_t num_render_channels_;
   const size_t num_capture_channels_;
   const bool use_coarse_filter_output_;
+  const bool skip_linear_processing_during_render_silence_;
+  std::unique_ptr<ChannelWorkerPool> worker_pool_;
   Subtractor subtractor_;
   SuppressionGain suppression_gain_;
   ComfortNoiseGenerator cng_;
@@ -195,11 +223,16 @@ EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
       num_capture_channels_(num_capture_channels),
       use_coarse_filter_output_(
           config_.filter.enable_coarse_filter_output_usage),
+      skip_linear_processing_during_render_silence_(
+          config_.echo_removal_control
+              .skip_linear_processing_during_render_silence),
+      worker_pool_(CreateChannelWorkerPool(config_, num_capture_channels_)),
       subtractor_(config,
                   num_render_channels_,
                   num_capture_channels_,
                   data_dumper_.get(),
-                  optimization_),
+                  optimization_,
+                  worker_pool_.get()),
       suppression_gain_(config_,
                         optimization_,
                         sample_rate_hz,
@@ -236,6 +269,18 @@ void EchoRemoverImpl::GetMetrics(EchoControl::Metrics* metrics) const {
       Log2TodB(aec_state_.FullBandErleLog2());
 }
 
+void EchoRemoverImpl::GetWarmStartState(Aec3WarmStartState* state) const {
+  RTC_DCHECK(state);
+  subtractor_.GetFilters(&state->filters);
+  aec_state_.GetWarmStartState(state);
+}
+
+void EchoRemoverImpl::SetWarmStartState(const Aec3WarmStartState& state) {
+  subtractor_.SetFilters(state.filters);
+  aec_state_.SetWarmStartState(state);
+  suppression_gain_.SetInitialState(false);
+}
+
 void EchoRemoverImpl::ProcessCapture(
     EchoPathVariability echo_path_variability,
     bool capture_signal_saturation,
@@ -365,18 +410,35 @@ void EchoRemoverImpl::ProcessCapture(
     suppression_gain_.SetInitialState(false);
   }
 
-  // Perform linear echo cancellation.
-  subtractor_.Process(*render_buffer, *y, render_signal_analyzer_, aec_state_,
-                      subtractor_output);
+  // Perform linear echo cancellation. While all the buffered render data is
+  // silent there is no echo to cancel, and the linear filtering and adaptation
+  // are skipped.
+  if (skip_linear_processing_during_render_silence_ &&
+      render_buffer->GetRenderSilence()) {
+    subtractor_.ProcessRenderSilence(*y, subtractor_output);
+  } else {
+    subtractor_.Process(*render_buffer, *y, render_signal_analyzer_,
+                        aec_state_, subtractor_output);
+  }
 
-  // Compute spectra.
+  // Compute spectra. The choice of linear filter output is carried over
+  // between the channels, and is therefore done serially.
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     FormLinearFilterOutput(subtractor_output[ch], e[ch]);
+  }
+  auto compute_spectra = [&](size_t ch) {
     WindowedPaddedFft(fft_, y->View(/*band=*/0, ch), y_old_[ch], &Y[ch]);
     WindowedPaddedFft(fft_, e[ch], e_old_[ch], &E[ch]);
     LinearEchoPower(E[ch], Y[ch], &S2_linear[ch]);
     Y[ch].Spectrum(optimization_, Y2[ch]);
     E[ch].Spectrum(optimization_, E2[ch]);
+  };
+  if (worker_pool_) {
+    worker_pool_->ParallelFor(num_capture_channels_, compute_spectra);
+  } else {
+    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+      compute_spectra(ch);
+    }
   }
 
   // Optionally return the linear filter output.
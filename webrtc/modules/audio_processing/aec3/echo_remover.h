@@ -20,6 +20,7 @@
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -55,6 +56,13 @@ class EchoRemover {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Copies the linear filters and the echo path estimates into `state`.
+  virtual void GetWarmStartState(Aec3WarmStartState* state) const = 0;
+
+  // Initializes the linear filters and the echo path estimates from a state
+  // exported during a previous call over the same echo path.
+  virtual void SetWarmStartState(const Aec3WarmStartState& state) = 0;
 };
 
 }  // namespace webrtc
@@ -126,10 +126,11 @@ void UpdateDbMetric(const std::array<float, kFftLengthBy2Plus1>& value,
   RTC_DCHECK(statistic);
   // Truncation is intended in the band width computation.
   constexpr int kNumBands = 2;
-  constexpr int kBandWidth = 65 / kNumBands;
+  constexpr int kBandWidth =
+      static_cast<int>(kFftLengthBy2Plus1) / kNumBands;
   constexpr float kOneByBandWidth = 1.f / kBandWidth;
   RTC_DCHECK_EQ(kNumBands, statistic->size());
-  RTC_DCHECK_EQ(65, value.size());
+  RTC_DCHECK_EQ(kFftLengthBy2Plus1, value.size());
   for (size_t k = 0; k < statistic->size(); ++k) {
     float average_band =
         std::accumulate(value.begin() + kBandWidth * k,
@@ -21,6 +21,7 @@ namespace {
 
 constexpr float kMinErl = 0.01f;
 constexpr float kMaxErl = 1000.f;
+constexpr int kHoldBlocks = 1000;
 
 }  // namespace
 
@@ -38,6 +39,17 @@ void ErlEstimator::Reset() {
   blocks_since_reset_ = 0;
 }
 
+void ErlEstimator::SetErl(rtc::ArrayView<const float, kFftLengthBy2Plus1> erl,
+                          float erl_time_domain) {
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    erl_[k] = std::min(std::max(erl[k], kMinErl), kMaxErl);
+  }
+  erl_time_domain_ = std::min(std::max(erl_time_domain, kMinErl), kMaxErl);
+  hold_counters_.fill(kHoldBlocks);
+  hold_counter_time_domain_ = kHoldBlocks;
+  blocks_since_reset_ = startup_phase_length_blocks__;
+}
+
 void ErlEstimator::Update(
     const std::vector<bool>& converged_filters,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> render_spectra,
@@ -107,7 +119,7 @@ void ErlEstimator::Update(
     if (X2[k] > kX2Min) {
       const float new_erl = Y2[k] / X2[k];
       if (new_erl < erl_[k]) {
-        hold_counters_[k - 1] = 1000;
+        hold_counters_[k - 1] = kHoldBlocks;
         erl_[k] += 0.1f * (new_erl - erl_[k]);
         erl_[k] = std::max(erl_[k], kMinErl);
       }
@@ -131,7 +143,7 @@ void ErlEstimator::Update(
     const float Y2_sum = std::accumulate(Y2.begin(), Y2.end(), 0.0f);
     const float new_erl = Y2_sum / X2_sum;
     if (new_erl < erl_time_domain_) {
-      hold_counter_time_domain_ = 1000;
+      hold_counter_time_domain_ = kHoldBlocks;
       erl_time_domain_ += 0.1f * (new_erl - erl_time_domain_);
       erl_time_domain_ = std::max(erl_time_domain_, kMinErl);
     }
@@ -40,6 +40,11 @@ class ErlEstimator {
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
                   capture_spectra);
 
+  // Sets the ERL estimates, e.g., from a previous call over the same echo
+  // path. The estimates are held as if they had just been measured.
+  void SetErl(rtc::ArrayView<const float, kFftLengthBy2Plus1> erl,
+              float erl_time_domain);
+
   // Returns the most recent ERL estimate.
   const std::array<float, kFftLengthBy2Plus1>& Erl() const { return erl_; }
   float ErlTimeDomain() const { return erl_time_domain_; }
@@ -42,6 +42,14 @@ void ErleEstimator::Reset(bool delay_change) {
   }
 }
 
+void ErleEstimator::SetErle(
+    rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
+    rtc::ArrayView<const float> fullband_erle_log2) {
+  subband_erle_estimator_.SetErle(erle);
+  fullband_erle_estimator_.SetErleLog2(fullband_erle_log2);
+  blocks_since_reset_ = startup_phase_length_blocks_;
+}
+
 void ErleEstimator::Update(
     const RenderBuffer& render_buffer,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
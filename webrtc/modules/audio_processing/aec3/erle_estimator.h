@@ -41,6 +41,11 @@ class ErleEstimator {
   // Resets the fullband ERLE estimator and the subbands ERLE estimators.
   void Reset(bool delay_change);
 
+  // Sets the subband and fullband ERLE estimates, e.g., from a previous call
+  // over the same echo path, and ends the startup phase.
+  void SetErle(rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
+               rtc::ArrayView<const float> fullband_erle_log2);
+
   // Updates the ERLE estimates.
   void Update(
       const RenderBuffer& render_buffer,
@@ -62,6 +67,13 @@ class ErleEstimator {
                : subband_erle_estimator_.Erle(onset_compensated);
   }
 
+  // Returns the ERLE estimates of the subband estimator, which the other
+  // estimates are derived from.
+  rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> SubbandErle()
+      const {
+    return subband_erle_estimator_.Erle(/*onset_compensated=*/false);
+  }
+
   // Returns the non-capped subband ERLE.
   rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> ErleUnbounded()
       const {
@@ -86,6 +98,11 @@ class ErleEstimator {
     return fullband_erle_estimator_.FullbandErleLog2();
   }
 
+  // Returns the per-channel fullband ERLE estimates.
+  rtc::ArrayView<const float> FullbandErleLog2PerChannel() const {
+    return fullband_erle_estimator_.ErleLog2();
+  }
+
   // Returns an estimation of the current linear filter quality based on the
   // current and past fullband ERLE estimates. The returned value is a float
   // vector with content between 0 and 1 where 1 indicates that, at this current
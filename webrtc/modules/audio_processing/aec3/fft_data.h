@@ -25,7 +25,8 @@
 
 namespace webrtc {
 
-// Struct that holds imaginary data produced from 128 point real-valued FFTs.
+// Struct that holds imaginary data produced from kFftLength point real-valued
+// FFTs.
 struct FftData {
   // Copies the data in src.
   void Assign(const FftData& src) {
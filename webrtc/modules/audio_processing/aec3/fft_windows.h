@@ -0,0 +1,208 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_FFT_WINDOWS_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_FFT_WINDOWS_H_
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// Time-domain windows applied before the kFftLength point FFTs, tabulated for
+// each of the supported block sizes.
+#if WEBRTC_AEC3_BLOCK_SIZE_LOG2 == 5
+
+// Hanning window from Matlab command win = hann(32).
+inline constexpr float kHanning[kFftLengthBy2] = {
+    0.f,         0.010235029f, 0.040521094f, 0.089618279f, 0.15551654f,
+    0.23551799f, 0.32634737f, 0.42428611f, 0.52532458f, 0.62532627f,
+    0.72019708f, 0.80605299f, 0.87937906f, 0.93717331f, 0.97706963f,
+    0.99743466f, 0.99743466f, 0.97706963f, 0.93717331f, 0.87937906f,
+    0.80605299f, 0.72019708f, 0.62532627f, 0.52532458f, 0.42428611f,
+    0.32634737f, 0.23551799f, 0.15551654f, 0.089618279f, 0.040521094f,
+    0.010235029f, 0.f};
+
+// Hanning window from Matlab command win = sqrt(hanning(64)).
+inline constexpr float kSqrtHanning[kFftLength] = {
+    0.00000000000000f, 0.04906767432742f, 0.09801714032956f, 0.14673047445536f,
+    0.19509032201613f, 0.24298017990326f, 0.29028467725446f, 0.33688985339222f,
+    0.38268343236509f, 0.42755509343028f, 0.47139673682600f, 0.51410274419322f,
+    0.55557023301960f, 0.59569930449243f, 0.63439328416365f, 0.67155895484702f,
+    0.70710678118655f, 0.74095112535496f, 0.77301045336274f, 0.80320753148064f,
+    0.83146961230255f, 0.85772861000027f, 0.88192126434835f, 0.90398929312344f,
+    0.92387953251129f, 0.94154406518302f, 0.95694033573221f, 0.97003125319454f,
+    0.98078528040323f, 0.98917650996478f, 0.99518472667220f, 0.99879545620517f,
+    1.00000000000000f, 0.99879545620517f, 0.99518472667220f, 0.98917650996478f,
+    0.98078528040323f, 0.97003125319454f, 0.95694033573221f, 0.94154406518302f,
+    0.92387953251129f, 0.90398929312344f, 0.88192126434836f, 0.85772861000027f,
+    0.83146961230255f, 0.80320753148064f, 0.77301045336274f, 0.74095112535496f,
+    0.70710678118655f, 0.67155895484702f, 0.63439328416365f, 0.59569930449243f,
+    0.55557023301960f, 0.51410274419322f, 0.47139673682600f, 0.42755509343028f,
+    0.38268343236509f, 0.33688985339222f, 0.29028467725446f, 0.24298017990326f,
+    0.19509032201613f, 0.14673047445536f, 0.09801714032956f, 0.04906767432742f};
+
+#elif WEBRTC_AEC3_BLOCK_SIZE_LOG2 == 6
+
+// Hanning window from Matlab command win = hann(64).
+inline constexpr float kHanning[kFftLengthBy2] = {
+    0.f,         0.00248461f, 0.00991376f, 0.0222136f,  0.03926189f,
+    0.06088921f, 0.08688061f, 0.11697778f, 0.15088159f, 0.1882551f,
+    0.22872687f, 0.27189467f, 0.31732949f, 0.36457977f, 0.41317591f,
+    0.46263495f, 0.51246535f, 0.56217185f, 0.61126047f, 0.65924333f,
+    0.70564355f, 0.75f,       0.79187184f, 0.83084292f, 0.86652594f,
+    0.89856625f, 0.92664544f, 0.95048443f, 0.96984631f, 0.98453864f,
+    0.99441541f, 0.99937846f, 0.99937846f, 0.99441541f, 0.98453864f,
+    0.96984631f, 0.95048443f, 0.92664544f, 0.89856625f, 0.86652594f,
+    0.83084292f, 0.79187184f, 0.75f,       0.70564355f, 0.65924333f,
+    0.61126047f, 0.56217185f, 0.51246535f, 0.46263495f, 0.41317591f,
+    0.36457977f, 0.31732949f, 0.27189467f, 0.22872687f, 0.1882551f,
+    0.15088159f, 0.11697778f, 0.08688061f, 0.06088921f, 0.03926189f,
+    0.0222136f,  0.00991376f, 0.00248461f, 0.f};
+
+// Hanning window from Matlab command win = sqrt(hanning(128)).
+inline constexpr float kSqrtHanning[kFftLength] = {
+    0.00000000000000f, 0.02454122852291f, 0.04906767432742f, 0.07356456359967f,
+    0.09801714032956f, 0.12241067519922f, 0.14673047445536f, 0.17096188876030f,
+    0.19509032201613f, 0.21910124015687f, 0.24298017990326f, 0.26671275747490f,
+    0.29028467725446f, 0.31368174039889f, 0.33688985339222f, 0.35989503653499f,
+    0.38268343236509f, 0.40524131400499f, 0.42755509343028f, 0.44961132965461f,
+    0.47139673682600f, 0.49289819222978f, 0.51410274419322f, 0.53499761988710f,
+    0.55557023301960f, 0.57580819141785f, 0.59569930449243f, 0.61523159058063f,
+    0.63439328416365f, 0.65317284295378f, 0.67155895484702f, 0.68954054473707f,
+    0.70710678118655f, 0.72424708295147f, 0.74095112535496f, 0.75720884650648f,
+    0.77301045336274f, 0.78834642762661f, 0.80320753148064f, 0.81758481315158f,
+    0.83146961230255f, 0.84485356524971f, 0.85772861000027f, 0.87008699110871f,
+    0.88192126434835f, 0.89322430119552f, 0.90398929312344f, 0.91420975570353f,
+    0.92387953251129f, 0.93299279883474f, 0.94154406518302f, 0.94952818059304f,
+    0.95694033573221f, 0.96377606579544f, 0.97003125319454f, 0.97570213003853f,
+    0.98078528040323f, 0.98527764238894f, 0.98917650996478f, 0.99247953459871f,
+    0.99518472667220f, 0.99729045667869f, 0.99879545620517f, 0.99969881869620f,
+    1.00000000000000f, 0.99969881869620f, 0.99879545620517f, 0.99729045667869f,
+    0.99518472667220f, 0.99247953459871f, 0.98917650996478f, 0.98527764238894f,
+    0.98078528040323f, 0.97570213003853f, 0.97003125319454f, 0.96377606579544f,
+    0.95694033573221f, 0.94952818059304f, 0.94154406518302f, 0.93299279883474f,
+    0.92387953251129f, 0.91420975570353f, 0.90398929312344f, 0.89322430119552f,
+    0.88192126434835f, 0.87008699110871f, 0.85772861000027f, 0.84485356524971f,
+    0.83146961230255f, 0.81758481315158f, 0.80320753148064f, 0.78834642762661f,
+    0.77301045336274f, 0.75720884650648f, 0.74095112535496f, 0.72424708295147f,
+    0.70710678118655f, 0.68954054473707f, 0.67155895484702f, 0.65317284295378f,
+    0.63439328416365f, 0.61523159058063f, 0.59569930449243f, 0.57580819141785f,
+    0.55557023301960f, 0.53499761988710f, 0.51410274419322f, 0.49289819222978f,
+    0.47139673682600f, 0.44961132965461f, 0.42755509343028f, 0.40524131400499f,
+    0.38268343236509f, 0.35989503653499f, 0.33688985339222f, 0.31368174039889f,
+    0.29028467725446f, 0.26671275747490f, 0.24298017990326f, 0.21910124015687f,
+    0.19509032201613f, 0.17096188876030f, 0.14673047445536f, 0.12241067519922f,
+    0.09801714032956f, 0.07356456359967f, 0.04906767432742f, 0.02454122852291f};
+
+#elif WEBRTC_AEC3_BLOCK_SIZE_LOG2 == 7
+
+// Hanning window from Matlab command win = hann(128).
+inline constexpr float kHanning[kFftLengthBy2] = {
+    0.f,         0.00061179189f, 0.0024456704f, 0.0054971478f, 0.0097587564f,
+    0.015220068f, 0.021867716f, 0.029685435f, 0.038654092f, 0.04875174f,
+    0.059953669f, 0.072232464f, 0.085558078f, 0.099897901f, 0.11521684f,
+    0.13147741f, 0.14863981f, 0.16666206f, 0.18550003f, 0.20510764f,
+    0.2254369f,  0.24643807f, 0.26805974f, 0.29024901f, 0.31295157f,
+    0.33611188f, 0.35967324f, 0.38357801f, 0.40776768f, 0.43218306f,
+    0.4567644f,  0.48145154f, 0.50618408f, 0.53090148f, 0.55554326f,
+    0.58004912f, 0.60435908f, 0.62841366f, 0.65215399f, 0.67552198f,
+    0.69846043f, 0.72091321f, 0.74282539f, 0.76414333f, 0.78481486f,
+    0.80478941f, 0.82401809f, 0.84245384f, 0.86005154f, 0.87676814f,
+    0.89256273f, 0.90739665f, 0.9212336f,  0.93403973f, 0.94578368f,
+    0.95643673f, 0.9659728f,  0.97436855f, 0.98160345f, 0.98765978f,
+    0.99252273f, 0.99618039f, 0.99862382f, 0.99984703f, 0.99984703f,
+    0.99862382f, 0.99618039f, 0.99252273f, 0.98765978f, 0.98160345f,
+    0.97436855f, 0.9659728f,  0.95643673f, 0.94578368f, 0.93403973f,
+    0.9212336f,  0.90739665f, 0.89256273f, 0.87676814f, 0.86005154f,
+    0.84245384f, 0.82401809f, 0.80478941f, 0.78481486f, 0.76414333f,
+    0.74282539f, 0.72091321f, 0.69846043f, 0.67552198f, 0.65215399f,
+    0.62841366f, 0.60435908f, 0.58004912f, 0.55554326f, 0.53090148f,
+    0.50618408f, 0.48145154f, 0.4567644f,  0.43218306f, 0.40776768f,
+    0.38357801f, 0.35967324f, 0.33611188f, 0.31295157f, 0.29024901f,
+    0.26805974f, 0.24643807f, 0.2254369f,  0.20510764f, 0.18550003f,
+    0.16666206f, 0.14863981f, 0.13147741f, 0.11521684f, 0.099897901f,
+    0.085558078f, 0.072232464f, 0.059953669f, 0.04875174f, 0.038654092f,
+    0.029685435f, 0.021867716f, 0.015220068f, 0.0097587564f, 0.0054971478f,
+    0.0024456704f, 0.00061179189f, 0.f};
+
+// Hanning window from Matlab command win = sqrt(hanning(256)).
+inline constexpr float kSqrtHanning[kFftLength] = {
+    0.00000000000000f, 0.01227153828572f, 0.02454122852291f, 0.03680722294136f,
+    0.04906767432742f, 0.06132073630221f, 0.07356456359967f, 0.08579731234444f,
+    0.09801714032956f, 0.11022220729388f, 0.12241067519922f, 0.13458070850713f,
+    0.14673047445536f, 0.15885814333386f, 0.17096188876030f, 0.18303988795514f,
+    0.19509032201613f, 0.20711137619222f, 0.21910124015687f, 0.23105810828067f,
+    0.24298017990326f, 0.25486565960451f, 0.26671275747490f, 0.27851968938505f,
+    0.29028467725446f, 0.30200594931923f, 0.31368174039889f, 0.32531029216226f,
+    0.33688985339222f, 0.34841868024943f, 0.35989503653499f, 0.37131719395184f,
+    0.38268343236509f, 0.39399204006105f, 0.40524131400499f, 0.41642956009764f,
+    0.42755509343028f, 0.43861623853853f, 0.44961132965461f, 0.46053871095824f,
+    0.47139673682600f, 0.48218377207912f, 0.49289819222978f, 0.50353838372572f,
+    0.51410274419322f, 0.52458968267847f, 0.53499761988710f, 0.54532498842205f,
+    0.55557023301960f, 0.56573181078361f, 0.57580819141785f, 0.58579785745644f,
+    0.59569930449243f, 0.60551104140433f, 0.61523159058063f, 0.62485948814239f,
+    0.63439328416365f, 0.64383154288979f, 0.65317284295378f, 0.66241577759017f,
+    0.67155895484702f, 0.68060099779545f, 0.68954054473707f, 0.69837624940897f,
+    0.70710678118655f, 0.71573082528382f, 0.72424708295147f, 0.73265427167241f,
+    0.74095112535496f, 0.74913639452346f, 0.75720884650648f, 0.76516726562246f,
+    0.77301045336274f, 0.78073722857209f, 0.78834642762661f, 0.79583690460888f,
+    0.80320753148064f, 0.81045719825259f, 0.81758481315158f, 0.82458930278503f,
+    0.83146961230255f, 0.83822470555484f, 0.84485356524971f, 0.85135519310527f,
+    0.85772861000027f, 0.86397285612159f, 0.87008699110871f, 0.87607009419541f,
+    0.88192126434835f, 0.88763962040285f, 0.89322430119552f, 0.89867446569395f,
+    0.90398929312344f, 0.90916798309052f, 0.91420975570353f, 0.91911385169006f,
+    0.92387953251129f, 0.92850608047322f, 0.93299279883474f, 0.93733901191257f,
+    0.94154406518302f, 0.94560732538052f, 0.94952818059304f, 0.95330604035419f,
+    0.95694033573221f, 0.96043051941557f, 0.96377606579544f, 0.96697647104485f,
+    0.97003125319454f, 0.97293995220556f, 0.97570213003853f, 0.97831737071963f,
+    0.98078528040323f, 0.98310548743122f, 0.98527764238894f, 0.98730141815786f,
+    0.98917650996478f, 0.99090263542778f, 0.99247953459871f, 0.99390697000236f,
+    0.99518472667220f, 0.99631261218278f, 0.99729045667869f, 0.99811811290015f,
+    0.99879545620517f, 0.99932238458835f, 0.99969881869620f, 0.99992470183914f,
+    1.00000000000000f, 0.99992470183914f, 0.99969881869620f, 0.99932238458835f,
+    0.99879545620517f, 0.99811811290015f, 0.99729045667869f, 0.99631261218278f,
+    0.99518472667220f, 0.99390697000236f, 0.99247953459871f, 0.99090263542778f,
+    0.98917650996478f, 0.98730141815786f, 0.98527764238894f, 0.98310548743122f,
+    0.98078528040323f, 0.97831737071963f, 0.97570213003853f, 0.97293995220556f,
+    0.97003125319454f, 0.96697647104485f, 0.96377606579544f, 0.96043051941557f,
+    0.95694033573221f, 0.95330604035419f, 0.94952818059304f, 0.94560732538052f,
+    0.94154406518302f, 0.93733901191257f, 0.93299279883474f, 0.92850608047322f,
+    0.92387953251129f, 0.91911385169006f, 0.91420975570353f, 0.90916798309052f,
+    0.90398929312344f, 0.89867446569395f, 0.89322430119552f, 0.88763962040285f,
+    0.88192126434836f, 0.87607009419541f, 0.87008699110871f, 0.86397285612159f,
+    0.85772861000027f, 0.85135519310527f, 0.84485356524971f, 0.83822470555484f,
+    0.83146961230255f, 0.82458930278503f, 0.81758481315158f, 0.81045719825259f,
+    0.80320753148064f, 0.79583690460888f, 0.78834642762661f, 0.78073722857209f,
+    0.77301045336274f, 0.76516726562246f, 0.75720884650648f, 0.74913639452346f,
+    0.74095112535496f, 0.73265427167241f, 0.72424708295147f, 0.71573082528382f,
+    0.70710678118655f, 0.69837624940897f, 0.68954054473707f, 0.68060099779545f,
+    0.67155895484702f, 0.66241577759017f, 0.65317284295378f, 0.64383154288979f,
+    0.63439328416365f, 0.62485948814239f, 0.61523159058063f, 0.60551104140433f,
+    0.59569930449243f, 0.58579785745644f, 0.57580819141785f, 0.56573181078361f,
+    0.55557023301960f, 0.54532498842205f, 0.53499761988710f, 0.52458968267847f,
+    0.51410274419322f, 0.50353838372572f, 0.49289819222978f, 0.48218377207912f,
+    0.47139673682600f, 0.46053871095824f, 0.44961132965461f, 0.43861623853853f,
+    0.42755509343028f, 0.41642956009764f, 0.40524131400499f, 0.39399204006105f,
+    0.38268343236509f, 0.37131719395184f, 0.35989503653499f, 0.34841868024943f,
+    0.33688985339222f, 0.32531029216226f, 0.31368174039889f, 0.30200594931923f,
+    0.29028467725446f, 0.27851968938505f, 0.26671275747490f, 0.25486565960451f,
+    0.24298017990326f, 0.23105810828067f, 0.21910124015687f, 0.20711137619222f,
+    0.19509032201613f, 0.18303988795514f, 0.17096188876030f, 0.15885814333386f,
+    0.14673047445536f, 0.13458070850713f, 0.12241067519922f, 0.11022220729388f,
+    0.09801714032956f, 0.08579731234444f, 0.07356456359967f, 0.06132073630221f,
+    0.04906767432742f, 0.03680722294136f, 0.02454122852291f, 0.01227153828572f};
+
+#endif
+
+}  // namespace aec3
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_FFT_WINDOWS_H_
@@ -21,8 +21,8 @@
 
 namespace webrtc {
 
-// Class for producing 64 sample multiband blocks from frames consisting of 2
-// subframes of 80 samples.
+// Class for producing kBlockSize sample multiband blocks from frames consisting
+// of 2 subframes of 80 samples.
 class FrameBlocker {
  public:
   FrameBlocker(size_t num_bands, size_t num_channels);
@@ -30,21 +30,33 @@ class FrameBlocker {
   FrameBlocker(const FrameBlocker&) = delete;
   FrameBlocker& operator=(const FrameBlocker&) = delete;
 
-  // Inserts one 80 sample multiband subframe from the multiband frame and
-  // extracts one 64 sample multiband block.
-  void InsertSubFrameAndExtractBlock(
-      const std::vector<std::vector<rtc::ArrayView<float>>>& sub_frame,
-      Block* block);
-  // Reports whether a multiband block of 64 samples is available for
+  // Inserts one 80 sample multiband subframe from the multiband frame. All
+  // available blocks must have been extracted before the next insertion.
+  void InsertSubFrame(
+      const std::vector<std::vector<rtc::ArrayView<float>>>& sub_frame);
+  // Reports whether a multiband block of kBlockSize samples is available for
   // extraction.
   bool IsBlockAvailable() const;
-  // Extracts a multiband block of 64 samples.
+  // Extracts a multiband block of kBlockSize samples.
   void ExtractBlock(Block* block);
 
  private:
+  // Maximum number of samples buffered per band and channel.
+  static constexpr size_t kBufferSize = kBlockSize - 1 + kSubFrameLength;
+
+  // Returns the index of the first buffered sample of the requested |band| and
+  // |channel|.
+  size_t GetIndex(size_t band, size_t channel) const {
+    return (band * num_channels_ + channel) * kBufferSize;
+  }
+
   const size_t num_bands_;
   const size_t num_channels_;
-  std::vector<std::vector<std::vector<float>>> buffer_;
+  // Samples not yet extracted into a block, for all bands and channels, stored
+  // in one flat allocation. All bands and channels always hold the same number
+  // of samples.
+  std::vector<float> buffer_;
+  size_t num_buffered_samples_ = 0;
 };
 }  // namespace webrtc
 
@@ -56,6 +56,14 @@ void FullBandErleEstimator::Reset() {
             hold_counters_instantaneous_erle_.end(), 0);
 }
 
+void FullBandErleEstimator::SetErleLog2(
+    rtc::ArrayView<const float> erle_log2) {
+  RTC_DCHECK_EQ(erle_time_domain_log2_.size(), erle_log2.size());
+  for (size_t ch = 0; ch < erle_time_domain_log2_.size(); ++ch) {
+    erle_time_domain_log2_[ch] = std::max(erle_log2[ch], min_erle_log2_);
+  }
+}
+
 void FullBandErleEstimator::Update(
     rtc::ArrayView<const float> X2,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -38,6 +38,15 @@ class FullBandErleEstimator {
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> E2,
               const std::vector<bool>& converged_filters);
 
+  // Sets the fullband ERLE estimates, in log2 units, e.g., from a previous call
+  // over the same echo path.
+  void SetErleLog2(rtc::ArrayView<const float> erle_log2);
+
+  // Returns the per-channel fullband ERLE estimates in log2 units.
+  rtc::ArrayView<const float> ErleLog2() const {
+    return erle_time_domain_log2_;
+  }
+
   // Returns the fullband ERLE estimates in log2 units.
   float FullbandErleLog2() const {
     float min_erle = erle_time_domain_log2_[0];
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/matched_filter.h"
 
@@ -64,7 +65,7 @@ class MatchedFilterLagAggregator {
 
    private:
     const int block_size_log2_;
-    std::array<int, 250> histogram_data_;
+    std::array<int, kNumBlocksPerSecond> histogram_data_;
     std::vector<int> histogram_;
     int histogram_data_index_ = 0;
     int pre_echo_candidate_ = 0;
@@ -81,7 +82,7 @@ class MatchedFilterLagAggregator {
 
    private:
     std::vector<int> histogram_;
-    std::array<int, 250> histogram_data_;
+    std::array<int, kNumBlocksPerSecond> histogram_data_;
     int histogram_data_index_ = 0;
     int candidate_ = -1;
   };
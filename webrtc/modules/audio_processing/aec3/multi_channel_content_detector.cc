@@ -25,16 +25,16 @@ constexpr int kNumFramesPerSecond = 100;
 // whether the signal is a proper stereo signal. To allow for differences
 // introduced by hardware drivers, a threshold `detection_threshold` is used for
 // the detection.
-bool HasStereoContent(const std::vector<std::vector<std::vector<float>>>& frame,
-                      float detection_threshold) {
-  if (frame[0].size() < 2) {
+bool HasStereoContent(const RenderFrame& frame, float detection_threshold) {
+  if (frame.NumChannels() < 2) {
     return false;
   }
 
-  for (size_t band = 0; band < frame.size(); ++band) {
-    for (size_t k = 0; k < frame[band][0].size(); ++k) {
-      if (std::fabs(frame[band][0][k] - frame[band][1][k]) >
-          detection_threshold) {
+  for (int band = 0; band < frame.NumBands(); ++band) {
+    rtc::ArrayView<const float, kFrameSize> left = frame.View(band, 0);
+    rtc::ArrayView<const float, kFrameSize> right = frame.View(band, 1);
+    for (size_t k = 0; k < kFrameSize; ++k) {
+      if (std::fabs(left[k] - right[k]) > detection_threshold) {
         return true;
       }
     }
@@ -105,10 +105,9 @@ MultiChannelContentDetector::MultiChannelContentDetector(
       persistent_multichannel_content_detected_(
           !detect_stereo_content && num_render_input_channels > 1) {}
 
-bool MultiChannelContentDetector::UpdateDetection(
-    const std::vector<std::vector<std::vector<float>>>& frame) {
+bool MultiChannelContentDetector::UpdateDetection(const RenderFrame& frame) {
   if (!detect_stereo_content_) {
-    RTC_DCHECK_EQ(frame[0].size() > 1,
+    RTC_DCHECK_EQ(frame.NumChannels() > 1,
                   persistent_multichannel_content_detected_);
     return false;
   }
@@ -17,6 +17,8 @@
 #include <optional>
 #include <vector>
 
+#include "modules/audio_processing/aec3/render_frame.h"
+
 namespace webrtc {
 
 // Analyzes audio content to determine whether the contained audio is proper
@@ -39,8 +41,7 @@ class MultiChannelContentDetector {
   // whether the signal is a proper multichannel signal. Returns a bool
   // indicating whether a change in the proper multichannel content was
   // detected.
-  bool UpdateDetection(
-      const std::vector<std::vector<std::vector<float>>>& frame);
+  bool UpdateDetection(const RenderFrame& frame);
 
   bool IsProperMultiChannelContentDetected() const {
     return persistent_multichannel_content_detected_;
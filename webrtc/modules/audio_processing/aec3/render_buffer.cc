@@ -27,10 +27,8 @@ RenderBuffer::RenderBuffer(BlockBuffer* block_buffer,
   RTC_DCHECK(block_buffer_);
   RTC_DCHECK(spectrum_buffer_);
   RTC_DCHECK(fft_buffer_);
-  RTC_DCHECK_EQ(block_buffer_->buffer.size(), fft_buffer_->buffer.size());
-  RTC_DCHECK_EQ(spectrum_buffer_->buffer.size(), fft_buffer_->buffer.size());
-  RTC_DCHECK_EQ(spectrum_buffer_->read, fft_buffer_->read);
-  RTC_DCHECK_EQ(spectrum_buffer_->write, fft_buffer_->write);
+  RTC_DCHECK_EQ(block_buffer_->buffer.size(), spectrum_buffer_->buffer.size());
+  RTC_DCHECK_GE(block_buffer_->buffer.size(), fft_buffer_->buffer.size());
 }
 
 RenderBuffer::~RenderBuffer() = default;
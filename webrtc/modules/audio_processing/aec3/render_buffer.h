@@ -54,17 +54,14 @@ class RenderBuffer {
     return spectrum_buffer_->buffer[position];
   }
 
-  // Returns the circular fft buffer.
+  // Returns the circular fft buffer. It only spans the most recent blocks
+  // covered by the linear filters, starting at Position().
   rtc::ArrayView<const std::vector<FftData>> GetFftBuffer() const {
     return fft_buffer_->buffer;
   }
 
-  // Returns the current position in the circular buffer.
-  size_t Position() const {
-    RTC_DCHECK_EQ(spectrum_buffer_->read, fft_buffer_->read);
-    RTC_DCHECK_EQ(spectrum_buffer_->write, fft_buffer_->write);
-    return fft_buffer_->read;
-  }
+  // Returns the current position in the circular fft buffer.
+  size_t Position() const { return fft_buffer_->read; }
 
   // Returns the sum of the spectrums for a certain number of FFTs.
   void SpectralSum(size_t num_spectra,
@@ -82,17 +79,24 @@ class RenderBuffer {
   // Specifies the recent activity seen in the render signal.
   void SetRenderActivity(bool activity) { render_activity_ = activity; }
 
+  // Gets whether all the render data in the buffers is silent.
+  bool GetRenderSilence() const { return render_silence_; }
+
+  // Specifies whether all the render data in the buffers is silent.
+  void SetRenderSilence(bool silence) { render_silence_ = silence; }
+
   // Returns the headroom between the write and the read positions in the
   // buffer.
   int Headroom() const {
     // The write and read indices are decreased over time.
     int headroom =
-        fft_buffer_->write < fft_buffer_->read
-            ? fft_buffer_->read - fft_buffer_->write
-            : fft_buffer_->size - fft_buffer_->write + fft_buffer_->read;
+        spectrum_buffer_->write < spectrum_buffer_->read
+            ? spectrum_buffer_->read - spectrum_buffer_->write
+            : spectrum_buffer_->size - spectrum_buffer_->write +
+                  spectrum_buffer_->read;
 
     RTC_DCHECK_LE(0, headroom);
-    RTC_DCHECK_GE(fft_buffer_->size, headroom);
+    RTC_DCHECK_GE(spectrum_buffer_->size, headroom);
 
     return headroom;
   }
@@ -108,6 +112,7 @@ class RenderBuffer {
   const SpectrumBuffer* const spectrum_buffer_;
   const FftBuffer* const fft_buffer_;
   bool render_activity_ = false;
+  bool render_silence_ = false;
 };
 
 }  // namespace webrtc
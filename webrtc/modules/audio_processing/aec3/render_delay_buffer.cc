@@ -40,6 +40,14 @@
 namespace webrtc {
 namespace {
 
+// Returns the number of render FFTs that are accessed by the linear filters.
+size_t GetFftBufferSize(const EchoCanceller3Config& config) {
+  return std::max({config.filter.refined.length_blocks,
+                   config.filter.refined_initial.length_blocks,
+                   config.filter.coarse.length_blocks,
+                   config.filter.coarse_initial.length_blocks});
+}
+
 class RenderDelayBufferImpl final : public RenderDelayBuffer {
  public:
   RenderDelayBufferImpl(const EchoCanceller3Config& config,
@@ -95,6 +103,7 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   int64_t render_call_counter_ = 0;
   bool render_activity_ = false;
   size_t render_activity_counter_ = 0;
+  size_t silent_render_blocks_ = 0;
   std::optional<int> external_audio_buffer_delay_;
   bool external_audio_buffer_delay_verified_after_reset_ = false;
   size_t min_latency_blocks_ = 0;
@@ -104,7 +113,10 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   int ComputeDelay() const;
   void ApplyTotalDelay(int delay);
   void InsertBlock(const Block& block, int previous_write);
+  void ComputeFft(int fft_index, int block_index);
+  void ComputeFfts();
   bool DetectActiveRender(rtc::ArrayView<const float> x) const;
+  bool DetectSilentRender(const Block& block) const;
   bool DetectExcessRenderBlocks();
   void IncrementWriteIndices();
   void IncrementLowRateReadIndices();
@@ -136,7 +148,7 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
               NumBandsForRate(sample_rate_hz),
               num_render_channels),
       spectra_(blocks_.buffer.size(), num_render_channels),
-      ffts_(blocks_.buffer.size(), num_render_channels),
+      ffts_(GetFftBufferSize(config), num_render_channels),
       delay_(config_.delay.default_delay),
       echo_remover_buffer_(&blocks_, &spectra_, &ffts_),
       low_rate_(GetDownSampledBufferSize(down_sampling_factor_,
@@ -146,11 +158,10 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
       fft_(),
       render_ds_(sub_block_size_, 0.f),
       buffer_headroom_(config.filter.refined.length_blocks) {
-  RTC_DCHECK_EQ(blocks_.buffer.size(), ffts_.buffer.size());
-  RTC_DCHECK_EQ(spectra_.buffer.size(), ffts_.buffer.size());
+  RTC_DCHECK_EQ(blocks_.buffer.size(), spectra_.buffer.size());
+  RTC_DCHECK_LT(ffts_.buffer.size(), blocks_.buffer.size());
   for (size_t i = 0; i < blocks_.buffer.size(); ++i) {
-    RTC_DCHECK_EQ(blocks_.buffer[i].NumChannels(), ffts_.buffer[i].size());
-    RTC_DCHECK_EQ(spectra_.buffer[i].size(), ffts_.buffer[i].size());
+    RTC_DCHECK_EQ(blocks_.buffer[i].NumChannels(), spectra_.buffer[i].size());
   }
 
   Reset();
@@ -232,6 +243,15 @@ RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
     render_activity_ = render_activity_counter_ >= 20;
   }
 
+  // Count the render blocks in a row that are silent.
+  if (config_.echo_removal_control
+          .skip_linear_processing_during_render_silence) {
+    silent_render_blocks_ =
+        DetectSilentRender(block)
+            ? std::min(silent_render_blocks_ + 1, blocks_.buffer.size())
+            : 0;
+  }
+
   // Insert the new render block into the specified position.
   InsertBlock(block, previous_write);
 
@@ -293,6 +313,8 @@ RenderDelayBufferImpl::PrepareCaptureProcessing() {
   }
 
   echo_remover_buffer_.SetRenderActivity(render_activity_);
+  echo_remover_buffer_.SetRenderSilence(silent_render_blocks_ ==
+                                        blocks_.buffer.size());
   if (render_activity_) {
     render_activity_counter_ = 0;
     render_activity_ = false;
@@ -336,7 +358,7 @@ void RenderDelayBufferImpl::SetAudioBufferDelay(int delay_ms) {
   }
 
   // Convert delay from milliseconds to blocks (rounded down).
-  external_audio_buffer_delay_ = delay_ms / 4;
+  external_audio_buffer_delay_ = delay_ms * kNumBlocksPerSecond / 1000;
 }
 
 bool RenderDelayBufferImpl::HasReceivedBufferDelay() {
@@ -366,7 +388,7 @@ void RenderDelayBufferImpl::ApplyTotalDelay(int delay) {
       << "Applying total delay of " << delay << " blocks.";
   blocks_.read = blocks_.OffsetIndex(blocks_.write, -delay);
   spectra_.read = spectra_.OffsetIndex(spectra_.write, delay);
-  ffts_.read = ffts_.OffsetIndex(ffts_.write, delay);
+  ComputeFfts();
 }
 
 void RenderDelayBufferImpl::AlignFromExternalDelay() {
@@ -386,7 +408,6 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
   auto& b = blocks_;
   auto& lr = low_rate_;
   auto& ds = render_ds_;
-  auto& f = ffts_;
   auto& s = spectra_;
   const size_t num_bands = b.buffer[b.write].NumBands();
   const size_t num_render_channels = b.buffer[b.write].NumChannels();
@@ -417,12 +438,39 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
   data_dumper_->DumpWav("aec3_render_decimator_output", ds.size(), ds.data(),
                         16000 / down_sampling_factor_, 1);
   std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
+  FftData X;
   for (int channel = 0; channel < b.buffer[b.write].NumChannels(); ++channel) {
     fft_.PaddedFft(b.buffer[b.write].View(/*band=*/0, channel),
-                   b.buffer[previous_write].View(/*band=*/0, channel),
-                   &f.buffer[f.write][channel]);
-    f.buffer[f.write][channel].Spectrum(optimization_,
-                                        s.buffer[s.write][channel]);
+                   b.buffer[previous_write].View(/*band=*/0, channel), &X);
+    X.Spectrum(optimization_, s.buffer[s.write][channel]);
+  }
+
+  // The FFTs of the filter partitions are only computed when the blocks reach
+  // the read position. When more render blocks than capture blocks have been
+  // received, the new block may overwrite one of the blocks that already have
+  // their FFT computed.
+  const int offset = (b.size + b.read - b.write) % b.size;
+  if (offset < ffts_.size) {
+    ComputeFft(ffts_.OffsetIndex(ffts_.read, offset), b.write);
+  }
+}
+
+// Computes the FFT of the block at `block_index`, padded with the block
+// preceding it, into the FFT buffer at `fft_index`.
+void RenderDelayBufferImpl::ComputeFft(int fft_index, int block_index) {
+  const Block& x = blocks_.buffer[block_index];
+  const Block& x_old = blocks_.buffer[blocks_.DecIndex(block_index)];
+  for (int channel = 0; channel < x.NumChannels(); ++channel) {
+    fft_.PaddedFft(x.View(/*band=*/0, channel), x_old.View(/*band=*/0, channel),
+                   &ffts_.buffer[fft_index][channel]);
+  }
+}
+
+// Computes the FFTs of all the blocks covered by the filter partitions.
+void RenderDelayBufferImpl::ComputeFfts() {
+  for (int k = 0; k < ffts_.size; ++k) {
+    ComputeFft(ffts_.OffsetIndex(ffts_.read, k),
+               blocks_.OffsetIndex(blocks_.read, -k));
   }
 }
 
@@ -434,6 +482,21 @@ bool RenderDelayBufferImpl::DetectActiveRender(
                         kFftLengthBy2;
 }
 
+bool RenderDelayBufferImpl::DetectSilentRender(const Block& block) const {
+  const float silence_threshold = config_.render_levels.silence_limit *
+                                  config_.render_levels.silence_limit *
+                                  kBlockSize;
+  for (int ch = 0; ch < block.NumChannels(); ++ch) {
+    rtc::ArrayView<const float> x = block.View(/*band=*/0, ch);
+    const float x_energy =
+        std::inner_product(x.begin(), x.end(), x.begin(), 0.f);
+    if (x_energy > silence_threshold) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool RenderDelayBufferImpl::DetectExcessRenderBlocks() {
   bool excess_render_detected = false;
   const size_t latency_blocks = static_cast<size_t>(BufferLatency());
@@ -471,7 +534,6 @@ void RenderDelayBufferImpl::IncrementWriteIndices() {
   low_rate_.UpdateWriteIndex(-sub_block_size_);
   blocks_.IncWriteIndex();
   spectra_.DecWriteIndex();
-  ffts_.DecWriteIndex();
 }
 
 // Increments the read indices of the low rate render buffers.
@@ -485,6 +547,7 @@ void RenderDelayBufferImpl::IncrementReadIndices() {
     blocks_.IncReadIndex();
     spectra_.DecReadIndex();
     ffts_.DecReadIndex();
+    ComputeFft(ffts_.read, blocks_.read);
   }
 }
 
@@ -43,6 +43,7 @@ class RenderDelayControllerImpl final : public RenderDelayController {
 
   ~RenderDelayControllerImpl() override;
   void Reset(bool reset_delay_confidence) override;
+  void SetDelay(size_t delay_blocks) override;
   void LogRenderCall() override;
   std::optional<DelayEstimate> GetDelay(
       const DownsampledRenderBuffer& render_buffer,
@@ -109,6 +110,14 @@ void RenderDelayControllerImpl::Reset(bool reset_delay_confidence) {
   }
 }
 
+void RenderDelayControllerImpl::SetDelay(size_t delay_blocks) {
+  delay_samples_ = DelayEstimate(DelayEstimate::Quality::kRefined,
+                                 delay_blocks << kBlockSizeLog2);
+  delay_ = ComputeBufferDelay(std::nullopt, 0, *delay_samples_);
+  last_delay_estimate_quality_ = DelayEstimate::Quality::kRefined;
+  delay_change_counter_ = 0;
+}
+
 void RenderDelayControllerImpl::LogRenderCall() {}
 
 std::optional<DelayEstimate> RenderDelayControllerImpl::GetDelay(
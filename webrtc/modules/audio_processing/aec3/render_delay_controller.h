@@ -35,6 +35,10 @@ class RenderDelayController {
   // behavior is as if the call is restarted.
   virtual void Reset(bool reset_delay_confidence) = 0;
 
+  // Sets the delay, in blocks, e.g., from a previous call over the same echo
+  // path. The delay is used until the delay estimator provides a new estimate.
+  virtual void SetDelay(size_t delay_blocks) = 0;
+
   // Logs a render call.
   virtual void LogRenderCall() = 0;
 
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_RENDER_FRAME_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_RENDER_FRAME_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+namespace webrtc {
+
+// Contains one or more channels of 10 milliseconds of audio data, split in one
+// or more frequency bands of 16 kHz each. All bands and channels are stored in
+// a single aligned allocation, laid out band by band, so that frames can be
+// swapped through a SwapQueue without any nested heap allocations.
+class RenderFrame {
+ public:
+  static constexpr size_t kAlignment = 64;
+
+  RenderFrame(int num_bands, int num_channels)
+      : num_bands_(num_bands),
+        num_channels_(num_channels),
+        data_(AlignedMalloc<float>(Size() * sizeof(float), kAlignment)) {
+    RTC_DCHECK_LT(0, num_bands_);
+    RTC_DCHECK_LT(0, num_channels_);
+    std::fill(data_.get(), data_.get() + Size(), 0.0f);
+  }
+
+  RenderFrame(const RenderFrame& other)
+      : num_bands_(other.num_bands_),
+        num_channels_(other.num_channels_),
+        data_(AlignedMalloc<float>(Size() * sizeof(float), kAlignment)) {
+    std::copy(other.data_.get(), other.data_.get() + Size(), data_.get());
+  }
+
+  RenderFrame(RenderFrame&& other) = default;
+  RenderFrame& operator=(RenderFrame&& other) = default;
+  RenderFrame& operator=(const RenderFrame&) = delete;
+
+  // Returns the number of bands.
+  int NumBands() const { return num_bands_; }
+
+  // Returns the number of channels.
+  int NumChannels() const { return num_channels_; }
+
+  // Access data via ArrayView.
+  rtc::ArrayView<float, kFrameSize> View(int band, int channel) {
+    return rtc::ArrayView<float, kFrameSize>(&data_[GetIndex(band, channel)],
+                                             kFrameSize);
+  }
+
+  rtc::ArrayView<const float, kFrameSize> View(int band, int channel) const {
+    return rtc::ArrayView<const float, kFrameSize>(
+        &data_[GetIndex(band, channel)], kFrameSize);
+  }
+
+  // Lets two RenderFrames swap audio data.
+  void Swap(RenderFrame& f) {
+    std::swap(num_bands_, f.num_bands_);
+    std::swap(num_channels_, f.num_channels_);
+    data_.swap(f.data_);
+  }
+
+ private:
+  size_t Size() const { return num_bands_ * num_channels_ * kFrameSize; }
+
+  // Returns the index of the first sample of the requested |band| and
+  // |channel|.
+  int GetIndex(int band, int channel) const {
+    RTC_DCHECK_LT(band, num_bands_);
+    RTC_DCHECK_LT(channel, num_channels_);
+    return (band * num_channels_ + channel) * kFrameSize;
+  }
+
+  int num_bands_;
+  int num_channels_;
+  std::unique_ptr<float[], AlignedFreeDeleter> data_;
+};
+
+// Used by SwapQueue, which swaps its items via an unqualified swap() call.
+inline void swap(RenderFrame& a, RenderFrame& b) {
+  a.Swap(b);
+}
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_RENDER_FRAME_H_
@@ -25,8 +25,11 @@ namespace webrtc {
 
 namespace {
 
-constexpr int kEarlyReverbMinSizeBlocks = 3;
-constexpr int kBlocksPerSection = 6;
+// The early reverb spans at least 192 samples and the sections used for its
+// analysis 384 samples, expressed in blocks.
+constexpr int kEarlyReverbMinSizeBlocks =
+    static_cast<int>((192 + kBlockSize - 1) / kBlockSize);
+constexpr int kBlocksPerSection = static_cast<int>(384 / kBlockSize);
 // Linear regression approach assumes symmetric index around 0.
 constexpr float kEarlyReverbFirstPointAtLinearRegressors =
     -0.5f * kBlocksPerSection * kFftLengthBy2 + 0.5f;
@@ -34,6 +34,13 @@ class ReverbDecayEstimator {
               int filter_delay_blocks,
               bool usable_linear_filter,
               bool stationary_signal);
+  // Sets the decay for the exponential model, e.g., from a previous call over
+  // the same echo path. Only has effect if the decay is adaptively estimated.
+  void SetDecay(float decay) {
+    if (use_adaptive_echo_decay_) {
+      decay_ = decay;
+    }
+  }
   // Returns the decay for the exponential model. The parameter `mild` indicates
   // which exponential decay to return, the default one or a milder one.
   float Decay(bool mild) const {
@@ -58,6 +58,14 @@ ReverbFrequencyResponse::ReverbFrequencyResponse(
 
 ReverbFrequencyResponse::~ReverbFrequencyResponse() = default;
 
+void ReverbFrequencyResponse::SetFrequencyResponse(
+    float average_decay,
+    rtc::ArrayView<const float, kFftLengthBy2Plus1> frequency_response) {
+  average_decay_ = average_decay;
+  std::copy(frequency_response.begin(), frequency_response.end(),
+            tail_response_.begin());
+}
+
 void ReverbFrequencyResponse::Update(
     const std::vector<std::array<float, kFftLengthBy2Plus1>>&
         frequency_response,
@@ -34,6 +34,15 @@ class ReverbFrequencyResponse {
               const std::optional<float>& linear_filter_quality,
               bool stationary_block);
 
+  // Sets the frequency response estimate and the average decay it is based on,
+  // e.g., from a previous call over the same echo path.
+  void SetFrequencyResponse(
+      float average_decay,
+      rtc::ArrayView<const float, kFftLengthBy2Plus1> frequency_response);
+
+  // Returns the average decay within the filter.
+  float AverageDecay() const { return average_decay_; }
+
   // Returns the estimated frequency response for the reverb.
   rtc::ArrayView<const float> FrequencyResponse() const {
     return tail_response_;
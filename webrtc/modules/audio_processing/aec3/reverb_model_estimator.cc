@@ -27,6 +27,17 @@ ReverbModelEstimator::ReverbModelEstimator(const EchoCanceller3Config& config,
 
 ReverbModelEstimator::~ReverbModelEstimator() = default;
 
+void ReverbModelEstimator::SetReverbModel(
+    float decay,
+    float average_decay,
+    rtc::ArrayView<const float, kFftLengthBy2Plus1> frequency_response) {
+  for (size_t ch = 0; ch < reverb_decay_estimators_.size(); ++ch) {
+    reverb_decay_estimators_[ch]->SetDecay(decay);
+    reverb_frequency_responses_[ch].SetFrequencyResponse(average_decay,
+                                                         frequency_response);
+  }
+}
+
 void ReverbModelEstimator::Update(
     rtc::ArrayView<const std::vector<float>> impulse_responses,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
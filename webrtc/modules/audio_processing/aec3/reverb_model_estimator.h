@@ -43,6 +43,13 @@ class ReverbModelEstimator {
       const std::vector<bool>& usable_linear_estimates,
       bool stationary_block);
 
+  // Sets the model parameters for all channels, e.g., from a previous call over
+  // the same echo path.
+  void SetReverbModel(
+      float decay,
+      float average_decay,
+      rtc::ArrayView<const float, kFftLengthBy2Plus1> frequency_response);
+
   // Returns the exponential decay of the reverberant echo. The parameter `mild`
   // indicates which exponential decay to return, the default one or a milder
   // one.
@@ -57,6 +64,11 @@ class ReverbModelEstimator {
     return reverb_frequency_responses_[0].FrequencyResponse();
   }
 
+  // Returns the average decay that the reverb frequency response is based on.
+  float AverageDecay() const {
+    return reverb_frequency_responses_[0].AverageDecay();
+  }
+
   // Dumps debug data.
   void Dump(ApmDataDumper* data_dumper) const {
     reverb_decay_estimators_[0]->Dump(data_dumper);
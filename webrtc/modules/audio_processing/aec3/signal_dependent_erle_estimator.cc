@@ -22,7 +22,13 @@ namespace webrtc {
 namespace {
 
 constexpr std::array<size_t, SignalDependentErleEstimator::kSubbands + 1>
-    kBandBoundaries = {1, 8, 16, 24, 32, 48, kFftLengthBy2Plus1};
+    kBandBoundaries = {1,
+                       kFftLengthBy2 / 8,
+                       kFftLengthBy2 / 4,
+                       3 * kFftLengthBy2 / 8,
+                       kFftLengthBy2 / 2,
+                       3 * kFftLengthBy2 / 4,
+                       kFftLengthBy2Plus1};
 
 std::array<size_t, kFftLengthBy2Plus1> FormSubbandMap() {
   std::array<size_t, kFftLengthBy2Plus1> map_band_to_subband;
@@ -357,9 +363,8 @@ void SignalDependentErleEstimator::ComputeEchoEstimatePerFilterSection(
   for (size_t capture_ch = 0; capture_ch < num_capture_channels; ++capture_ch) {
     RTC_DCHECK_EQ(S2_section_accum_[capture_ch].size() + 1,
                   section_boundaries_blocks_.size());
-    size_t idx_render = render_buffer.Position();
-    idx_render = spectrum_render_buffer.OffsetIndex(
-        idx_render, section_boundaries_blocks_[0]);
+    size_t idx_render = spectrum_render_buffer.OffsetIndex(
+        spectrum_render_buffer.read, section_boundaries_blocks_[0]);
 
     for (size_t section = 0; section < num_sections_; ++section) {
       std::array<float, kFftLengthBy2Plus1> X2_section;
@@ -71,6 +71,20 @@ void SubbandErleEstimator::Reset() {
   ResetAccumulatedSpectra();
 }
 
+void SubbandErleEstimator::SetErle(
+    rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle) {
+  RTC_DCHECK_EQ(erle_.size(), erle.size());
+  for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      erle_[ch][k] = rtc::SafeClamp(erle[ch][k], min_erle_, max_erle_[k]);
+    }
+    erle_onset_compensated_[ch] = erle_[ch];
+    erle_unbounded_[ch] = erle_[ch];
+    erle_during_onsets_[ch] = erle_[ch];
+  }
+  ResetAccumulatedSpectra();
+}
+
 void SubbandErleEstimator::Update(
     rtc::ArrayView<const float, kFftLengthBy2Plus1> X2,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
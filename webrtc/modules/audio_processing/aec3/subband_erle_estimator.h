@@ -40,6 +40,11 @@ class SubbandErleEstimator {
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> E2,
               const std::vector<bool>& converged_filters);
 
+  // Sets the ERLE estimates, e.g., from a previous call over the same echo
+  // path.
+  void SetErle(
+      rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle);
+
   // Returns the ERLE estimate.
   rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Erle(
       bool onset_compensated) const {
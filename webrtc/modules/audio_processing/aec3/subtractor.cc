@@ -66,9 +66,11 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
                        size_t num_render_channels,
                        size_t num_capture_channels,
                        ApmDataDumper* data_dumper,
-                       Aec3Optimization optimization)
+                       Aec3Optimization optimization,
+                       ChannelWorkerPool* worker_pool)
     : fft_(),
       data_dumper_(data_dumper),
+      worker_pool_(worker_pool),
       optimization_(optimization),
       config_(config),
       num_capture_channels_(num_capture_channels),
@@ -105,18 +107,23 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
     }
   }
 
+  // There are no Neon half precision kernels, and the scalar conversion would
+  // make the filters slower than with single precision storage.
+  const bool half_precision_storage =
+      config.filter.half_precision_storage &&
+      optimization != Aec3Optimization::kNeon;
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     refined_filters_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.refined.length_blocks,
         config_.filter.refined_initial.length_blocks,
         config.filter.config_change_duration_blocks, num_render_channels,
-        optimization, data_dumper_);
+        half_precision_storage, optimization, data_dumper_);
 
     coarse_filter_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.coarse.length_blocks,
         config_.filter.coarse_initial.length_blocks,
         config.filter.config_change_duration_blocks, num_render_channels,
-        optimization, data_dumper_);
+        half_precision_storage, optimization, data_dumper_);
     refined_gains_[ch] = std::make_unique<RefinedFilterUpdateGain>(
         config_.filter.refined_initial,
         config_.filter.config_change_duration_blocks);
@@ -175,6 +182,33 @@ void Subtractor::ExitInitialState() {
   }
 }
 
+void Subtractor::GetFilters(
+    std::vector<std::vector<std::vector<FftData>>>* filters) const {
+  RTC_DCHECK(filters);
+  filters->resize(num_capture_channels_);
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    refined_filters_[ch]->GetFilter(refined_filters_[ch]->SizePartitions(),
+                                    &(*filters)[ch]);
+  }
+}
+
+void Subtractor::SetFilters(
+    const std::vector<std::vector<std::vector<FftData>>>& filters) {
+  RTC_DCHECK_EQ(num_capture_channels_, filters.size());
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    refined_gains_[ch]->SetConfig(config_.filter.refined, true);
+    coarse_gains_[ch]->SetConfig(config_.filter.coarse, true);
+    refined_filters_[ch]->SetSizePartitions(
+        config_.filter.refined.length_blocks, true);
+    coarse_filter_[ch]->SetSizePartitions(config_.filter.coarse.length_blocks,
+                                          true);
+    refined_filters_[ch]->SetFilter(filters[ch].size(), filters[ch],
+                                    &refined_impulse_responses_[ch]);
+    coarse_filter_[ch]->SetFilter(filters[ch].size(), filters[ch]);
+    poor_coarse_filter_counters_[ch] = 0;
+  }
+}
+
 void Subtractor::Process(const RenderBuffer& render_buffer,
                          const Block& capture,
                          const RenderSignalAnalyzer& render_signal_analyzer,
@@ -203,124 +237,165 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
   }
 
   // Process all capture channels
+  if (worker_pool_) {
+    worker_pool_->ParallelFor(num_capture_channels_, [&](size_t ch) {
+      ProcessChannel(ch, render_buffer, capture, render_signal_analyzer,
+                     aec_state, X2_refined, X2_coarse, outputs[ch]);
+    });
+  } else {
+    for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+      ProcessChannel(ch, render_buffer, capture, render_signal_analyzer,
+                     aec_state, X2_refined, X2_coarse, outputs[ch]);
+    }
+  }
+}
+
+void Subtractor::ProcessRenderSilence(
+    const Block& capture,
+    rtc::ArrayView<SubtractorOutput> outputs) {
+  RTC_DCHECK_EQ(num_capture_channels_, capture.NumChannels());
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-    SubtractorOutput& output = outputs[ch];
     rtc::ArrayView<const float> y = capture.View(/*band=*/0, ch);
-    FftData& E_refined = output.E_refined;
-    FftData E_coarse;
-    std::array<float, kBlockSize>& e_refined = output.e_refined;
-    std::array<float, kBlockSize>& e_coarse = output.e_coarse;
-
-    FftData S;
-    FftData& G = S;
-
-    // Form the outputs of the refined and coarse filters.
-    refined_filters_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_refined, &output.s_refined);
+    SubtractorOutput& output = outputs[ch];
+    output.s_refined.fill(0.f);
+    output.s_coarse.fill(0.f);
+    std::copy(y.begin(), y.end(), output.e_refined.begin());
+    std::copy(y.begin(), y.end(), output.e_coarse.begin());
+    output.ComputeMetrics(y);
 
-    coarse_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
+    fft_.ZeroPaddedFft(output.e_refined, Aec3Fft::Window::kHanning,
+                       &output.E_refined);
+    output.E_refined.Spectrum(optimization_, output.E2_refined);
+    output.E2_coarse = output.E2_refined;
 
-    // Compute the signal powers in the subtractor output.
-    output.ComputeMetrics(y);
+    std::for_each(output.e_refined.begin(), output.e_refined.end(),
+                  [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+  }
+}
 
-    // Adjust the filter if needed.
-    bool refined_filters_adjusted = false;
-    filter_misadjustment_estimators_[ch].Update(output);
-    if (filter_misadjustment_estimators_[ch].IsAdjustmentNeeded()) {
-      float scale = filter_misadjustment_estimators_[ch].GetMisadjustment();
-      refined_filters_[ch]->ScaleFilter(scale);
-      for (auto& h_k : refined_impulse_responses_[ch]) {
-        h_k *= scale;
-      }
-      ScaleFilterOutput(y, scale, e_refined, output.s_refined);
-      filter_misadjustment_estimators_[ch].Reset();
-      refined_filters_adjusted = true;
+void Subtractor::ProcessChannel(
+    size_t ch,
+    const RenderBuffer& render_buffer,
+    const Block& capture,
+    const RenderSignalAnalyzer& render_signal_analyzer,
+    const AecState& aec_state,
+    const std::array<float, kFftLengthBy2Plus1>& X2_refined,
+    const std::array<float, kFftLengthBy2Plus1>& X2_coarse,
+    SubtractorOutput& output) {
+  rtc::ArrayView<const float> y = capture.View(/*band=*/0, ch);
+  FftData& E_refined = output.E_refined;
+  FftData E_coarse;
+  std::array<float, kBlockSize>& e_refined = output.e_refined;
+  std::array<float, kBlockSize>& e_coarse = output.e_coarse;
+
+  FftData S;
+  FftData& G = S;
+
+  // Form the outputs of the refined and coarse filters.
+  refined_filters_[ch]->Filter(render_buffer, &S);
+  PredictionError(fft_, S, y, &e_refined, &output.s_refined);
+
+  coarse_filter_[ch]->Filter(render_buffer, &S);
+  PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
+
+  // Compute the signal powers in the subtractor output.
+  output.ComputeMetrics(y);
+
+  // Adjust the filter if needed.
+  bool refined_filters_adjusted = false;
+  filter_misadjustment_estimators_[ch].Update(output);
+  if (filter_misadjustment_estimators_[ch].IsAdjustmentNeeded()) {
+    float scale = filter_misadjustment_estimators_[ch].GetMisadjustment();
+    refined_filters_[ch]->ScaleFilter(scale);
+    for (auto& h_k : refined_impulse_responses_[ch]) {
+      h_k *= scale;
     }
+    ScaleFilterOutput(y, scale, e_refined, output.s_refined);
+    filter_misadjustment_estimators_[ch].Reset();
+    refined_filters_adjusted = true;
+  }
 
-    // Compute the FFts of the refined and coarse filter outputs.
-    fft_.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
-    fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
-
-    // Compute spectra for future use.
-    E_coarse.Spectrum(optimization_, output.E2_coarse);
-    E_refined.Spectrum(optimization_, output.E2_refined);
-
-    // Update the refined filter.
-    if (!refined_filters_adjusted) {
-      // Do not allow the performance of the coarse filter to affect the
-      // adaptation speed of the refined filter just after the coarse filter has
-      // been reset.
-      const bool disallow_leakage_diverged =
-          coarse_filter_reset_hangover_[ch] > 0 &&
-          use_coarse_filter_reset_hangover_;
-
-      std::array<float, kFftLengthBy2Plus1> erl;
-      ComputeErl(optimization_, refined_frequency_responses_[ch], erl);
-      refined_gains_[ch]->Compute(X2_refined, render_signal_analyzer, output,
-                                  erl, refined_filters_[ch]->SizePartitions(),
-                                  aec_state.SaturatedCapture(),
-                                  disallow_leakage_diverged, &G);
-    } else {
-      G.re.fill(0.f);
-      G.im.fill(0.f);
-    }
-    refined_filters_[ch]->Adapt(render_buffer, G,
-                                &refined_impulse_responses_[ch]);
-    refined_filters_[ch]->ComputeFrequencyResponse(
-        &refined_frequency_responses_[ch]);
-
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
-    }
+  // Compute the FFts of the refined and coarse filter outputs.
+  fft_.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
+  fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
+
+  // Compute spectra for future use.
+  E_coarse.Spectrum(optimization_, output.E2_coarse);
+  E_refined.Spectrum(optimization_, output.E2_refined);
+
+  // Update the refined filter.
+  if (!refined_filters_adjusted) {
+    // Do not allow the performance of the coarse filter to affect the
+    // adaptation speed of the refined filter just after the coarse filter has
+    // been reset.
+    const bool disallow_leakage_diverged =
+        coarse_filter_reset_hangover_[ch] > 0 &&
+        use_coarse_filter_reset_hangover_;
+
+    std::array<float, kFftLengthBy2Plus1> erl;
+    ComputeErl(optimization_, refined_frequency_responses_[ch], erl);
+    refined_gains_[ch]->Compute(X2_refined, render_signal_analyzer, output, erl,
+                                refined_filters_[ch]->SizePartitions(),
+                                aec_state.SaturatedCapture(),
+                                disallow_leakage_diverged, &G);
+  } else {
+    G.re.fill(0.f);
+    G.im.fill(0.f);
+  }
+  refined_filters_[ch]->Adapt(render_buffer, G,
+                              &refined_impulse_responses_[ch]);
+  refined_filters_[ch]->ComputeFrequencyResponse(
+      &refined_frequency_responses_[ch]);
+
+  if (ch == 0) {
+    data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
+  }
 
-    // Update the coarse filter.
-    poor_coarse_filter_counters_[ch] =
-        output.e2_refined < output.e2_coarse
-            ? poor_coarse_filter_counters_[ch] + 1
-            : 0;
-    if (poor_coarse_filter_counters_[ch] < 5) {
-      coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_coarse,
-                                 coarse_filter_[ch]->SizePartitions(),
-                                 aec_state.SaturatedCapture(), &G);
-      coarse_filter_reset_hangover_[ch] =
-          std::max(coarse_filter_reset_hangover_[ch] - 1, 0);
-    } else {
-      poor_coarse_filter_counters_[ch] = 0;
-      coarse_filter_[ch]->SetFilter(refined_filters_[ch]->SizePartitions(),
-                                    refined_filters_[ch]->GetFilter());
-      coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_refined,
-                                 coarse_filter_[ch]->SizePartitions(),
-                                 aec_state.SaturatedCapture(), &G);
-      coarse_filter_reset_hangover_[ch] =
-          config_.filter.coarse_reset_hangover_blocks;
-    }
+  // Update the coarse filter.
+  poor_coarse_filter_counters_[ch] =
+      output.e2_refined < output.e2_coarse
+          ? poor_coarse_filter_counters_[ch] + 1
+          : 0;
+  if (poor_coarse_filter_counters_[ch] < 5) {
+    coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_coarse,
+                               coarse_filter_[ch]->SizePartitions(),
+                               aec_state.SaturatedCapture(), &G);
+    coarse_filter_reset_hangover_[ch] =
+        std::max(coarse_filter_reset_hangover_[ch] - 1, 0);
+  } else {
+    poor_coarse_filter_counters_[ch] = 0;
+    coarse_filter_[ch]->SetFilter(refined_filters_[ch]->SizePartitions(),
+                                  *refined_filters_[ch]);
+    coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_refined,
+                               coarse_filter_[ch]->SizePartitions(),
+                               aec_state.SaturatedCapture(), &G);
+    coarse_filter_reset_hangover_[ch] =
+        config_.filter.coarse_reset_hangover_blocks;
+  }
 
-    if (ApmDataDumper::IsAvailable()) {
-      RTC_DCHECK_LT(ch, coarse_impulse_responses_.size());
-      coarse_filter_[ch]->Adapt(render_buffer, G,
-                                &coarse_impulse_responses_[ch]);
-    } else {
-      coarse_filter_[ch]->Adapt(render_buffer, G);
-    }
+  if (ApmDataDumper::IsAvailable()) {
+    RTC_DCHECK_LT(ch, coarse_impulse_responses_.size());
+    coarse_filter_[ch]->Adapt(render_buffer, G, &coarse_impulse_responses_[ch]);
+  } else {
+    coarse_filter_[ch]->Adapt(render_buffer, G);
+  }
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
-      filter_misadjustment_estimators_[ch].Dump(data_dumper_);
-      DumpFilters();
-    }
+  if (ch == 0) {
+    data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
+    filter_misadjustment_estimators_[ch].Dump(data_dumper_);
+    DumpFilters();
+  }
 
-    std::for_each(e_refined.begin(), e_refined.end(),
-                  [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+  std::for_each(e_refined.begin(), e_refined.end(),
+                [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
 
-    if (ch == 0) {
-      data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
-                            &e_refined[0], 16000, 1);
-      data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
-                            &e_coarse[0], 16000, 1);
-    }
+  if (ch == 0) {
+    data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
+                          &e_refined[0], 16000, 1);
+    data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
+                          &e_coarse[0], 16000, 1);
   }
 }
 
@@ -24,8 +24,10 @@
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/aec_state.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/channel_worker_pool.h"
 #include "modules/audio_processing/aec3/coarse_filter_update_gain.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
+#include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/refined_filter_update_gain.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
@@ -38,11 +40,14 @@ namespace webrtc {
 // Proves linear echo cancellation functionality
 class Subtractor {
  public:
+  // If `worker_pool` is non-null, the capture channels are processed in
+  // parallel on the pool. The pool must outlive the Subtractor.
   Subtractor(const EchoCanceller3Config& config,
              size_t num_render_channels,
              size_t num_capture_channels,
              ApmDataDumper* data_dumper,
-             Aec3Optimization optimization);
+             Aec3Optimization optimization,
+             ChannelWorkerPool* worker_pool);
   ~Subtractor();
   Subtractor(const Subtractor&) = delete;
   Subtractor& operator=(const Subtractor&) = delete;
@@ -54,11 +59,27 @@ class Subtractor {
                const AecState& aec_state,
                rtc::ArrayView<SubtractorOutput> outputs);
 
+  // Forms the outputs for a block during which all the render data is silent,
+  // in which case the filter outputs are zero. The filtering and the filter
+  // adaptation are skipped and the filters are left unchanged.
+  void ProcessRenderSilence(const Block& capture,
+                            rtc::ArrayView<SubtractorOutput> outputs);
+
   void HandleEchoPathChange(const EchoPathVariability& echo_path_variability);
 
   // Exits the initial state.
   void ExitInitialState();
 
+  // Copies the partitions of the refined filters, one set per capture channel,
+  // into `filters`.
+  void GetFilters(
+      std::vector<std::vector<std::vector<FftData>>>* filters) const;
+
+  // Initializes the refined and coarse filters with the supplied refined
+  // filter partitions and exits the initial state immediately.
+  void SetFilters(
+      const std::vector<std::vector<std::vector<FftData>>>& filters);
+
   // Returns the block-wise frequency responses for the refined adaptive
   // filters.
   const std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>&
@@ -125,8 +146,19 @@ class Subtractor {
     int overhang_ = 0.f;
   };
 
+  // Performs the echo subtraction for capture channel `ch`.
+  void ProcessChannel(size_t ch,
+                      const RenderBuffer& render_buffer,
+                      const Block& capture,
+                      const RenderSignalAnalyzer& render_signal_analyzer,
+                      const AecState& aec_state,
+                      const std::array<float, kFftLengthBy2Plus1>& X2_refined,
+                      const std::array<float, kFftLengthBy2Plus1>& X2_coarse,
+                      SubtractorOutput& output);
+
   const Aec3Fft fft_;
   ApmDataDumper* data_dumper_;
+  ChannelWorkerPool* const worker_pool_;
   const Aec3Optimization optimization_;
   const EchoCanceller3Config config_;
   const size_t num_capture_channels_;
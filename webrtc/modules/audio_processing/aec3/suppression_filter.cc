@@ -16,49 +16,12 @@
 #include <functional>
 #include <iterator>
 
+#include "modules/audio_processing/aec3/fft_windows.h"
 #include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
-namespace {
-
-// Hanning window from Matlab command win = sqrt(hanning(128)).
-const float kSqrtHanning[kFftLength] = {
-    0.00000000000000f, 0.02454122852291f, 0.04906767432742f, 0.07356456359967f,
-    0.09801714032956f, 0.12241067519922f, 0.14673047445536f, 0.17096188876030f,
-    0.19509032201613f, 0.21910124015687f, 0.24298017990326f, 0.26671275747490f,
-    0.29028467725446f, 0.31368174039889f, 0.33688985339222f, 0.35989503653499f,
-    0.38268343236509f, 0.40524131400499f, 0.42755509343028f, 0.44961132965461f,
-    0.47139673682600f, 0.49289819222978f, 0.51410274419322f, 0.53499761988710f,
-    0.55557023301960f, 0.57580819141785f, 0.59569930449243f, 0.61523159058063f,
-    0.63439328416365f, 0.65317284295378f, 0.67155895484702f, 0.68954054473707f,
-    0.70710678118655f, 0.72424708295147f, 0.74095112535496f, 0.75720884650648f,
-    0.77301045336274f, 0.78834642762661f, 0.80320753148064f, 0.81758481315158f,
-    0.83146961230255f, 0.84485356524971f, 0.85772861000027f, 0.87008699110871f,
-    0.88192126434835f, 0.89322430119552f, 0.90398929312344f, 0.91420975570353f,
-    0.92387953251129f, 0.93299279883474f, 0.94154406518302f, 0.94952818059304f,
-    0.95694033573221f, 0.96377606579544f, 0.97003125319454f, 0.97570213003853f,
-    0.98078528040323f, 0.98527764238894f, 0.98917650996478f, 0.99247953459871f,
-    0.99518472667220f, 0.99729045667869f, 0.99879545620517f, 0.99969881869620f,
-    1.00000000000000f, 0.99969881869620f, 0.99879545620517f, 0.99729045667869f,
-    0.99518472667220f, 0.99247953459871f, 0.98917650996478f, 0.98527764238894f,
-    0.98078528040323f, 0.97570213003853f, 0.97003125319454f, 0.96377606579544f,
-    0.95694033573221f, 0.94952818059304f, 0.94154406518302f, 0.93299279883474f,
-    0.92387953251129f, 0.91420975570353f, 0.90398929312344f, 0.89322430119552f,
-    0.88192126434835f, 0.87008699110871f, 0.85772861000027f, 0.84485356524971f,
-    0.83146961230255f, 0.81758481315158f, 0.80320753148064f, 0.78834642762661f,
-    0.77301045336274f, 0.75720884650648f, 0.74095112535496f, 0.72424708295147f,
-    0.70710678118655f, 0.68954054473707f, 0.67155895484702f, 0.65317284295378f,
-    0.63439328416365f, 0.61523159058063f, 0.59569930449243f, 0.57580819141785f,
-    0.55557023301960f, 0.53499761988710f, 0.51410274419322f, 0.49289819222978f,
-    0.47139673682600f, 0.44961132965461f, 0.42755509343028f, 0.40524131400499f,
-    0.38268343236509f, 0.35989503653499f, 0.33688985339222f, 0.31368174039889f,
-    0.29028467725446f, 0.26671275747490f, 0.24298017990326f, 0.21910124015687f,
-    0.19509032201613f, 0.17096188876030f, 0.14673047445536f, 0.12241067519922f,
-    0.09801714032956f, 0.07356456359967f, 0.04906767432742f, 0.02454122852291f};
-
-}  // namespace
 
 SuppressionFilter::SuppressionFilter(Aec3Optimization optimization,
                                      int sample_rate_hz,
@@ -127,8 +90,8 @@ void SuppressionFilter::ApplyGain(
     // Window and add the first half of e_extended with the second half of
     // e_extended from the previous block.
     for (size_t i = 0; i < kFftLengthBy2; ++i) {
-      float e0_i = e0_old[i] * kSqrtHanning[kFftLengthBy2 + i];
-      e0_i += e_extended[i] * kSqrtHanning[i];
+      float e0_i = e0_old[i] * aec3::kSqrtHanning[kFftLengthBy2 + i];
+      e0_i += e_extended[i] * aec3::kSqrtHanning[i];
       e0[i] = e0_i * kIfftNormalization;
     }
 
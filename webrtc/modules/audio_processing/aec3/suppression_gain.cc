@@ -15,13 +15,16 @@
 
 #include <algorithm>
 #include <numeric>
+#include <utility>
 
+#include "modules/audio_processing/aec3/audible_echo_gain.h"
 #include "modules/audio_processing/aec3/dominant_nearend_detector.h"
 #include "modules/audio_processing/aec3/moving_average.h"
 #include "modules/audio_processing/aec3/subband_nearend_detector.h"
 #include "modules/audio_processing/aec3/vector_math.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
@@ -37,7 +40,7 @@ void LimitHighFrequencyGains(bool conservative_hf_suppression,
                              std::array<float, kFftLengthBy2Plus1>* gain) {
   // Limit the high frequency gains to avoid echo leakage due to an imperfect
   // filter.
-  constexpr size_t kFirstBandToLimit = (64 * 2000) / 8000;
+  constexpr size_t kFirstBandToLimit = (kFftLengthBy2 * 2000) / 8000;
   const float min_upper_gain = (*gain)[kFirstBandToLimit];
   std::for_each(
       gain->begin() + kFirstBandToLimit + 1, gain->end(),
@@ -172,8 +175,10 @@ float SuppressionGain::UpperBandsGain(
     // Bound the upper gain during significant echo activity.
     const auto& cfg = config_.suppressor.high_bands_suppression;
     auto low_frequency_energy = [](rtc::ArrayView<const float> spectrum) {
-      RTC_DCHECK_LE(16, spectrum.size());
-      return std::accumulate(spectrum.begin() + 1, spectrum.begin() + 16, 0.f);
+      constexpr size_t kLastBin = kFftLengthBy2 / 4;
+      RTC_DCHECK_LE(kLastBin, spectrum.size());
+      return std::accumulate(spectrum.begin() + 1, spectrum.begin() + kLastBin,
+                             0.f);
     };
     for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
       const float echo_sum = low_frequency_energy(echo_spectrum[ch]);
@@ -197,16 +202,24 @@ void SuppressionGain::GainToNoAudibleEcho(
     std::array<float, kFftLengthBy2Plus1>* gain) const {
   const auto& p = dominant_nearend_detector_->IsNearendState() ? nearend_params_
                                                                : normal_params_;
-  for (size_t k = 0; k < gain->size(); ++k) {
-    float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
-    float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
-    float g = 1.0f;
-    if (enr > p.enr_transparent_[k] && emr > p.emr_transparent_[k]) {
-      g = (p.enr_suppress_[k] - enr) /
-          (p.enr_suppress_[k] - p.enr_transparent_[k]);
-      g = std::max(g, p.emr_transparent_[k] / emr);
-    }
-    (*gain)[k] = g;
+  switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+    case Aec3Optimization::kSse2:
+      aec3::GainToNoAudibleEcho_SSE2(nearend, echo, masker, p.enr_transparent_,
+                                     p.enr_suppress_, p.emr_transparent_,
+                                     *gain);
+      break;
+#endif
+    case Aec3Optimization::kAvx2:
+      aec3::GainToNoAudibleEcho_AVX2(nearend, echo, masker, p.enr_transparent_,
+                                     p.enr_suppress_, p.emr_transparent_,
+                                     *gain);
+      break;
+#endif
+    default:
+      aec3::GainToNoAudibleEcho(nearend, echo, masker, p.enr_transparent_,
+                                p.enr_suppress_, p.emr_transparent_, *gain);
   }
 }
 
@@ -224,11 +237,22 @@ void SuppressionGain::GetMinGain(
         low_noise_render ? config_.echo_audibility.low_render_limit
                          : config_.echo_audibility.normal_render_limit;
 
-    for (size_t k = 0; k < min_gain.size(); ++k) {
-      min_gain[k] = weighted_residual_echo[k] > 0.f
-                        ? min_echo_power / weighted_residual_echo[k]
-                        : 1.f;
-      min_gain[k] = std::min(min_gain[k], 1.f);
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+      case Aec3Optimization::kSse2:
+        aec3::MinGainForEchoPower_SSE2(min_echo_power, weighted_residual_echo,
+                                       min_gain);
+        break;
+#endif
+      case Aec3Optimization::kAvx2:
+        aec3::MinGainForEchoPower_AVX2(min_echo_power, weighted_residual_echo,
+                                       min_gain);
+        break;
+#endif
+      default:
+        aec3::MinGainForEchoPower(min_echo_power, weighted_residual_echo,
+                                  min_gain);
     }
 
     if (!initial_state_ ||
@@ -280,11 +304,11 @@ void SuppressionGain::LowerBandGain(
 
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     std::array<float, kFftLengthBy2Plus1> G;
-    std::array<float, kFftLengthBy2Plus1> nearend;
+    auto& nearend = nearend_[ch];
     nearend_smoothers_[ch].Average(suppressor_input[ch], nearend);
 
     // Weight echo power in terms of audibility.
-    std::array<float, kFftLengthBy2Plus1> weighted_residual_echo;
+    auto& weighted_residual_echo = weighted_residual_echo_[ch];
     WeightEchoForAudibility(config_, residual_echo[ch], weighted_residual_echo);
 
     std::array<float, kFftLengthBy2Plus1> min_gain;
@@ -294,17 +318,27 @@ void SuppressionGain::LowerBandGain(
     GainToNoAudibleEcho(nearend, weighted_residual_echo, comfort_noise[0], &G);
 
     // Clamp gains.
-    for (size_t k = 0; k < gain->size(); ++k) {
-      G[k] = std::max(std::min(G[k], max_gain[k]), min_gain[k]);
-      (*gain)[k] = std::min((*gain)[k], G[k]);
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if !defined(WAP_DISABLE_INLINE_SSE)
+      case Aec3Optimization::kSse2:
+        aec3::ApplyGainBounds_SSE2(G, min_gain, max_gain, *gain);
+        break;
+#endif
+      case Aec3Optimization::kAvx2:
+        aec3::ApplyGainBounds_AVX2(G, min_gain, max_gain, *gain);
+        break;
+#endif
+      default:
+        aec3::ApplyGainBounds(G, min_gain, max_gain, *gain);
     }
-
-    // Store data required for the gain computation of the next block.
-    std::copy(nearend.begin(), nearend.end(), last_nearend_[ch].begin());
-    std::copy(weighted_residual_echo.begin(), weighted_residual_echo.end(),
-              last_echo_[ch].begin());
   }
 
+  // Keep the data required for the gain computation of the next block. The
+  // buffers are swapped rather than copied.
+  std::swap(last_nearend_, nearend_);
+  std::swap(last_echo_, weighted_residual_echo_);
+
   LimitLowFrequencyGains(gain);
   // Use conservative high-frequency gains during clock-drift or when not in
   // dominant nearend.
@@ -333,6 +367,8 @@ SuppressionGain::SuppressionGain(const EchoCanceller3Config& config,
           static_cast<int>(config_.filter.config_change_duration_blocks)),
       last_nearend_(num_capture_channels_, {0}),
       last_echo_(num_capture_channels_, {0}),
+      nearend_(num_capture_channels_),
+      weighted_residual_echo_(num_capture_channels_),
       nearend_smoothers_(
           num_capture_channels_,
           aec3::MovingAverage(kFftLengthBy2Plus1,
@@ -428,7 +464,7 @@ bool SuppressionGain::LowNoiseRenderDetector::Detect(const Block& render) {
   }
   x2_sum = x2_sum / render.NumChannels();
 
-  constexpr float kThreshold = 50.f * 50.f * 64.f;
+  constexpr float kThreshold = 50.f * 50.f * kBlockSize;
   const bool low_noise_render =
       average_power_ < kThreshold && x2_max < 3 * average_power_;
   average_power_ = average_power_ * 0.9f + x2_sum * 0.1f;
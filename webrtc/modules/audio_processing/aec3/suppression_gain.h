@@ -128,6 +128,8 @@ class SuppressionGain {
   std::array<float, kFftLengthBy2Plus1> last_gain_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> last_nearend_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> last_echo_;
+  std::vector<std::array<float, kFftLengthBy2Plus1>> nearend_;
+  std::vector<std::array<float, kFftLengthBy2Plus1>> weighted_residual_echo_;
   LowNoiseRenderDetector low_render_detector_;
   bool initial_state_ = true;
   int initial_state_change_counter_ = 0;
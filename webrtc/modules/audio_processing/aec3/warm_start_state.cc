@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/warm_start_state.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace webrtc {
+namespace {
+
+// Identifies the serialization format. The FFT size is part of it, since the
+// spectra depend on the configured block size.
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kFormatSpectrumSize = kFftLengthBy2Plus1;
+
+// Appends the raw bytes of values to a byte sequence.
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>* data) : data_(data) {}
+
+  template <typename T>
+  void Write(const T& value) {
+    Write(&value, 1);
+  }
+
+  template <typename T>
+  void Write(const T* values, size_t num_values) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+    data_->insert(data_->end(), bytes, bytes + num_values * sizeof(T));
+  }
+
+ private:
+  std::vector<uint8_t>* const data_;
+};
+
+// Reads values written by Writer. Each read fails once the data is exhausted.
+class Reader {
+ public:
+  explicit Reader(rtc::ArrayView<const uint8_t> data) : data_(data) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    return Read(value, 1);
+  }
+
+  template <typename T>
+  bool Read(T* values, size_t num_values) {
+    if (num_values > Remaining() / sizeof(T)) {
+      return false;
+    }
+    memcpy(values, data_.data() + position_, num_values * sizeof(T));
+    position_ += num_values * sizeof(T);
+    return true;
+  }
+
+  // Reads a count of items that each occupy at least `min_item_size` bytes,
+  // which bounds the count by the remaining data.
+  bool ReadCount(size_t min_item_size, size_t* count) {
+    uint32_t value;
+    if (!Read(&value) || value > Remaining() / min_item_size) {
+      return false;
+    }
+    *count = value;
+    return true;
+  }
+
+  size_t Remaining() const { return data_.size() - position_; }
+
+ private:
+  const rtc::ArrayView<const uint8_t> data_;
+  size_t position_ = 0;
+};
+
+constexpr size_t kSpectrumBytes = kFftLengthBy2Plus1 * sizeof(float);
+
+bool AllFinite(rtc::ArrayView<const float> values) {
+  return std::all_of(values.begin(), values.end(),
+                     [](float value) { return std::isfinite(value); });
+}
+
+// The state is restored from caller-provided bytes, so any value that would
+// propagate NaN or Inf into the filters or the estimators is rejected.
+bool IsFinite(const Aec3WarmStartState& state) {
+  for (const auto& filter : state.filters) {
+    for (const auto& partition : filter) {
+      for (const FftData& H : partition) {
+        if (!AllFinite(H.re) || !AllFinite(H.im)) {
+          return false;
+        }
+      }
+    }
+  }
+  for (const auto& erle : state.erle) {
+    if (!AllFinite(erle)) {
+      return false;
+    }
+  }
+  return AllFinite(state.erl) && std::isfinite(state.erl_time_domain) &&
+         AllFinite(state.fullband_erle_log2) &&
+         std::isfinite(state.reverb_decay) &&
+         std::isfinite(state.reverb_average_decay) &&
+         AllFinite(state.reverb_frequency_response);
+}
+
+}  // namespace
+
+std::vector<uint8_t> SerializeWarmStartState(const Aec3WarmStartState& state) {
+  std::vector<uint8_t> data;
+  Writer writer(&data);
+  writer.Write(kFormatVersion);
+  writer.Write(kFormatSpectrumSize);
+
+  writer.Write(static_cast<uint8_t>(state.delay_blocks.has_value()));
+  writer.Write(static_cast<uint32_t>(state.delay_blocks.value_or(0)));
+
+  writer.Write(static_cast<uint32_t>(state.filters.size()));
+  for (const auto& filter : state.filters) {
+    writer.Write(static_cast<uint32_t>(filter.size()));
+    writer.Write(static_cast<uint32_t>(filter.empty() ? 0 : filter[0].size()));
+    for (const auto& partition : filter) {
+      for (const FftData& H : partition) {
+        writer.Write(H.re.data(), H.re.size());
+        writer.Write(H.im.data(), H.im.size());
+      }
+    }
+  }
+
+  writer.Write(state.erl.data(), state.erl.size());
+  writer.Write(state.erl_time_domain);
+
+  writer.Write(static_cast<uint32_t>(state.erle.size()));
+  for (const auto& erle : state.erle) {
+    writer.Write(erle.data(), erle.size());
+  }
+  writer.Write(static_cast<uint32_t>(state.fullband_erle_log2.size()));
+  writer.Write(state.fullband_erle_log2.data(),
+               state.fullband_erle_log2.size());
+
+  writer.Write(state.reverb_decay);
+  writer.Write(state.reverb_average_decay);
+  writer.Write(state.reverb_frequency_response.data(),
+               state.reverb_frequency_response.size());
+  return data;
+}
+
+std::optional<Aec3WarmStartState> DeserializeWarmStartState(
+    rtc::ArrayView<const uint8_t> data) {
+  Reader reader(data);
+  uint32_t version;
+  uint32_t spectrum_size;
+  if (!reader.Read(&version) || version != kFormatVersion ||
+      !reader.Read(&spectrum_size) || spectrum_size != kFormatSpectrumSize) {
+    return std::nullopt;
+  }
+
+  Aec3WarmStartState state;
+  uint8_t has_delay;
+  uint32_t delay_blocks;
+  if (!reader.Read(&has_delay) || !reader.Read(&delay_blocks)) {
+    return std::nullopt;
+  }
+  if (has_delay) {
+    state.delay_blocks = delay_blocks;
+  }
+
+  size_t num_capture_channels;
+  if (!reader.ReadCount(2 * sizeof(uint32_t), &num_capture_channels)) {
+    return std::nullopt;
+  }
+  state.filters.resize(num_capture_channels);
+  for (auto& filter : state.filters) {
+    size_t num_partitions;
+    uint32_t num_render_channels;
+    if (!reader.ReadCount(sizeof(uint32_t), &num_partitions) ||
+        !reader.Read(&num_render_channels)) {
+      return std::nullopt;
+    }
+    if (num_partitions > 0 &&
+        (num_render_channels == 0 ||
+         num_render_channels >
+             reader.Remaining() / (2 * kSpectrumBytes) / num_partitions)) {
+      return std::nullopt;
+    }
+    filter.resize(num_partitions, std::vector<FftData>(num_render_channels));
+    for (auto& partition : filter) {
+      for (FftData& H : partition) {
+        if (!reader.Read(H.re.data(), H.re.size()) ||
+            !reader.Read(H.im.data(), H.im.size())) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  if (!reader.Read(state.erl.data(), state.erl.size()) ||
+      !reader.Read(&state.erl_time_domain)) {
+    return std::nullopt;
+  }
+
+  size_t num_erle;
+  if (!reader.ReadCount(kSpectrumBytes, &num_erle)) {
+    return std::nullopt;
+  }
+  state.erle.resize(num_erle);
+  for (auto& erle : state.erle) {
+    if (!reader.Read(erle.data(), erle.size())) {
+      return std::nullopt;
+    }
+  }
+  size_t num_fullband_erle;
+  if (!reader.ReadCount(sizeof(float), &num_fullband_erle)) {
+    return std::nullopt;
+  }
+  state.fullband_erle_log2.resize(num_fullband_erle);
+  if (!reader.Read(state.fullband_erle_log2.data(), num_fullband_erle)) {
+    return std::nullopt;
+  }
+
+  if (!reader.Read(&state.reverb_decay) ||
+      !reader.Read(&state.reverb_average_decay) ||
+      !reader.Read(state.reverb_frequency_response.data(),
+                   state.reverb_frequency_response.size()) ||
+      reader.Remaining() != 0 || !IsFinite(state)) {
+    return std::nullopt;
+  }
+  return state;
+}
+
+}  // namespace webrtc
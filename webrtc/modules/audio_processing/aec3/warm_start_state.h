@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+
+namespace webrtc {
+
+// Snapshot of the converged echo path state of an echo canceller. It is
+// exported from a running instance and can be imported into a new instance
+// operating on the same audio path, e.g., when a call reconnects, in order to
+// skip the initial convergence phase.
+struct Aec3WarmStartState {
+  // Render delay buffer delay, in blocks. Unset if no delay had been estimated.
+  std::optional<size_t> delay_blocks;
+
+  // Partitions of the refined linear filters. Indexed by capture channel,
+  // partition and render channel.
+  std::vector<std::vector<std::vector<FftData>>> filters;
+
+  // Echo return loss estimates.
+  std::array<float, kFftLengthBy2Plus1> erl;
+  float erl_time_domain = 0.f;
+
+  // Echo return loss enhancement estimates, per capture channel.
+  std::vector<std::array<float, kFftLengthBy2Plus1>> erle;
+  std::vector<float> fullband_erle_log2;
+
+  // Parameters of the reverberant echo model.
+  float reverb_decay = 0.f;
+  float reverb_average_decay = 0.f;
+  std::array<float, kFftLengthBy2Plus1> reverb_frequency_response;
+};
+
+// Serializes `state` into a byte sequence. The values are stored in the native
+// byte order, so the state is only meant to be restored by the same build of
+// the library.
+std::vector<uint8_t> SerializeWarmStartState(const Aec3WarmStartState& state);
+
+// Restores a state serialized by SerializeWarmStartState(). Returns nullopt if
+// `data` does not hold a complete state of the current format or if any of its
+// values is not finite.
+std::optional<Aec3WarmStartState> DeserializeWarmStartState(
+    rtc::ArrayView<const uint8_t> data);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
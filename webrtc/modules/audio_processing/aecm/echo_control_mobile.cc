@@ -16,11 +16,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <memory>
+
 extern "C" {
-#include "common_audio/ring_buffer.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "modules/audio_processing/aecm/aecm_defines.h"
 }
+#include "common_audio/spsc_ring_buffer.h"
 #include "modules/audio_processing/aecm/aecm_core.h"
 
 namespace webrtc {
@@ -74,7 +76,7 @@ typedef struct {
   FILE* postCompFile;
 #endif  // AEC_DEBUG
   // Structures
-  RingBuffer* farendBuf;
+  std::unique_ptr<SpscRingBuffer<int16_t>> farendBuf;
 
   AecmCore* aecmCore;
 } AecMobile;
@@ -89,8 +91,8 @@ static int WebRtcAecm_EstBufDelay(AecMobile* aecm, short msInSndCardBuf);
 static int WebRtcAecm_DelayComp(AecMobile* aecm);
 
 void* WebRtcAecm_Create() {
-  // Allocate zero-filled memory.
-  AecMobile* aecm = static_cast<AecMobile*>(calloc(1, sizeof(AecMobile)));
+  // Value-initialization zero-fills the plain members.
+  AecMobile* aecm = new AecMobile();
 
   aecm->aecmCore = WebRtcAecm_CreateCore();
   if (!aecm->aecmCore) {
@@ -98,11 +100,7 @@ void* WebRtcAecm_Create() {
     return NULL;
   }
 
-  aecm->farendBuf = WebRtc_CreateBuffer(kBufSizeSamp, sizeof(int16_t));
-  if (!aecm->farendBuf) {
-    WebRtcAecm_Free(aecm);
-    return NULL;
-  }
+  aecm->farendBuf = std::make_unique<SpscRingBuffer<int16_t>>(kBufSizeSamp);
 
 #ifdef AEC_DEBUG
   aecm->aecmCore->farFile = fopen("aecFar.pcm", "wb");
@@ -137,8 +135,7 @@ void WebRtcAecm_Free(void* aecmInst) {
   fclose(aecm->postCompFile);
 #endif  // AEC_DEBUG
   WebRtcAecm_FreeCore(aecm->aecmCore);
-  WebRtc_FreeBuffer(aecm->farendBuf);
-  free(aecm);
+  delete aecm;
 }
 
 int32_t WebRtcAecm_Init(void* aecmInst, int32_t sampFreq) {
@@ -160,7 +157,7 @@ int32_t WebRtcAecm_Init(void* aecmInst, int32_t sampFreq) {
   }
 
   // Initialize farend buffer
-  WebRtc_InitBuffer(aecm->farendBuf);
+  aecm->farendBuf->Reset();
 
   aecm->initFlag = kInitCheck;  // indicates that initialization has been done
 
@@ -230,7 +227,7 @@ int32_t WebRtcAecm_BufferFarend(void* aecmInst,
     WebRtcAecm_DelayComp(aecm);
   }
 
-  WebRtc_WriteBuffer(aecm->farendBuf, farend, nrOfSamples);
+  aecm->farendBuf->Write(rtc::ArrayView<const int16_t>(farend, nrOfSamples));
 
   return 0;
 }
@@ -294,7 +291,7 @@ int32_t WebRtcAecm_Process(void* aecmInst,
     }
 
     nmbrOfFilledBuffers =
-        (short)WebRtc_available_read(aecm->farendBuf) / FRAME_LEN;
+        (short)aecm->farendBuf->available_read() / FRAME_LEN;
     // The AECM is in the start up mode
     // AECM is disabled until the soundcard buffer and farend buffers are OK
 
@@ -349,9 +346,9 @@ int32_t WebRtcAecm_Process(void* aecmInst,
       if (nmbrOfFilledBuffers == aecm->bufSizeStart) {
         aecm->ECstartup = 0;  // Enable the AECM
       } else if (nmbrOfFilledBuffers > aecm->bufSizeStart) {
-        WebRtc_MoveReadPtr(aecm->farendBuf,
-                           (int)WebRtc_available_read(aecm->farendBuf) -
-                               (int)aecm->bufSizeStart * FRAME_LEN);
+        aecm->farendBuf->MoveReadPosition(
+            (int)aecm->farendBuf->available_read() -
+            (int)aecm->bufSizeStart * FRAME_LEN);
         aecm->ECstartup = 0;
       }
     }
@@ -361,24 +358,19 @@ int32_t WebRtcAecm_Process(void* aecmInst,
 
     // Note only 1 block supported for nb and 2 blocks for wb
     for (i = 0; i < nFrames; i++) {
-      int16_t farend[FRAME_LEN];
-      const int16_t* farend_ptr = NULL;
+      // The far end frame of this block, which is also kept for use when we
+      // run out of data.
+      const int16_t* farend_ptr = &(aecm->farendOld[i][0]);
 
       nmbrOfFilledBuffers =
-          (short)WebRtc_available_read(aecm->farendBuf) / FRAME_LEN;
+          (short)aecm->farendBuf->available_read() / FRAME_LEN;
 
-      // Check that there is data in the far end buffer
+      // Check that there is data in the far end buffer. If not, we use the
+      // last played frame.
       if (nmbrOfFilledBuffers > 0) {
         // Get the next 80 samples from the farend buffer
-        WebRtc_ReadBuffer(aecm->farendBuf, (void**)&farend_ptr, farend,
-                          FRAME_LEN);
-
-        // Always store the last frame for use when we run out of data
-        memcpy(&(aecm->farendOld[i][0]), farend_ptr, FRAME_LEN * sizeof(short));
-      } else {
-        // We have no data so we use the last played frame
-        memcpy(farend, &(aecm->farendOld[i][0]), FRAME_LEN * sizeof(short));
-        farend_ptr = farend;
+        aecm->farendBuf->Read(
+            rtc::ArrayView<int16_t>(&(aecm->farendOld[i][0]), FRAME_LEN));
       }
 
       // Call buffer delay estimator when all data is extracted,
@@ -400,7 +392,7 @@ int32_t WebRtcAecm_Process(void* aecmInst,
   }
 
 #ifdef AEC_DEBUG
-  msInAECBuf = (short)WebRtc_available_read(aecm->farendBuf) /
+  msInAECBuf = (short)aecm->farendBuf->available_read() /
                (kSampMsNb * aecm->aecmCore->mult);
   fwrite(&msInAECBuf, 2, 1, aecm->bufFile);
   fwrite(&(aecm->knownDelay), sizeof(aecm->knownDelay), 1, aecm->delayFile);
@@ -535,7 +527,7 @@ size_t WebRtcAecm_echo_path_size_bytes() {
 
 static int WebRtcAecm_EstBufDelay(AecMobile* aecm, short msInSndCardBuf) {
   short delayNew, nSampSndCard;
-  short nSampFar = (short)WebRtc_available_read(aecm->farendBuf);
+  short nSampFar = (short)aecm->farendBuf->available_read();
   short diff;
 
   nSampSndCard = msInSndCardBuf * kSampMsNb * aecm->aecmCore->mult;
@@ -543,7 +535,7 @@ static int WebRtcAecm_EstBufDelay(AecMobile* aecm, short msInSndCardBuf) {
   delayNew = nSampSndCard - nSampFar;
 
   if (delayNew < FRAME_LEN) {
-    WebRtc_MoveReadPtr(aecm->farendBuf, FRAME_LEN);
+    aecm->farendBuf->MoveReadPosition(FRAME_LEN);
     delayNew += FRAME_LEN;
   }
 
@@ -575,7 +567,7 @@ static int WebRtcAecm_EstBufDelay(AecMobile* aecm, short msInSndCardBuf) {
 }
 
 static int WebRtcAecm_DelayComp(AecMobile* aecm) {
-  int nSampFar = (int)WebRtc_available_read(aecm->farendBuf);
+  int nSampFar = (int)aecm->farendBuf->available_read();
   int nSampSndCard, delayNew, nSampAdd;
   const int maxStuffSamp = 10 * FRAME_LEN;
 
@@ -589,7 +581,7 @@ static int WebRtcAecm_DelayComp(AecMobile* aecm) {
         (int)(WEBRTC_SPL_MAX(((nSampSndCard >> 1) - nSampFar), FRAME_LEN));
     nSampAdd = WEBRTC_SPL_MIN(nSampAdd, maxStuffSamp);
 
-    WebRtc_MoveReadPtr(aecm->farendBuf, -nSampAdd);
+    aecm->farendBuf->MoveReadPosition(-nSampAdd);
     aecm->delayChange = 1;  // the delay needs to be updated
   }
 
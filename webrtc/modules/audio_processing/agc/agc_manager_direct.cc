@@ -11,6 +11,7 @@
 #include "modules/audio_processing/agc/agc_manager_direct.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 #include "api/array_view.h"
@@ -130,6 +131,29 @@ float ComputeClippedRatio(const float* const* audio,
   return static_cast<float>(num_clipped) / (samples_per_channel);
 }
 
+// Converts the average of the first band of all the channels of
+// `audio_buffer` to int16 and stores it in `downmix`.
+void DownmixFirstBandToS16(const AudioBuffer& audio_buffer,
+                           rtc::ArrayView<int16_t> downmix) {
+  const size_t num_frames = audio_buffer.num_frames_per_band();
+  const size_t num_channels = audio_buffer.num_channels();
+  RTC_DCHECK_LE(num_frames, downmix.size());
+  const float* const* channels =
+      audio_buffer.split_channels_const_f(kBand0To8kHz);
+  std::array<float, AudioBuffer::kMaxSampleRate / 100> sum;
+  std::copy(channels[0], channels[0] + num_frames, sum.begin());
+  for (size_t ch = 1; ch < num_channels; ++ch) {
+    for (size_t i = 0; i < num_frames; ++i) {
+      sum[i] += channels[ch][i];
+    }
+  }
+  const float scaling = 1.f / num_channels;
+  for (size_t i = 0; i < num_frames; ++i) {
+    sum[i] *= scaling;
+  }
+  FloatS16ToS16(sum.data(), num_frames, downmix.data());
+}
+
 void LogClippingMetrics(int clipping_rate) {
   RTC_LOG(LS_INFO) << "Input clipping rate: " << clipping_rate << "%";
   RTC_HISTOGRAM_COUNTS_LINEAR(/*name=*/"WebRTC.Audio.Agc.InputClippingRate",
@@ -462,14 +486,15 @@ AgcManagerDirect::AgcManagerDirect(int num_capture_channels,
       min_mic_level_override_(GetMinMicLevelOverride()),
       data_dumper_(new ApmDataDumper(instance_counter_.fetch_add(1) + 1)),
       num_capture_channels_(num_capture_channels),
+      shared_channel_analysis_(analog_config.shared_channel_analysis),
       disable_digital_adaptive_(!analog_config.enable_digital_adaptive),
       frames_since_clipped_(analog_config.clipped_wait_frames),
       capture_output_used_(true),
       clipped_level_step_(analog_config.clipped_level_step),
       clipped_ratio_threshold_(analog_config.clipped_ratio_threshold),
       clipped_wait_frames_(analog_config.clipped_wait_frames),
-      channel_agcs_(num_capture_channels),
-      new_compressions_to_set_(num_capture_channels),
+      channel_agcs_(shared_channel_analysis_ ? 1 : num_capture_channels),
+      new_compressions_to_set_(channel_agcs_.size()),
       clipping_predictor_(
           CreateClippingPredictor(num_capture_channels,
                                   analog_config.clipping_predictor)),
@@ -581,10 +606,11 @@ void AgcManagerDirect::AnalyzePreProcess(const AudioBuffer& audio_buffer) {
   bool clipping_predicted = false;
   int predicted_step = 0;
   if (!!clipping_predictor_) {
+    // All the channel AGCs share the same minimum input volume.
     for (int channel = 0; channel < num_capture_channels_; ++channel) {
       const auto step = clipping_predictor_->EstimateClippedLevelStep(
           channel, recommended_input_volume_, clipped_level_step_,
-          channel_agcs_[channel]->min_mic_level(), kMaxMicLevel);
+          channel_agcs_[0]->min_mic_level(), kMaxMicLevel);
       if (step.has_value()) {
         predicted_step = std::max(predicted_step, step.value());
         clipping_predicted = true;
@@ -640,8 +666,12 @@ void AgcManagerDirect::Process(const AudioBuffer& audio_buffer,
   for (size_t ch = 0; ch < channel_agcs_.size(); ++ch) {
     std::array<int16_t, AudioBuffer::kMaxSampleRate / 100> audio_data;
     int16_t* audio_use = audio_data.data();
-    FloatS16ToS16(audio_buffer.split_bands_const_f(ch)[0], num_frames_per_band,
-                  audio_use);
+    if (shared_channel_analysis_ && num_capture_channels_ > 1) {
+      DownmixFirstBandToS16(audio_buffer, audio_data);
+    } else {
+      FloatS16ToS16(audio_buffer.split_bands_const_f(ch)[0],
+                    num_frames_per_band, audio_use);
+    }
     channel_agcs_[ch]->Process({audio_use, num_frames_per_band},
                                rms_error_override);
     new_compressions_to_set_[ch] = channel_agcs_[ch]->new_compression();
@@ -40,7 +40,9 @@ class AgcManagerDirect final {
  public:
   // Ctor. `num_capture_channels` specifies the number of channels for the audio
   // passed to `AnalyzePreProcess()` and `Process()`. Clamps
-  // `analog_config.startup_min_level` in the [12, 255] range.
+  // `analog_config.startup_min_level` in the [12, 255] range. If
+  // `analog_config.shared_channel_analysis` is true, a single `MonoAgc`
+  // analyzes the downmix of all the channels.
   AgcManagerDirect(
       int num_capture_channels,
       const AudioProcessing::Config::GainController1::AnalogGainController&
@@ -98,6 +100,9 @@ class AgcManagerDirect final {
 
   int num_channels() const { return num_capture_channels_; }
 
+  // Returns true if the channels share a single loudness analysis.
+  bool shared_channel_analysis() const { return shared_channel_analysis_; }
+
   // If available, returns the latest digital compression gain that has been
   // chosen.
   std::optional<int> GetDigitalComressionGain();
@@ -154,6 +159,7 @@ class AgcManagerDirect final {
   std::unique_ptr<ApmDataDumper> data_dumper_;
   static std::atomic<int> instance_counter_;
   const int num_capture_channels_;
+  const bool shared_channel_analysis_;
   const bool disable_digital_adaptive_;
 
   int frames_since_clipped_;
@@ -175,6 +181,8 @@ class AgcManagerDirect final {
   const float clipped_ratio_threshold_;
   const int clipped_wait_frames_;
 
+  // One per capture channel, or a single one for the downmix if
+  // `shared_channel_analysis_` is true.
   std::vector<std::unique_ptr<MonoAgc>> channel_agcs_;
   std::vector<std::optional<int>> new_compressions_to_set_;
 
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/channel_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr float kClippedMax = 32767.0f;
+constexpr float kClippedMin = -32768.0f;
+
+// Accumulates the statistics of the leading samples of `channel` that fill
+// whole vectors and returns how many samples that is.
+
+#if defined(WEBRTC_HAS_NEON)
+
+size_t ComputeStatisticsSimd(rtc::ArrayView<const float> channel,
+                             ChannelStatistics& statistics) {
+  const float32x4_t clipped_max = vdupq_n_f32(kClippedMax);
+  const float32x4_t clipped_min = vdupq_n_f32(kClippedMin);
+  float32x4_t peak = vdupq_n_f32(0.0f);
+  float32x4_t energy = vdupq_n_f32(0.0f);
+  uint32x4_t num_clipped = vdupq_n_u32(0);
+  size_t i = 0;
+  for (; i + 4 <= channel.size(); i += 4) {
+    const float32x4_t x = vld1q_f32(&channel[i]);
+    peak = vmaxq_f32(peak, vabsq_f32(x));
+    energy = vaddq_f32(energy, vmulq_f32(x, x));
+    // The comparison masks are all ones, i.e. -1, for the clipped samples.
+    num_clipped = vsubq_u32(
+        num_clipped,
+        vorrq_u32(vcgeq_f32(x, clipped_max), vcleq_f32(x, clipped_min)));
+  }
+  float peak_lanes[4];
+  float energy_lanes[4];
+  uint32_t num_clipped_lanes[4];
+  vst1q_f32(peak_lanes, peak);
+  vst1q_f32(energy_lanes, energy);
+  vst1q_u32(num_clipped_lanes, num_clipped);
+  for (int k = 0; k < 4; ++k) {
+    statistics.peak = std::max(statistics.peak, peak_lanes[k]);
+    statistics.energy += energy_lanes[k];
+    statistics.num_clipped += num_clipped_lanes[k];
+  }
+  return i;
+}
+
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+
+size_t ComputeStatisticsSimd(rtc::ArrayView<const float> channel,
+                             ChannelStatistics& statistics) {
+  const __m128 clipped_max = _mm_set1_ps(kClippedMax);
+  const __m128 clipped_min = _mm_set1_ps(kClippedMin);
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  __m128 peak = _mm_setzero_ps();
+  __m128 energy = _mm_setzero_ps();
+  __m128i num_clipped = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= channel.size(); i += 4) {
+    const __m128 x = _mm_loadu_ps(&channel[i]);
+    peak = _mm_max_ps(peak, _mm_and_ps(x, abs_mask));
+    energy = _mm_add_ps(energy, _mm_mul_ps(x, x));
+    // The comparison masks are all ones, i.e. -1, for the clipped samples.
+    num_clipped = _mm_sub_epi32(
+        num_clipped, _mm_castps_si128(_mm_or_ps(_mm_cmpge_ps(x, clipped_max),
+                                                _mm_cmple_ps(x, clipped_min))));
+  }
+  float peak_lanes[4];
+  float energy_lanes[4];
+  int32_t num_clipped_lanes[4];
+  _mm_storeu_ps(peak_lanes, peak);
+  _mm_storeu_ps(energy_lanes, energy);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(num_clipped_lanes), num_clipped);
+  for (int k = 0; k < 4; ++k) {
+    statistics.peak = std::max(statistics.peak, peak_lanes[k]);
+    statistics.energy += energy_lanes[k];
+    statistics.num_clipped += num_clipped_lanes[k];
+  }
+  return i;
+}
+
+#else
+
+size_t ComputeStatisticsSimd(rtc::ArrayView<const float> channel,
+                             ChannelStatistics& statistics) {
+  return 0;
+}
+
+#endif
+
+}  // namespace
+
+ChannelStatistics ComputeChannelStatistics(
+    rtc::ArrayView<const float> channel) {
+  ChannelStatistics statistics;
+  for (size_t i = ComputeStatisticsSimd(channel, statistics);
+       i < channel.size(); ++i) {
+    const float x = channel[i];
+    statistics.peak = std::max(statistics.peak, std::fabs(x));
+    statistics.energy += x * x;
+    if (x >= kClippedMax || x <= kClippedMin) {
+      ++statistics.num_clipped;
+    }
+  }
+  return statistics;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_CHANNEL_STATISTICS_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_CHANNEL_STATISTICS_H_
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Frame-wise statistics of a channel of audio in the S16 float range, shared by
+// the AGC2 level estimators and clipping detectors so that the samples are only
+// traversed once per frame.
+struct ChannelStatistics {
+  // Largest absolute sample value.
+  float peak = 0.0f;
+  // Sum of the squared samples.
+  float energy = 0.0f;
+  // Number of samples at full scale (and presumably clipped).
+  int num_clipped = 0;
+};
+
+// Computes the statistics of `channel` in a single pass over the samples.
+ChannelStatistics ComputeChannelStatistics(rtc::ArrayView<const float> channel);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_CHANNEL_STATISTICS_H_
@@ -58,6 +58,16 @@ float ComputeCrestFactor(const ClippingPredictorLevelBuffer::Level& level) {
   return crest_factor;
 }
 
+// Stores the frame-wise metrics of a channel with `statistics` computed over
+// `samples_per_channel` samples.
+void PushLevel(const ChannelStatistics& statistics,
+               int samples_per_channel,
+               ClippingPredictorLevelBuffer& buffer) {
+  RTC_DCHECK_GT(samples_per_channel, 0);
+  buffer.Push({statistics.energy / static_cast<float>(samples_per_channel),
+               statistics.peak});
+}
+
 // Crest factor-based clipping prediction and clipped level step estimation.
 class ClippingEventPredictor : public ClippingPredictor {
  public:
@@ -76,8 +86,7 @@ class ClippingEventPredictor : public ClippingPredictor {
                          int reference_window_delay,
                          float clipping_threshold,
                          float crest_factor_margin)
-      : window_length_(window_length),
-        reference_window_length_(reference_window_length),
+      : reference_window_length_(reference_window_length),
         reference_window_delay_(reference_window_delay),
         clipping_threshold_(clipping_threshold),
         crest_factor_margin_(crest_factor_margin) {
@@ -92,6 +101,9 @@ class ClippingEventPredictor : public ClippingPredictor {
     for (int i = 0; i < num_channels; ++i) {
       ch_buffers_.push_back(
           std::make_unique<ClippingPredictorLevelBuffer>(buffer_length));
+      window_ = ch_buffers_.back()->AddWindow(0, window_length);
+      reference_window_ = ch_buffers_.back()->AddWindow(
+          reference_window_delay, reference_window_length);
     }
   }
 
@@ -111,17 +123,17 @@ class ClippingEventPredictor : public ClippingPredictor {
   void Analyze(const AudioFrameView<const float>& frame) {
     const int num_channels = frame.num_channels();
     RTC_DCHECK_EQ(num_channels, ch_buffers_.size());
-    const int samples_per_channel = frame.samples_per_channel();
-    RTC_DCHECK_GT(samples_per_channel, 0);
     for (int channel = 0; channel < num_channels; ++channel) {
-      float sum_squares = 0.0f;
-      float peak = 0.0f;
-      for (const auto& sample : frame.channel(channel)) {
-        sum_squares += sample * sample;
-        peak = std::max(std::fabs(sample), peak);
-      }
-      ch_buffers_[channel]->Push(
-          {sum_squares / static_cast<float>(samples_per_channel), peak});
+      PushLevel(ComputeChannelStatistics(frame.channel(channel)),
+                frame.samples_per_channel(), *ch_buffers_[channel]);
+    }
+  }
+
+  void Analyze(rtc::ArrayView<const ChannelStatistics> channels,
+               int samples_per_channel) {
+    RTC_DCHECK_EQ(channels.size(), ch_buffers_.size());
+    for (size_t channel = 0; channel < channels.size(); ++channel) {
+      PushLevel(channels[channel], samples_per_channel, *ch_buffers_[channel]);
     }
   }
 
@@ -168,14 +180,13 @@ class ClippingEventPredictor : public ClippingPredictor {
   // Predicts clipping events based on the processed audio frames. Returns
   // true if a clipping event is likely.
   bool PredictClippingEvent(int channel) const {
-    const auto metrics =
-        ch_buffers_[channel]->ComputePartialMetrics(0, window_length_);
+    const auto metrics = ch_buffers_[channel]->GetWindowMetrics(window_);
     if (!metrics.has_value() ||
         !(FloatS16ToDbfs(metrics.value().max) > clipping_threshold_)) {
       return false;
     }
-    const auto reference_metrics = ch_buffers_[channel]->ComputePartialMetrics(
-        reference_window_delay_, reference_window_length_);
+    const auto reference_metrics =
+        ch_buffers_[channel]->GetWindowMetrics(reference_window_);
     if (!reference_metrics.has_value()) {
       return false;
     }
@@ -189,7 +200,9 @@ class ClippingEventPredictor : public ClippingPredictor {
   }
 
   std::vector<std::unique_ptr<ClippingPredictorLevelBuffer>> ch_buffers_;
-  const int window_length_;
+  // Windows registered in every buffer of `ch_buffers_`.
+  int window_ = 0;
+  int reference_window_ = 0;
   const int reference_window_length_;
   const int reference_window_delay_;
   const float clipping_threshold_;
@@ -215,8 +228,7 @@ class ClippingPeakPredictor : public ClippingPredictor {
                                  int reference_window_delay,
                                  int clipping_threshold,
                                  bool adaptive_step_estimation)
-      : window_length_(window_length),
-        reference_window_length_(reference_window_length),
+      : reference_window_length_(reference_window_length),
         reference_window_delay_(reference_window_delay),
         clipping_threshold_(clipping_threshold),
         adaptive_step_estimation_(adaptive_step_estimation) {
@@ -231,6 +243,9 @@ class ClippingPeakPredictor : public ClippingPredictor {
     for (int i = 0; i < num_channels; ++i) {
       ch_buffers_.push_back(
           std::make_unique<ClippingPredictorLevelBuffer>(buffer_length));
+      window_ = ch_buffers_.back()->AddWindow(0, window_length);
+      reference_window_ = ch_buffers_.back()->AddWindow(
+          reference_window_delay, reference_window_length);
     }
   }
 
@@ -250,17 +265,17 @@ class ClippingPeakPredictor : public ClippingPredictor {
   void Analyze(const AudioFrameView<const float>& frame) {
     const int num_channels = frame.num_channels();
     RTC_DCHECK_EQ(num_channels, ch_buffers_.size());
-    const int samples_per_channel = frame.samples_per_channel();
-    RTC_DCHECK_GT(samples_per_channel, 0);
     for (int channel = 0; channel < num_channels; ++channel) {
-      float sum_squares = 0.0f;
-      float peak = 0.0f;
-      for (const auto& sample : frame.channel(channel)) {
-        sum_squares += sample * sample;
-        peak = std::max(std::fabs(sample), peak);
-      }
-      ch_buffers_[channel]->Push(
-          {sum_squares / static_cast<float>(samples_per_channel), peak});
+      PushLevel(ComputeChannelStatistics(frame.channel(channel)),
+                frame.samples_per_channel(), *ch_buffers_[channel]);
+    }
+  }
+
+  void Analyze(rtc::ArrayView<const ChannelStatistics> channels,
+               int samples_per_channel) {
+    RTC_DCHECK_EQ(channels.size(), ch_buffers_.size());
+    for (size_t channel = 0; channel < channels.size(); ++channel) {
+      PushLevel(channels[channel], samples_per_channel, *ch_buffers_[channel]);
     }
   }
 
@@ -321,13 +336,12 @@ class ClippingPeakPredictor : public ClippingPredictor {
   // Returns the estimated peak value if clipping is predicted. Otherwise
   // returns std::nullopt.
   std::optional<float> EstimatePeakValue(int channel) const {
-    const auto reference_metrics = ch_buffers_[channel]->ComputePartialMetrics(
-        reference_window_delay_, reference_window_length_);
+    const auto reference_metrics =
+        ch_buffers_[channel]->GetWindowMetrics(reference_window_);
     if (!reference_metrics.has_value()) {
       return std::nullopt;
     }
-    const auto metrics =
-        ch_buffers_[channel]->ComputePartialMetrics(0, window_length_);
+    const auto metrics = ch_buffers_[channel]->GetWindowMetrics(window_);
     if (!metrics.has_value() ||
         !(FloatS16ToDbfs(metrics.value().max) > clipping_threshold_)) {
       return std::nullopt;
@@ -341,7 +355,9 @@ class ClippingPeakPredictor : public ClippingPredictor {
   }
 
   std::vector<std::unique_ptr<ClippingPredictorLevelBuffer>> ch_buffers_;
-  const int window_length_;
+  // Windows registered in every buffer of `ch_buffers_`.
+  int window_ = 0;
+  int reference_window_ = 0;
   const int reference_window_length_;
   const int reference_window_delay_;
   const int clipping_threshold_;
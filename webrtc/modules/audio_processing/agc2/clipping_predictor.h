@@ -15,7 +15,9 @@
 #include <optional>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/audio/audio_processing.h"
+#include "modules/audio_processing/agc2/channel_statistics.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
 
 namespace webrtc {
@@ -33,6 +35,11 @@ class ClippingPredictor {
   // Analyzes a 10 ms multi-channel audio frame.
   virtual void Analyze(const AudioFrameView<const float>& frame) = 0;
 
+  // Like above, but takes the statistics of the channels of the frame computed
+  // by `ComputeChannelStatistics()`.
+  virtual void Analyze(rtc::ArrayView<const ChannelStatistics> channels,
+                       int samples_per_channel) = 0;
+
   // Predicts if clipping is going to occur for the specified `channel` in the
   // near-future and, if so, it returns a recommended analog mic level decrease
   // step. Returns std::nullopt if clipping is not predicted.
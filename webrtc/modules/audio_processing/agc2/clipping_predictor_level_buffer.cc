@@ -24,8 +24,20 @@ bool ClippingPredictorLevelBuffer::Level::operator==(const Level& level) const {
          std::fabs(max - level.max) < kEpsilon;
 }
 
+ClippingPredictorLevelBuffer::Window::Window(int delay, int num_items)
+    : delay(delay), num_items(num_items), candidates(num_items) {
+  Reset();
+}
+
+void ClippingPredictorLevelBuffer::Window::Reset() {
+  sum = 0.0;
+  updates_since_sum = 0;
+  first_candidate = 0;
+  num_candidates = 0;
+}
+
 ClippingPredictorLevelBuffer::ClippingPredictorLevelBuffer(int capacity)
-    : tail_(-1), size_(0), data_(std::max(1, capacity)) {
+    : tail_(-1), size_(0), data_(std::max(1, capacity)), num_pushed_(0) {
   if (capacity > kMaxCapacity) {
     RTC_LOG(LS_WARNING) << "[agc]: ClippingPredictorLevelBuffer exceeds the "
                         << "maximum allowed capacity. Capacity: " << capacity;
@@ -36,9 +48,29 @@ ClippingPredictorLevelBuffer::ClippingPredictorLevelBuffer(int capacity)
 void ClippingPredictorLevelBuffer::Reset() {
   tail_ = -1;
   size_ = 0;
+  num_pushed_ = 0;
+  for (Window& window : windows_) {
+    window.Reset();
+  }
 }
 
 void ClippingPredictorLevelBuffer::Push(Level level) {
+  // The items leaving the windows are removed first, since the oldest of them
+  // may be overwritten by `level`.
+  for (Window& window : windows_) {
+    const int last = window.delay + window.num_items - 1;
+    if (size_ <= last) {
+      continue;
+    }
+    window.sum -= GetItem(last).average;
+    const int64_t leaving_index = num_pushed_ - 1 - last;
+    if (window.num_candidates > 0 &&
+        window.candidates[window.first_candidate].index == leaving_index) {
+      window.first_candidate = (window.first_candidate + 1) % window.num_items;
+      --window.num_candidates;
+    }
+  }
+
   ++tail_;
   if (tail_ == Capacity()) {
     tail_ = 0;
@@ -47,9 +79,40 @@ void ClippingPredictorLevelBuffer::Push(Level level) {
     size_++;
   }
   data_[tail_] = level;
+  ++num_pushed_;
+
+  for (Window& window : windows_) {
+    if (size_ <= window.delay) {
+      continue;
+    }
+    const Level& entering = GetItem(window.delay);
+    while (window.num_candidates > 0) {
+      const int last_candidate =
+          (window.first_candidate + window.num_candidates - 1) %
+          window.num_items;
+      if (window.candidates[last_candidate].max > entering.max) {
+        break;
+      }
+      --window.num_candidates;
+    }
+    window.candidates[(window.first_candidate + window.num_candidates) %
+                      window.num_items] = {num_pushed_ - 1 - window.delay,
+                                           entering.max};
+    ++window.num_candidates;
+
+    if (++window.updates_since_sum < window.num_items) {
+      window.sum += entering.average;
+    } else {
+      window.updates_since_sum = 0;
+      window.sum = 0.0;
+      const int end = std::min(size_, window.delay + window.num_items);
+      for (int delay = window.delay; delay < end; ++delay) {
+        window.sum += GetItem(delay).average;
+      }
+    }
+  }
 }
 
-// TODO(bugs.webrtc.org/12774): Optimize partial computation for long buffers.
 std::optional<ClippingPredictorLevelBuffer::Level>
 ClippingPredictorLevelBuffer::ComputePartialMetrics(int delay,
                                                     int num_items) const {
@@ -74,4 +137,41 @@ ClippingPredictorLevelBuffer::ComputePartialMetrics(int delay,
   return std::optional<Level>({sum / static_cast<float>(num_items), max});
 }
 
+int ClippingPredictorLevelBuffer::AddWindow(int delay, int num_items) {
+  RTC_DCHECK_EQ(num_pushed_, 0);
+  RTC_DCHECK_GE(delay, 0);
+  RTC_DCHECK_LT(delay, Capacity());
+  RTC_DCHECK_GT(num_items, 0);
+  RTC_DCHECK_LE(num_items, Capacity());
+  RTC_DCHECK_LE(delay + num_items, Capacity());
+  windows_.emplace_back(delay, num_items);
+  return static_cast<int>(windows_.size()) - 1;
+}
+
+std::optional<ClippingPredictorLevelBuffer::Level>
+ClippingPredictorLevelBuffer::GetWindowMetrics(int window) const {
+  RTC_DCHECK_GE(window, 0);
+  RTC_DCHECK_LT(window, windows_.size());
+  const Window& w = windows_[window];
+  if (w.delay + w.num_items > Size()) {
+    return std::nullopt;
+  }
+  RTC_DCHECK_GT(w.num_candidates, 0);
+  // Rounding errors may leave a tiny negative sum when the averages are zero.
+  const float sum = std::max(static_cast<float>(w.sum), 0.0f);
+  return std::optional<Level>({sum / static_cast<float>(w.num_items),
+                               w.candidates[w.first_candidate].max});
+}
+
+const ClippingPredictorLevelBuffer::Level&
+ClippingPredictorLevelBuffer::GetItem(int delay) const {
+  RTC_DCHECK_GE(delay, 0);
+  RTC_DCHECK_LT(delay, Size());
+  int index = tail_ - delay;
+  if (index < 0) {
+    index += Capacity();
+  }
+  return data_[index];
+}
+
 }  // namespace webrtc
@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_PROCESSING_AGC2_CLIPPING_PREDICTOR_LEVEL_BUFFER_H_
 #define MODULES_AUDIO_PROCESSING_AGC2_CLIPPING_PREDICTOR_LEVEL_BUFFER_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <optional>
 #include <vector>
@@ -18,7 +20,9 @@
 namespace webrtc {
 
 // A circular buffer to store frame-wise `Level` items for clipping prediction.
-// The current implementation is not optimized for large buffer lengths.
+// The metrics of arbitrary windows are computed in linear time, while those of
+// the windows registered with `AddWindow()` are updated at each push in
+// constant time.
 class ClippingPredictorLevelBuffer {
  public:
   struct Level {
@@ -28,7 +32,8 @@ class ClippingPredictorLevelBuffer {
   };
 
   // Recommended maximum capacity. It is possible to create a buffer with a
-  // larger capacity, but the implementation is not optimized for large values.
+  // larger capacity, but `ComputePartialMetrics()` is not optimized for large
+  // values.
   static constexpr int kMaxCapacity = 100;
 
   // Ctor. Sets the buffer capacity to max(1, `capacity`) and logs a warning
@@ -59,10 +64,52 @@ class ClippingPredictorLevelBuffer {
   // [0, N] and `num_items` to [1, M] where N + M is the capacity of the buffer.
   std::optional<Level> ComputePartialMetrics(int delay, int num_items) const;
 
+  // Registers the window of `num_items` items from `delay`, with the same
+  // limits as in `ComputePartialMetrics()`, and returns its index. Must be
+  // called before the first item is pushed.
+  int AddWindow(int delay, int num_items);
+
+  // Returns the same metrics as `ComputePartialMetrics()` for the registered
+  // window `window`, up to rounding errors in the average, but in constant
+  // time.
+  std::optional<Level> GetWindowMetrics(int window) const;
+
  private:
+  // Window whose sum of averages and maximum are updated as items enter and
+  // leave it.
+  struct Window {
+    // Candidate for the maximum: an item that is not followed in the window by
+    // an item with a greater or equal maximum.
+    struct Candidate {
+      int64_t index;
+      float max;
+    };
+
+    Window(int delay, int num_items);
+    void Reset();
+
+    int delay;
+    int num_items;
+    // Sum of the averages. Computed from scratch every `num_items` updates, so
+    // that rounding errors do not accumulate.
+    double sum;
+    int updates_since_sum;
+    // Circular queue of the candidates, oldest first. Their maxima decrease, so
+    // the oldest is the maximum of the window.
+    std::vector<Candidate> candidates;
+    int first_candidate;
+    int num_candidates;
+  };
+
+  // Returns the item pushed `delay` items before the most recent one.
+  const Level& GetItem(int delay) const;
+
   int tail_;
   int size_;
   std::vector<Level> data_;
+  // Number of items pushed since the last reset.
+  int64_t num_pushed_;
+  std::vector<Window> windows_;
 };
 
 }  // namespace webrtc
@@ -16,7 +16,6 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/gain_map_internal.h"
 #include "modules/audio_processing/agc2/input_volume_stats_reporter.h"
-#include "modules/audio_processing/include/audio_frame_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
@@ -77,26 +76,6 @@ int ComputeVolumeUpdate(int gain_error_db,
   return new_volume;
 }
 
-// Returns the proportion of samples in the buffer which are at full-scale
-// (and presumably clipped).
-float ComputeClippedRatio(const float* const* audio,
-                          size_t num_channels,
-                          size_t samples_per_channel) {
-  RTC_DCHECK_GT(samples_per_channel, 0);
-  int num_clipped = 0;
-  for (size_t ch = 0; ch < num_channels; ++ch) {
-    int num_clipped_in_ch = 0;
-    for (size_t i = 0; i < samples_per_channel; ++i) {
-      RTC_DCHECK(audio[ch]);
-      if (audio[ch][i] >= 32767.0f || audio[ch][i] <= -32768.0f) {
-        ++num_clipped_in_ch;
-      }
-    }
-    num_clipped = std::max(num_clipped, num_clipped_in_ch);
-  }
-  return static_cast<float>(num_clipped) / (samples_per_channel);
-}
-
 void LogClippingMetrics(int clipping_rate) {
   RTC_LOG(LS_INFO) << "[AGC2] Input clipping rate: " << clipping_rate << "%";
   RTC_HISTOGRAM_COUNTS_LINEAR(/*name=*/"WebRTC.Audio.Agc.InputClippingRate",
@@ -369,38 +348,35 @@ InputVolumeController::InputVolumeController(int num_capture_channels,
       frames_since_clipped_(config.clipped_wait_frames),
       clipping_rate_log_counter_(0),
       clipping_rate_log_(0.0f),
+      channel_statistics_(num_capture_channels),
       target_range_max_dbfs_(config.target_range_max_dbfs),
       target_range_min_dbfs_(config.target_range_min_dbfs),
-      channel_controllers_(num_capture_channels) {
+      controller_(std::make_unique<MonoInputVolumeController>(
+          config.clipped_level_min,
+          min_input_volume_,
+          config.update_input_volume_wait_frames,
+          config.speech_probability_threshold,
+          config.speech_ratio_threshold)) {
   RTC_LOG(LS_INFO)
       << "[AGC2] Input volume controller enabled. Minimum input volume: "
       << min_input_volume_;
 
-  for (auto& controller : channel_controllers_) {
-    controller = std::make_unique<MonoInputVolumeController>(
-        config.clipped_level_min, min_input_volume_,
-        config.update_input_volume_wait_frames,
-        config.speech_probability_threshold, config.speech_ratio_threshold);
-  }
-
-  RTC_DCHECK(!channel_controllers_.empty());
+  RTC_DCHECK_GT(num_capture_channels_, 0);
   RTC_DCHECK_GT(clipped_level_step_, 0);
   RTC_DCHECK_LE(clipped_level_step_, 255);
   RTC_DCHECK_GT(clipped_ratio_threshold_, 0.0f);
   RTC_DCHECK_LT(clipped_ratio_threshold_, 1.0f);
   RTC_DCHECK_GT(clipped_wait_frames_, 0);
-  channel_controllers_[0]->ActivateLogging();
+  controller_->ActivateLogging();
 }
 
 InputVolumeController::~InputVolumeController() {}
 
 void InputVolumeController::Initialize() {
-  for (auto& controller : channel_controllers_) {
-    controller->Initialize();
-  }
+  controller_->Initialize();
   capture_output_used_ = true;
 
-  AggregateChannelLevels();
+  UpdateRecommendedInputVolume();
   clipping_rate_log_ = 0.0f;
   clipping_rate_log_counter_ = 0;
 
@@ -414,20 +390,30 @@ void InputVolumeController::AnalyzeInputAudio(int applied_input_volume,
 
   SetAppliedInputVolume(applied_input_volume);
 
-  RTC_DCHECK_EQ(audio_buffer.num_channels(), channel_controllers_.size());
+  RTC_DCHECK_EQ(audio_buffer.num_channels(), num_capture_channels_);
   const float* const* audio = audio_buffer.channels_const();
   size_t samples_per_channel = audio_buffer.num_frames();
   RTC_DCHECK(audio);
 
-  AggregateChannelLevels();
+  UpdateRecommendedInputVolume();
   if (!capture_output_used_) {
     return;
   }
 
+  // The samples are traversed once for both the clipping detection and
+  // prediction.
+  RTC_DCHECK_GT(samples_per_channel, 0);
+  int num_clipped = 0;
+  for (int ch = 0; ch < num_capture_channels_; ++ch) {
+    RTC_DCHECK(audio[ch]);
+    channel_statistics_[ch] =
+        ComputeChannelStatistics({audio[ch], samples_per_channel});
+    num_clipped = std::max(num_clipped, channel_statistics_[ch].num_clipped);
+  }
+
   if (!!clipping_predictor_) {
-    AudioFrameView<const float> frame = AudioFrameView<const float>(
-        audio, num_capture_channels_, static_cast<int>(samples_per_channel));
-    clipping_predictor_->Analyze(frame);
+    clipping_predictor_->Analyze(channel_statistics_,
+                                 static_cast<int>(samples_per_channel));
   }
 
   // Check for clipped samples. We do this in the preprocessing phase in order
@@ -437,8 +423,8 @@ void InputVolumeController::AnalyzeInputAudio(int applied_input_volume,
   // input volume and enforce a new maximum input volume, dropped the same
   // amount from the current maximum. This harsh treatment is an effort to avoid
   // repeated clipped echo events.
-  float clipped_ratio =
-      ComputeClippedRatio(audio, num_capture_channels_, samples_per_channel);
+  const float clipped_ratio =
+      static_cast<float>(num_clipped) / samples_per_channel;
   clipping_rate_log_ = std::max(clipped_ratio, clipping_rate_log_);
   clipping_rate_log_counter_++;
   constexpr int kNumFramesIn30Seconds = 3000;
@@ -460,7 +446,7 @@ void InputVolumeController::AnalyzeInputAudio(int applied_input_volume,
     for (int channel = 0; channel < num_capture_channels_; ++channel) {
       const auto step = clipping_predictor_->EstimateClippedLevelStep(
           channel, recommended_input_volume_, clipped_level_step_,
-          channel_controllers_[channel]->min_input_volume_after_clipping(),
+          controller_->min_input_volume_after_clipping(),
           kMaxInputVolume);
       if (step.has_value()) {
         predicted_step = std::max(predicted_step, step.value());
@@ -486,16 +472,14 @@ void InputVolumeController::AnalyzeInputAudio(int applied_input_volume,
 
   if (clipping_detected ||
       (clipping_predicted && use_clipping_predictor_step_)) {
-    for (auto& state_ch : channel_controllers_) {
-      state_ch->HandleClipping(step);
-    }
+    controller_->HandleClipping(step);
     frames_since_clipped_ = 0;
     if (!!clipping_predictor_) {
       clipping_predictor_->Reset();
     }
   }
 
-  AggregateChannelLevels();
+  UpdateRecommendedInputVolume();
 }
 
 std::optional<int> InputVolumeController::RecommendInputVolume(
@@ -507,7 +491,7 @@ std::optional<int> InputVolumeController::RecommendInputVolume(
     return std::nullopt;
   }
 
-  AggregateChannelLevels();
+  UpdateRecommendedInputVolume();
   const int volume_after_clipping_handling = recommended_input_volume_;
 
   if (!capture_output_used_) {
@@ -521,11 +505,9 @@ std::optional<int> InputVolumeController::RecommendInputVolume(
         *speech_level_dbfs, target_range_min_dbfs_, target_range_max_dbfs_);
   }
 
-  for (auto& controller : channel_controllers_) {
-    controller->Process(rms_error_db, speech_probability);
-  }
+  controller_->Process(rms_error_db, speech_probability);
 
-  AggregateChannelLevels();
+  UpdateRecommendedInputVolume();
   if (volume_after_clipping_handling != recommended_input_volume_) {
     // The recommended input volume was adjusted in order to match the target
     // level.
@@ -539,9 +521,7 @@ std::optional<int> InputVolumeController::RecommendInputVolume(
 
 void InputVolumeController::HandleCaptureOutputUsedChange(
     bool capture_output_used) {
-  for (auto& controller : channel_controllers_) {
-    controller->HandleCaptureOutputUsedChange(capture_output_used);
-  }
+  controller_->HandleCaptureOutputUsedChange(capture_output_used);
 
   capture_output_used_ = capture_output_used;
 }
@@ -549,24 +529,13 @@ void InputVolumeController::HandleCaptureOutputUsedChange(
 void InputVolumeController::SetAppliedInputVolume(int input_volume) {
   applied_input_volume_ = input_volume;
 
-  for (auto& controller : channel_controllers_) {
-    controller->set_stream_analog_level(input_volume);
-  }
+  controller_->set_stream_analog_level(input_volume);
 
-  AggregateChannelLevels();
+  UpdateRecommendedInputVolume();
 }
 
-void InputVolumeController::AggregateChannelLevels() {
-  int new_recommended_input_volume =
-      channel_controllers_[0]->recommended_analog_level();
-  channel_controlling_gain_ = 0;
-  for (size_t ch = 1; ch < channel_controllers_.size(); ++ch) {
-    int input_volume = channel_controllers_[ch]->recommended_analog_level();
-    if (input_volume < new_recommended_input_volume) {
-      new_recommended_input_volume = input_volume;
-      channel_controlling_gain_ = static_cast<int>(ch);
-    }
-  }
+void InputVolumeController::UpdateRecommendedInputVolume() {
+  int new_recommended_input_volume = controller_->recommended_analog_level();
 
   // Enforce the minimum input volume when a recommendation is made.
   if (applied_input_volume_.has_value() && *applied_input_volume_ > 0) {
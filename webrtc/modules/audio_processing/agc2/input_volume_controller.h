@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "api/audio/audio_processing.h"
+#include "modules/audio_processing/agc2/channel_statistics.h"
 #include "modules/audio_processing/agc2/clipping_predictor.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "rtc_base/gtest_prod_util.h"
@@ -138,7 +139,9 @@ class InputVolumeController final {
   // Sets the applied input volume and resets the recommended input volume.
   void SetAppliedInputVolume(int level);
 
-  void AggregateChannelLevels();
+  // Updates `recommended_input_volume_` from the volume controller, enforcing
+  // the minimum input volume when a recommendation is made.
+  void UpdateRecommendedInputVolume();
 
   const int num_capture_channels_;
 
@@ -168,6 +171,9 @@ class InputVolumeController final {
   int frames_since_clipped_;
   int clipping_rate_log_counter_;
   float clipping_rate_log_;
+  // Statistics of the channels of the latest analyzed frame, shared by the
+  // clipping detection and prediction.
+  std::vector<ChannelStatistics> channel_statistics_;
 
   // Target range minimum and maximum. If the seech level is in the range
   // [`target_range_min_dbfs`, `target_range_max_dbfs`], no volume adjustments
@@ -176,9 +182,10 @@ class InputVolumeController final {
   const int target_range_max_dbfs_;
   const int target_range_min_dbfs_;
 
-  // Channel controllers updating the gain upwards/downwards.
-  std::vector<std::unique_ptr<MonoInputVolumeController>> channel_controllers_;
-  int channel_controlling_gain_ = 0;
+  // Controller updating the gain upwards/downwards. A single one serves all the
+  // channels, since every channel is given the same applied input volume,
+  // clipping steps and speech level; only the clipping analysis is per channel.
+  const std::unique_ptr<MonoInputVolumeController> controller_;
 };
 
 // TODO(bugs.webrtc.org/7494): Use applied/recommended input volume naming
@@ -18,8 +18,113 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
+namespace {
+
+// Looks up the gains of the leading levels that fill whole vectors and returns
+// how many levels that is. Instead of a search per level, the curve points are
+// compared in order with all the levels of a vector at once, counting the
+// points below each level until no level is above the next point. The count is
+// one past the index of the linear piece, or zero in the identity region. The
+// levels in the saturation region are left for the caller to correct.
+
+// Computes the gain from the number of curve points below `input_level`, like
+// the scalar look up.
+inline float GainFromNumPointsBelow(int num_points_below,
+                                    float input_level,
+                                    const float* m,
+                                    const float* q) {
+  if (num_points_below == 0) {
+    return 1.0f;
+  }
+  return m[num_points_below - 1] * input_level + q[num_points_below - 1];
+}
+
+#if defined(WEBRTC_HAS_NEON)
+
+size_t LookUpGainsSimd(const float* x,
+                       const float* m,
+                       const float* q,
+                       size_t num_points,
+                       rtc::ArrayView<const float> input_levels,
+                       rtc::ArrayView<float> gains) {
+  size_t i = 0;
+  for (; i + 4 <= input_levels.size(); i += 4) {
+    const float32x4_t level = vld1q_f32(&input_levels[i]);
+    uint32x4_t num_points_below = vdupq_n_u32(0);
+    for (size_t k = 0; k < num_points; ++k) {
+      const uint32x4_t below = vcltq_f32(vdupq_n_f32(x[k]), level);
+      const uint32x2_t any =
+          vorr_u32(vget_low_u32(below), vget_high_u32(below));
+      if ((vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) == 0) {
+        break;
+      }
+      // The comparison masks are all ones, i.e. -1, for the levels above.
+      num_points_below = vsubq_u32(num_points_below, below);
+    }
+    uint32_t counts[4];
+    vst1q_u32(counts, num_points_below);
+    for (int j = 0; j < 4; ++j) {
+      gains[i + j] = GainFromNumPointsBelow(static_cast<int>(counts[j]),
+                                            input_levels[i + j], m, q);
+    }
+  }
+  return i;
+}
+
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WAP_DISABLE_INLINE_SSE)
+
+size_t LookUpGainsSimd(const float* x,
+                       const float* m,
+                       const float* q,
+                       size_t num_points,
+                       rtc::ArrayView<const float> input_levels,
+                       rtc::ArrayView<float> gains) {
+  size_t i = 0;
+  for (; i + 4 <= input_levels.size(); i += 4) {
+    const __m128 level = _mm_loadu_ps(&input_levels[i]);
+    __m128i num_points_below = _mm_setzero_si128();
+    for (size_t k = 0; k < num_points; ++k) {
+      const __m128 below = _mm_cmplt_ps(_mm_set1_ps(x[k]), level);
+      if (_mm_movemask_ps(below) == 0) {
+        break;
+      }
+      // The comparison masks are all ones, i.e. -1, for the levels above.
+      num_points_below =
+          _mm_sub_epi32(num_points_below, _mm_castps_si128(below));
+    }
+    int32_t counts[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(counts), num_points_below);
+    for (int j = 0; j < 4; ++j) {
+      gains[i + j] =
+          GainFromNumPointsBelow(counts[j], input_levels[i + j], m, q);
+    }
+  }
+  return i;
+}
+
+#else
+
+size_t LookUpGainsSimd(const float* x,
+                       const float* m,
+                       const float* q,
+                       size_t num_points,
+                       rtc::ArrayView<const float> input_levels,
+                       rtc::ArrayView<float> gains) {
+  return 0;
+}
+
+#endif
+
+}  // namespace
 
 constexpr std::array<float, kInterpolatedGainCurveTotalPoints>
     InterpolatedGainCurve::approximation_params_x_;
@@ -32,7 +137,8 @@ constexpr std::array<float, kInterpolatedGainCurveTotalPoints>
 
 InterpolatedGainCurve::InterpolatedGainCurve(
     ApmDataDumper* apm_data_dumper,
-    absl::string_view histogram_name_prefix)
+    absl::string_view histogram_name_prefix,
+    bool enable_stats)
     : region_logger_(
           (rtc::StringBuilder("WebRTC.Audio.")
            << histogram_name_prefix << ".FixedDigitalGainCurveRegion.Identity")
@@ -47,7 +153,8 @@ InterpolatedGainCurve::InterpolatedGainCurve(
            << histogram_name_prefix
            << ".FixedDigitalGainCurveRegion.Saturation")
               .str()),
-      apm_data_dumper_(apm_data_dumper) {}
+      apm_data_dumper_(apm_data_dumper),
+      enable_stats_(enable_stats) {}
 
 InterpolatedGainCurve::~InterpolatedGainCurve() {
   if (stats_.available) {
@@ -166,8 +273,37 @@ void InterpolatedGainCurve::UpdateStats(float input_level) const {
 // O(2 + log2(`LightkInterpolatedGainCurveTotalPoints`), plus O(1) for the
 // linear interpolation (one product and one sum).
 float InterpolatedGainCurve::LookUpGainToApply(float input_level) const {
-  UpdateStats(input_level);
+  if (enable_stats_) {
+    UpdateStats(input_level);
+  }
+  return ComputeGain(input_level);
+}
+
+void InterpolatedGainCurve::LookUpGainsToApply(
+    rtc::ArrayView<const float> input_levels,
+    rtc::ArrayView<float> gains) const {
+  RTC_DCHECK_EQ(input_levels.size(), gains.size());
+  if (enable_stats_) {
+    for (float input_level : input_levels) {
+      UpdateStats(input_level);
+    }
+  }
+
+  const size_t num_vectorized = LookUpGainsSimd(
+      approximation_params_x_.data(), approximation_params_m_.data(),
+      approximation_params_q_.data(), kInterpolatedGainCurveTotalPoints,
+      input_levels, gains);
+  for (size_t i = 0; i < num_vectorized; ++i) {
+    if (input_levels[i] >= kMaxInputLevelLinear) {
+      gains[i] = ComputeGain(input_levels[i]);
+    }
+  }
+  for (size_t i = num_vectorized; i < input_levels.size(); ++i) {
+    gains[i] = ComputeGain(input_levels[i]);
+  }
+}
 
+float InterpolatedGainCurve::ComputeGain(float input_level) {
   if (input_level <= approximation_params_x_[0]) {
     // Identity region.
     return 1.0f;
@@ -14,6 +14,7 @@
 #include <array>
 
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "modules/audio_processing/agc2/agc2_common.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "system_wrappers/include/metrics.h"
@@ -59,8 +60,11 @@ class InterpolatedGainCurve {
     int64_t region_duration_frames = 0;
   };
 
+  // If `enable_stats` is false, the look ups are not counted per region and
+  // no region histograms are logged.
   InterpolatedGainCurve(ApmDataDumper* apm_data_dumper,
-                        absl::string_view histogram_name_prefix);
+                        absl::string_view histogram_name_prefix,
+                        bool enable_stats);
   ~InterpolatedGainCurve();
 
   InterpolatedGainCurve(const InterpolatedGainCurve&) = delete;
@@ -74,6 +78,13 @@ class InterpolatedGainCurve {
   // after applying this gain
   float LookUpGainToApply(float input_level) const;
 
+  // Looks up the gains for all the `input_levels` at once and writes them to
+  // `gains`, which must have the same size. Equivalent to calling
+  // `LookUpGainToApply()` for each level, but the segments of the curve are
+  // selected with vector compares instead of a search per level.
+  void LookUpGainsToApply(rtc::ArrayView<const float> input_levels,
+                          rtc::ArrayView<float> gains) const;
+
  private:
   // For comparing 'approximation_params_*_' with ones computed by
   // ComputeInterpolatedGainCurve.
@@ -98,7 +109,11 @@ class InterpolatedGainCurve {
 
   void UpdateStats(float input_level) const;
 
+  // Computes the gain without updating the stats.
+  static float ComputeGain(float input_level);
+
   ApmDataDumper* const apm_data_dumper_;
+  const bool enable_stats_;
 
   static constexpr std::array<float, kInterpolatedGainCurveTotalPoints>
       approximation_params_x_ = {
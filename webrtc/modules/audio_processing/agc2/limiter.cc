@@ -88,8 +88,11 @@ void ScaleSamples(MonoView<const float> per_sample_scaling_factors,
 
 Limiter::Limiter(ApmDataDumper* apm_data_dumper,
                  size_t samples_per_channel,
-                 absl::string_view histogram_name)
-    : interp_gain_curve_(apm_data_dumper, histogram_name),
+                 absl::string_view histogram_name,
+                 bool enable_gain_curve_stats)
+    : interp_gain_curve_(apm_data_dumper,
+                         histogram_name,
+                         enable_gain_curve_stats),
       level_estimator_(samples_per_channel, apm_data_dumper),
       apm_data_dumper_(apm_data_dumper) {
   RTC_DCHECK_LE(samples_per_channel, kMaximalNumberOfSamplesPerChannel);
@@ -106,10 +109,9 @@ void Limiter::Process(DeinterleavedView<float> signal) {
 
   RTC_DCHECK_EQ(level_estimate.size() + 1, scaling_factors_.size());
   scaling_factors_[0] = last_scaling_factor_;
-  std::transform(level_estimate.begin(), level_estimate.end(),
-                 scaling_factors_.begin() + 1, [this](float x) {
-                   return interp_gain_curve_.LookUpGainToApply(x);
-                 });
+  interp_gain_curve_.LookUpGainsToApply(
+      level_estimate,
+      rtc::ArrayView<float>(&scaling_factors_[1], level_estimate.size()));
 
   MonoView<float> per_sample_scaling_factors(&per_sample_scaling_factors_[0],
                                              signal.samples_per_channel());
@@ -25,9 +25,12 @@ class ApmDataDumper;
 class Limiter {
  public:
   // See `SetSamplesPerChannel()` for valid values for `samples_per_channel`.
+  // `enable_gain_curve_stats` enables the stats returned by
+  // `GetGainCurveStats()`.
   Limiter(ApmDataDumper* apm_data_dumper,
           size_t samples_per_channel,
-          absl::string_view histogram_name_prefix);
+          absl::string_view histogram_name_prefix,
+          bool enable_gain_curve_stats);
 
   Limiter(const Limiter& limiter) = delete;
   Limiter& operator=(const Limiter& limiter) = delete;
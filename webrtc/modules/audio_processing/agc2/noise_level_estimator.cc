@@ -14,7 +14,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <numeric>
 
 #include "api/audio/audio_view.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
@@ -25,18 +24,6 @@ namespace {
 
 constexpr int kFramesPerSecond = 100;
 
-float FrameEnergy(DeinterleavedView<const float> audio) {
-  float energy = 0.0f;
-  for (size_t k = 0; k < audio.num_channels(); ++k) {
-    MonoView<const float> ch = audio[k];
-    float channel_energy =
-        std::accumulate(ch.begin(), ch.end(), 0.0f,
-                        [](float a, float b) -> float { return a + b * b; });
-    energy = std::max(channel_energy, energy);
-  }
-  return energy;
-}
-
 float EnergyToDbfs(float signal_energy, int num_samples) {
   RTC_DCHECK_GE(signal_energy, 0.0f);
   const float rms_square = signal_energy / num_samples;
@@ -83,21 +70,40 @@ class NoiseFloorEstimator : public NoiseLevelEstimator {
   ~NoiseFloorEstimator() = default;
 
   float Analyze(DeinterleavedView<const float> frame) override {
+    float frame_energy = 0.0f;
+    for (size_t k = 0; k < frame.num_channels(); ++k) {
+      frame_energy =
+          std::max(ComputeChannelStatistics(frame[k]).energy, frame_energy);
+    }
+    return AnalyzeFrameEnergy(frame_energy,
+                              static_cast<int>(frame.samples_per_channel()));
+  }
+
+  float Analyze(rtc::ArrayView<const ChannelStatistics> channels,
+                int samples_per_channel) override {
+    float frame_energy = 0.0f;
+    for (const ChannelStatistics& channel : channels) {
+      frame_energy = std::max(channel.energy, frame_energy);
+    }
+    return AnalyzeFrameEnergy(frame_energy, samples_per_channel);
+  }
+
+ private:
+  // Updates the estimation with the largest energy among the channels of a
+  // frame with `samples_per_channel` samples.
+  float AnalyzeFrameEnergy(float frame_energy, int samples_per_channel) {
     // Detect sample rate changes.
-    const int sample_rate_hz =
-        static_cast<int>(frame.samples_per_channel() * kFramesPerSecond);
+    const int sample_rate_hz = samples_per_channel * kFramesPerSecond;
     if (sample_rate_hz != sample_rate_hz_) {
       Initialize(sample_rate_hz);
     }
 
-    const float frame_energy = FrameEnergy(frame);
     if (frame_energy <= min_noise_energy_) {
       // Ignore frames when muted or below the minimum measurable energy.
       if (data_dumper_)
         data_dumper_->DumpRaw("agc2_noise_floor_estimator_preliminary_level",
                               noise_energy_);
-      return EnergyToDbfs(noise_energy_,
-                          static_cast<int>(frame.samples_per_channel()));
+      return EnergyToDbfs(noise_energy_, samples_per_channel);
     }
 
     if (preliminary_noise_energy_set_) {
@@ -133,15 +139,13 @@ class NoiseFloorEstimator : public NoiseLevelEstimator {
       counter_--;
     }
 
-    float noise_rms_dbfs = EnergyToDbfs(
-        noise_energy_, static_cast<int>(frame.samples_per_channel()));
+    float noise_rms_dbfs = EnergyToDbfs(noise_energy_, samples_per_channel);
     if (data_dumper_)
       data_dumper_->DumpRaw("agc2_noise_rms_dbfs", noise_rms_dbfs);
 
     return noise_rms_dbfs;
   }
 
- private:
   void Initialize(int sample_rate_hz) {
     sample_rate_hz_ = sample_rate_hz;
     first_period_ = true;
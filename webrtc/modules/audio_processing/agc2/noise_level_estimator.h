@@ -13,7 +13,9 @@
 
 #include <memory>
 
+#include "api/array_view.h"
 #include "api/audio/audio_view.h"
+#include "modules/audio_processing/agc2/channel_statistics.h"
 
 namespace webrtc {
 class ApmDataDumper;
@@ -25,6 +27,10 @@ class NoiseLevelEstimator {
   // Analyzes a 10 ms `frame`, updates the noise level estimation and returns
   // the value for the latter in dBFS.
   virtual float Analyze(DeinterleavedView<const float> frame) = 0;
+  // Like above, but takes the statistics of the channels of the frame computed
+  // by `ComputeChannelStatistics()`.
+  virtual float Analyze(rtc::ArrayView<const ChannelStatistics> channels,
+                        int samples_per_channel) = 0;
 };
 
 // Creates a noise level estimator based on noise floor detection.
@@ -310,9 +310,7 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
         resampling_required ? float_buffer.data() : data_->channels()[0];
 
     if (config_num_channels == 1) {
-      for (size_t j = 0; j < output_num_frames_; ++j) {
-        interleaved[j] = FloatS16ToS16(deinterleaved[j]);
-      }
+      FloatS16ToS16(deinterleaved, output_num_frames_, interleaved);
     } else {
       for (size_t i = 0, k = 0; i < output_num_frames_; ++i) {
         float tmp = FloatS16ToS16(deinterleaved[i]);
@@ -356,6 +354,120 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
   }
 }
 
+// Deinterleaves and converts to the FloatS16 range in one pass when no
+// resampling is needed. Otherwise, the result matches that of CopyFrom() with
+// the same audio deinterleaved.
+void AudioBuffer::CopyFrom(const float* const interleaved_data,
+                           const StreamConfig& stream_config) {
+  RTC_DCHECK_EQ(stream_config.num_channels(), input_num_channels_);
+  RTC_DCHECK_EQ(stream_config.num_frames(), input_num_frames_);
+  RestoreNumChannels();
+
+  const bool resampling_required = input_num_frames_ != buffer_num_frames_;
+
+  const float* interleaved = interleaved_data;
+  if (num_channels_ == 1) {
+    std::array<float, kMaxSamplesPerChannel10ms> float_buffer;
+    const float* mono = interleaved;
+    if (input_num_channels_ > 1) {
+      if (downmix_by_averaging_) {
+        const float kOneByNumChannels = 1.f / input_num_channels_;
+        for (size_t j = 0, k = 0; j < input_num_frames_; ++j) {
+          float value = interleaved[k++];
+          for (size_t i = 1; i < input_num_channels_; ++i, ++k) {
+            value += interleaved[k];
+          }
+          float_buffer[j] = value * kOneByNumChannels;
+        }
+      } else {
+        for (size_t j = 0, k = channel_for_downmixing_; j < input_num_frames_;
+             ++j, k += input_num_channels_) {
+          float_buffer[j] = interleaved[k];
+        }
+      }
+      mono = float_buffer.data();
+    }
+
+    if (resampling_required) {
+      input_resamplers_[0]->Resample(mono, input_num_frames_,
+                                     data_->channels()[0], buffer_num_frames_);
+      mono = data_->channels()[0];
+    }
+    FloatToFloatS16(mono, buffer_num_frames_, data_->channels()[0]);
+  } else if (resampling_required) {
+    std::array<float, kMaxSamplesPerChannel10ms> float_buffer;
+    for (size_t i = 0; i < num_channels_; ++i) {
+      for (size_t j = 0, k = i; j < input_num_frames_;
+           ++j, k += input_num_channels_) {
+        float_buffer[j] = interleaved[k];
+      }
+      input_resamplers_[i]->Resample(float_buffer.data(), input_num_frames_,
+                                     data_->channels()[i], buffer_num_frames_);
+      FloatToFloatS16(data_->channels()[i], buffer_num_frames_,
+                      data_->channels()[i]);
+    }
+  } else {
+    DeinterleaveFloatToFloatS16(
+        InterleavedView<const float>(interleaved, input_num_frames_,
+                                     input_num_channels_),
+        DeinterleavedView<float>(data_->channels()[0], buffer_num_frames_,
+                                 num_channels_));
+  }
+}
+
+// Converts from the FloatS16 range and interleaves in one pass when no
+// resampling is needed. Otherwise, the result matches that of CopyTo() into
+// deinterleaved channels.
+void AudioBuffer::CopyTo(const StreamConfig& stream_config,
+                         float* const interleaved_data) {
+  const size_t config_num_channels = stream_config.num_channels();
+
+  RTC_DCHECK(config_num_channels == num_channels_ || num_channels_ == 1);
+  RTC_DCHECK_EQ(stream_config.num_frames(), output_num_frames_);
+
+  const bool resampling_required = buffer_num_frames_ != output_num_frames_;
+
+  float* interleaved = interleaved_data;
+  if (num_channels_ == 1) {
+    std::array<float, kMaxSamplesPerChannel10ms> float_buffer;
+    float* mono = config_num_channels == 1 ? interleaved : float_buffer.data();
+    if (resampling_required) {
+      FloatS16ToFloat(data_->channels()[0], buffer_num_frames_,
+                      data_->channels()[0]);
+      output_resamplers_[0]->Resample(data_->channels()[0], buffer_num_frames_,
+                                      mono, output_num_frames_);
+    } else {
+      FloatS16ToFloat(data_->channels()[0], buffer_num_frames_, mono);
+    }
+
+    if (config_num_channels > 1) {
+      for (size_t j = 0, k = 0; j < output_num_frames_; ++j) {
+        for (size_t i = 0; i < config_num_channels; ++i, ++k) {
+          interleaved[k] = mono[j];
+        }
+      }
+    }
+  } else if (resampling_required) {
+    std::array<float, kMaxSamplesPerChannel10ms> float_buffer;
+    for (size_t i = 0; i < num_channels_; ++i) {
+      FloatS16ToFloat(data_->channels()[i], buffer_num_frames_,
+                      data_->channels()[i]);
+      output_resamplers_[i]->Resample(data_->channels()[i], buffer_num_frames_,
+                                      float_buffer.data(), output_num_frames_);
+      for (size_t j = 0, k = i; j < output_num_frames_;
+           ++j, k += config_num_channels) {
+        interleaved[k] = float_buffer[j];
+      }
+    }
+  } else {
+    InterleaveFloatS16ToFloat(
+        DeinterleavedView<const float>(data_->channels()[0],
+                                       buffer_num_frames_, num_channels_),
+        InterleavedView<float>(interleaved, output_num_frames_,
+                               config_num_channels));
+  }
+}
+
 void AudioBuffer::SplitIntoFrequencyBands() {
   splitting_filter_->Analysis(data_.get(), split_data_.get());
 }
@@ -116,11 +116,14 @@ class AudioBuffer {
                 const StreamConfig& stream_config);
   void CopyFrom(const float* const* stacked_data,
                 const StreamConfig& stream_config);
+  void CopyFrom(const float* const interleaved_data,
+                const StreamConfig& stream_config);
 
   // Copies data from the buffer.
   void CopyTo(const StreamConfig& stream_config,
               int16_t* const interleaved_data);
   void CopyTo(const StreamConfig& stream_config, float* const* stacked_data);
+  void CopyTo(const StreamConfig& stream_config, float* const interleaved_data);
   void CopyTo(AudioBuffer* buffer) const;
 
   // Splits the buffer data into frequency bands.
@@ -24,8 +24,10 @@
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "api/audio/audio_frame.h"
+#include "api/audio/audio_view.h"
 #include "api/task_queue/task_queue_base.h"
 #include "common_audio/audio_converter.h"
+#include "common_audio/channel_buffer.h"
 #include "common_audio/include/audio_util.h"
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
 #include "modules/audio_processing/audio_buffer.h"
@@ -106,9 +108,8 @@ bool MinimizeProcessingForUnusedOutput() {
   return !field_trial::IsEnabled("WebRTC-MutedStateKillSwitch");
 }
 
-// Maximum lengths that frame of samples being passed from the render side to
-// the capture side can have (does not apply to AEC3).
-static const size_t kMaxAllowedValuesOfSamplesPerBand = 160;
+// Maximum length of the fullband frames of samples being passed from the
+// render side to the capture side (does not apply to AEC3).
 static const size_t kMaxAllowedValuesOfSamplesPerFrame = 480;
 
 // Maximum number of frames to buffer in the render queue.
@@ -116,13 +117,6 @@ static const size_t kMaxAllowedValuesOfSamplesPerFrame = 480;
 // reverse and forward call numbers.
 static const size_t kMaxNumFramesToBuffer = 100;
 
-void PackRenderAudioBufferForEchoDetector(const AudioBuffer& audio,
-                                          std::vector<float>& packed_buffer) {
-  packed_buffer.clear();
-  packed_buffer.insert(packed_buffer.end(), audio.channels_const()[0],
-                       audio.channels_const()[0] + audio.num_frames());
-}
-
 // Options for gracefully handling processing errors.
 enum class FormatErrorOutputOption {
   kOutputExactCopyOfInput,
@@ -225,11 +219,12 @@ std::pair<int, FormatErrorOutputOption> ChooseErrorOutputOption(
 }
 
 // Checks if the audio format is supported. If not, the output is populated in a
-// best-effort manner and an APM error code is returned.
-int HandleUnsupportedAudioFormats(const int16_t* const src,
+// best-effort manner and an APM error code is returned. For interleaved audio.
+template <typename T>
+int HandleUnsupportedAudioFormats(const T* const src,
                                   const StreamConfig& input_config,
                                   const StreamConfig& output_config,
-                                  int16_t* const dest) {
+                                  T* const dest) {
   RTC_DCHECK(src);
   RTC_DCHECK(dest);
 
@@ -241,18 +236,18 @@ int HandleUnsupportedAudioFormats(const int16_t* const src,
   const size_t num_output_channels = output_config.num_channels();
   switch (output_option) {
     case FormatErrorOutputOption::kOutputSilence:
-      memset(dest, 0, output_config.num_samples() * sizeof(int16_t));
+      memset(dest, 0, output_config.num_samples() * sizeof(T));
       break;
     case FormatErrorOutputOption::kOutputBroadcastCopyOfFirstInputChannel:
       for (size_t i = 0; i < output_config.num_frames(); ++i) {
-        int16_t sample = src[input_config.num_channels() * i];
+        T sample = src[input_config.num_channels() * i];
         for (size_t ch = 0; ch < num_output_channels; ++ch) {
           dest[ch + num_output_channels * i] = sample;
         }
       }
       break;
     case FormatErrorOutputOption::kOutputExactCopyOfInput:
-      memcpy(dest, src, output_config.num_samples() * sizeof(int16_t));
+      memcpy(dest, src, output_config.num_samples() * sizeof(T));
       break;
     case FormatErrorOutputOption::kDoNothing:
       break;
@@ -303,6 +298,18 @@ int HandleUnsupportedAudioFormats(const float* const* src,
   return error_code;
 }
 
+// Deinterleaves float audio for the consumers that only handle it in
+// deinterleaved form, such as the AecDump and the AudioConverter.
+void DeinterleaveToChannelBuffer(const float* const interleaved,
+                                 const StreamConfig& config,
+                                 ChannelBuffer<float>& deinterleaved) {
+  Deinterleave(InterleavedView<const float>(interleaved, config.num_frames(),
+                                            config.num_channels()),
+               DeinterleavedView<float>(deinterleaved.channels()[0],
+                                        config.num_frames(),
+                                        config.num_channels()));
+}
+
 using DownmixMethod = AudioProcessing::Config::Pipeline::DownmixMethod;
 
 void SetDownmixMethod(AudioBuffer& buffer, DownmixMethod method) {
@@ -535,12 +542,22 @@ void AudioProcessingImpl::InitializeLocked() {
           formats_.api_format.reverse_input_stream().num_frames(),
           formats_.api_format.reverse_output_stream().num_channels(),
           formats_.api_format.reverse_output_stream().num_frames());
+      render_.render_converter_input.reset(new ChannelBuffer<float>(
+          formats_.api_format.reverse_input_stream().num_frames(),
+          formats_.api_format.reverse_input_stream().num_channels()));
+      render_.render_converter_output.reset(new ChannelBuffer<float>(
+          formats_.api_format.reverse_output_stream().num_frames(),
+          formats_.api_format.reverse_output_stream().num_channels()));
     } else {
       render_.render_converter.reset(nullptr);
+      render_.render_converter_input.reset(nullptr);
+      render_.render_converter_output.reset(nullptr);
     }
   } else {
     render_.render_audio.reset(nullptr);
     render_.render_converter.reset(nullptr);
+    render_.render_converter_input.reset(nullptr);
+    render_.render_converter_output.reset(nullptr);
   }
 
   capture_.capture_audio.reset(new AudioBuffer(
@@ -907,7 +924,7 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
       HandleUnsupportedAudioFormats(src, input_config, output_config, dest));
   MaybeInitializeCapture(input_config, output_config);
 
-  MutexLock lock_capture(&mutex_capture_);
+  CaptureStreamLock lock_capture(this);
 
   if (aec_dump_) {
     RecordUnprocessedCaptureStream(src);
@@ -932,6 +949,39 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
   return kNoError;
 }
 
+int AudioProcessingImpl::ProcessStream(const float* const src,
+                                       const StreamConfig& input_config,
+                                       const StreamConfig& output_config,
+                                       float* const dest) {
+  TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_Interleaved");
+  DenormalDisabler denormal_disabler;
+  RETURN_ON_ERR(
+      HandleUnsupportedAudioFormats(src, input_config, output_config, dest));
+  MaybeInitializeCapture(input_config, output_config);
+
+  CaptureStreamLock lock_capture(this);
+
+  if (aec_dump_) {
+    RecordUnprocessedCaptureStream(src, input_config);
+  }
+
+  capture_.capture_audio->CopyFrom(src, input_config);
+  if (capture_.capture_fullband_audio) {
+    capture_.capture_fullband_audio->CopyFrom(src, input_config);
+  }
+  RETURN_ON_ERR(ProcessCaptureStreamLocked());
+  if (capture_.capture_fullband_audio) {
+    capture_.capture_fullband_audio->CopyTo(output_config, dest);
+  } else {
+    capture_.capture_audio->CopyTo(output_config, dest);
+  }
+
+  if (aec_dump_) {
+    RecordProcessedCaptureStream(dest, output_config);
+  }
+  return kNoError;
+}
+
 void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
   RuntimeSetting setting;
   int num_settings_processed = 0;
@@ -1067,105 +1117,66 @@ void AudioProcessingImpl::HandleRenderRuntimeSettings() {
   }
 }
 
-void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
-  RTC_DCHECK_GE(160, audio->num_frames_per_band());
+void AudioProcessingImpl::PackBandedRenderAudio(const AudioBuffer& audio) {
+  RTC_DCHECK_GE(160, audio.num_frames_per_band());
 
-  if (submodules_.echo_control_mobile) {
-    EchoControlMobileImpl::PackRenderAudioBuffer(audio, num_output_channels(),
-                                                 num_reverse_channels(),
-                                                 &aecm_render_queue_buffer_);
-    RTC_DCHECK(aecm_render_signal_queue_);
-    // Insert the samples into the queue.
-    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result =
-          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
-  }
-
-  if (!submodules_.agc_manager && submodules_.gain_control) {
-    GainControlImpl::PackRenderAudioBuffer(*audio, &agc_render_queue_buffer_);
-    // Insert the samples into the queue.
-    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+  // The AECM and AGC1 both read the 0-8 kHz band converted to S16, which hence
+  // is only converted once, and AGC1 additionally reads the downmix of it.
+  const bool downmix = !submodules_.agc_manager && submodules_.gain_control;
+  if (submodules_.echo_control_mobile || downmix) {
+    render_queue_frame_.PackLowestBand(audio, downmix);
   }
 }
 
-void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
+void AudioProcessingImpl::PackNonbandedRenderAudio(const AudioBuffer& audio) {
   if (submodules_.echo_detector) {
-    PackRenderAudioBufferForEchoDetector(*audio, red_render_queue_buffer_);
-    RTC_DCHECK(red_render_signal_queue_);
-    // Insert the samples into the queue.
-    if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-      RTC_DCHECK(result);
-    }
+    render_queue_frame_.PackFullband(audio);
   }
 }
 
-void AudioProcessingImpl::AllocateRenderQueue() {
-  const size_t new_agc_render_queue_element_max_size =
-      std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerBand);
-
-  const size_t new_red_render_queue_element_max_size =
-      std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerFrame);
-
-  // Reallocate the queues if the queue item sizes are too small to fit the
-  // data to put in the queues.
+void AudioProcessingImpl::QueueRenderAudio() {
+  if (!render_queue_frame_.has_fullband() &&
+      !render_queue_frame_.has_lowest_band()) {
+    return;
+  }
 
-  if (agc_render_queue_element_max_size_ <
-      new_agc_render_queue_element_max_size) {
-    agc_render_queue_element_max_size_ = new_agc_render_queue_element_max_size;
+  RTC_DCHECK(render_signal_queue_);
+  // Insert the frame into the queue.
+  if (!render_signal_queue_->Insert(&render_queue_frame_)) {
+    // The data queue is full and needs to be emptied.
+    EmptyQueuedRenderAudio();
 
-    std::vector<int16_t> template_queue_element(
-        agc_render_queue_element_max_size_);
+    // Retry the insert (should always work).
+    bool result = render_signal_queue_->Insert(&render_queue_frame_);
+    RTC_DCHECK(result);
+  }
+}
 
-    agc_render_signal_queue_.reset(
-        new SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>(
+void AudioProcessingImpl::AllocateRenderQueue() {
+  const size_t new_max_num_channels =
+      std::max(static_cast<size_t>(1), num_reverse_channels());
+  const size_t new_max_num_fullband_samples =
+      submodules_.echo_detector ? kMaxAllowedValuesOfSamplesPerFrame : 0;
+
+  // Reallocate the queue if the queue items are too small to fit the data to
+  // put in the queue.
+  if (!render_signal_queue_ ||
+      render_queue_frame_.max_num_channels() < new_max_num_channels ||
+      render_queue_frame_.max_num_fullband_samples() <
+          new_max_num_fullband_samples) {
+    RenderQueueFrame template_queue_element(new_max_num_channels,
+                                            new_max_num_fullband_samples);
+
+    render_signal_queue_.reset(
+        new SwapQueue<RenderQueueFrame, RenderQueueFrameVerifier>(
             kMaxNumFramesToBuffer, template_queue_element,
-            RenderQueueItemVerifier<int16_t>(
-                agc_render_queue_element_max_size_)));
+            RenderQueueFrameVerifier(new_max_num_channels,
+                                     new_max_num_fullband_samples)));
 
-    agc_render_queue_buffer_.resize(agc_render_queue_element_max_size_);
-    agc_capture_queue_buffer_.resize(agc_render_queue_element_max_size_);
+    render_queue_frame_ = template_queue_element;
+    capture_queue_frame_ = template_queue_element;
   } else {
-    agc_render_signal_queue_->Clear();
-  }
-
-  if (submodules_.echo_detector) {
-    if (red_render_queue_element_max_size_ <
-        new_red_render_queue_element_max_size) {
-      red_render_queue_element_max_size_ =
-          new_red_render_queue_element_max_size;
-
-      std::vector<float> template_queue_element(
-          red_render_queue_element_max_size_);
-
-      red_render_signal_queue_.reset(
-          new SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>(
-              kMaxNumFramesToBuffer, template_queue_element,
-              RenderQueueItemVerifier<float>(
-                  red_render_queue_element_max_size_)));
-
-      red_render_queue_buffer_.resize(red_render_queue_element_max_size_);
-      red_capture_queue_buffer_.resize(red_render_queue_element_max_size_);
-    } else {
-      red_render_signal_queue_->Clear();
-    }
+    render_signal_queue_->Clear();
   }
 }
 
@@ -1175,23 +1186,23 @@ void AudioProcessingImpl::EmptyQueuedRenderAudio() {
 }
 
 void AudioProcessingImpl::EmptyQueuedRenderAudioLocked() {
-  if (submodules_.echo_control_mobile) {
-    RTC_DCHECK(aecm_render_signal_queue_);
-    while (aecm_render_signal_queue_->Remove(&aecm_capture_queue_buffer_)) {
+  RTC_DCHECK(render_signal_queue_);
+  while (render_signal_queue_->Remove(&capture_queue_frame_)) {
+    if (submodules_.echo_control_mobile &&
+        capture_queue_frame_.has_lowest_band()) {
       submodules_.echo_control_mobile->ProcessRenderAudio(
-          aecm_capture_queue_buffer_);
+          capture_queue_frame_.lowest_band());
     }
-  }
 
-  if (submodules_.gain_control) {
-    while (agc_render_signal_queue_->Remove(&agc_capture_queue_buffer_)) {
-      submodules_.gain_control->ProcessRenderAudio(agc_capture_queue_buffer_);
+    if (submodules_.gain_control &&
+        capture_queue_frame_.has_downmixed_lowest_band()) {
+      submodules_.gain_control->ProcessRenderAudio(
+          capture_queue_frame_.downmixed_lowest_band());
     }
-  }
 
-  if (submodules_.echo_detector) {
-    while (red_render_signal_queue_->Remove(&red_capture_queue_buffer_)) {
-      submodules_.echo_detector->AnalyzeRenderAudio(red_capture_queue_buffer_);
+    if (submodules_.echo_detector && capture_queue_frame_.has_fullband()) {
+      submodules_.echo_detector->AnalyzeRenderAudio(
+          capture_queue_frame_.fullband());
     }
   }
 }
@@ -1206,7 +1217,7 @@ int AudioProcessingImpl::ProcessStream(const int16_t* const src,
       HandleUnsupportedAudioFormats(src, input_config, output_config, dest));
   MaybeInitializeCapture(input_config, output_config);
 
-  MutexLock lock_capture(&mutex_capture_);
+  CaptureStreamLock lock_capture(this);
   DenormalDisabler denormal_disabler;
 
   if (aec_dump_) {
@@ -1251,7 +1262,29 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   AudioBuffer* capture_buffer = capture_.capture_audio.get();  // For brevity.
   AudioBuffer* linear_aec_buffer = capture_.linear_aec_output.get();
 
-  if (submodules_.high_pass_filter &&
+  // While the capture output is unused, the processing is reduced to what is
+  // needed for keeping the submodules in sync with the render side and the
+  // input volume: the high-pass filter, the band splitting, the noise
+  // suppression and the AGC1 gain control in the digital modes are bypassed,
+  // and the echo controller only keeps its render buffering aligned. Any
+  // transient caused by their stale state is masked by the zeroing of the
+  // output once it is used again.
+  const bool capture_output_used = capture_.capture_output_used;
+  // Without the AGC1 manager, the adaptive analog mode of AGC1 computes the
+  // recommended input volume while analyzing and processing the capture
+  // audio, so it keeps running.
+  const bool process_gain_control =
+      submodules_.gain_control &&
+      (capture_output_used ||
+       (!submodules_.agc_manager &&
+        submodules_.gain_control->mode() == GainControl::kAdaptiveAnalog));
+  // AECM keeps processing the split bands in order to stay in sync with its
+  // render buffering, and the analog AGC1 analyzes them.
+  const bool process_split_bands = capture_output_used ||
+                                   !!submodules_.echo_control_mobile ||
+                                   process_gain_control;
+
+  if (capture_output_used && submodules_.high_pass_filter &&
       config_.high_pass_filter.apply_in_full_band &&
       !constants_.enforce_split_band_hpf) {
     submodules_.high_pass_filter->Process(capture_buffer,
@@ -1328,7 +1361,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
   }
 
-  if (submodule_states_.CaptureMultiBandSubModulesActive() &&
+  if (process_split_bands &&
+      submodule_states_.CaptureMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
     capture_buffer->SplitIntoFrequencyBands();
@@ -1344,19 +1378,20 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     capture_buffer->set_num_channels(1);
   }
 
-  if (submodules_.high_pass_filter &&
+  if (capture_output_used && submodules_.high_pass_filter &&
       (!config_.high_pass_filter.apply_in_full_band ||
        constants_.enforce_split_band_hpf)) {
     submodules_.high_pass_filter->Process(capture_buffer,
                                           /*use_split_band_data=*/true);
   }
 
-  if (submodules_.gain_control) {
+  if (process_gain_control) {
     RETURN_ON_ERR(
         submodules_.gain_control->AnalyzeCaptureAudio(*capture_buffer));
   }
 
-  if ((!config_.noise_suppression.analyze_linear_aec_output_when_available ||
+  if (capture_output_used &&
+      (!config_.noise_suppression.analyze_linear_aec_output_when_available ||
        !linear_aec_buffer || submodules_.echo_control_mobile) &&
       submodules_.noise_suppressor) {
     submodules_.noise_suppressor->Analyze(*capture_buffer);
@@ -1369,7 +1404,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
       return AudioProcessing::kStreamParameterNotSetError;
     }
 
-    if (submodules_.noise_suppressor) {
+    if (capture_output_used && submodules_.noise_suppressor) {
       submodules_.noise_suppressor->Process(capture_buffer);
     }
 
@@ -1387,12 +1422,13 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
           capture_buffer, linear_aec_buffer, capture_.echo_path_gain_change);
     }
 
-    if (config_.noise_suppression.analyze_linear_aec_output_when_available &&
+    if (capture_output_used &&
+        config_.noise_suppression.analyze_linear_aec_output_when_available &&
         linear_aec_buffer && submodules_.noise_suppressor) {
       submodules_.noise_suppressor->Analyze(*linear_aec_buffer);
     }
 
-    if (submodules_.noise_suppressor) {
+    if (capture_output_used && submodules_.noise_suppressor) {
       submodules_.noise_suppressor->Process(capture_buffer);
     }
   }
@@ -1407,19 +1443,20 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
   }
 
-  if (submodules_.gain_control) {
+  if (process_gain_control) {
     // TODO(peah): Add reporting from AEC3 whether there is echo.
     RETURN_ON_ERR(submodules_.gain_control->ProcessCaptureAudio(
         capture_buffer, /*stream_has_echo*/ false));
   }
 
-  if (submodule_states_.CaptureMultiBandProcessingPresent() &&
+  if (process_split_bands &&
+      submodule_states_.CaptureMultiBandProcessingPresent() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
     capture_buffer->MergeFrequencyBands();
   }
 
-  if (capture_.capture_output_used) {
+  if (capture_output_used) {
     if (capture_.capture_fullband_audio) {
       const auto& ec = submodules_.echo_controller;
       bool ec_active = ec ? ec->ActiveProcessing() : false;
@@ -1492,6 +1529,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     recommended_input_volume_stats_reporter_.UpdateStatistics(
         *capture_.recommended_input_volume);
   }
+  NotifyRecommendedInputVolumeLocked();
 
   if (submodules_.capture_levels_adjuster) {
     submodules_.capture_levels_adjuster->ApplyPostLevelAdjustment(
@@ -1522,6 +1560,9 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   capture_.capture_output_used_last_frame = capture_.capture_output_used;
 
   capture_.was_stream_delay_set = false;
+  // The applied input volume is kept for the next frame, for which it is only
+  // flagged as changed if `set_stream_analog_level()` sets a different one.
+  capture_.applied_input_volume_changed = false;
 
   data_dumper_->DumpRaw("recommended_input_volume",
                         capture_.recommended_input_volume.value_or(
@@ -1621,6 +1662,51 @@ int AudioProcessingImpl::ProcessReverseStream(const int16_t* const src,
   return kNoError;
 }
 
+int AudioProcessingImpl::ProcessReverseStream(const float* const src,
+                                              const StreamConfig& input_config,
+                                              const StreamConfig& output_config,
+                                              float* const dest) {
+  TRACE_EVENT0("webrtc", "AudioProcessing::ProcessReverseStream_Interleaved");
+
+  MutexLock lock(&mutex_render_);
+  DenormalDisabler denormal_disabler;
+
+  RETURN_ON_ERR(
+      HandleUnsupportedAudioFormats(src, input_config, output_config, dest));
+  MaybeInitializeRender(input_config, output_config);
+
+  if (aec_dump_) {
+    ChannelBuffer<float> deinterleaved(input_config.num_frames(),
+                                       input_config.num_channels());
+    DeinterleaveToChannelBuffer(src, input_config, deinterleaved);
+    aec_dump_->WriteRenderStreamMessage(AudioFrameView<const float>(
+        deinterleaved.channels(), deinterleaved.num_channels(),
+        deinterleaved.num_frames()));
+  }
+
+  render_.render_audio->CopyFrom(src, input_config);
+  RETURN_ON_ERR(ProcessRenderStreamLocked());
+  if (submodule_states_.RenderMultiBandProcessingActive() ||
+      submodule_states_.RenderFullBandProcessingActive()) {
+    render_.render_audio->CopyTo(output_config, dest);
+  } else if (formats_.api_format.reverse_input_stream() !=
+             formats_.api_format.reverse_output_stream()) {
+    ChannelBuffer<float>& input = *render_.render_converter_input;
+    ChannelBuffer<float>& output = *render_.render_converter_output;
+    DeinterleaveToChannelBuffer(src, input_config, input);
+    render_.render_converter->Convert(input.channels(), input.size(),
+                                      output.channels(), output.size());
+    Interleave(DeinterleavedView<const float>(output.channels()[0],
+                                              output_config.num_frames(),
+                                              output_config.num_channels()),
+               InterleavedView<float>(dest, output_config.num_frames(),
+                                      output_config.num_channels()));
+  } else if (src != dest) {
+    memcpy(dest, src, input_config.num_samples() * sizeof(*dest));
+  }
+  return kNoError;
+}
+
 int AudioProcessingImpl::ProcessRenderStreamLocked() {
   AudioBuffer* render_buffer = render_.render_audio.get();  // For brevity.
 
@@ -1631,7 +1717,8 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
     submodules_.render_pre_processor->Process(render_buffer);
   }
 
-  QueueNonbandedRenderAudio(render_buffer);
+  render_queue_frame_.Reset();
+  PackNonbandedRenderAudio(*render_buffer);
 
   if (submodule_states_.RenderMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
@@ -1640,8 +1727,9 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
   }
 
   if (submodule_states_.RenderMultiBandSubModulesActive()) {
-    QueueBandedRenderAudio(render_buffer);
+    PackBandedRenderAudio(*render_buffer);
   }
+  QueueRenderAudio();
 
   // TODO(peah): Perform the queuing inside QueueRenderAudiuo().
   if (submodules_.echo_controller) {
@@ -1702,6 +1790,23 @@ bool AudioProcessingImpl::GetLinearAecOutput(
   return false;
 }
 
+std::vector<uint8_t> AudioProcessingImpl::GetEchoCancellerWarmStartState() {
+  MutexLock lock(&mutex_capture_);
+  if (!submodules_.echo_controller) {
+    return {};
+  }
+  return submodules_.echo_controller->GetWarmStartState();
+}
+
+bool AudioProcessingImpl::SetEchoCancellerWarmStartState(
+    rtc::ArrayView<const uint8_t> state) {
+  MutexLock lock(&mutex_capture_);
+  if (!submodules_.echo_controller) {
+    return false;
+  }
+  return submodules_.echo_controller->SetWarmStartState(state);
+}
+
 int AudioProcessingImpl::stream_delay_ms() const {
   // Used as callback from submodules, hence locking is not allowed.
   return capture_nonlocked_.stream_delay_ms;
@@ -1722,6 +1827,9 @@ void AudioProcessingImpl::set_stream_analog_level_locked(int level) {
       capture_.applied_input_volume.has_value() &&
       *capture_.applied_input_volume != level;
   capture_.applied_input_volume = level;
+  if (capture_.applied_input_volume_changed) {
+    capture_.notified_input_volume = std::nullopt;
+  }
 
   // Invalidate any previously recommended input volume which will be updated by
   // `ProcessStream()`.
@@ -1784,6 +1892,55 @@ void AudioProcessingImpl::UpdateRecommendedInputVolumeLocked() {
   capture_.recommended_input_volume = capture_.applied_input_volume;
 }
 
+void AudioProcessingImpl::SetRecommendedStreamAnalogLevelCallback(
+    absl::AnyInvocable<void(int)> callback) {
+  // The callback and the flag enabling the notifications are published
+  // together, so that no notification is produced for a missing callback.
+  MutexLock lock_callback(&mutex_input_volume_callback_);
+  MutexLock lock_capture(&mutex_capture_);
+  recommended_input_volume_callback_ = std::move(callback);
+  capture_.has_recommended_input_volume_callback =
+      recommended_input_volume_callback_ != nullptr;
+  capture_.notified_input_volume = std::nullopt;
+  capture_.input_volume_to_notify = std::nullopt;
+}
+
+void AudioProcessingImpl::NotifyRecommendedInputVolumeLocked() {
+  // With the input volume emulation, the recommended input volume is applied
+  // by APM itself.
+  if (!capture_.has_recommended_input_volume_callback ||
+      !capture_.recommended_input_volume.has_value() ||
+      config_.capture_level_adjustment.analog_mic_gain_emulation.enabled) {
+    return;
+  }
+  const int input_volume = *capture_.recommended_input_volume;
+  if (input_volume == capture_.applied_input_volume ||
+      input_volume == capture_.notified_input_volume) {
+    return;
+  }
+  capture_.notified_input_volume = input_volume;
+  capture_.input_volume_to_notify = input_volume;
+}
+
+AudioProcessingImpl::CaptureStreamLock::CaptureStreamLock(
+    AudioProcessingImpl* apm)
+    : apm_(apm) {
+  apm_->mutex_capture_.Lock();
+}
+
+AudioProcessingImpl::CaptureStreamLock::~CaptureStreamLock() {
+  const std::optional<int> input_volume =
+      std::exchange(apm_->capture_.input_volume_to_notify, std::nullopt);
+  apm_->mutex_capture_.Unlock();
+  if (!input_volume.has_value()) {
+    return;
+  }
+  MutexLock lock_callback(&apm_->mutex_input_volume_callback_);
+  if (apm_->recommended_input_volume_callback_) {
+    apm_->recommended_input_volume_callback_(*input_volume);
+  }
+}
+
 bool AudioProcessingImpl::CreateAndAttachAecDump(
     absl::string_view file_name,
     int64_t max_log_size_bytes,
@@ -1898,6 +2055,8 @@ void AudioProcessingImpl::InitializeEchoController() {
           config, multichannel_config, proc_sample_rate_hz(),
           num_reverse_channels(), num_proc_channels());
     }
+    submodules_.echo_controller->SetCaptureOutputUsage(
+        capture_.capture_output_used);
 
     // Setup the storage for returning the linear AEC output.
     if (config_.echo_canceller.export_linear_aec_output) {
@@ -1912,7 +2071,6 @@ void AudioProcessingImpl::InitializeEchoController() {
     capture_nonlocked_.echo_controller_enabled = true;
 
     submodules_.echo_control_mobile.reset();
-    aecm_render_signal_queue_.reset();
     return;
   }
 
@@ -1922,28 +2080,11 @@ void AudioProcessingImpl::InitializeEchoController() {
 
   if (!config_.echo_canceller.enabled) {
     submodules_.echo_control_mobile.reset();
-    aecm_render_signal_queue_.reset();
     return;
   }
 
   if (config_.echo_canceller.mobile_mode) {
     // Create and activate AECM.
-    size_t max_element_size =
-        std::max(static_cast<size_t>(1),
-                 kMaxAllowedValuesOfSamplesPerBand *
-                     EchoControlMobileImpl::NumCancellersRequired(
-                         num_output_channels(), num_reverse_channels()));
-
-    std::vector<int16_t> template_queue_element(max_element_size);
-
-    aecm_render_signal_queue_.reset(
-        new SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>(
-            kMaxNumFramesToBuffer, template_queue_element,
-            RenderQueueItemVerifier<int16_t>(max_element_size)));
-
-    aecm_render_queue_buffer_.resize(max_element_size);
-    aecm_capture_queue_buffer_.resize(max_element_size);
-
     submodules_.echo_control_mobile.reset(new EchoControlMobileImpl());
 
     submodules_.echo_control_mobile->Initialize(proc_split_sample_rate_hz(),
@@ -1953,7 +2094,6 @@ void AudioProcessingImpl::InitializeEchoController() {
   }
 
   submodules_.echo_control_mobile.reset();
-  aecm_render_signal_queue_.reset();
 }
 
 void AudioProcessingImpl::InitializeGainController1() {
@@ -2008,7 +2148,10 @@ void AudioProcessingImpl::InitializeGainController1() {
 
   if (!submodules_.agc_manager.get() ||
       submodules_.agc_manager->num_channels() !=
-          static_cast<int>(num_proc_channels())) {
+          static_cast<int>(num_proc_channels()) ||
+      submodules_.agc_manager->shared_channel_analysis() !=
+          config_.gain_controller1.analog_gain_controller
+              .shared_channel_analysis) {
     int stream_analog_level = -1;
     const bool re_creation = !!submodules_.agc_manager;
     if (re_creation) {
@@ -2069,6 +2212,8 @@ void AudioProcessingImpl::InitializeNoiseSuppressor() {
     cfg.target_level = map_level(config_.noise_suppression.level);
     submodules_.noise_suppressor = std::make_unique<NoiseSuppressor>(
         cfg, proc_sample_rate_hz(), num_proc_channels());
+    submodules_.noise_suppressor->SetCaptureOutputUsage(
+        capture_.capture_output_used);
   }
 }
 
@@ -2213,6 +2358,21 @@ void AudioProcessingImpl::RecordUnprocessedCaptureStream(
   RecordAudioProcessingState();
 }
 
+void AudioProcessingImpl::RecordUnprocessedCaptureStream(
+    const float* const data,
+    const StreamConfig& config) {
+  RTC_DCHECK(aec_dump_);
+  WriteAecDumpConfigMessage(false);
+
+  ChannelBuffer<float> deinterleaved(config.num_frames(),
+                                     config.num_channels());
+  DeinterleaveToChannelBuffer(data, config, deinterleaved);
+  aec_dump_->AddCaptureStreamInput(AudioFrameView<const float>(
+      deinterleaved.channels(), deinterleaved.num_channels(),
+      deinterleaved.num_frames()));
+  RecordAudioProcessingState();
+}
+
 void AudioProcessingImpl::RecordProcessedCaptureStream(
     const float* const* processed_capture_stream) {
   RTC_DCHECK(aec_dump_);
@@ -2235,6 +2395,20 @@ void AudioProcessingImpl::RecordProcessedCaptureStream(
   aec_dump_->WriteCaptureStreamMessage();
 }
 
+void AudioProcessingImpl::RecordProcessedCaptureStream(
+    const float* const data,
+    const StreamConfig& config) {
+  RTC_DCHECK(aec_dump_);
+
+  ChannelBuffer<float> deinterleaved(config.num_frames(),
+                                     config.num_channels());
+  DeinterleaveToChannelBuffer(data, config, deinterleaved);
+  aec_dump_->AddCaptureStreamOutput(AudioFrameView<const float>(
+      deinterleaved.channels(), deinterleaved.num_channels(),
+      deinterleaved.num_frames()));
+  aec_dump_->WriteCaptureStreamMessage();
+}
+
 void AudioProcessingImpl::RecordAudioProcessingState() {
   RTC_DCHECK(aec_dump_);
   AecDump::AudioProcessingState audio_proc_state;
@@ -2256,7 +2430,8 @@ AudioProcessingImpl::ApmCaptureState::ApmCaptureState()
       prev_pre_adjustment_gain(-1.0f),
       playout_volume(-1),
       prev_playout_volume(-1),
-      applied_input_volume_changed(false) {}
+      applied_input_volume_changed(false),
+      has_recommended_input_volume_callback(false) {}
 
 AudioProcessingImpl::ApmCaptureState::~ApmCaptureState() = default;
 
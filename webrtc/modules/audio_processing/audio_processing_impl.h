@@ -21,12 +21,14 @@
 #include <vector>
 
 #include "absl/base/nullability.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "api/audio/audio_processing.h"
 #include "api/audio/audio_processing_statistics.h"
 #include "api/function_view.h"
 #include "api/task_queue/task_queue_base.h"
+#include "common_audio/channel_buffer.h"
 #include "modules/audio_processing/aec3/echo_canceller3.h"
 #include "modules/audio_processing/agc/agc_manager_direct.h"
 #include "modules/audio_processing/agc/gain_control.h"
@@ -40,7 +42,7 @@
 #include "modules/audio_processing/include/aec_dump.h"
 #include "modules/audio_processing/include/audio_frame_proxies.h"
 #include "modules/audio_processing/ns/noise_suppressor.h"
-#include "modules/audio_processing/render_queue_item_verifier.h"
+#include "modules/audio_processing/render_queue_frame.h"
 #include "modules/audio_processing/rms_level.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/swap_queue.h"
@@ -95,8 +97,15 @@ class AudioProcessingImpl : public AudioProcessing {
                     const StreamConfig& input_config,
                     const StreamConfig& output_config,
                     float* const* dest) override;
+  int ProcessStream(const float* const src,
+                    const StreamConfig& input_config,
+                    const StreamConfig& output_config,
+                    float* const dest) override;
   bool GetLinearAecOutput(
       rtc::ArrayView<std::array<float, 160>> linear_output) const override;
+  std::vector<uint8_t> GetEchoCancellerWarmStartState() override;
+  bool SetEchoCancellerWarmStartState(
+      rtc::ArrayView<const uint8_t> state) override;
   void set_output_will_be_muted(bool muted) override;
   void HandleCaptureOutputUsedSetting(bool capture_output_used)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
@@ -105,6 +114,8 @@ class AudioProcessingImpl : public AudioProcessing {
   void set_stream_analog_level(int level) override;
   int recommended_stream_analog_level() const
       RTC_LOCKS_EXCLUDED(mutex_capture_) override;
+  void SetRecommendedStreamAnalogLevelCallback(
+      absl::AnyInvocable<void(int)> callback) override;
 
   // Render-side exclusive methods possibly running APM in a
   // multi-threaded manner. Acquire the render lock.
@@ -118,6 +129,10 @@ class AudioProcessingImpl : public AudioProcessing {
                            const StreamConfig& input_config,
                            const StreamConfig& output_config,
                            float* const* dest) override;
+  int ProcessReverseStream(const float* const src,
+                           const StreamConfig& input_config,
+                           const StreamConfig& output_config,
+                           float* const dest) override;
 
   // Methods only accessed from APM submodules or
   // from AudioProcessing tests in a single-threaded manner.
@@ -160,6 +175,27 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void UpdateRecommendedInputVolumeLocked()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  // Queues the recommended input volume for the callback, if any, when it
+  // asks for an input volume change that has not been notified yet.
+  void NotifyRecommendedInputVolumeLocked()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
+  // Holds the capture lock during a ProcessStream() call. Once the lock is
+  // released, passes the input volume queued by
+  // NotifyRecommendedInputVolumeLocked(), if any, to the callback, so that the
+  // callback can call into APM.
+  class RTC_SCOPED_LOCKABLE CaptureStreamLock {
+   public:
+    explicit CaptureStreamLock(AudioProcessingImpl* apm)
+        RTC_EXCLUSIVE_LOCK_FUNCTION(apm->mutex_capture_);
+    ~CaptureStreamLock() RTC_UNLOCK_FUNCTION();
+
+    CaptureStreamLock(const CaptureStreamLock&) = delete;
+    CaptureStreamLock& operator=(const CaptureStreamLock&) = delete;
+
+   private:
+    AudioProcessingImpl* const apm_;
+  };
 
   // Class providing thread-safe message pipe functionality for
   // `runtime_settings_`.
@@ -287,10 +323,11 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
-  void QueueBandedRenderAudio(AudioBuffer* audio)
+  void PackBandedRenderAudio(const AudioBuffer& audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
-  void QueueNonbandedRenderAudio(AudioBuffer* audio)
+  void PackNonbandedRenderAudio(const AudioBuffer& audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
+  void QueueRenderAudio() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
   // Capture-side exclusive methods possibly running APM in a multi-threaded
   // manner that are called with the render lock already acquired.
@@ -320,6 +357,10 @@ class AudioProcessingImpl : public AudioProcessing {
                                       const StreamConfig& config)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
 
+  void RecordUnprocessedCaptureStream(const float* const data,
+                                      const StreamConfig& config)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
   // Notifies attached AecDump of current configuration and
   // processed capture data and issues a capture stream recording
   // request.
@@ -331,6 +372,10 @@ class AudioProcessingImpl : public AudioProcessing {
                                     const StreamConfig& config)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
 
+  void RecordProcessedCaptureStream(const float* const data,
+                                    const StreamConfig& config)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
   // Notifies attached AecDump about current state (delay, drift, etc).
   void RecordAudioProcessingState()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
@@ -352,6 +397,12 @@ class AudioProcessingImpl : public AudioProcessing {
   // Critical sections.
   mutable Mutex mutex_render_ RTC_ACQUIRED_BEFORE(mutex_capture_);
   mutable Mutex mutex_capture_;
+  Mutex mutex_input_volume_callback_ RTC_ACQUIRED_BEFORE(mutex_capture_);
+
+  // Callback notified of the recommended input volume changes. It is invoked
+  // without holding the capture lock, and may call set_stream_analog_level().
+  absl::AnyInvocable<void(int)> recommended_input_volume_callback_
+      RTC_GUARDED_BY(mutex_input_volume_callback_);
 
   // Struct containing the Config specifying the behavior of APM.
   AudioProcessing::Config config_;
@@ -446,6 +497,12 @@ class AudioProcessingImpl : public AudioProcessing {
     // that audio is acquired. Unspecified when no input volume can be
     // recommended.
     std::optional<int> recommended_input_volume;
+    // Whether a recommended input volume callback is set, the last input
+    // volume passed to it since the applied input volume changed and the input
+    // volume to pass to it once the capture lock is released.
+    bool has_recommended_input_volume_callback;
+    std::optional<int> notified_input_volume;
+    std::optional<int> input_volume_to_notify;
   } capture_ RTC_GUARDED_BY(mutex_capture_);
 
   struct ApmCaptureNonLockedState {
@@ -466,6 +523,10 @@ class AudioProcessingImpl : public AudioProcessing {
     ApmRenderState();
     ~ApmRenderState();
     std::unique_ptr<AudioConverter> render_converter;
+    // Deinterleaved input and output of `render_converter` for the
+    // interleaved float ProcessReverseStream().
+    std::unique_ptr<ChannelBuffer<float>> render_converter_input;
+    std::unique_ptr<ChannelBuffer<float>> render_converter_output;
     std::unique_ptr<AudioBuffer> render_audio;
   } render_ RTC_GUARDED_BY(mutex_render_);
 
@@ -488,19 +549,10 @@ class AudioProcessingImpl : public AudioProcessing {
     SwapQueue<AudioProcessingStats> stats_message_queue_;
   } stats_reporter_;
 
-  std::vector<int16_t> aecm_render_queue_buffer_ RTC_GUARDED_BY(mutex_render_);
-  std::vector<int16_t> aecm_capture_queue_buffer_
-      RTC_GUARDED_BY(mutex_capture_);
-
-  size_t agc_render_queue_element_max_size_ RTC_GUARDED_BY(mutex_render_)
-      RTC_GUARDED_BY(mutex_capture_) = 0;
-  std::vector<int16_t> agc_render_queue_buffer_ RTC_GUARDED_BY(mutex_render_);
-  std::vector<int16_t> agc_capture_queue_buffer_ RTC_GUARDED_BY(mutex_capture_);
-
-  size_t red_render_queue_element_max_size_ RTC_GUARDED_BY(mutex_render_)
-      RTC_GUARDED_BY(mutex_capture_) = 0;
-  std::vector<float> red_render_queue_buffer_ RTC_GUARDED_BY(mutex_render_);
-  std::vector<float> red_capture_queue_buffer_ RTC_GUARDED_BY(mutex_capture_);
+  // Render audio shared by the capture side submodules, as packed on the render
+  // side and as removed from the queue on the capture side.
+  RenderQueueFrame render_queue_frame_ RTC_GUARDED_BY(mutex_render_);
+  RenderQueueFrame capture_queue_frame_ RTC_GUARDED_BY(mutex_capture_);
 
   RmsLevel capture_input_rms_ RTC_GUARDED_BY(mutex_capture_);
   RmsLevel capture_output_rms_ RTC_GUARDED_BY(mutex_capture_);
@@ -512,14 +564,8 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_GUARDED_BY(mutex_capture_);
 
   // Lock protection not needed.
-  std::unique_ptr<
-      SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>>
-      aecm_render_signal_queue_;
-  std::unique_ptr<
-      SwapQueue<std::vector<int16_t>, RenderQueueItemVerifier<int16_t>>>
-      agc_render_signal_queue_;
-  std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
-      red_render_signal_queue_;
+  std::unique_ptr<SwapQueue<RenderQueueFrame, RenderQueueFrameVerifier>>
+      render_signal_queue_;
 };
 
 }  // namespace webrtc
@@ -108,47 +108,20 @@ EchoControlMobileImpl::EchoControlMobileImpl()
 EchoControlMobileImpl::~EchoControlMobileImpl() {}
 
 void EchoControlMobileImpl::ProcessRenderAudio(
-    rtc::ArrayView<const int16_t> packed_render_audio) {
+    rtc::ArrayView<const int16_t> render_audio) {
   RTC_DCHECK(stream_properties_);
+  const size_t num_reverse_channels = stream_properties_->num_reverse_channels;
+  const size_t num_frames_per_band = render_audio.size() / num_reverse_channels;
+  RTC_DCHECK_EQ(num_frames_per_band * num_reverse_channels,
+                render_audio.size());
 
-  size_t buffer_index = 0;
-  size_t num_frames_per_band =
-      packed_render_audio.size() / (stream_properties_->num_output_channels *
-                                    stream_properties_->num_reverse_channels);
-
+  // The ordering convention must be followed to pass to the correct AECM.
+  size_t render_channel = 0;
   for (auto& canceller : cancellers_) {
     WebRtcAecm_BufferFarend(canceller->state(),
-                            &packed_render_audio[buffer_index],
+                            &render_audio[render_channel * num_frames_per_band],
                             num_frames_per_band);
-
-    buffer_index += num_frames_per_band;
-  }
-}
-
-void EchoControlMobileImpl::PackRenderAudioBuffer(
-    const AudioBuffer* audio,
-    size_t num_output_channels,
-    size_t num_channels,
-    std::vector<int16_t>* packed_buffer) {
-  RTC_DCHECK_GE(AudioBuffer::kMaxSplitFrameLength,
-                audio->num_frames_per_band());
-  RTC_DCHECK_EQ(num_channels, audio->num_channels());
-
-  // The ordering convention must be followed to pass to the correct AECM.
-  packed_buffer->clear();
-  int render_channel = 0;
-  for (size_t i = 0; i < num_output_channels; i++) {
-    for (size_t j = 0; j < audio->num_channels(); j++) {
-      std::array<int16_t, AudioBuffer::kMaxSplitFrameLength> data_to_buffer;
-      FloatS16ToS16(audio->split_bands_const(render_channel)[kBand0To8kHz],
-                    audio->num_frames_per_band(), data_to_buffer.data());
-
-      // Buffer the samples in the render queue.
-      packed_buffer->insert(
-          packed_buffer->end(), data_to_buffer.data(),
-          data_to_buffer.data() + audio->num_frames_per_band());
-      render_channel = (render_channel + 1) % audio->num_channels();
-    }
+    render_channel = (render_channel + 1) % num_reverse_channels;
   }
 }
 
@@ -52,18 +52,15 @@ class EchoControlMobileImpl {
   int enable_comfort_noise(bool enable);
   bool is_comfort_noise_enabled() const;
 
-  void ProcessRenderAudio(rtc::ArrayView<const int16_t> packed_render_audio);
+  // Buffers the 0-8 kHz band of the render audio, with the render channels
+  // stored one after the other.
+  void ProcessRenderAudio(rtc::ArrayView<const int16_t> render_audio);
   int ProcessCaptureAudio(AudioBuffer* audio, int stream_delay_ms);
 
   void Initialize(int sample_rate_hz,
                   size_t num_reverse_channels,
                   size_t num_output_channels);
 
-  static void PackRenderAudioBuffer(const AudioBuffer* audio,
-                                    size_t num_output_channels,
-                                    size_t num_channels,
-                                    std::vector<int16_t>* packed_buffer);
-
   static size_t NumCancellersRequired(size_t num_output_channels,
                                       size_t num_reverse_channels);
 
@@ -106,41 +106,13 @@ GainControlImpl::GainControlImpl()
 GainControlImpl::~GainControlImpl() = default;
 
 void GainControlImpl::ProcessRenderAudio(
-    rtc::ArrayView<const int16_t> packed_render_audio) {
+    rtc::ArrayView<const int16_t> render_audio) {
   for (size_t ch = 0; ch < mono_agcs_.size(); ++ch) {
-    WebRtcAgc_AddFarend(mono_agcs_[ch]->state, packed_render_audio.data(),
-                        packed_render_audio.size());
+    WebRtcAgc_AddFarend(mono_agcs_[ch]->state, render_audio.data(),
+                        render_audio.size());
   }
 }
 
-void GainControlImpl::PackRenderAudioBuffer(
-    const AudioBuffer& audio,
-    std::vector<int16_t>* packed_buffer) {
-  RTC_DCHECK_GE(AudioBuffer::kMaxSplitFrameLength, audio.num_frames_per_band());
-  std::array<int16_t, AudioBuffer::kMaxSplitFrameLength>
-      mixed_16_kHz_render_data;
-  rtc::ArrayView<const int16_t> mixed_16_kHz_render(
-      mixed_16_kHz_render_data.data(), audio.num_frames_per_band());
-  if (audio.num_channels() == 1) {
-    FloatS16ToS16(audio.split_bands_const(0)[kBand0To8kHz],
-                  audio.num_frames_per_band(), mixed_16_kHz_render_data.data());
-  } else {
-    const int num_channels = static_cast<int>(audio.num_channels());
-    for (size_t i = 0; i < audio.num_frames_per_band(); ++i) {
-      int32_t sum = 0;
-      for (int ch = 0; ch < num_channels; ++ch) {
-        sum += FloatS16ToS16(audio.split_channels_const(kBand0To8kHz)[ch][i]);
-      }
-      mixed_16_kHz_render_data[i] = sum / num_channels;
-    }
-  }
-
-  packed_buffer->clear();
-  packed_buffer->insert(
-      packed_buffer->end(), mixed_16_kHz_render.data(),
-      (mixed_16_kHz_render.data() + audio.num_frames_per_band()));
-}
-
 int GainControlImpl::AnalyzeCaptureAudio(const AudioBuffer& audio) {
   RTC_DCHECK(num_proc_channels_);
   RTC_DCHECK_GE(AudioBuffer::kMaxSplitFrameLength, audio.num_frames_per_band());
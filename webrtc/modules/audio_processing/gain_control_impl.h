@@ -34,15 +34,13 @@ class GainControlImpl : public GainControl {
 
   ~GainControlImpl() override;
 
-  void ProcessRenderAudio(rtc::ArrayView<const int16_t> packed_render_audio);
+  // Analyzes the 0-8 kHz band of the render audio, downmixed to mono.
+  void ProcessRenderAudio(rtc::ArrayView<const int16_t> render_audio);
   int AnalyzeCaptureAudio(const AudioBuffer& audio);
   int ProcessCaptureAudio(AudioBuffer* audio, bool stream_has_echo);
 
   void Initialize(size_t num_proc_channels, int sample_rate_hz);
 
-  static void PackRenderAudioBuffer(const AudioBuffer& audio,
-                                    std::vector<int16_t>* packed_buffer);
-
   // GainControl implementation.
   int stream_analog_level() const override;
   bool is_limiter_enabled() const override { return limiter_enabled_; }
@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/gain_controller2.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <utility>
 
@@ -63,18 +65,14 @@ struct SpeechLevel {
   float rms_dbfs;
 };
 
-// Computes the audio levels for the first channel in `frame`.
-AudioLevels ComputeAudioLevels(DeinterleavedView<float> frame,
+// Computes the audio levels from the statistics of a channel with
+// `samples_per_channel` samples.
+AudioLevels ComputeAudioLevels(const ChannelStatistics& statistics,
+                               size_t samples_per_channel,
                                ApmDataDumper& data_dumper) {
-  float peak = 0.0f;
-  float rms = 0.0f;
-  for (const auto& x : frame[0]) {
-    peak = std::max(std::fabs(x), peak);
-    rms += x * x;
-  }
   AudioLevels levels{
-      FloatS16ToDbfs(peak),
-      FloatS16ToDbfs(std::sqrt(rms / frame.samples_per_channel()))};
+      FloatS16ToDbfs(statistics.peak),
+      FloatS16ToDbfs(std::sqrt(statistics.energy / samples_per_channel))};
   data_dumper.DumpRaw("agc2_input_rms_dbfs", levels.rms_dbfs);
   data_dumper.DumpRaw("agc2_input_peak_dbfs", levels.peak_dbfs);
   return levels;
@@ -97,7 +95,9 @@ GainController2::GainController2(
           /*initial_gain_factor=*/DbToRatio(config.fixed_digital.gain_db)),
       limiter_(&data_dumper_,
                SampleRateToDefaultChannelSize(sample_rate_hz),
-               /*histogram_name_prefix=*/"Agc2"),
+               /*histogram_name_prefix=*/"Agc2",
+               /*enable_gain_curve_stats=*/true),
+      channel_statistics_(num_channels),
       calls_since_last_limiter_log_(0) {
   RTC_DCHECK(Validate(config));
   data_dumper_.InitiateNewSetOfRecordings();
@@ -201,13 +201,24 @@ void GainController2::Process(std::optional<float> speech_probability,
   if (speech_probability.has_value())
     data_dumper_.DumpRaw("agc2_speech_probability", *speech_probability);
 
-  // Compute audio, noise and speech levels.
-  AudioLevels audio_levels = ComputeAudioLevels(float_frame, data_dumper_);
+  // Compute audio, noise and speech levels. The samples are traversed once for
+  // all of them; the audio levels only need the first channel.
+  const size_t num_analyzed_channels =
+      noise_level_estimator_ ? float_frame.num_channels() : 1;
+  channel_statistics_.resize(
+      std::max(channel_statistics_.size(), num_analyzed_channels));
+  for (size_t ch = 0; ch < num_analyzed_channels; ++ch) {
+    channel_statistics_[ch] = ComputeChannelStatistics(float_frame[ch]);
+  }
+  AudioLevels audio_levels =
+      ComputeAudioLevels(channel_statistics_[0],
+                         float_frame.samples_per_channel(), data_dumper_);
   std::optional<float> noise_rms_dbfs;
   if (noise_level_estimator_) {
-    // TODO(bugs.webrtc.org/7494): Pass `audio_levels` to remove duplicated
-    // computation in `noise_level_estimator_`.
-    noise_rms_dbfs = noise_level_estimator_->Analyze(float_frame);
+    noise_rms_dbfs = noise_level_estimator_->Analyze(
+        rtc::ArrayView<const ChannelStatistics>(channel_statistics_.data(),
+                                                num_analyzed_channels),
+        static_cast<int>(float_frame.samples_per_channel()));
   }
   std::optional<SpeechLevel> speech_level;
   if (speech_level_estimator_) {
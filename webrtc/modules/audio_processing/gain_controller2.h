@@ -14,9 +14,11 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/audio/audio_processing.h"
 #include "modules/audio_processing/agc2/adaptive_digital_gain_controller.h"
+#include "modules/audio_processing/agc2/channel_statistics.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/gain_applier.h"
 #include "modules/audio_processing/agc2/input_volume_controller.h"
@@ -95,6 +97,9 @@ class GainController2 {
   std::unique_ptr<SaturationProtector> saturation_protector_;
   std::unique_ptr<AdaptiveDigitalGainController> adaptive_digital_controller_;
   Limiter limiter_;
+  // Statistics of the channels of the frame passed to `Process()`, shared by
+  // the audio and noise level estimation.
+  std::vector<ChannelStatistics> channel_statistics_;
 
   int calls_since_last_limiter_log_;
 
@@ -30,6 +30,7 @@ class HighPassFilter {
 
   void Process(AudioBuffer* audio, bool use_split_band_data);
   void Process(std::vector<std::vector<float>>* audio);
+  void Process(size_t channel, rtc::ArrayView<float> audio);
   void Reset();
   void Reset(size_t num_channels);
 
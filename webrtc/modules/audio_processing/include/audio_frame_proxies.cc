@@ -10,10 +10,48 @@
 
 #include "modules/audio_processing/include/audio_frame_proxies.h"
 
+#include <array>
+
 #include "api/audio/audio_frame.h"
 #include "api/audio/audio_processing.h"
+#include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+// The views hold 10 ms of audio.
+int SampleRateHz(size_t samples_per_channel) {
+  return static_cast<int>(samples_per_channel * 100);
+}
+
+// The int16 reverse stream must be at a native rate.
+int CheckReverseFormat(int sample_rate_hz, size_t num_channels) {
+  if (sample_rate_hz != AudioProcessing::NativeRate::kSampleRate8kHz &&
+      sample_rate_hz != AudioProcessing::NativeRate::kSampleRate16kHz &&
+      sample_rate_hz != AudioProcessing::NativeRate::kSampleRate32kHz &&
+      sample_rate_hz != AudioProcessing::NativeRate::kSampleRate48kHz) {
+    return AudioProcessing::Error::kBadSampleRateError;
+  }
+
+  if (num_channels == 0) {
+    return AudioProcessing::Error::kBadNumberChannelsError;
+  }
+  return AudioProcessing::Error::kNoError;
+}
+
+// Points to the channels of `frame`, which must not have more than
+// kMaxConcurrentChannels channels.
+std::array<float*, kMaxConcurrentChannels> ChannelPointers(
+    DeinterleavedView<float> frame) {
+  RTC_DCHECK_LE(NumChannels(frame), kMaxConcurrentChannels);
+  std::array<float*, kMaxConcurrentChannels> channels = {};
+  for (size_t ch = 0; ch < NumChannels(frame); ++ch) {
+    channels[ch] = frame[ch].data();
+  }
+  return channels;
+}
+
+}  // namespace
 
 int ProcessAudioFrame(AudioProcessing* ap, AudioFrame* frame) {
   if (!frame || !ap) {
@@ -43,16 +81,10 @@ int ProcessReverseAudioFrame(AudioProcessing* ap, AudioFrame* frame) {
     return AudioProcessing::Error::kNullPointerError;
   }
 
-  // Must be a native rate.
-  if (frame->sample_rate_hz_ != AudioProcessing::NativeRate::kSampleRate8kHz &&
-      frame->sample_rate_hz_ != AudioProcessing::NativeRate::kSampleRate16kHz &&
-      frame->sample_rate_hz_ != AudioProcessing::NativeRate::kSampleRate32kHz &&
-      frame->sample_rate_hz_ != AudioProcessing::NativeRate::kSampleRate48kHz) {
-    return AudioProcessing::Error::kBadSampleRateError;
-  }
-
-  if (frame->num_channels_ <= 0) {
-    return AudioProcessing::Error::kBadNumberChannelsError;
+  const int format_error =
+      CheckReverseFormat(frame->sample_rate_hz_, frame->num_channels_);
+  if (format_error != AudioProcessing::Error::kNoError) {
+    return format_error;
   }
 
   StreamConfig input_config(frame->sample_rate_hz_, frame->num_channels_);
@@ -63,4 +95,67 @@ int ProcessReverseAudioFrame(AudioProcessing* ap, AudioFrame* frame) {
   return result;
 }
 
+int ProcessAudioFrame(AudioProcessing* ap, InterleavedView<int16_t> frame) {
+  if (!ap) {
+    return AudioProcessing::Error::kNullPointerError;
+  }
+
+  StreamConfig config(SampleRateHz(SamplesPerChannel(frame)),
+                      NumChannels(frame));
+  return ap->ProcessStream(frame.data().data(), config, config,
+                           frame.data().data());
+}
+
+int ProcessAudioFrame(AudioProcessing* ap, DeinterleavedView<float> frame) {
+  if (!ap) {
+    return AudioProcessing::Error::kNullPointerError;
+  }
+
+  if (NumChannels(frame) > kMaxConcurrentChannels) {
+    return AudioProcessing::Error::kBadNumberChannelsError;
+  }
+
+  StreamConfig config(SampleRateHz(SamplesPerChannel(frame)),
+                      NumChannels(frame));
+  const std::array<float*, kMaxConcurrentChannels> channels =
+      ChannelPointers(frame);
+  return ap->ProcessStream(channels.data(), config, config, channels.data());
+}
+
+int ProcessReverseAudioFrame(AudioProcessing* ap,
+                             InterleavedView<int16_t> frame) {
+  if (!ap) {
+    return AudioProcessing::Error::kNullPointerError;
+  }
+
+  const int sample_rate_hz = SampleRateHz(SamplesPerChannel(frame));
+  const int format_error =
+      CheckReverseFormat(sample_rate_hz, NumChannels(frame));
+  if (format_error != AudioProcessing::Error::kNoError) {
+    return format_error;
+  }
+
+  StreamConfig config(sample_rate_hz, NumChannels(frame));
+  return ap->ProcessReverseStream(frame.data().data(), config, config,
+                                  frame.data().data());
+}
+
+int ProcessReverseAudioFrame(AudioProcessing* ap,
+                             DeinterleavedView<float> frame) {
+  if (!ap) {
+    return AudioProcessing::Error::kNullPointerError;
+  }
+
+  if (NumChannels(frame) > kMaxConcurrentChannels) {
+    return AudioProcessing::Error::kBadNumberChannelsError;
+  }
+
+  StreamConfig config(SampleRateHz(SamplesPerChannel(frame)),
+                      NumChannels(frame));
+  const std::array<float*, kMaxConcurrentChannels> channels =
+      ChannelPointers(frame);
+  return ap->ProcessReverseStream(channels.data(), config, config,
+                                  channels.data());
+}
+
 }  // namespace webrtc
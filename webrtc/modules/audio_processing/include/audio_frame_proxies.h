@@ -11,6 +11,10 @@
 #ifndef MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_FRAME_PROXIES_H_
 #define MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_FRAME_PROXIES_H_
 
+#include <stdint.h>
+
+#include "api/audio/audio_view.h"
+
 namespace webrtc {
 
 class AudioFrame;
@@ -36,6 +40,19 @@ int ProcessAudioFrame(AudioProcessing* ap, AudioFrame* frame);
 // ProcessReverseStream method.
 int ProcessReverseAudioFrame(AudioProcessing* ap, AudioFrame* frame);
 
+// Versions of the above that process caller-owned 10 ms frames in place,
+// without the fixed size buffer of an AudioFrame. The sample rate follows from
+// the number of samples per channel. The float versions take audio in the
+// range [-1, 1] and support up to kMaxConcurrentChannels channels. The voice
+// activity, if detected, is available through
+// AudioProcessing::GetStatistics().
+int ProcessAudioFrame(AudioProcessing* ap, InterleavedView<int16_t> frame);
+int ProcessAudioFrame(AudioProcessing* ap, DeinterleavedView<float> frame);
+int ProcessReverseAudioFrame(AudioProcessing* ap,
+                             InterleavedView<int16_t> frame);
+int ProcessReverseAudioFrame(AudioProcessing* ap,
+                             DeinterleavedView<float> frame);
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_INCLUDE_AUDIO_FRAME_PROXIES_H_
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/render_queue_frame.h"
+
+#include <algorithm>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RenderQueueFrame::RenderQueueFrame(size_t max_num_channels,
+                                   size_t max_num_fullband_samples)
+    : max_num_channels_(max_num_channels),
+      fullband_(max_num_fullband_samples),
+      lowest_band_(max_num_channels * AudioBuffer::kMaxSplitFrameLength),
+      downmixed_lowest_band_(AudioBuffer::kMaxSplitFrameLength) {}
+
+void RenderQueueFrame::Reset() {
+  num_channels_ = 0;
+  num_frames_per_band_ = 0;
+  num_fullband_samples_ = 0;
+  has_fullband_ = false;
+  has_downmix_ = false;
+}
+
+void RenderQueueFrame::PackFullband(const AudioBuffer& audio) {
+  RTC_DCHECK_GE(fullband_.size(), audio.num_frames());
+  num_fullband_samples_ = audio.num_frames();
+  std::copy(audio.channels_const()[0],
+            audio.channels_const()[0] + num_fullband_samples_,
+            fullband_.begin());
+  has_fullband_ = true;
+}
+
+void RenderQueueFrame::PackLowestBand(const AudioBuffer& audio, bool downmix) {
+  RTC_DCHECK_GE(AudioBuffer::kMaxSplitFrameLength, audio.num_frames_per_band());
+  RTC_DCHECK_GE(max_num_channels_, audio.num_channels());
+  RTC_DCHECK_LT(0, audio.num_channels());
+  num_channels_ = audio.num_channels();
+  num_frames_per_band_ = audio.num_frames_per_band();
+
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    FloatS16ToS16(audio.split_bands_const(ch)[kBand0To8kHz],
+                  num_frames_per_band_,
+                  &lowest_band_[ch * num_frames_per_band_]);
+  }
+
+  // The downmix of a single channel is the channel itself, which is returned
+  // without any copy.
+  has_downmix_ = downmix;
+  if (!downmix || num_channels_ == 1) {
+    return;
+  }
+  const int num_channels = static_cast<int>(num_channels_);
+  for (size_t i = 0; i < num_frames_per_band_; ++i) {
+    int32_t sum = 0;
+    for (size_t ch = 0; ch < num_channels_; ++ch) {
+      sum += lowest_band_[ch * num_frames_per_band_ + i];
+    }
+    downmixed_lowest_band_[i] = sum / num_channels;
+  }
+}
+
+rtc::ArrayView<const float> RenderQueueFrame::fullband() const {
+  RTC_DCHECK(has_fullband_);
+  return rtc::ArrayView<const float>(fullband_.data(), num_fullband_samples_);
+}
+
+rtc::ArrayView<const int16_t> RenderQueueFrame::lowest_band() const {
+  RTC_DCHECK(has_lowest_band());
+  return rtc::ArrayView<const int16_t>(lowest_band_.data(),
+                                       num_channels_ * num_frames_per_band_);
+}
+
+rtc::ArrayView<const int16_t> RenderQueueFrame::downmixed_lowest_band() const {
+  RTC_DCHECK(has_downmix_);
+  return rtc::ArrayView<const int16_t>(
+      num_channels_ == 1 ? lowest_band_.data() : downmixed_lowest_band_.data(),
+      num_frames_per_band_);
+}
+
+}  // namespace webrtc
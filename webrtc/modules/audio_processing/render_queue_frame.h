@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_RENDER_QUEUE_FRAME_H_
+#define MODULES_AUDIO_PROCESSING_RENDER_QUEUE_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/audio_buffer.h"
+
+namespace webrtc {
+
+// Render audio handed over from the render side to the capture side submodules
+// that do not own a render path of their own (AECM, AGC1 and the residual echo
+// detector). The frame is packed once per render call and passed through a
+// single queue; each submodule reads its part through views instead of
+// getting a separately packed copy.
+class RenderQueueFrame {
+ public:
+  RenderQueueFrame() = default;
+  // Preallocates storage for up to `max_num_channels` render channels with
+  // room for `max_num_fullband_samples` samples of fullband audio.
+  RenderQueueFrame(size_t max_num_channels, size_t max_num_fullband_samples);
+
+  // Clears the content of the frame, keeping the allocated storage.
+  void Reset();
+
+  // Stores the first channel of the fullband `audio`.
+  void PackFullband(const AudioBuffer& audio);
+
+  // Stores the 0-8 kHz band of all channels in `audio`, converted to S16, and
+  // optionally the average of them.
+  void PackLowestBand(const AudioBuffer& audio, bool downmix);
+
+  bool has_fullband() const { return has_fullband_; }
+  bool has_lowest_band() const { return num_channels_ > 0; }
+  bool has_downmixed_lowest_band() const { return has_downmix_; }
+
+  // Fullband samples of the first render channel.
+  rtc::ArrayView<const float> fullband() const;
+
+  // 0-8 kHz band of all render channels stored one channel after the other.
+  rtc::ArrayView<const int16_t> lowest_band() const;
+
+  // Average of the 0-8 kHz band of all render channels.
+  rtc::ArrayView<const int16_t> downmixed_lowest_band() const;
+
+  size_t max_num_channels() const { return max_num_channels_; }
+  size_t max_num_fullband_samples() const { return fullband_.size(); }
+
+ private:
+  size_t max_num_channels_ = 0;
+  size_t num_channels_ = 0;
+  size_t num_frames_per_band_ = 0;
+  size_t num_fullband_samples_ = 0;
+  bool has_fullband_ = false;
+  bool has_downmix_ = false;
+  std::vector<float> fullband_;
+  std::vector<int16_t> lowest_band_;
+  std::vector<int16_t> downmixed_lowest_band_;
+};
+
+// Functor verifying that queue items have the storage required for the
+// current render format.
+class RenderQueueFrameVerifier {
+ public:
+  RenderQueueFrameVerifier(size_t max_num_channels,
+                           size_t max_num_fullband_samples)
+      : max_num_channels_(max_num_channels),
+        max_num_fullband_samples_(max_num_fullband_samples) {}
+
+  bool operator()(const RenderQueueFrame& frame) const {
+    return frame.max_num_channels() >= max_num_channels_ &&
+           frame.max_num_fullband_samples() >= max_num_fullband_samples_;
+  }
+
+ private:
+  size_t max_num_channels_;
+  size_t max_num_fullband_samples_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_RENDER_QUEUE_FRAME_H_
@@ -104,6 +104,9 @@ int GetCPUInfo(CPUFeature feature) {
   if (feature == kFMA3) {
     return 0 != (cpu_info[2] & 0x00001000);
   }
+  if (feature == kF16C) {
+    return 0 != (cpu_info[2] & 0x20000000);
+  }
   return 0;
 }
 #else